@@ -52,6 +52,7 @@
 
 #include "Serializer/JsonSerializer.h"
 #include "Serializer/WorldSerializer.h"
+#include "WorldFileBinary.h"
 
 #include "Util/Algorithm.h"
 #include "Util/FpsCounter.h"
@@ -429,6 +430,16 @@ void Editor::ExportEntity()
     }
 }
 
+void Editor::ExportCompiledWorld()
+{
+    Save();
+
+    const std::string compiled_filename = shared::CompiledWorldFilename(m_world_filename.c_str());
+    const bool compiled = shared::CompileWorldFile(m_world_filename.c_str(), compiled_filename.c_str());
+    if(compiled)
+        m_context.notifications.emplace_back(export_texture, "Exported compiled world...", 2000);
+}
+
 void Editor::ImportEntity()
 {
     m_context.modal_items = GetAllEntities();
@@ -884,6 +895,8 @@ void Editor::EditorMenuCallback(EditorMenuOptions option)
         DuplicateSelected();
     else if(option == EditorMenuOptions::REEXPORTENTITIES)
         ReExportEntities();
+    else if(option == EditorMenuOptions::EXPORT_COMPILED_WORLD)
+        ExportCompiledWorld();
 }
 
 void Editor::ToolsMenuCallback(ToolsMenuOptions option)
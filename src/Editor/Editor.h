@@ -57,6 +57,7 @@ namespace editor
         void Save();
         void ImportEntity();
         void ExportEntity();
+        void ExportCompiledWorld();
 
         void AddPath(const std::vector<math::Vector>& path_points);
 
@@ -44,6 +44,9 @@ namespace
             if(ImGui::MenuItem("Re Export Entiites"))
                 context.editor_menu_callback(EditorMenuOptions::REEXPORTENTITIES);
 
+            if(ImGui::MenuItem("Export Compiled World"))
+                context.editor_menu_callback(EditorMenuOptions::EXPORT_COMPILED_WORLD);
+
             ImGui::EndMenu();
         }
 
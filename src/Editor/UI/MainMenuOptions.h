@@ -11,6 +11,7 @@ namespace editor
         EXPORT_ENTITY,
         DUPLICATE,
         REEXPORTENTITIES,
+        EXPORT_COMPILED_WORLD,
     };
 
     enum ToolsMenuOptions
@@ -20,6 +20,9 @@
 #include "Entity/LoadEntity.h"
 
 #include "DamageSystem.h"
+#include "Entity/EntityPoolSystem.h"
+#include "SimulationClock.h"
+#include "TimerSystem.h"
 #include "TriggerSystem/TriggerSystem.h"
 
 #include "Editor.h"
@@ -50,6 +53,9 @@ int main()
         mono::EventHandler event_handler;
         mono::SystemContext system_context;
 
+        // Entity files are edited while the editor runs.
+        shared::SetEntityFileReload(true);
+
         mono::TransformSystem* transform_system = system_context.CreateSystem<mono::TransformSystem>(max_entities);
         system_context.CreateSystem<mono::SpriteSystem>(max_entities, transform_system);
         system_context.CreateSystem<mono::TextSystem>(max_entities, transform_system);
@@ -65,8 +71,12 @@ int main()
         mono::EntitySystem* entity_system = system_context.CreateSystem<mono::EntitySystem>(
             max_entities, &system_context, shared::LoadEntityFile, ComponentNameFromHash);
 
-        game::DamageSystem* damage_system = system_context.CreateSystem<game::DamageSystem>(max_entities, entity_system, &event_handler);
-        system_context.CreateSystem<game::TriggerSystem>(max_entities, damage_system, physics_system, entity_system);
+        game::EntityPoolSystem* entity_pool_system = system_context.CreateSystem<game::EntityPoolSystem>(entity_system, &system_context);
+        game::DamageSystem* damage_system =
+            system_context.CreateSystem<game::DamageSystem>(max_entities, entity_system, entity_pool_system, &event_handler);
+        game::SimulationClock* simulation_clock = system_context.CreateSystem<game::SimulationClock>(60);
+        game::TimerSystem* timer_system = system_context.CreateSystem<game::TimerSystem>(max_entities, simulation_clock);
+        system_context.CreateSystem<game::TriggerSystem>(max_entities, damage_system, physics_system, entity_system, timer_system);
 
 
         shared::RegisterSharedComponents(entity_system);
@@ -0,0 +1,63 @@
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+
+namespace game
+{
+    // Array indexed by entity id that grows a chunk at a time. Elements never move when it grows, so pointers to
+    // components stay valid while more entities are added. New elements are value initialized.
+    template <typename T, size_t ChunkSize = 256>
+    class ChunkedArray
+    {
+    public:
+
+        static_assert((ChunkSize & (ChunkSize - 1)) == 0, "Chunk size has to be a power of two");
+
+        ChunkedArray()
+            : m_size(0)
+        { }
+
+        ChunkedArray(size_t size)
+            : m_size(0)
+        {
+            EnsureSize(size);
+        }
+
+        // Grows the array to at least the size, rounded up to whole chunks. Never shrinks.
+        void EnsureSize(size_t size)
+        {
+            while(m_size < size)
+            {
+                m_chunks.push_back(std::make_unique<T[]>(ChunkSize));
+                m_size += ChunkSize;
+            }
+        }
+
+        size_t Size() const
+        {
+            return m_size;
+        }
+
+        T& operator[](size_t index)
+        {
+            assert(index < m_size);
+            return m_chunks[index / ChunkSize][index & (ChunkSize - 1)];
+        }
+
+        const T& operator[](size_t index) const
+        {
+            assert(index < m_size);
+            return m_chunks[index / ChunkSize][index & (ChunkSize - 1)];
+        }
+
+    private:
+
+        size_t m_size;
+        std::vector<std::unique_ptr<T[]>> m_chunks;
+    };
+}
@@ -1,5 +1,7 @@
 
 #include "DamageSystem.h"
+#include "Component.h"
+#include "Entity/EntityPoolSystem.h"
 
 #include "EntitySystem/IEntityManager.h"
 #include "EventHandler/EventHandler.h"
@@ -8,6 +10,7 @@
 #include "System/Hash.h"
 #include <limits>
 #include <cassert>
+#include <algorithm>
 
 
 #include "Math/MathFunctions.h"
@@ -16,108 +19,196 @@
 
 using namespace game;
 
+namespace
+{
+    constexpr uint32_t NO_CALLBACK = std::numeric_limits<uint32_t>::max();
+}
+
 DamageSystem::DamageSystem(
     size_t num_records,
     mono::IEntityManager* entity_manager,
+    EntityPoolSystem* entity_pool,
     mono::EventHandler* event_handler)
     : m_entity_manager(entity_manager)
+    , m_entity_pool(entity_pool)
     , m_event_handler(event_handler)
     , m_timestamp(0)
+    , m_health(num_records)
     , m_damage_records(num_records)
-    , m_damage_callbacks(num_records)
-    , m_active(num_records, false)
+    , m_active(num_records)
+    , m_callback_lists(num_records)
+    , m_n_callbacks(0)
 { }
 
 DamageRecord* DamageSystem::CreateRecord(uint32_t id)
 {
-    assert(!m_active[id]);
-    m_active[id] = true;
+    const bool added = m_active.Add(id);
+    assert(added);
+    (void)added;
+
+    m_health.EnsureSize(id + 1);
+    m_damage_records.EnsureSize(id + 1);
+    m_callback_lists.EnsureSize(id + 1);
+
+    HealthData& health_data = m_health[id];
+    health_data.health = 100;
+    health_data.release_entity_on_death = true;
 
     DamageRecord& new_record = m_damage_records[id];
-    new_record.health = 100;
     new_record.strong_against = 0;
     new_record.weak_against = 0;
     new_record.multipier = 1;
     new_record.last_damaged_timestamp = std::numeric_limits<uint32_t>::max();
-    new_record.release_entity_on_death = true;
+
+    m_callback_lists[id] = NO_CALLBACK;
 
     return &new_record;
 }
 
 uint32_t DamageSystem::SetDamageCallback(uint32_t id, uint32_t callback_types, DamageCallback damage_callback)
 {
-    const size_t free_index = FindFreeCallbackIndex(id);
-    assert(free_index != std::numeric_limits<size_t>::max());
-    m_damage_callbacks[id][free_index] = { callback_types, damage_callback };
-    return free_index;
+    uint32_t callback_index;
+    if(m_free_callbacks.empty())
+    {
+        callback_index = m_n_callbacks++;
+        m_callbacks.EnsureSize(m_n_callbacks);
+    }
+    else
+    {
+        callback_index = m_free_callbacks.back();
+        m_free_callbacks.pop_back();
+    }
+
+    DamageCallbackData& callback_data = m_callbacks[callback_index];
+    callback_data.id = id;
+    callback_data.callback_types = callback_types;
+    callback_data.next = m_callback_lists[id];
+    callback_data.callback = std::move(damage_callback);
+    m_callback_lists[id] = callback_index;
+
+    return callback_index;
 }
 
 void DamageSystem::RemoveDamageCallback(uint32_t id, uint32_t callback_id)
 {
-    m_damage_callbacks[id][callback_id].callback = nullptr;
+    // The callback might be the one that is called right now, it's destroyed with the other removed ones.
+    DamageCallbackData& callback_data = m_callbacks[callback_id];
+    if(callback_data.id != id || callback_data.callback_types == 0)
+        return;
+
+    callback_data.callback_types = 0;
+    m_removed_callbacks.push_back(callback_id);
+}
+
+void DamageSystem::RemoveAllCallbacks(uint32_t id)
+{
+    for(uint32_t index = m_callback_lists[id]; index != NO_CALLBACK; index = m_callbacks[index].next)
+        RemoveDamageCallback(id, index);
+}
+
+void DamageSystem::FreeRemovedCallbacks()
+{
+    for(uint32_t callback_index : m_removed_callbacks)
+    {
+        // The list is gone if the record was created again since the callback was removed.
+        const uint32_t id = m_callbacks[callback_index].id;
+        uint32_t* link = &m_callback_lists[id];
+        while(*link != NO_CALLBACK && *link != callback_index)
+            link = &m_callbacks[*link].next;
+
+        if(*link == callback_index)
+            *link = m_callbacks[callback_index].next;
+
+        m_callbacks[callback_index].next = NO_CALLBACK;
+        m_callbacks[callback_index].callback = nullptr;
+        m_free_callbacks.push_back(callback_index);
+    }
+
+    m_removed_callbacks.clear();
 }
 
 void DamageSystem::ReleaseRecord(uint32_t id)
 {
-    for(auto& callback : m_damage_callbacks[id])
-        callback.callback = nullptr;
+    RemoveAllCallbacks(id);
+    m_active.Remove(id);
+}
 
-    m_active[id] = false;
+void DamageSystem::ResetRecord(uint32_t id)
+{
+    RemoveAllCallbacks(id);
+
+    HealthData& health_data = m_health[id];
+    DamageRecord& damage_record = m_damage_records[id];
+
+    health_data.health = damage_record.full_health;
+    health_data.release_entity_on_death = true;
+    damage_record.multipier = 1;
+    damage_record.last_damaged_timestamp = std::numeric_limits<uint32_t>::max();
 }
 
 bool DamageSystem::IsAllocated(uint32_t id) const
 {
-    return m_active[id];
+    return m_active.Contains(id);
 }
 
 DamageRecord* DamageSystem::GetDamageRecord(uint32_t id)
 {
-    assert(m_active[id]);
+    assert(m_active.Contains(id));
     return &m_damage_records[id];
 }
 
+int DamageSystem::GetHealth(uint32_t id) const
+{
+    assert(m_active.Contains(id));
+    return m_health[id].health;
+}
+
+void DamageSystem::SetHealth(uint32_t id, int health)
+{
+    assert(m_active.Contains(id));
+    HealthData& health_data = m_health[id];
+
+    const bool killed = (health_data.health > 0 && health <= 0);
+    health_data.health = health;
+
+    if(killed)
+        m_dead.push_back(id);
+}
+
 DamageResult DamageSystem::ApplyDamage(uint32_t id, int damage, uint32_t id_who_did_damage)
 {
     DamageResult result = { false, 0 };
 
-    DamageRecord& damage_record = m_damage_records[id];
-    if(damage_record.health <= 0)
+    // Read only, the health is not written while other systems run.
+    if(!m_active.Contains(id))
         return result;
 
-    damage_record.health -= damage * damage_record.multipier;
-    damage_record.last_damaged_timestamp = m_timestamp;
-
-    damage_record.health = std::max(0, damage_record.health);
+    const int health = m_health[id].health;
+    if(health <= 0)
+        return result;
 
     result.did_damage = true;
-    result.health_left = damage_record.health;
+    result.health_left = health;
 
-    const DamageType damage_type = (result.health_left <= 0) ? DamageType::DESTROYED : DamageType::DAMAGED;
-
-    for(const auto& callback_data : m_damage_callbacks[id])
-    {
-        if(callback_data.callback && callback_data.callback_types & damage_type)
-            callback_data.callback(id, damage, id_who_did_damage, damage_type);
-    }
-
-    if(damage_type == DamageType::DESTROYED)
-    {
-        m_event_handler->DispatchEvent(game::ScoreEvent(id_who_did_damage, damage_record.score));
-        if(!damage_record.release_entity_on_death)
-            m_destroyed_but_not_released.push_back(id);
-    }
+    std::lock_guard<std::mutex> lock(m_damage_mutex);
+    m_damage_requests.push_back({ id, damage, id_who_did_damage });
 
     return result;
 }
 
-const std::vector<DamageRecord>& DamageSystem::GetDamageRecords() const
+const ChunkedArray<DamageRecord>& DamageSystem::GetDamageRecords() const
 {
     return m_damage_records;
 }
 
 void DamageSystem::PreventReleaseOnDeath(uint32_t id, bool enable)
 {
-    m_damage_records[id].release_entity_on_death = !enable;
+    HealthData& health_data = m_health[id];
+    health_data.release_entity_on_death = !enable;
+
+    // Already dead and kept alive until now, released with the others in the next update.
+    if(!enable && health_data.health <= 0)
+        m_dead.push_back(id);
 }
 
 uint32_t DamageSystem::Id() const
@@ -130,35 +221,126 @@ const char* DamageSystem::Name() const
     return "damagesystem";
 }
 
-void DamageSystem::Update(const mono::UpdateContext& update_context)
+SystemAccess DamageSystem::Access() const
+{
+    // Damage and destroyed callbacks, and releasing the dead entities.
+    SystemAccess access;
+    access.exclusive = true;
+    return access;
+}
+
+void DamageSystem::ScheduledUpdate(const mono::UpdateContext& update_context)
 {
     m_timestamp = update_context.timestamp;
 
-    for(uint32_t entity_id = 0; entity_id < m_damage_records.size(); ++entity_id)
+    FreeRemovedCallbacks();
+    ResolveDamage();
+    ReleaseDead();
+}
+
+void DamageSystem::ReleaseDead()
+{
+    for(uint32_t entity_id : m_dead)
+    {
+        if(!m_active.Contains(entity_id))
+            continue;
+
+        const HealthData& health_data = m_health[entity_id];
+        if(health_data.health <= 0 && health_data.release_entity_on_death)
+            m_entity_pool->ReleaseEntity(entity_id);
+    }
+
+    m_dead.clear();
+}
+
+void DamageSystem::ResolveDamage()
+{
     {
-        if(!m_active[entity_id])
+        std::lock_guard<std::mutex> lock(m_damage_mutex);
+        std::swap(m_damage_requests, m_resolve_requests);
+    }
+
+    // Grouped per target in the order the damage was queued, so the kill goes to the last hit.
+    const auto sort_by_target = [](const DamageRequest& first, const DamageRequest& second) {
+        return first.id < second.id;
+    };
+    std::stable_sort(m_resolve_requests.begin(), m_resolve_requests.end(), sort_by_target);
+
+    size_t begin = 0;
+    while(begin < m_resolve_requests.size())
+    {
+        const uint32_t id = m_resolve_requests[begin].id;
+
+        size_t end = begin + 1;
+        while(end < m_resolve_requests.size() && m_resolve_requests[end].id == id)
+            end++;
+
+        const size_t first_request = begin;
+        begin = end;
+
+        if(!m_active.Contains(id))
+            continue;
+
+        HealthData& health_data = m_health[id];
+        if(health_data.health <= 0)
             continue;
 
-        DamageRecord& damage_record = m_damage_records[entity_id];
-        if(damage_record.health <= 0)
+        DamageRecord& damage_record = m_damage_records[id];
+
+        // The request that takes the health to zero gets the kill, the rest are dropped.
+        int total_damage = 0;
+        uint32_t id_who_did_damage = 0;
+
+        for(size_t index = first_request; index < end; ++index)
+        {
+            const DamageRequest& request = m_resolve_requests[index];
+            health_data.health -= request.damage * damage_record.multipier;
+            total_damage += request.damage;
+            id_who_did_damage = request.id_who_did_damage;
+
+            if(health_data.health <= 0)
+                break;
+        }
+
+        health_data.health = std::max(0, health_data.health);
+        damage_record.last_damaged_timestamp = m_timestamp;
+
+        const DamageType damage_type = (health_data.health <= 0) ? DamageType::DESTROYED : DamageType::DAMAGED;
+
+        if(damage_type == DamageType::DESTROYED)
+        {
+            m_scores.push_back({ id_who_did_damage, damage_record.score });
+            m_dead.push_back(id);
+        }
+
+        for(uint32_t index = m_callback_lists[id]; index != NO_CALLBACK; index = m_callbacks[index].next)
         {
-            if(damage_record.release_entity_on_death)
-                m_entity_manager->ReleaseEntity(entity_id);
+            const DamageCallbackData& callback_data = m_callbacks[index];
+            if(callback_data.callback_types & damage_type)
+                callback_data.callback(id, total_damage, id_who_did_damage, damage_type);
         }
     }
-}
 
-void DamageSystem::Destroy()
-{ }
+    m_resolve_requests.clear();
 
-size_t DamageSystem::FindFreeCallbackIndex(uint32_t id) const
-{
-    const DamageCallbacks& callbacks = m_damage_callbacks[id];
-    for(size_t index = 0; index < callbacks.size(); ++index)
+    const auto sort_by_id = [](const ScoreData& first, const ScoreData& second) {
+        return first.id < second.id;
+    };
+    std::stable_sort(m_scores.begin(), m_scores.end(), sort_by_id);
+
+    for(size_t index = 0; index < m_scores.size(); ++index)
     {
-        if(callbacks[index].callback == nullptr)
-            return index;
+        const ScoreData& score_data = m_scores[index];
+        int total_score = score_data.score;
+
+        while(index + 1 < m_scores.size() && m_scores[index + 1].id == score_data.id)
+            total_score += m_scores[++index].score;
+
+        m_event_handler->DispatchEvent(game::ScoreEvent(score_data.id, total_score));
     }
 
-    return std::numeric_limits<size_t>::max();
+    m_scores.clear();
 }
+
+void DamageSystem::Destroy()
+{ }
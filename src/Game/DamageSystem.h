@@ -1,25 +1,27 @@
 
 #pragma once
 
-#include "IGameSystem.h"
+#include "Scheduler/ScheduledSystem.h"
+#include "SparseSet.h"
+#include "ChunkedArray.h"
 #include "MonoFwd.h"
 #include <vector>
 #include <functional>
-#include <array>
 #include <memory>
+#include <mutex>
 
 namespace game
 {
+    // The rarely touched part of the health component, the health itself is kept apart from it in the
+    // system and accessed with GetHealth and SetHealth.
     struct DamageRecord
     {
-        int health;
         int full_health;
         int multipier;
         int score;
         uint32_t strong_against;
         uint32_t weak_against;
         uint32_t last_damaged_timestamp;
-        bool release_entity_on_death;
         bool is_boss;
     };
 
@@ -36,64 +38,116 @@ namespace game
         ALL = DESTROYED | DAMAGED,
     };
 
+    class EntityPoolSystem;
+
     using DamageCallback = std::function<void (uint32_t id, int damage, uint32_t who_did_damage, DamageType type)>;
 
-    class DamageSystem : public mono::IGameSystem
+    class DamageSystem : public ScheduledSystem
     {
     public:
         DamageSystem(
             size_t num_records,
             mono::IEntityManager* entity_manager,
+            EntityPoolSystem* entity_pool,
             mono::EventHandler* event_handler);
 
         DamageRecord* CreateRecord(uint32_t id);
         void ReleaseRecord(uint32_t id);
+
+        // Back to full health without callbacks, for an entity that is reused from a pool.
+        void ResetRecord(uint32_t id);
         bool IsAllocated(uint32_t id) const;
         DamageRecord* GetDamageRecord(uint32_t id);
 
+        int GetHealth(uint32_t id) const;
+        void SetHealth(uint32_t id, int health);
+
         uint32_t SetDamageCallback(uint32_t id, uint32_t callback_types, DamageCallback damage_callback);
         void RemoveDamageCallback(uint32_t id, uint32_t callback_id);
 
+        // Queues the damage, it's resolved together with all other damage in the next update in the order it was
+        // queued, so the kill goes to the last hit. The queue is locked, so systems running in parallel can call it.
+        // The health is read without the lock, it's only written by this system's exclusive update and by SetHealth
+        // and the component functions, which must not run at the same time as the callers. The result tells if the
+        // target could take damage, and its health before the damage queued this frame.
         DamageResult ApplyDamage(uint32_t id, int damage, uint32_t id_who_did_damage);
-        const std::vector<DamageRecord>& GetDamageRecords() const;
+        const ChunkedArray<DamageRecord>& GetDamageRecords() const;
 
         void PreventReleaseOnDeath(uint32_t id, bool enable);
 
         template <typename T>
         inline void ForEeach(T&& func)
         {
-            for(size_t entity_id = 0; entity_id < m_damage_records.size(); ++entity_id)
-            {
-                if(m_active[entity_id])
-                    func(entity_id, m_damage_records[entity_id]);
-            }
+            for(uint32_t entity_id : m_active)
+                func(entity_id, m_health[entity_id].health, m_damage_records[entity_id]);
         }
 
         uint32_t Id() const override;
         const char* Name() const override;
-        void Update(const mono::UpdateContext& update_context) override;
+        void ScheduledUpdate(const mono::UpdateContext& update_context) override;
+        SystemAccess Access() const override;
         void Destroy() override;
 
     private:
 
-        size_t FindFreeCallbackIndex(uint32_t id) const;
+        void ReleaseDead();
+        void ResolveDamage();
+        void RemoveAllCallbacks(uint32_t id);
+        void FreeRemovedCallbacks();
 
         mono::IEntityManager* m_entity_manager;
+        EntityPoolSystem* m_entity_pool;
         mono::EventHandler* m_event_handler;
         uint32_t m_timestamp;
-        
-        std::vector<DamageRecord> m_damage_records;
 
+        // What the damage resolve and the release of dead entities touch, packed on its own.
+        struct HealthData
+        {
+            int health;
+            bool release_entity_on_death;
+        };
+
+        ChunkedArray<HealthData> m_health;
+        ChunkedArray<DamageRecord> m_damage_records;
+        SparseSet m_active;
+
+        // Entities that reached zero health, released at the end of the update unless they were revived or reset.
+        // Killed from outside the update, by SetHealth, they are released in the next one.
+        std::vector<uint32_t> m_dead;
+
+        // The damage callbacks of all entities share one pool, each entity has a list through it. Few entities
+        // have any callbacks at all. A removed callback is only unlinked and reused before the next resolve,
+        // so the callbacks can add and remove callbacks while they're called.
         struct DamageCallbackData
         {
+            uint32_t id;
             uint32_t callback_types;
+            uint32_t next;
             DamageCallback callback;
         };
 
-        using DamageCallbacks = std::array<DamageCallbackData, 8>;
-        std::vector<DamageCallbacks> m_damage_callbacks;
-        std::vector<bool> m_active;
+        ChunkedArray<uint32_t> m_callback_lists;
+        ChunkedArray<DamageCallbackData> m_callbacks;
+        uint32_t m_n_callbacks;
+        std::vector<uint32_t> m_free_callbacks;
+        std::vector<uint32_t> m_removed_callbacks;
+
+        struct DamageRequest
+        {
+            uint32_t id;
+            int damage;
+            uint32_t id_who_did_damage;
+        };
+
+        struct ScoreData
+        {
+            uint32_t id;
+            int score;
+        };
 
-        std::vector<uint32_t> m_destroyed_but_not_released;
+        std::mutex m_damage_mutex;
+        std::vector<DamageRequest> m_damage_requests;
+        std::vector<DamageRequest> m_resolve_requests;
+        std::vector<ScoreData> m_scores;
     };
 }
@@ -1,20 +1,27 @@
 
 #include "BulletTrailEffect.h"
+#include "Component.h"
 
+#include "Entity/EntityProperties.h"
+#include "EntitySystem/IEntityManager.h"
 #include "Particle/ParticleSystem.h"
+#include "Rendering/Lights/LightSystem.h"
 #include "Rendering/RenderSystem.h"
 #include "Rendering/Texture/ITextureFactory.h"
 #include "Math/Matrix.h"
 #include "Math/MathFunctions.h"
 #include "TransformSystem/TransformSystem.h"
 #include "Util/Random.h"
+#include "Weapons/ProjectileSystem.h"
 
-#include "EntitySystem/IEntityManager.h"
+#include <limits>
 
 using namespace game;
 
 namespace
 {
+    constexpr uint32_t NO_LIGHT = std::numeric_limits<uint32_t>::max();
+
     void TrailGenerator(const math::Vector& position, mono::ParticlePoolComponentView& component_view)
     {
         constexpr int life = 300;
@@ -39,12 +46,17 @@ namespace
 }
 
 BulletTrailEffect::BulletTrailEffect(
+    const ProjectileSystem* projectile_system,
     mono::TransformSystem* transform_system,
     mono::ParticleSystem* particle_system,
+    mono::LightSystem* light_system,
     mono::IEntityManager* entity_system)
-    : m_transform_system(transform_system)
+    : m_projectile_system(projectile_system)
+    , m_transform_system(transform_system)
     , m_particle_system(particle_system)
+    , m_light_system(light_system)
     , m_entity_system(entity_system)
+    , m_frame(0)
 {
     mono::Entity particle_entity = m_entity_system->CreateEntity("bullettraileffect", {});
     particle_system->AllocatePool(particle_entity.id, 500, mono::DefaultUpdater);
@@ -57,35 +69,122 @@ BulletTrailEffect::BulletTrailEffect(
 
 BulletTrailEffect::~BulletTrailEffect()
 {
+    for(auto& pair : m_attachments)
+        Release(pair.second);
+
+    for(uint32_t light_id : m_light_entities)
+        m_entity_system->ReleaseEntity(light_id);
+
     m_particle_system->ReleasePool(m_particle_entity);
     m_entity_system->ReleaseEntity(m_particle_entity);
 }
 
-void BulletTrailEffect::AttachEmitterToBullet(uint32_t entity_id)
+void BulletTrailEffect::Update(const mono::UpdateContext& update_context)
 {
-    const auto generator_proxy = [this, entity_id](const math::Vector& position, mono::ParticlePoolComponentView& component_view) {
-        const math::Matrix& world_transform = m_transform_system->GetWorld(entity_id);
-        TrailGenerator(math::GetPosition(world_transform), component_view);
+    m_frame++;
+
+    const auto follow_projectile = [this](uint32_t projectile_id, const math::Vector& position, uint8_t flags) {
+        const uint8_t effect_flags = flags & (ProjectileFlags::TRAIL | ProjectileFlags::LIGHT);
+        if(effect_flags == 0)
+            return;
+
+        const auto it = m_attachments.find(projectile_id);
+        const bool has_attachment = (it != m_attachments.end());
+
+        // A released id can be handed out again before this runs, the new projectile gets its own effects.
+        if(has_attachment && it->second.flags != effect_flags)
+            Release(it->second);
+
+        Attachment& attachment = has_attachment ? it->second : m_attachments[projectile_id];
+        attachment.position = position;
+        attachment.last_seen_frame = m_frame;
+
+        if(!has_attachment || attachment.flags != effect_flags)
+        {
+            attachment.flags = effect_flags;
+            Attach(attachment);
+        }
+
+        if(attachment.light_id != NO_LIGHT)
+            m_transform_system->GetTransform(attachment.light_id) = math::CreateMatrixWithPosition(position);
     };
+    m_projectile_system->ForEachProjectileWithId(follow_projectile);
+
+    for(auto it = m_attachments.begin(); it != m_attachments.end();)
+    {
+        if(it->second.last_seen_frame != m_frame)
+        {
+            Release(it->second);
+            it = m_attachments.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
 
-    mono::ParticleEmitterComponent* emitter = m_particle_system->AttachEmitter(
-        m_particle_entity,
-        math::ZeroVec,
-        -1.0f,
-        50.0f,
-        mono::EmitterType::CONTINOUS,
-        generator_proxy);
+void BulletTrailEffect::Attach(Attachment& attachment)
+{
+    attachment.emitter = nullptr;
+    attachment.light_id = NO_LIGHT;
+
+    if(attachment.flags & ProjectileFlags::TRAIL)
+    {
+        const math::Vector* projectile_position = &attachment.position;
+        const auto generator_proxy = [projectile_position](const math::Vector& position, mono::ParticlePoolComponentView& component_view) {
+            TrailGenerator(*projectile_position, component_view);
+        };
+
+        attachment.emitter = m_particle_system->AttachEmitter(
+            m_particle_entity,
+            math::ZeroVec,
+            -1.0f,
+            50.0f,
+            mono::EmitterType::CONTINOUS,
+            generator_proxy);
+    }
 
-    m_bullet_id_to_emitter[entity_id] = emitter;
+    if(attachment.flags & ProjectileFlags::LIGHT)
+    {
+        attachment.light_id = AllocateLight();
+
+        mono::LightComponent light = {};
+        light.radius = 1.0f;
+        light.shade = mono::Color::WHITE;
+        m_light_system->SetData(attachment.light_id, light);
+    }
 }
 
-void BulletTrailEffect::RemoveEmitterFromBullet(uint32_t entity_id)
+void BulletTrailEffect::Release(Attachment& attachment)
 {
-    const auto it = m_bullet_id_to_emitter.find(entity_id);
-    if(it != m_bullet_id_to_emitter.end())
+    if(attachment.emitter)
+        m_particle_system->ReleaseEmitter(m_particle_entity, attachment.emitter);
+
+    if(attachment.light_id != NO_LIGHT)
     {
-        m_particle_system->ReleaseEmitter(m_particle_entity, it->second);
-        m_bullet_id_to_emitter.erase(entity_id);
+        mono::LightComponent no_light = {};
+        no_light.radius = 0.0f;
+        m_light_system->SetData(attachment.light_id, no_light);
+        m_free_lights.push_back(attachment.light_id);
     }
+
+    attachment.emitter = nullptr;
+    attachment.light_id = NO_LIGHT;
 }
 
+uint32_t BulletTrailEffect::AllocateLight()
+{
+    if(!m_free_lights.empty())
+    {
+        const uint32_t light_id = m_free_lights.back();
+        m_free_lights.pop_back();
+        return light_id;
+    }
+
+    const mono::Entity light_entity = m_entity_system->CreateEntity("bulletlight", { TRANSFORM_COMPONENT, LIGHT_COMPONENT });
+    m_entity_system->SetEntityProperties(light_entity.id, EntityProperties::LOCAL);
+    m_light_entities.push_back(light_entity.id);
+
+    return light_entity.id;
+}
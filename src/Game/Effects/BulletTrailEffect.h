@@ -2,32 +2,60 @@
 #pragma once
 
 #include "MonoFwd.h"
+#include "IUpdatable.h"
 #include "Particle/ParticleFwd.h"
+#include "Math/Vector.h"
+
 #include <cstdint>
+#include <vector>
 #include <unordered_map>
 
 namespace game
 {
-    class BulletTrailEffect
+    class ProjectileSystem;
+
+    // Particle trails and lights that follow the projectiles flagged with TRAIL or LIGHT, on the server as
+    // well as the visual projectiles on a client. Attached when a projectile shows up, released when it is gone.
+    class BulletTrailEffect : public mono::IUpdatable
     {
     public:
 
         BulletTrailEffect(
+            const ProjectileSystem* projectile_system,
             mono::TransformSystem* transform_system,
             mono::ParticleSystem* particle_system,
+            mono::LightSystem* light_system,
             mono::IEntityManager* entity_system);
         ~BulletTrailEffect();
 
-        void AttachEmitterToBullet(uint32_t entity_id);
-        void RemoveEmitterFromBullet(uint32_t entity_id);
+        void Update(const mono::UpdateContext& update_context) override;
 
     private:
 
+        struct Attachment
+        {
+            math::Vector position;
+            mono::ParticleEmitterComponent* emitter;
+            uint32_t light_id;
+            uint32_t last_seen_frame;
+            uint8_t flags;
+        };
+
+        void Attach(Attachment& attachment);
+        void Release(Attachment& attachment);
+        uint32_t AllocateLight();
+
+        const ProjectileSystem* m_projectile_system;
         mono::TransformSystem* m_transform_system;
         mono::ParticleSystem* m_particle_system;
+        mono::LightSystem* m_light_system;
         mono::IEntityManager* m_entity_system;
         uint32_t m_particle_entity;
+        uint32_t m_frame;
 
-        std::unordered_map<uint32_t, mono::ParticleEmitterComponent*> m_bullet_id_to_emitter;
+        // Node based so that the trail generators can keep a pointer to the position.
+        std::unordered_map<uint32_t, Attachment> m_attachments;
+        std::vector<uint32_t> m_light_entities;
+        std::vector<uint32_t> m_free_lights;
     };
 }
@@ -0,0 +1,121 @@
+
+#include "EffectEvents.h"
+#include "DamageEffect.h"
+#include "ImpactEffect.h"
+
+#include "Entity/EntityProperties.h"
+#include "Entity/EntityPoolSystem.h"
+#include "EntitySystem/IEntityManager.h"
+#include "Math/MathFunctions.h"
+#include "Particle/ParticleSystem.h"
+#include "Rendering/Sprite/SpriteSystem.h"
+#include "Rendering/Sprite/Sprite.h"
+#include "SystemContext.h"
+#include "System/Hash.h"
+#include "System/System.h"
+#include "TransformSystem/TransformSystem.h"
+
+namespace
+{
+    game::DamageEffect* g_damage_effect = nullptr;
+    game::ImpactEffect* g_impact_effect = nullptr;
+
+    mono::IEntityManager* g_entity_manager = nullptr;
+    game::EntityPoolSystem* g_entity_pool = nullptr;
+    mono::SpriteSystem* g_sprite_system = nullptr;
+    mono::TransformSystem* g_transform_system = nullptr;
+
+    bool g_record_events = false;
+    std::vector<game::EffectEvent> g_recorded_events;
+
+    void SpawnAnimatedEntity(const game::EffectEvent& event)
+    {
+        const char* entity_file = hash::HashLookup(event.param);
+        if(!entity_file)
+        {
+            System::Log("EffectEvents|Unable to find entity file for hash %u.", event.param);
+            return;
+        }
+
+        // Spawned locally on both server and clients, the effect event is what gets replicated.
+        const uint32_t spawned_entity_id = g_entity_pool->SpawnEntity(entity_file);
+        g_entity_manager->SetEntityProperties(spawned_entity_id, EntityProperties::LOCAL);
+
+        math::Matrix& entity_transform = g_transform_system->GetTransform(spawned_entity_id);
+        entity_transform = math::CreateMatrixWithPosition(event.position);
+
+        const auto remove_entity_callback = [spawned_entity_id]() {
+            g_entity_pool->ReleaseEntity(spawned_entity_id);
+        };
+
+        mono::Sprite* spawned_entity_sprite = g_sprite_system->GetSprite(spawned_entity_id);
+        spawned_entity_sprite->SetAnimation(event.animation_id, remove_entity_callback);
+    }
+}
+
+void game::InitEffectEvents(mono::SystemContext* system_context)
+{
+    mono::ParticleSystem* particle_system = system_context->GetSystem<mono::ParticleSystem>();
+    g_entity_manager = system_context->GetSystem<mono::IEntityManager>();
+    g_entity_pool = system_context->GetSystem<game::EntityPoolSystem>();
+    g_sprite_system = system_context->GetSystem<mono::SpriteSystem>();
+    g_transform_system = system_context->GetSystem<mono::TransformSystem>();
+
+    g_damage_effect = new game::DamageEffect(particle_system, g_entity_manager);
+    g_impact_effect = new game::ImpactEffect(particle_system, g_entity_manager);
+}
+
+void game::CleanupEffectEvents()
+{
+    delete g_damage_effect;
+    g_damage_effect = nullptr;
+
+    delete g_impact_effect;
+    g_impact_effect = nullptr;
+
+    g_recorded_events.clear();
+}
+
+void game::EmitEffectEvent(const EffectEvent& event)
+{
+    PlayEffectEvent(event);
+
+    if(g_record_events)
+        g_recorded_events.push_back(event);
+}
+
+void game::PlayEffectEvent(const EffectEvent& event)
+{
+    switch(event.type)
+    {
+    case EffectEventType::DAMAGE_GIBS:
+        g_damage_effect->EmitGibsAt(event.position, event.direction);
+        break;
+    case EffectEventType::IMPACT:
+        g_impact_effect->EmittAt(event.position, event.direction);
+        break;
+    case EffectEventType::SPRITE_FLASH:
+        if(g_sprite_system->IsAllocated(event.entity_id))
+            g_sprite_system->GetSprite(event.entity_id)->FlashSprite();
+        break;
+    case EffectEventType::ANIMATED_ENTITY:
+        SpawnAnimatedEntity(event);
+        break;
+    }
+}
+
+void game::SetRecordEffectEvents(bool record)
+{
+    g_record_events = record;
+    g_recorded_events.clear();
+}
+
+const std::vector<game::EffectEvent>& game::GetRecordedEffectEvents()
+{
+    return g_recorded_events;
+}
+
+void game::ClearRecordedEffectEvents()
+{
+    g_recorded_events.clear();
+}
@@ -0,0 +1,45 @@
+
+#pragma once
+
+#include "MonoFwd.h"
+#include "Math/Vector.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace game
+{
+    enum class EffectEventType : uint8_t
+    {
+        DAMAGE_GIBS,
+        IMPACT,
+        SPRITE_FLASH,
+        ANIMATED_ENTITY,
+    };
+
+    // Compact description of a visual effect, replicated to clients and replayed there through the
+    // same effect classes instead of replicating short lived effect entities.
+    struct EffectEvent
+    {
+        uint32_t timestamp;     // Server time, set when the event is replicated
+        math::Vector position;
+        float direction;
+        uint32_t param;         // Entity file hash for ANIMATED_ENTITY
+        uint16_t entity_id;     // Target entity for SPRITE_FLASH
+        EffectEventType type;
+        uint8_t animation_id;   // Animation for ANIMATED_ENTITY
+    };
+
+    void InitEffectEvents(mono::SystemContext* system_context);
+    void CleanupEffectEvents();
+
+    // Plays the effect locally and, if recording, queues it for replication.
+    void EmitEffectEvent(const EffectEvent& event);
+
+    // Plays the effect locally only, used when replaying replicated events.
+    void PlayEffectEvent(const EffectEvent& event);
+
+    void SetRecordEffectEvents(bool record);
+    const std::vector<EffectEvent>& GetRecordedEffectEvents();
+    void ClearRecordedEffectEvents();
+}
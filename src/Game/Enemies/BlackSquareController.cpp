@@ -4,7 +4,8 @@
 #include "Player/PlayerInfo.h"
 #include "CollisionConfiguration.h"
 #include "DamageSystem.h"
-#include "Shockwave.h"
+#include "Entity/EntityPoolSystem.h"
+#include "ShockwaveSystem.h"
 
 #include "Physics/IBody.h"
 #include "Physics/PhysicsSystem.h"
@@ -49,8 +50,9 @@ BlackSquareController::BlackSquareController(uint32_t entity_id, mono::SystemCon
     m_body = m_physics_system->GetBody(entity_id);
     m_body->AddCollisionHandler(this);
 
-    m_entity_manager = system_context->GetSystem<mono::IEntityManager>();
+    m_entity_pool = system_context->GetSystem<game::EntityPoolSystem>();
     m_damage_system = system_context->GetSystem<game::DamageSystem>();
+    m_shockwave_system = system_context->GetSystem<game::ShockwaveSystem>();
 
     using namespace std::placeholders;
 
@@ -79,11 +81,11 @@ mono::CollisionResolve BlackSquareController::OnCollideWith(
     if(category == shared::CollisionCategory::PLAYER)
     {
         const math::Vector& entity_position = math::GetPosition(*m_transform);
-        game::ShockwaveAt(m_physics_system, entity_position, tweak_values::shockwave_magnitude);
+        m_shockwave_system->ShockwaveAt(entity_position, tweak_values::shockwave_magnitude);
 
         const uint32_t other_entity_id = mono::PhysicsSystem::GetIdFromBody(body);
         //m_damage_system->ApplyDamage(other_entity_id, tweak_values::collision_damage, m_entity_id);
-        m_entity_manager->ReleaseEntity(m_entity_id);
+        m_entity_pool->ReleaseEntity(m_entity_id);
     }
 
     return mono::CollisionResolve::NORMAL;
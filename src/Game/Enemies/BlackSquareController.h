@@ -54,8 +54,9 @@ namespace game
         const struct PlayerInfo* m_target_player_info;
         float m_current_heading;
 
-        mono::IEntityManager* m_entity_manager;
+        class EntityPoolSystem* m_entity_pool;
         mono::PhysicsSystem* m_physics_system;
         class DamageSystem* m_damage_system;
+        class ShockwaveSystem* m_shockwave_system;
     };
 }
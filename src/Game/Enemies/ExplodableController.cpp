@@ -2,13 +2,13 @@
 #include "ExplodableController.h"
 
 #include "DamageSystem.h"
+#include "Entity/EntityPoolSystem.h"
 #include "Effects/ExplosionEffect.h"
-#include "Shockwave.h"
+#include "ShockwaveSystem.h"
 
 #include "System/Audio.h"
 #include "EntitySystem/IEntityManager.h"
 #include "Particle/ParticleSystem.h"
-#include "Physics/PhysicsSystem.h"
 #include "Rendering/Sprite/SpriteSystem.h"
 #include "SystemContext.h"
 #include "TransformSystem/TransformSystem.h"
@@ -22,9 +22,10 @@ ExplodableController::ExplodableController(uint32_t entity_id, mono::SystemConte
         audio::CreateSound("res/sound/explosion_metallic.wav", audio::SoundPlayback::ONCE);
 
     m_transform_system = system_context->GetSystem<mono::TransformSystem>();
-    m_physics_system = system_context->GetSystem<mono::PhysicsSystem>();
+    m_shockwave_system = system_context->GetSystem<game::ShockwaveSystem>();
     m_sprite_system = system_context->GetSystem<mono::SpriteSystem>();
     m_entity_system = system_context->GetSystem<mono::IEntityManager>();
+    m_entity_pool = system_context->GetSystem<game::EntityPoolSystem>();
 
     const DamageCallback destroyed_callback = [this](uint32_t id, int damage, uint32_t who_did_damage, DamageType type) {
         m_states.TransitionTo(ExplodableStates::DEAD);
@@ -64,7 +65,7 @@ void ExplodableController::OnDead()
     const math::Vector world_position = math::GetPosition(m_transform_system->GetWorld(m_entity_id));
     m_explosion_effect->ExplodeAt(world_position);
 
-    game::ShockwaveAndDamageAt(m_physics_system, m_damage_system, world_position, 50.0f, 10, m_entity_id);
+    m_shockwave_system->ShockwaveAndDamageAt(world_position, 50.0f, 10, m_entity_id);
 
     m_wait_timer = 0;
 }
@@ -73,5 +74,5 @@ void ExplodableController::Dead(const mono::UpdateContext& update_context)
 {
     m_wait_timer += update_context.delta_ms;
     if(m_wait_timer > 500)
-        m_entity_system->ReleaseEntity(m_entity_id);
+        m_entity_pool->ReleaseEntity(m_entity_id);
 }
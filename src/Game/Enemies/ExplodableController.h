@@ -12,6 +12,8 @@
 namespace game
 {
     class DamageSystem;
+    class EntityPoolSystem;
+    class ShockwaveSystem;
 
     class ExplodableController : public IEntityLogic
     {
@@ -29,9 +31,10 @@ namespace game
 
         uint32_t m_entity_id;
         mono::TransformSystem* m_transform_system;
-        mono::PhysicsSystem* m_physics_system;
+        game::ShockwaveSystem* m_shockwave_system;
         mono::SpriteSystem* m_sprite_system;
         mono::IEntityManager* m_entity_system;
+        game::EntityPoolSystem* m_entity_pool;
 
         game::DamageSystem* m_damage_system;
 
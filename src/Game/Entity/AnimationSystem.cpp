@@ -1,5 +1,6 @@
 
 #include "AnimationSystem.h"
+#include "Component.h"
 #include "TriggerSystem/TriggerSystem.h"
 
 #include "Rendering/Sprite/SpriteSystem.h"
@@ -21,14 +22,16 @@ AnimationSystem::AnimationSystem(
     , m_transform_system(transform_system)
     , m_sprite_system(sprite_system)
     , m_sprite_anim_pool(32)
-    , m_transform_anim_pool(32)
+    , m_n_transform_anims(0)
 {
-    m_animation_containers.resize(n);
-    m_active_animation_containers.resize(n, false);
+    m_animation_containers.EnsureSize(n);
+    m_active_animation_containers.resize(m_animation_containers.Size(), false);
 }
 
 AnimationContainer* AnimationSystem::AllocateAnimationContainer(uint32_t entity_id)
 {
+    m_animation_containers.EnsureSize(entity_id + 1);
+    m_active_animation_containers.resize(m_animation_containers.Size(), false);
     m_active_animation_containers[entity_id] = true;
     
     AnimationContainer& allocated_container = m_animation_containers[entity_id];
@@ -53,13 +56,19 @@ void AnimationSystem::ReleaseAnimationContainer(uint32_t entity_id)
         m_sprite_anim_pool.ReleasePoolData(component);
     }
 
-    for(TransformAnimationComponent* component : allocated_container.transform_components)
+    for(uint32_t transform_anim_index : allocated_container.transform_components)
     {
-        if(component->callback_id != NO_CALLBACK_SET)
-            m_trigger_system->RemoveTriggerCallback(component->trigger_hash, component->callback_id, entity_id);
+        TransformAnimationComponent& component = m_transform_anims[transform_anim_index];
+        if(component.callback_id != NO_CALLBACK_SET)
+            m_trigger_system->RemoveTriggerCallback(component.trigger_hash, component.callback_id, entity_id);
 
-        mono::remove(m_transform_anims_to_process, component);
-        m_transform_anim_pool.ReleasePoolData(component);
+        if(component.tween_id != TweenEngine::NO_TWEEN)
+            m_tween_engine.RemoveTween(component.tween_id);
+
+        // Any start request left in the list is skipped since the flag is cleared.
+        component.tween_id = TweenEngine::NO_TWEEN;
+        component.start_requested = false;
+        m_free_transform_anims.push_back(transform_anim_index);
     }
 
     allocated_container.sprite_components.clear();
@@ -70,7 +79,7 @@ void AnimationSystem::ReleaseAnimationContainer(uint32_t entity_id)
 
 bool AnimationSystem::IsAnimationContainerAllocated(uint32_t entity_id)
 {
-    return m_active_animation_containers[entity_id];
+    return entity_id < m_active_animation_containers.size() && m_active_animation_containers[entity_id];
 }
 
  SpriteAnimationComponent* AnimationSystem::AddSpriteAnimation(
@@ -96,73 +105,95 @@ bool AnimationSystem::IsAnimationContainerAllocated(uint32_t entity_id)
 TransformAnimationComponent* AnimationSystem::AddTranslationComponent(
     uint32_t container_id, uint32_t trigger_hash, float duration, math::EaseFunction func, shared::AnimationMode mode, const math::Vector& translation_delta)
 {
-    TransformAnimationComponent* allocated_component = m_transform_anim_pool.GetPoolData();
-    allocated_component->target_id = container_id;
-    allocated_component->trigger_hash = trigger_hash;
-    allocated_component->callback_id = NO_CALLBACK_SET;
-    allocated_component->duration = duration;
-    allocated_component->duration_counter = 0.0f;
-    allocated_component->ease_function = func;
-    allocated_component->animation_flags = mode;
-    allocated_component->transform_type = TransformAnimType::TRANSLATION;
-    allocated_component->is_initialized = false;
-
-    allocated_component->delta_x = translation_delta.x;
-    allocated_component->delta_y = translation_delta.y;
+    const uint32_t transform_anim_index = AllocateTransformAnimation();
+
+    TransformAnimationComponent& allocated_component = m_transform_anims[transform_anim_index];
+    allocated_component.target_id = container_id;
+    allocated_component.trigger_hash = trigger_hash;
+    allocated_component.callback_id = NO_CALLBACK_SET;
+    allocated_component.duration = duration;
+    allocated_component.ease_function = func;
+    allocated_component.animation_flags = mode;
+    allocated_component.transform_type = TransformAnimType::TRANSLATION;
+    allocated_component.delta_x = translation_delta.x;
+    allocated_component.delta_y = translation_delta.y;
+    allocated_component.start_requested = false;
+    allocated_component.tween_id = TweenEngine::NO_TWEEN;
 
     if(mode & shared::AnimationMode::TRIGGER_ACTIVATED)
     {
-        const TriggerCallback callback = [this, allocated_component](uint32_t trigger_id) {
-            AddTransformAnimatonToUpdate(allocated_component);
+        const TriggerCallback callback = [this, transform_anim_index](uint32_t trigger_id) {
+            AddTransformAnimatonToUpdate(transform_anim_index);
         };
-        allocated_component->callback_id = m_trigger_system->RegisterTriggerCallback(trigger_hash, callback, container_id);
+        allocated_component.callback_id = m_trigger_system->RegisterTriggerCallback(trigger_hash, callback, container_id);
     }
     else
     {
-        AddTransformAnimatonToUpdate(allocated_component);
+        AddTransformAnimatonToUpdate(transform_anim_index);
     }
 
-    m_animation_containers[container_id].transform_components.push_back(allocated_component);
-    return allocated_component;
+    m_animation_containers[container_id].transform_components.push_back(transform_anim_index);
+    return &allocated_component;
 }
 
 TransformAnimationComponent* AnimationSystem::AddRotationComponent(
     uint32_t container_id, uint32_t trigger_hash, float duration, math::EaseFunction func, shared::AnimationMode mode, float rotation_delta)
 {
-    TransformAnimationComponent* allocated_component = m_transform_anim_pool.GetPoolData();
-    allocated_component->target_id = container_id;
-    allocated_component->trigger_hash = trigger_hash;
-    allocated_component->callback_id = NO_CALLBACK_SET;
-    allocated_component->duration = duration;
-    allocated_component->duration_counter = 0.0f;
-    allocated_component->ease_function = func;
-    allocated_component->animation_flags = mode;
-    allocated_component->transform_type = TransformAnimType::ROTATION;
-    allocated_component->is_initialized = false;
-
-    allocated_component->delta_x = rotation_delta;
+    const uint32_t transform_anim_index = AllocateTransformAnimation();
+
+    TransformAnimationComponent& allocated_component = m_transform_anims[transform_anim_index];
+    allocated_component.target_id = container_id;
+    allocated_component.trigger_hash = trigger_hash;
+    allocated_component.callback_id = NO_CALLBACK_SET;
+    allocated_component.duration = duration;
+    allocated_component.ease_function = func;
+    allocated_component.animation_flags = mode;
+    allocated_component.transform_type = TransformAnimType::ROTATION;
+    allocated_component.delta_x = rotation_delta;
+    allocated_component.delta_y = 0.0f;
+    allocated_component.start_requested = false;
+    allocated_component.tween_id = TweenEngine::NO_TWEEN;
 
     if(mode & shared::AnimationMode::TRIGGER_ACTIVATED)
     {
-        const TriggerCallback callback = [this, allocated_component](uint32_t trigger_id) {
-            AddTransformAnimatonToUpdate(allocated_component);
+        const TriggerCallback callback = [this, transform_anim_index](uint32_t trigger_id) {
+            AddTransformAnimatonToUpdate(transform_anim_index);
         };
-        allocated_component->callback_id = m_trigger_system->RegisterTriggerCallback(trigger_hash, callback, container_id);
+        allocated_component.callback_id = m_trigger_system->RegisterTriggerCallback(trigger_hash, callback, container_id);
     }
     else
     {
-        AddTransformAnimatonToUpdate(allocated_component);
+        AddTransformAnimatonToUpdate(transform_anim_index);
     }
 
-    m_animation_containers[container_id].transform_components.push_back(allocated_component);
-    return allocated_component;
+    m_animation_containers[container_id].transform_components.push_back(transform_anim_index);
+    return &allocated_component;
 }
 
-void AnimationSystem::AddTransformAnimatonToUpdate(TransformAnimationComponent* transform_animation)
+uint32_t AnimationSystem::AllocateTransformAnimation()
 {
-    const bool is_in_update = mono::contains(m_transform_anims_to_process, transform_animation);
-    if(!is_in_update)
-        m_transform_anims_to_process.push_back(transform_animation);
+    if(!m_free_transform_anims.empty())
+    {
+        const uint32_t transform_anim_index = m_free_transform_anims.back();
+        m_free_transform_anims.pop_back();
+        return transform_anim_index;
+    }
+
+    const uint32_t transform_anim_index = m_n_transform_anims++;
+    m_transform_anims.EnsureSize(m_n_transform_anims);
+    return transform_anim_index;
+}
+
+void AnimationSystem::AddTransformAnimatonToUpdate(uint32_t transform_anim_index)
+{
+    TransformAnimationComponent& transform_anim = m_transform_anims[transform_anim_index];
+
+    const bool is_in_update = (transform_anim.start_requested || transform_anim.tween_id != TweenEngine::NO_TWEEN);
+    if(is_in_update)
+        return;
+
+    transform_anim.start_requested = true;
+    m_transform_anims_to_start.push_back(transform_anim_index);
 }
 
 uint32_t AnimationSystem::Id() const
@@ -175,7 +206,14 @@ const char* AnimationSystem::Name() const
     return "AnimationSystem";
 }
 
-void AnimationSystem::Update(const mono::UpdateContext& update_context)
+SystemAccess AnimationSystem::Access() const
+{
+    SystemAccess access;
+    access.writes = { ANIMATION_COMPONENT, TRANSLATION_COMPONENT, ROTATION_COMPONENT, TRANSFORM_COMPONENT, SPRITE_COMPONENT, TRIGGERS_RESOURCE };
+    return access;
+}
+
+void AnimationSystem::ScheduledUpdate(const mono::UpdateContext& update_context)
 {
     for(SpriteAnimationComponent* sprite_anim : m_sprite_anims_to_process)
     {
@@ -186,78 +224,109 @@ void AnimationSystem::Update(const mono::UpdateContext& update_context)
     m_sprite_anims_to_process.clear();
 
 
-    const auto process_transform_anims_func = [this, &update_context](TransformAnimationComponent* transform_anim) {
-
-        // Do the stuff
-        math::Matrix& transform = m_transform_system->GetTransform(transform_anim->target_id);
-        const math::Vector& position = math::GetPosition(transform);
+    StartTransformAnimations();
+    m_tween_engine.Update(float(update_context.delta_ms) / 1000.0f);
+    ApplyTweens();
+    FinishTransformAnimations();
+}
 
-        if(!transform_anim->is_initialized)
-        {
-            if(transform_anim->transform_type == TransformAnimType::TRANSLATION)
-            {
-                transform_anim->start_x = position.x;
-                transform_anim->start_y = position.y;
-            }
-            else
-            {
-                transform_anim->start_x = math::GetZRotation(transform);
-            }
+void AnimationSystem::StartTransformAnimations()
+{
+    for(uint32_t transform_anim_index : m_transform_anims_to_start)
+    {
+        TransformAnimationComponent& transform_anim = m_transform_anims[transform_anim_index];
+        if(!transform_anim.start_requested)
+            continue;
 
-            transform_anim->is_initialized = true;
-        }
+        transform_anim.start_requested = false;
 
-        transform_anim->duration_counter += (float(update_context.delta_ms) / 1000.0f);
-        transform_anim->duration_counter = std::clamp(transform_anim->duration_counter, 0.0f, transform_anim->duration);
+        const math::Matrix& transform = m_transform_system->GetTransform(transform_anim.target_id);
 
-        if(transform_anim->transform_type == TransformAnimType::TRANSLATION)
+        if(transform_anim.transform_type == TransformAnimType::TRANSLATION)
         {
-            const math::Vector new_position(
-                transform_anim->ease_function(transform_anim->duration_counter, transform_anim->duration, transform_anim->start_x, transform_anim->delta_x),
-                transform_anim->ease_function(transform_anim->duration_counter, transform_anim->duration, transform_anim->start_y, transform_anim->delta_y)
-            );
-            math::Position(transform, new_position);
+            const math::Vector position = math::GetPosition(transform);
+            transform_anim.tween_id = m_tween_engine.AddTween(
+                transform_anim.target_id,
+                TweenType::TRANSLATION,
+                transform_anim.ease_function,
+                transform_anim.duration,
+                position.x,
+                position.y,
+                transform_anim.delta_x,
+                transform_anim.delta_y,
+                transform_anim_index);
         }
         else
         {
-            const float new_rotation =
-                transform_anim->ease_function(transform_anim->duration_counter, transform_anim->duration, transform_anim->start_x, transform_anim->delta_x);
-            transform = math::CreateMatrixFromZRotation(new_rotation);
-            math::Position(transform, position);
+            transform_anim.tween_id = m_tween_engine.AddTween(
+                transform_anim.target_id,
+                TweenType::ROTATION,
+                transform_anim.ease_function,
+                transform_anim.duration,
+                math::GetZRotation(transform),
+                0.0f,
+                transform_anim.delta_x,
+                0.0f,
+                transform_anim_index);
         }
 
-        m_transform_system->SetTransformState(transform_anim->target_id, mono::TransformState::CLIENT);
-
-        // Check if done
-        bool is_done = (transform_anim->duration - transform_anim->duration_counter) <= 0.0f;
-        
-        const bool ping_pong = (transform_anim->animation_flags & shared::AnimationMode::PING_PONG);
-        const bool reversable = (transform_anim->animation_flags & shared::AnimationMode::TRIGGER_REVERSE);
-        if(is_done && (ping_pong || reversable))
+        if(transform_anim.animation_flags & shared::AnimationMode::ONE_SHOT && transform_anim.callback_id != NO_CALLBACK_SET)
         {
-            transform_anim->is_initialized = false;
-            transform_anim->duration_counter = 0.0f;
-            transform_anim->delta_x = -transform_anim->delta_x;
-            transform_anim->delta_y = -transform_anim->delta_y;
-
-            is_done = ping_pong ? false : true;
+            m_trigger_system->RemoveTriggerCallback(
+                transform_anim.trigger_hash, transform_anim.callback_id, transform_anim.target_id);
+            transform_anim.callback_id = NO_CALLBACK_SET;
         }
+    }
 
-        if(transform_anim->animation_flags & shared::AnimationMode::ONE_SHOT && transform_anim->callback_id != NO_CALLBACK_SET)
+    m_transform_anims_to_start.clear();
+}
+
+void AnimationSystem::ApplyTweens()
+{
+    const auto apply_group = [this](TweenType type, uint32_t count, const uint32_t* target_ids, const float* values_x, const float* values_y) {
+        if(type == TweenType::TRANSLATION)
         {
-            m_trigger_system->RemoveTriggerCallback(
-                transform_anim->trigger_hash, transform_anim->callback_id, transform_anim->target_id);
-            transform_anim->callback_id = NO_CALLBACK_SET;
+            for(uint32_t index = 0; index < count; ++index)
+            {
+                math::Matrix& transform = m_transform_system->GetTransform(target_ids[index]);
+                math::Position(transform, math::Vector(values_x[index], values_y[index]));
+            }
         }
-
-        if(is_done)
+        else
         {
-            transform_anim->is_initialized = false;
-            transform_anim->duration_counter = 0.0f;
+            for(uint32_t index = 0; index < count; ++index)
+            {
+                math::Matrix& transform = m_transform_system->GetTransform(target_ids[index]);
+                const math::Vector position = math::GetPosition(transform);
+                transform = math::CreateMatrixFromZRotation(values_x[index]);
+                math::Position(transform, position);
+            }
         }
 
-        return is_done;
+        for(uint32_t index = 0; index < count; ++index)
+            m_transform_system->SetTransformState(target_ids[index], mono::TransformState::CLIENT);
     };
-    
-    mono::remove_if(m_transform_anims_to_process, process_transform_anims_func);
+
+    m_tween_engine.ForEachGroup(apply_group);
+}
+
+void AnimationSystem::FinishTransformAnimations()
+{
+    for(const FinishedTween& finished : m_tween_engine.RemoveFinished())
+    {
+        TransformAnimationComponent& transform_anim = m_transform_anims[finished.user_data];
+        transform_anim.tween_id = TweenEngine::NO_TWEEN;
+
+        const bool ping_pong = (transform_anim.animation_flags & shared::AnimationMode::PING_PONG);
+        const bool reversable = (transform_anim.animation_flags & shared::AnimationMode::TRIGGER_REVERSE);
+        if(ping_pong || reversable)
+        {
+            transform_anim.delta_x = -transform_anim.delta_x;
+            transform_anim.delta_y = -transform_anim.delta_y;
+        }
+
+        // Ping pong goes back from where it ended, at the next update.
+        if(ping_pong)
+            AddTransformAnimatonToUpdate(finished.user_data);
+    }
 }
@@ -1,12 +1,14 @@
 
 #pragma once
 
-#include "IGameSystem.h"
+#include "Scheduler/ScheduledSystem.h"
+#include "ChunkedArray.h"
 #include "MonoFwd.h"
 #include "Math/Vector.h"
 #include "Math/EasingFunctions.h"
 #include "Util/ObjectPool.h"
 #include "AnimationModes.h"
+#include "TweenEngine.h"
 
 #include <vector>
 
@@ -34,29 +36,27 @@ namespace game
         uint32_t callback_id;
 
         float duration;
-        float duration_counter;
 
         math::EaseFunction ease_function;
         shared::AnimationMode animation_flags;
         TransformAnimType transform_type;
 
-        bool is_initialized;
-
-        float start_x;
-        float start_y;
-
         float delta_x;
         float delta_y;
+
+        // Started at the next update, the start values are read from the transform then.
+        bool start_requested;
+        uint32_t tween_id;
     };
 
     struct AnimationContainer
     {
         int ref_counter = 0;
         std::vector<SpriteAnimationComponent*> sprite_components;
-        std::vector<TransformAnimationComponent*> transform_components;
+        std::vector<uint32_t> transform_components;
     };
 
-    class AnimationSystem : public mono::IGameSystem
+    class AnimationSystem : public ScheduledSystem
     {
     public:
 
@@ -90,21 +90,30 @@ namespace game
 
         uint32_t Id() const override;
         const char* Name() const override;
-        void Update(const mono::UpdateContext& update_context) override;
+        void ScheduledUpdate(const mono::UpdateContext& update_context) override;
+        SystemAccess Access() const override;
 
-        void AddTransformAnimatonToUpdate(TransformAnimationComponent* transform_animation);
+        uint32_t AllocateTransformAnimation();
+        void AddTransformAnimatonToUpdate(uint32_t transform_anim_index);
+        void StartTransformAnimations();
+        void ApplyTweens();
+        void FinishTransformAnimations();
 
         class TriggerSystem* m_trigger_system;
         mono::TransformSystem* m_transform_system;
         mono::SpriteSystem* m_sprite_system;
 
         mono::ObjectPool<SpriteAnimationComponent> m_sprite_anim_pool;
-        mono::ObjectPool<TransformAnimationComponent> m_transform_anim_pool;
 
-        std::vector<AnimationContainer> m_animation_containers;
+        ChunkedArray<TransformAnimationComponent> m_transform_anims;
+        uint32_t m_n_transform_anims;
+        std::vector<uint32_t> m_free_transform_anims;
+        TweenEngine m_tween_engine;
+
+        ChunkedArray<AnimationContainer> m_animation_containers;
         std::vector<bool> m_active_animation_containers;
 
         std::vector<SpriteAnimationComponent*> m_sprite_anims_to_process;
-        std::vector<TransformAnimationComponent*> m_transform_anims_to_process;
+        std::vector<uint32_t> m_transform_anims_to_start;
     };
 }
@@ -1,5 +1,6 @@
 
 #include "EntityLogicFactory.h"
+#include "EntityLogicSystem.h"
 #include "IEntityLogic.h"
 
 #include "Enemies/BatController.h"
@@ -14,16 +15,19 @@
 
 #include "Paths/PathFactory.h"
 #include "Component.h"
+#include "SystemContext.h"
 
 namespace
 {
     using CreateLogicFunc =
-        game::IEntityLogic*(*)(uint32_t entity_id, mono::SystemContext* system_context, mono::EventHandler& event_handler);
+        game::IEntityLogic*(*)(
+            game::EntityLogicSystem* logic_system, uint32_t entity_id, mono::SystemContext* system_context, mono::EventHandler& event_handler);
 
     template <typename T>
-    game::IEntityLogic* MakeController(uint32_t entity_id, mono::SystemContext* system_context, mono::EventHandler& event_handler)
+    game::IEntityLogic* MakeController(
+        game::EntityLogicSystem* logic_system, uint32_t entity_id, mono::SystemContext* system_context, mono::EventHandler& event_handler)
     {
-        return new T(entity_id, system_context, event_handler);
+        return logic_system->CreateLogic<T>(entity_id, entity_id, system_context, event_handler);
     }
 
     constexpr CreateLogicFunc create_functions[] = {
@@ -48,6 +52,8 @@ EntityLogicFactory::EntityLogicFactory(mono::SystemContext* system_context, mono
 
 IEntityLogic* EntityLogicFactory::CreateLogic(shared::EntityLogicType type, const std::vector<Attribute>& properties, uint32_t entity_id)
 {
+    game::EntityLogicSystem* logic_system = m_system_context->GetSystem<game::EntityLogicSystem>();
+
     if(type == shared::EntityLogicType::INVADER_PATH)
     {
         uint32_t entity_reference;
@@ -55,8 +61,9 @@ IEntityLogic* EntityLogicFactory::CreateLogic(shared::EntityLogicType type, cons
         if(!found_path_property)
             return nullptr;
 
-        return new game::InvaderPathController(entity_id, entity_reference, m_system_context, m_event_handler);
+        return logic_system->CreateLogic<game::InvaderPathController>(
+            entity_id, entity_id, entity_reference, m_system_context, m_event_handler);
     }
 
-    return create_functions[static_cast<uint32_t>(type)](entity_id, m_system_context, m_event_handler);
+    return create_functions[static_cast<uint32_t>(type)](logic_system, entity_id, m_system_context, m_event_handler);
 }
@@ -14,6 +14,8 @@ namespace game
     public:
 
         EntityLogicFactory(mono::SystemContext* system_context, mono::EventHandler& event_handler);
+
+        // Creates the logic and adds it to the entity logic system.
         class IEntityLogic* CreateLogic(shared::EntityLogicType type, const std::vector<Attribute>& properties, uint32_t entity_id);
 
     private:
@@ -0,0 +1,160 @@
+
+#pragma once
+
+#include "IEntityLogic.h"
+
+#include <vector>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <limits>
+#include <cstdint>
+
+namespace game
+{
+    inline uint32_t NextLogicTypeIndex()
+    {
+        static uint32_t s_type_index = 0;
+        return s_type_index++;
+    }
+
+    template <typename T>
+    inline uint32_t LogicTypeIndex()
+    {
+        static const uint32_t type_index = NextLogicTypeIndex();
+        return type_index;
+    }
+
+    // The live logics of one type, in a dense list with the entity id of each logic next to it. A logic released
+    // while the bucket is updating leaves a nullptr tombstone behind that is compacted away after the update.
+    class LogicBucket
+    {
+    public:
+
+        virtual ~LogicBucket() = default;
+        virtual void Update(const mono::UpdateContext& update_context) = 0;
+        virtual void Free(IEntityLogic* logic) = 0;
+
+        uint32_t Add(uint32_t entity_id, IEntityLogic* logic)
+        {
+            m_logics.push_back(logic);
+            m_entity_ids.push_back(entity_id);
+            return m_logics.size() - 1;
+        }
+
+        // Swap removes the logic at index, returns the entity id of the logic moved into index.
+        uint32_t RemoveAt(uint32_t index)
+        {
+            m_logics[index] = m_logics.back();
+            m_entity_ids[index] = m_entity_ids.back();
+            m_logics.pop_back();
+            m_entity_ids.pop_back();
+
+            return (index < m_logics.size()) ? m_entity_ids[index] : std::numeric_limits<uint32_t>::max();
+        }
+
+        void Tombstone(uint32_t index)
+        {
+            m_logics[index] = nullptr;
+            m_n_tombstones++;
+        }
+
+        bool HasTombstones() const
+        {
+            return m_n_tombstones > 0;
+        }
+
+        void Compact()
+        {
+            uint32_t write_index = 0;
+            for(uint32_t read_index = 0; read_index < m_logics.size(); ++read_index)
+            {
+                if(m_logics[read_index] == nullptr)
+                    continue;
+
+                m_logics[write_index] = m_logics[read_index];
+                m_entity_ids[write_index] = m_entity_ids[read_index];
+                write_index++;
+            }
+
+            m_logics.resize(write_index);
+            m_entity_ids.resize(write_index);
+            m_n_tombstones = 0;
+        }
+
+        const std::vector<uint32_t>& EntityIds() const
+        {
+            return m_entity_ids;
+        }
+
+        size_t Size() const
+        {
+            return m_logics.size() - m_n_tombstones;
+        }
+
+    protected:
+
+        std::vector<IEntityLogic*> m_logics;
+        std::vector<uint32_t> m_entity_ids;
+        uint32_t m_n_tombstones = 0;
+    };
+
+    // Constructs the logics in fixed size chunks that are kept until the bucket is destroyed, so the addresses
+    // are stable (bullets register themselves as collision handlers) and spawning does not touch the heap once
+    // the pool has grown to the peak number of logics.
+    template <typename T>
+    class PooledLogicBucket : public LogicBucket
+    {
+    public:
+
+        static constexpr size_t chunk_size = 64;
+
+        template <typename ... Args>
+        T* Create(Args&& ... args)
+        {
+            if(m_free_slots.empty())
+                AddChunk();
+
+            Storage* slot = m_free_slots.back();
+            m_free_slots.pop_back();
+
+            return new (slot) T(std::forward<Args>(args)...);
+        }
+
+        void Free(IEntityLogic* logic) override
+        {
+            T* typed_logic = static_cast<T*>(logic);
+            typed_logic->~T();
+            m_free_slots.push_back(reinterpret_cast<Storage*>(typed_logic));
+        }
+
+        void Update(const mono::UpdateContext& update_context) override
+        {
+            // Logics created during the update are updated next time.
+            const size_t n_logics = m_logics.size();
+            for(size_t index = 0; index < n_logics; ++index)
+            {
+                IEntityLogic* logic = m_logics[index];
+                if(logic)
+                    static_cast<T*>(logic)->T::Update(update_context);
+            }
+        }
+
+    private:
+
+        using Storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+        void AddChunk()
+        {
+            m_chunks.push_back(std::make_unique<Storage[]>(chunk_size));
+            Storage* chunk = m_chunks.back().get();
+
+            for(size_t index = chunk_size; index > 0; --index)
+                m_free_slots.push_back(&chunk[index - 1]);
+        }
+
+        std::vector<std::unique_ptr<Storage[]>> m_chunks;
+        std::vector<Storage*> m_free_slots;
+    };
+}
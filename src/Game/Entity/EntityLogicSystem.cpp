@@ -1,6 +1,8 @@
 
 #include "EntityLogicSystem.h"
+#include "Component.h"
 #include "IEntityLogic.h"
+#include "SimulationClock.h"
 #include "System/Hash.h"
 
 #include <algorithm>
@@ -8,34 +10,82 @@
 
 using namespace game;
 
-EntityLogicSystem::EntityLogicSystem(size_t n_entities)
-    : m_logics(n_entities, nullptr)
+EntityLogicSystem::EntityLogicSystem(size_t n_entities, const SimulationClock* simulation_clock)
+    : m_simulation_clock(simulation_clock)
+    , m_logics(n_entities, { nullptr, nullptr, 0 })
+    , m_updating(false)
 { }
 
 EntityLogicSystem::~EntityLogicSystem()
 {
-    const auto all_is_nullptr = [](IEntityLogic* logic) {
-        return logic == nullptr;
+    const auto all_is_nullptr = [](const LogicEntry& entry) {
+        return entry.logic == nullptr;
     };
 
     (void)all_is_nullptr;
     assert(std::all_of(m_logics.begin(), m_logics.end(), all_is_nullptr));
 }
 
-void EntityLogicSystem::AddLogic(uint32_t entity_id, IEntityLogic* entity_logic)
+void EntityLogicSystem::AddLogic(uint32_t entity_id, IEntityLogic* entity_logic, LogicBucket* bucket)
 {
-    assert(m_logics[entity_id] == nullptr);
-    m_logics[entity_id] = entity_logic;
+    // Only indices into the buckets are kept per entity, so the entries can move when it grows.
+    if(entity_id >= m_logics.size())
+        m_logics.resize(std::max(size_t(entity_id) + 1, m_logics.size() * 2), { nullptr, nullptr, 0 });
+
+    LogicEntry& entry = m_logics[entity_id];
+    assert(entry.logic == nullptr);
+
+    entry.logic = entity_logic;
+    entry.bucket = bucket;
+    entry.index = bucket->Add(entity_id, entity_logic);
 }
 
 void EntityLogicSystem::ReleaseLogic(uint32_t entity_id)
 {
-    assert(m_logics[entity_id] != nullptr);
+    LogicEntry& entry = m_logics[entity_id];
+    assert(entry.logic != nullptr);
+
+    if(m_updating)
+    {
+        // The bucket might be iterating, leave a tombstone and free it after the update.
+        entry.bucket->Tombstone(entry.index);
+        m_released_logics.push_back({ entry.logic, entry.bucket });
+    }
+    else
+    {
+        const uint32_t moved_entity_id = entry.bucket->RemoveAt(entry.index);
+        if(moved_entity_id != std::numeric_limits<uint32_t>::max())
+            m_logics[moved_entity_id].index = entry.index;
+
+        entry.bucket->Free(entry.logic);
+    }
 
-    IEntityLogic* logic = m_logics[entity_id];
-    delete logic;
+    entry = { nullptr, nullptr, 0 };
+}
 
-    m_logics[entity_id] = nullptr;
+bool EntityLogicSystem::HasLogic(uint32_t entity_id) const
+{
+    return entity_id < m_logics.size() && m_logics[entity_id].logic != nullptr;
+}
+
+void EntityLogicSystem::FreeReleasedLogics()
+{
+    for(const std::unique_ptr<LogicBucket>& bucket : m_buckets)
+    {
+        if(!bucket || !bucket->HasTombstones())
+            continue;
+
+        bucket->Compact();
+
+        const std::vector<uint32_t>& entity_ids = bucket->EntityIds();
+        for(uint32_t index = 0; index < entity_ids.size(); ++index)
+            m_logics[entity_ids[index]].index = index;
+    }
+
+    for(const ReleasedLogic& released_logic : m_released_logics)
+        released_logic.bucket->Free(released_logic.logic);
+
+    m_released_logics.clear();
 }
 
 uint32_t EntityLogicSystem::Id() const
@@ -48,11 +98,28 @@ const char* EntityLogicSystem::Name() const
     return "entitylogicsystem";
 }
 
-void EntityLogicSystem::Update(const mono::UpdateContext& update_context)
+SystemAccess EntityLogicSystem::Access() const
 {
-    for(IEntityLogic* logic : m_logics)
-    {
-        if(logic)
-            logic->Update(update_context);
-    }
+    // Entity logic reads and writes whatever the entity it runs is made of.
+    SystemAccess access;
+    access.exclusive = true;
+    return access;
+}
+
+void EntityLogicSystem::ScheduledUpdate(const mono::UpdateContext& update_context)
+{
+    const auto tick_func = [this](const mono::UpdateContext& tick_context) {
+
+        // One bucket per logic type, a bucket for a new type can be added while updating.
+        m_updating = true;
+        for(size_t index = 0; index < m_buckets.size(); ++index)
+        {
+            if(m_buckets[index])
+                m_buckets[index]->Update(tick_context);
+        }
+        m_updating = false;
+
+        FreeReleasedLogics();
+    };
+    ForEachSimulationTick(m_simulation_clock, tick_func);
 }
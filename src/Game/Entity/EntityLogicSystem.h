@@ -1,27 +1,78 @@
 
 #pragma once
 
-#include "IGameSystem.h"
+#include "Scheduler/ScheduledSystem.h"
+#include "EntityLogicPool.h"
 #include <vector>
+#include <memory>
 
 namespace game
 {
     class IEntityLogic;
 
-    class EntityLogicSystem : public mono::IGameSystem
+    class EntityLogicSystem : public ScheduledSystem
     {
     public:
 
-        EntityLogicSystem(size_t n_entities);
+        EntityLogicSystem(size_t n_entities, const class SimulationClock* simulation_clock);
         ~EntityLogicSystem();
 
-        void AddLogic(uint32_t entity_id, IEntityLogic* entity_logic);
+        // Constructs the logic in the pool for its type, logics of the same type are updated together.
+        template <typename T, typename ... Args>
+        T* CreateLogic(uint32_t entity_id, Args&& ... args)
+        {
+            PooledLogicBucket<T>* bucket = GetBucket<T>();
+            T* logic = bucket->Create(std::forward<Args>(args)...);
+            AddLogic(entity_id, logic, bucket);
+            return logic;
+        }
+
         void ReleaseLogic(uint32_t entity_id);
+        bool HasLogic(uint32_t entity_id) const;
 
         uint32_t Id() const override;
         const char* Name() const override;
-        void Update(const mono::UpdateContext& update_context) override;
+        void ScheduledUpdate(const mono::UpdateContext& update_context) override;
+        SystemAccess Access() const override;
+
+    private:
+
+        template <typename T>
+        PooledLogicBucket<T>* GetBucket()
+        {
+            const uint32_t type_index = LogicTypeIndex<T>();
+            if(type_index >= m_buckets.size())
+                m_buckets.resize(type_index + 1);
+
+            std::unique_ptr<LogicBucket>& bucket = m_buckets[type_index];
+            if(!bucket)
+                bucket = std::make_unique<PooledLogicBucket<T>>();
+
+            return static_cast<PooledLogicBucket<T>*>(bucket.get());
+        }
+
+        void AddLogic(uint32_t entity_id, IEntityLogic* entity_logic, LogicBucket* bucket);
+        void FreeReleasedLogics();
+
+        const class SimulationClock* m_simulation_clock;
+
+        struct LogicEntry
+        {
+            IEntityLogic* logic;
+            LogicBucket* bucket;
+            uint32_t index;
+        };
+
+        struct ReleasedLogic
+        {
+            IEntityLogic* logic;
+            LogicBucket* bucket;
+        };
+
+        std::vector<LogicEntry> m_logics;
+        std::vector<std::unique_ptr<LogicBucket>> m_buckets;
 
-        std::vector<IEntityLogic*> m_logics;
+        bool m_updating;
+        std::vector<ReleasedLogic> m_released_logics;
     };
 }
@@ -0,0 +1,382 @@
+
+#include "EntityPoolSystem.h"
+#include "EntityLogicSystem.h"
+#include "DamageSystem.h"
+#include "Pickups/PickupSystem.h"
+#include "Component.h"
+
+#include "Entity/LoadEntity.h"
+#include "EntitySystem/IEntityManager.h"
+#include "Physics/IBody.h"
+#include "Physics/IShape.h"
+#include "Physics/PhysicsSpace.h"
+#include "Physics/PhysicsSystem.h"
+#include "Rendering/Lights/LightSystem.h"
+#include "Rendering/Sprite/SpriteSystem.h"
+#include "SystemContext.h"
+
+#include "Math/Vector.h"
+#include "System/File.h"
+#include "System/Hash.h"
+#include "System/System.h"
+
+#include "nlohmann/json.hpp"
+
+using namespace game;
+
+namespace
+{
+    // Components that are reset when the entity is taken out of a pool, an entity file with any other component
+    // is not pooled.
+    bool IsPoolableComponent(uint32_t component_hash)
+    {
+        const uint32_t poolable_components[] = {
+            NAME_FOLDER_COMPONENT,
+            TRANSFORM_COMPONENT,
+            SPRITE_COMPONENT,
+            LIGHT_COMPONENT,
+            PHYSICS_COMPONENT,
+            CIRCLE_SHAPE_COMPONENT,
+            BOX_SHAPE_COMPONENT,
+            SEGMENT_SHAPE_COMPONENT,
+            POLYGON_SHAPE_COMPONENT,
+            HEALTH_COMPONENT,
+            BEHAVIOUR_COMPONENT,
+            PICKUP_COMPONENT,
+        };
+
+        for(uint32_t poolable_component : poolable_components)
+        {
+            if(poolable_component == component_hash)
+                return true;
+        }
+
+        return false;
+    }
+}
+
+EntityPoolSystem::EntityPoolSystem(mono::IEntityManager* entity_manager, mono::SystemContext* system_context)
+    : m_entity_manager(entity_manager)
+    , m_system_context(system_context)
+    , m_physics_system(nullptr)
+    , m_sprite_system(nullptr)
+    , m_light_system(nullptr)
+    , m_damage_system(nullptr)
+    , m_pickup_system(nullptr)
+    , m_logic_system(nullptr)
+{
+    file::FilePtr config_file = file::OpenAsciiFile("res/entity_pools.json");
+    if(config_file)
+    {
+        const std::vector<byte> file_data = file::FileRead(config_file);
+        const nlohmann::json& json = nlohmann::json::parse(file_data);
+
+        for(const auto& pool_props : json["entity_pools"])
+        {
+            WarmUpDefinition warm_up;
+            warm_up.entity_file = pool_props["entity"];
+            warm_up.count = pool_props["warm_up"];
+            m_warm_up_definitions.push_back(warm_up);
+        }
+    }
+}
+
+uint32_t EntityPoolSystem::SpawnEntity(const char* entity_file)
+{
+    EntityPool& pool = FindOrCreatePool(entity_file);
+    if(!pool.poolable)
+        return m_entity_manager->CreateEntity(entity_file).id;
+
+    const uint32_t pool_hash = hash::Hash(entity_file);
+
+    if(pool.idle_entities.empty())
+        return CreatePooledEntity(pool_hash, entity_file);
+
+    const uint32_t entity_id = pool.idle_entities.back();
+    pool.idle_entities.pop_back();
+
+    Activate(entity_id, pool);
+    m_pooled_entities[entity_id].state = PooledState::ACTIVE;
+
+    mono::IEntityManager::SpawnEvent spawn_event = {};
+    spawn_event.entity_id = entity_id;
+    spawn_event.spawned = true;
+    m_spawn_events.push_back(spawn_event);
+
+    return entity_id;
+}
+
+void EntityPoolSystem::ReleaseEntity(uint32_t entity_id)
+{
+    const auto it = m_pooled_entities.find(entity_id);
+    if(it == m_pooled_entities.end())
+    {
+        m_entity_manager->ReleaseEntity(entity_id);
+        return;
+    }
+
+    // Released several times before Sync, like when released every frame while the health is zero.
+    if(it->second.state != PooledState::ACTIVE)
+        return;
+
+    it->second.state = PooledState::RELEASED;
+    m_released_entities.push_back(entity_id);
+}
+
+void EntityPoolSystem::WarmUp()
+{
+    for(const WarmUpDefinition& warm_up : m_warm_up_definitions)
+        WarmUp(warm_up.entity_file.c_str(), warm_up.count);
+}
+
+void EntityPoolSystem::WarmUp(const char* entity_file, uint32_t count)
+{
+    EntityPool& pool = FindOrCreatePool(entity_file);
+    if(!pool.poolable)
+    {
+        System::Log("EntityPoolSystem|Entity file '%s' has components that can not be pooled.", entity_file);
+        return;
+    }
+
+    const uint32_t pool_hash = hash::Hash(entity_file);
+
+    while(pool.idle_entities.size() < count)
+    {
+        const uint32_t entity_id = CreatePooledEntity(pool_hash, entity_file);
+        Deactivate(entity_id, pool);
+        m_pooled_entities[entity_id].state = PooledState::IDLE;
+        pool.idle_entities.push_back(entity_id);
+    }
+}
+
+void EntityPoolSystem::ReleaseIdleEntities()
+{
+    for(auto& pair : m_pools)
+    {
+        EntityPool& pool = pair.second;
+
+        // The body and shapes go back into the space, since the physics system removes them when released.
+        for(uint32_t entity_id : pool.idle_entities)
+        {
+            Activate(entity_id, pool);
+            m_pooled_entities[entity_id].state = PooledState::ACTIVE;
+            m_entity_manager->ReleaseEntity(entity_id);
+        }
+
+        pool.idle_entities.clear();
+    }
+
+    m_released_entities.clear();
+}
+
+bool EntityPoolSystem::IsPooled(uint32_t entity_id) const
+{
+    const auto it = m_pooled_entities.find(entity_id);
+    return (it != m_pooled_entities.end() && it->second.state == PooledState::IDLE);
+}
+
+const std::vector<mono::IEntityManager::SpawnEvent>& EntityPoolSystem::GetSpawnEvents() const
+{
+    return m_spawn_events;
+}
+
+uint32_t EntityPoolSystem::Id() const
+{
+    return hash::Hash(Name());
+}
+
+const char* EntityPoolSystem::Name() const
+{
+    return "entitypoolsystem";
+}
+
+void EntityPoolSystem::Update(const mono::UpdateContext& update_context)
+{ }
+
+void EntityPoolSystem::Sync()
+{
+    m_spawn_events.clear();
+
+    for(uint32_t entity_id : m_released_entities)
+    {
+        const auto it = m_pooled_entities.find(entity_id);
+        if(it == m_pooled_entities.end() || it->second.state != PooledState::RELEASED)
+            continue;
+
+        EntityPool& pool = m_pools[it->second.pool_hash];
+        Deactivate(entity_id, pool);
+        it->second.state = PooledState::IDLE;
+        pool.idle_entities.push_back(entity_id);
+
+        mono::IEntityManager::SpawnEvent spawn_event = {};
+        spawn_event.entity_id = entity_id;
+        spawn_event.spawned = false;
+        m_spawn_events.push_back(spawn_event);
+    }
+
+    m_released_entities.clear();
+}
+
+EntityPoolSystem::EntityPool& EntityPoolSystem::FindOrCreatePool(const char* entity_file)
+{
+    const uint32_t pool_hash = hash::Hash(entity_file);
+
+    const auto it = m_pools.find(pool_hash);
+    if(it != m_pools.end())
+        return it->second;
+
+    const mono::EntityData entity_data = shared::LoadEntityFile(entity_file);
+
+    EntityPool& pool = m_pools[pool_hash];
+    pool.poolable = true;
+    pool.has_transform = false;
+    pool.has_physics = false;
+    pool.has_sprite = false;
+    pool.has_light = false;
+    pool.has_health = false;
+    pool.has_pickup = false;
+    pool.has_logic = false;
+    pool.entity_properties = entity_data.entity_properties;
+
+    for(const mono::ComponentData& component : entity_data.entity_components)
+    {
+        const uint32_t component_hash = hash::Hash(component.name.c_str());
+        pool.poolable &= IsPoolableComponent(component_hash);
+
+        if(component_hash == TRANSFORM_COMPONENT)
+        {
+            pool.has_transform = true;
+            pool.transform_properties = component.properties;
+        }
+        else if(component_hash == PHYSICS_COMPONENT)
+        {
+            pool.has_physics = true;
+        }
+        else if(component_hash == SPRITE_COMPONENT)
+        {
+            pool.has_sprite = true;
+            pool.sprite_properties = component.properties;
+        }
+        else if(component_hash == LIGHT_COMPONENT)
+        {
+            pool.has_light = true;
+            pool.light_properties = component.properties;
+        }
+        else if(component_hash == HEALTH_COMPONENT)
+        {
+            pool.has_health = true;
+        }
+        else if(component_hash == PICKUP_COMPONENT)
+        {
+            pool.has_pickup = true;
+        }
+        else if(component_hash == BEHAVIOUR_COMPONENT)
+        {
+            pool.has_logic = true;
+            pool.logic_properties = component.properties;
+        }
+    }
+
+    return pool;
+}
+
+uint32_t EntityPoolSystem::CreatePooledEntity(uint32_t pool_hash, const char* entity_file)
+{
+    const mono::Entity new_entity = m_entity_manager->CreateEntity(entity_file);
+    m_pooled_entities[new_entity.id] = { pool_hash, PooledState::ACTIVE };
+
+    // If the entity manager releases the entity, like when the zone is unloaded, it's not pooled anymore.
+    const auto release_callback = [this](uint32_t entity_id) {
+        m_pooled_entities.erase(entity_id);
+    };
+    m_entity_manager->AddReleaseCallback(new_entity.id, release_callback);
+
+    return new_entity.id;
+}
+
+void EntityPoolSystem::Activate(uint32_t entity_id, const EntityPool& pool)
+{
+    ResolveSystems();
+
+    m_entity_manager->SetEntityProperties(entity_id, pool.entity_properties);
+
+    // The last user might have moved or rotated the entity, tinted or flipped the sprite or changed the animation,
+    // so they are set back to what the entity file says.
+    if(pool.has_transform)
+        m_entity_manager->SetComponentData(entity_id, TRANSFORM_COMPONENT, pool.transform_properties);
+
+    if(pool.has_physics)
+    {
+        mono::PhysicsSpace* space = m_physics_system->GetSpace();
+        mono::IBody* body = m_physics_system->GetBody(entity_id);
+        body->SetVelocity(math::ZeroVec);
+        body->ResetForces();
+        space->Add(body);
+
+        for(mono::IShape* shape : m_physics_system->GetShapesAttachedToBody(entity_id))
+            space->Add(shape);
+    }
+
+    if(pool.has_sprite)
+    {
+        m_entity_manager->SetComponentData(entity_id, SPRITE_COMPONENT, pool.sprite_properties);
+        m_sprite_system->SetSpriteEnabled(entity_id, true);
+    }
+
+    if(pool.has_light)
+        m_entity_manager->SetComponentData(entity_id, LIGHT_COMPONENT, pool.light_properties);
+
+    if(pool.has_logic)
+        m_entity_manager->SetComponentData(entity_id, BEHAVIOUR_COMPONENT, pool.logic_properties);
+
+    if(pool.has_pickup)
+        m_pickup_system->SetPickupEnabled(entity_id, true);
+}
+
+void EntityPoolSystem::Deactivate(uint32_t entity_id, const EntityPool& pool)
+{
+    ResolveSystems();
+
+    if(pool.has_physics)
+    {
+        mono::PhysicsSpace* space = m_physics_system->GetSpace();
+        for(mono::IShape* shape : m_physics_system->GetShapesAttachedToBody(entity_id))
+            space->Remove(shape);
+
+        space->Remove(m_physics_system->GetBody(entity_id));
+    }
+
+    if(pool.has_sprite)
+        m_sprite_system->SetSpriteEnabled(entity_id, false);
+
+    if(pool.has_light)
+    {
+        mono::LightComponent no_light = {};
+        no_light.radius = 0.0f;
+        m_light_system->SetData(entity_id, no_light);
+    }
+
+    // Logics register damage callbacks when created, so the logic is released before the record is reset.
+    if(pool.has_logic && m_logic_system->HasLogic(entity_id))
+        m_logic_system->ReleaseLogic(entity_id);
+
+    if(pool.has_health)
+        m_damage_system->ResetRecord(entity_id);
+
+    if(pool.has_pickup)
+        m_pickup_system->SetPickupEnabled(entity_id, false);
+}
+
+void EntityPoolSystem::ResolveSystems()
+{
+    // The game systems are created after this one, so they are looked up on first use.
+    if(m_physics_system)
+        return;
+
+    m_physics_system = m_system_context->GetSystem<mono::PhysicsSystem>();
+    m_sprite_system = m_system_context->GetSystem<mono::SpriteSystem>();
+    m_light_system = m_system_context->GetSystem<mono::LightSystem>();
+    m_damage_system = m_system_context->GetSystem<DamageSystem>();
+    m_pickup_system = m_system_context->GetSystem<PickupSystem>();
+    m_logic_system = m_system_context->GetSystem<EntityLogicSystem>();
+}
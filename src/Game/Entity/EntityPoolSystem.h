@@ -0,0 +1,114 @@
+
+#pragma once
+
+#include "IGameSystem.h"
+#include "MonoFwd.h"
+#include "EntitySystem/IEntityManager.h"
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+namespace game
+{
+    class DamageSystem;
+    class PickupSystem;
+    class EntityLogicSystem;
+
+    // Recycles entities created from entity files. A released entity is deactivated instead of destroyed, the body
+    // is taken out of the physics space, the sprite is hidden and the logic is released, and the entity is handed
+    // out again on the next spawn from the same file. Only files with components that can be reset are pooled, the
+    // rest are created and released through the entity manager as usual.
+    class EntityPoolSystem : public mono::IGameSystem
+    {
+    public:
+
+        EntityPoolSystem(mono::IEntityManager* entity_manager, mono::SystemContext* system_context);
+
+        // Returns the id of the spawned entity, set it up like an entity from the entity manager.
+        uint32_t SpawnEntity(const char* entity_file);
+
+        // The entity is deactivated in Sync, entities that are not from a pool are released by the entity manager.
+        void ReleaseEntity(uint32_t entity_id);
+
+        // Creates the warm up entities from res/entity_pools.json, call when a zone is loaded.
+        void WarmUp();
+        void WarmUp(const char* entity_file, uint32_t count);
+
+        // Releases the idle entities, call before the entity manager releases all entities.
+        void ReleaseIdleEntities();
+
+        // True if the entity is deactivated and waiting in a pool.
+        bool IsPooled(uint32_t entity_id) const;
+
+        // Entities taken out of or put back into a pool this frame, they never spawn or despawn in the entity manager.
+        const std::vector<mono::IEntityManager::SpawnEvent>& GetSpawnEvents() const;
+
+        uint32_t Id() const override;
+        const char* Name() const override;
+        void Update(const mono::UpdateContext& update_context) override;
+        void Sync() override;
+
+    private:
+
+        struct EntityPool
+        {
+            bool poolable;
+            bool has_transform;
+            bool has_physics;
+            bool has_sprite;
+            bool has_light;
+            bool has_health;
+            bool has_pickup;
+            bool has_logic;
+            uint32_t entity_properties;
+            std::vector<Attribute> transform_properties;
+            std::vector<Attribute> sprite_properties;
+            std::vector<Attribute> light_properties;
+            std::vector<Attribute> logic_properties;
+            std::vector<uint32_t> idle_entities;
+        };
+
+        enum class PooledState
+        {
+            ACTIVE,
+            RELEASED,
+            IDLE,
+        };
+
+        struct PooledEntity
+        {
+            uint32_t pool_hash;
+            PooledState state;
+        };
+
+        EntityPool& FindOrCreatePool(const char* entity_file);
+        uint32_t CreatePooledEntity(uint32_t pool_hash, const char* entity_file);
+        void Activate(uint32_t entity_id, const EntityPool& pool);
+        void Deactivate(uint32_t entity_id, const EntityPool& pool);
+        void ResolveSystems();
+
+        mono::IEntityManager* m_entity_manager;
+        mono::SystemContext* m_system_context;
+
+        mono::PhysicsSystem* m_physics_system;
+        mono::SpriteSystem* m_sprite_system;
+        mono::LightSystem* m_light_system;
+        DamageSystem* m_damage_system;
+        PickupSystem* m_pickup_system;
+        EntityLogicSystem* m_logic_system;
+
+        struct WarmUpDefinition
+        {
+            std::string entity_file;
+            uint32_t count;
+        };
+        std::vector<WarmUpDefinition> m_warm_up_definitions;
+
+        std::unordered_map<uint32_t, EntityPool> m_pools;
+        std::unordered_map<uint32_t, PooledEntity> m_pooled_entities;
+        std::vector<uint32_t> m_released_entities;
+        std::vector<mono::IEntityManager::SpawnEvent> m_spawn_events;
+    };
+}
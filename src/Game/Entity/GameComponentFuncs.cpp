@@ -20,12 +20,15 @@
 #include "Pickups/PickupSystem.h"
 
 #include "Component.h"
+#include "Entity/ComponentSchema.h"
 #include "CollisionConfiguration.h"
 
 #include "System/Hash.h"
 #include "System/System.h"
 #include "Math/EasingFunctions.h"
 
+using namespace shared;
+
 namespace
 {
     bool CreatePhysics(mono::Entity* entity, mono::SystemContext* context)
@@ -47,18 +50,30 @@ namespace
         return true;
     }
 
-    bool UpdatePhysics(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct PhysicsData
     {
-        mono::BodyComponent body_args;
+        mono::BodyType body_type;
+        float mass;
+        bool prevent_rotation;
+    };
 
-        FindAttribute(BODY_TYPE_ATTRIBUTE, properties, (int&)body_args.type, FallbackMode::SET_DEFAULT);
-        FindAttribute(MASS_ATTRIBUTE, properties, body_args.mass, FallbackMode::SET_DEFAULT);
-        //FindAttribute(INERTIA_ATTRIBUTE, properties, body_args.inertia, FallbackMode::SET_DEFAULT);
+    const ComponentSchema<PhysicsData>& PhysicsSchema()
+    {
+        static const ComponentSchema<PhysicsData> schema(PHYSICS_COMPONENT, {
+            Field<&PhysicsData::body_type>(BODY_TYPE_ATTRIBUTE),
+            Field<&PhysicsData::mass>(MASS_ATTRIBUTE),
+            Field<&PhysicsData::prevent_rotation>(PREVENT_ROTATION_ATTRIBUTE),
+        });
+        return schema;
+    }
 
-        bool prevent_rotation = false;
-        FindAttribute(PREVENT_ROTATION_ATTRIBUTE, properties, prevent_rotation, FallbackMode::SET_DEFAULT);
+    bool UpdatePhysics(mono::Entity* entity, const PhysicsData& data, mono::SystemContext* context)
+    {
+        mono::BodyComponent body_args;
+        body_args.type = data.body_type;
+        body_args.mass = data.mass;
 
-        if(prevent_rotation)
+        if(data.prevent_rotation)
             body_args.inertia = math::INF;
 
         mono::PhysicsSystem* physics_system = context->GetSystem<mono::PhysicsSystem>();
@@ -83,17 +98,33 @@ namespace
         return true;
     }
 
-    bool UpdateCircleShape(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct CircleShapeData
     {
-        int faction = 0;
-        mono::CircleComponent shape_params;
+        int faction;
+        float radius;
+        math::Vector offset;
+        bool is_sensor;
+    };
+
+    const ComponentSchema<CircleShapeData>& CircleShapeSchema()
+    {
+        static const ComponentSchema<CircleShapeData> schema(CIRCLE_SHAPE_COMPONENT, {
+            Field<&CircleShapeData::faction>(FACTION_ATTRIBUTE),
+            Field<&CircleShapeData::radius>(RADIUS_ATTRIBUTE),
+            Field<&CircleShapeData::offset>(POSITION_ATTRIBUTE),
+            Field<&CircleShapeData::is_sensor>(SENSOR_ATTRIBUTE),
+        });
+        return schema;
+    }
 
-        FindAttribute(FACTION_ATTRIBUTE, properties, faction, FallbackMode::SET_DEFAULT);
-        FindAttribute(RADIUS_ATTRIBUTE, properties, shape_params.radius, FallbackMode::SET_DEFAULT);
-        FindAttribute(POSITION_ATTRIBUTE, properties, shape_params.offset, FallbackMode::SET_DEFAULT);
-        FindAttribute(SENSOR_ATTRIBUTE, properties, shape_params.is_sensor, FallbackMode::SET_DEFAULT);
+    bool UpdateCircleShape(mono::Entity* entity, const CircleShapeData& data, mono::SystemContext* context)
+    {
+        const shared::FactionPair& faction_pair = shared::faction_lookup_table[data.faction];
 
-        const shared::FactionPair& faction_pair = shared::faction_lookup_table[faction];
+        mono::CircleComponent shape_params;
+        shape_params.radius = data.radius;
+        shape_params.offset = data.offset;
+        shape_params.is_sensor = data.is_sensor;
         shape_params.category = faction_pair.category;
         shape_params.mask = faction_pair.mask;
 
@@ -102,17 +133,33 @@ namespace
         return true;
     }
 
-    bool UpdateBoxShape(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct BoxShapeData
     {
         int faction;
-        mono::BoxComponent shape_params;
+        math::Vector size;
+        math::Vector offset;
+        bool is_sensor;
+    };
 
-        FindAttribute(FACTION_ATTRIBUTE, properties, faction, FallbackMode::SET_DEFAULT);
-        FindAttribute(SIZE_ATTRIBUTE, properties, shape_params.size, FallbackMode::SET_DEFAULT);
-        FindAttribute(POSITION_ATTRIBUTE, properties, shape_params.offset, FallbackMode::SET_DEFAULT);
-        FindAttribute(SENSOR_ATTRIBUTE, properties, shape_params.is_sensor, FallbackMode::SET_DEFAULT);
+    const ComponentSchema<BoxShapeData>& BoxShapeSchema()
+    {
+        static const ComponentSchema<BoxShapeData> schema(BOX_SHAPE_COMPONENT, {
+            Field<&BoxShapeData::faction>(FACTION_ATTRIBUTE),
+            Field<&BoxShapeData::size>(SIZE_ATTRIBUTE),
+            Field<&BoxShapeData::offset>(POSITION_ATTRIBUTE),
+            Field<&BoxShapeData::is_sensor>(SENSOR_ATTRIBUTE),
+        });
+        return schema;
+    }
 
-        const shared::FactionPair& faction_pair = shared::faction_lookup_table[faction];
+    bool UpdateBoxShape(mono::Entity* entity, const BoxShapeData& data, mono::SystemContext* context)
+    {
+        const shared::FactionPair& faction_pair = shared::faction_lookup_table[data.faction];
+
+        mono::BoxComponent shape_params;
+        shape_params.size = data.size;
+        shape_params.offset = data.offset;
+        shape_params.is_sensor = data.is_sensor;
         shape_params.category = faction_pair.category;
         shape_params.mask = faction_pair.mask;
 
@@ -121,18 +168,36 @@ namespace
         return true;
     }
 
-    bool UpdateSegmentShape(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct SegmentShapeData
     {
         int faction;
-        mono::SegmentComponent shape_params;
+        math::Vector start;
+        math::Vector end;
+        float radius;
+        bool is_sensor;
+    };
 
-        FindAttribute(FACTION_ATTRIBUTE, properties, faction, FallbackMode::SET_DEFAULT);
-        FindAttribute(RADIUS_ATTRIBUTE, properties, shape_params.radius, FallbackMode::SET_DEFAULT);
-        FindAttribute(START_ATTRIBUTE, properties, shape_params.start, FallbackMode::SET_DEFAULT);
-        FindAttribute(END_ATTRIBUTE, properties, shape_params.end, FallbackMode::SET_DEFAULT);
-        FindAttribute(SENSOR_ATTRIBUTE, properties, shape_params.is_sensor, FallbackMode::SET_DEFAULT);
+    const ComponentSchema<SegmentShapeData>& SegmentShapeSchema()
+    {
+        static const ComponentSchema<SegmentShapeData> schema(SEGMENT_SHAPE_COMPONENT, {
+            Field<&SegmentShapeData::faction>(FACTION_ATTRIBUTE),
+            Field<&SegmentShapeData::start>(START_ATTRIBUTE),
+            Field<&SegmentShapeData::end>(END_ATTRIBUTE),
+            Field<&SegmentShapeData::radius>(RADIUS_ATTRIBUTE),
+            Field<&SegmentShapeData::is_sensor>(SENSOR_ATTRIBUTE),
+        });
+        return schema;
+    }
+
+    bool UpdateSegmentShape(mono::Entity* entity, const SegmentShapeData& data, mono::SystemContext* context)
+    {
+        const shared::FactionPair& faction_pair = shared::faction_lookup_table[data.faction];
 
-        const shared::FactionPair& faction_pair = shared::faction_lookup_table[faction];
+        mono::SegmentComponent shape_params;
+        shape_params.radius = data.radius;
+        shape_params.start = data.start;
+        shape_params.end = data.end;
+        shape_params.is_sensor = data.is_sensor;
         shape_params.category = faction_pair.category;
         shape_params.mask = faction_pair.mask;
 
@@ -141,16 +206,30 @@ namespace
         return true;
     }
 
-    bool UpdatePolygonShape(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct PolygonShapeData
     {
         int faction;
-        mono::PolyComponent shape_params;
+        std::vector<math::Vector> vertices;
+        bool is_sensor;
+    };
+
+    const ComponentSchema<PolygonShapeData>& PolygonShapeSchema()
+    {
+        static const ComponentSchema<PolygonShapeData> schema(POLYGON_SHAPE_COMPONENT, {
+            Field<&PolygonShapeData::faction>(FACTION_ATTRIBUTE),
+            Field<&PolygonShapeData::vertices>(POLYGON_ATTRIBUTE),
+            Field<&PolygonShapeData::is_sensor>(SENSOR_ATTRIBUTE),
+        });
+        return schema;
+    }
 
-        FindAttribute(FACTION_ATTRIBUTE, properties, faction, FallbackMode::SET_DEFAULT);
-        FindAttribute(POLYGON_ATTRIBUTE, properties, shape_params.vertices, FallbackMode::SET_DEFAULT);
-        FindAttribute(SENSOR_ATTRIBUTE, properties, shape_params.is_sensor, FallbackMode::SET_DEFAULT);
+    bool UpdatePolygonShape(mono::Entity* entity, const PolygonShapeData& data, mono::SystemContext* context)
+    {
+        const shared::FactionPair& faction_pair = shared::faction_lookup_table[data.faction];
 
-        const shared::FactionPair& faction_pair = shared::faction_lookup_table[faction];
+        mono::PolyComponent shape_params;
+        shape_params.vertices = data.vertices;
+        shape_params.is_sensor = data.is_sensor;
         shape_params.category = faction_pair.category;
         shape_params.mask = faction_pair.mask;
 
@@ -173,23 +252,31 @@ namespace
         return true;
     }
 
-    bool UpdateHealth(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct HealthData
     {
         int health;
-        FindAttribute(HEALTH_ATTRIBUTE, properties, health, FallbackMode::SET_DEFAULT);
-
         int score;
-        FindAttribute(SCORE_ATTRIBUTE, properties, score, FallbackMode::SET_DEFAULT);
+        bool is_boss;
+    };
 
-        bool is_boss_health;
-        FindAttribute(BOSS_HEALTH_ATTRIBUTE, properties, is_boss_health, FallbackMode::SET_DEFAULT);
+    const ComponentSchema<HealthData>& HealthSchema()
+    {
+        static const ComponentSchema<HealthData> schema(HEALTH_COMPONENT, {
+            Field<&HealthData::health>(HEALTH_ATTRIBUTE),
+            Field<&HealthData::score>(SCORE_ATTRIBUTE),
+            Field<&HealthData::is_boss>(BOSS_HEALTH_ATTRIBUTE),
+        });
+        return schema;
+    }
 
+    bool UpdateHealth(mono::Entity* entity, const HealthData& data, mono::SystemContext* context)
+    {
         game::DamageSystem* damage_system = context->GetSystem<game::DamageSystem>();
         game::DamageRecord* damage_record = damage_system->GetDamageRecord(entity->id);
-        damage_record->health = health;
-        damage_record->full_health = health;
-        damage_record->score = score;
-        damage_record->is_boss = is_boss_health;
+        damage_system->SetHealth(entity->id, data.health);
+        damage_record->full_health = data.health;
+        damage_record->score = data.score;
+        damage_record->is_boss = data.is_boss;
 
         return true;
     }
@@ -203,8 +290,10 @@ namespace
 
     bool ReleaseEntityLogic(mono::Entity* entity, mono::SystemContext* context)
     {
+        // Pooled entities are released without a logic, it's released when the entity goes back to the pool.
         game::EntityLogicSystem* logic_system = context->GetSystem<game::EntityLogicSystem>();
-        logic_system->ReleaseLogic(entity->id);
+        if(logic_system->HasLogic(entity->id))
+            logic_system->ReleaseLogic(entity->id);
         return true;
     }
 
@@ -216,10 +305,7 @@ namespace
             return false;
 
         game::IEntityLogic* entity_logic = game::g_logic_factory->CreateLogic(shared::EntityLogicType(logic_type_value), properties, entity->id);
-        game::EntityLogicSystem* logic_system = context->GetSystem<game::EntityLogicSystem>();
-        logic_system->AddLogic(entity->id, entity_logic);
-
-        return true;
+        return entity_logic != nullptr;
     }
 
     bool CreateSpawnPoint(mono::Entity* entity, mono::SystemContext* context)
@@ -236,25 +322,36 @@ namespace
         return true;
     }
 
-    bool UpdateSpawnPoint(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct SpawnPointData
     {
-        game::SpawnSystem::SpawnPointComponent spawn_point;
-        spawn_point.enable_trigger = 0;
-        spawn_point.disable_trigger = 0;
+        int spawn_score;
+        float radius;
+        int interval;
+        StringHash enable_trigger;
+        StringHash disable_trigger;
+    };
 
-        FindAttribute(SPAWN_SCORE_ATTRIBUTE, properties, spawn_point.spawn_score, FallbackMode::SET_DEFAULT);
-        FindAttribute(RADIUS_ATTRIBUTE, properties, spawn_point.radius, FallbackMode::SET_DEFAULT);
-        FindAttribute(TIME_STAMP_ATTRIBUTE, properties, spawn_point.interval, FallbackMode::SET_DEFAULT);
-
-        std::string enable_trigger;
-        const bool found_enable = FindAttribute(ENABLE_TRIGGER_ATTRIBUTE, properties, enable_trigger, FallbackMode::SET_DEFAULT);
-        if(found_enable)
-            spawn_point.enable_trigger = hash::Hash(enable_trigger.c_str());
+    const ComponentSchema<SpawnPointData>& SpawnPointSchema()
+    {
+        static const ComponentSchema<SpawnPointData> schema(SPAWN_POINT_COMPONENT, {
+            Field<&SpawnPointData::spawn_score>(SPAWN_SCORE_ATTRIBUTE),
+            Field<&SpawnPointData::radius>(RADIUS_ATTRIBUTE),
+            Field<&SpawnPointData::interval>(TIME_STAMP_ATTRIBUTE),
+            Field<&SpawnPointData::enable_trigger>(ENABLE_TRIGGER_ATTRIBUTE),
+            Field<&SpawnPointData::disable_trigger>(DISABLE_TRIGGER_ATTRIBUTE),
+        });
+        return schema;
+    }
 
-        std::string disable_trigger;
-        const bool found_disable = FindAttribute(DISABLE_TRIGGER_ATTRIBUTE, properties, disable_trigger, FallbackMode::SET_DEFAULT);
-        if(found_disable)
-            spawn_point.disable_trigger = hash::Hash(disable_trigger.c_str());
+    bool UpdateSpawnPoint(mono::Entity* entity, const SpawnPointData& data, mono::SystemContext* context)
+    {
+        game::SpawnSystem::SpawnPointComponent spawn_point;
+        spawn_point.spawn_score = data.spawn_score;
+        spawn_point.radius = data.radius;
+        spawn_point.interval = data.interval;
+        spawn_point.properties = 0;
+        spawn_point.enable_trigger = data.enable_trigger.value;
+        spawn_point.disable_trigger = data.disable_trigger.value;
 
         game::SpawnSystem* spawn_system = context->GetSystem<game::SpawnSystem>();
         spawn_system->SetSpawnPointData(entity->id, spawn_point);
@@ -275,34 +372,45 @@ namespace
         return true;
     }
     
-    bool UpdateShapeTrigger(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct ShapeTriggerData
     {
-        std::string enter_trigger_name;
-        const bool found_trigger_name =
-            FindAttribute(TRIGGER_NAME_ATTRIBUTE, properties, enter_trigger_name, FallbackMode::REQUIRE_ATTRIBUTE);
+        StringHash enter_trigger;
+        StringHash exit_trigger;
+        uint32_t faction;
+    };
+
+    const ComponentSchema<ShapeTriggerData>& ShapeTriggerSchema()
+    {
+        static const ComponentSchema<ShapeTriggerData> schema(SHAPE_TRIGGER_COMPONENT, {
+            Field<&ShapeTriggerData::enter_trigger>(TRIGGER_NAME_ATTRIBUTE, FallbackMode::REQUIRE_ATTRIBUTE),
+            Field<&ShapeTriggerData::exit_trigger>(TRIGGER_NAME_EXIT_ATTRIBUTE, FallbackMode::REQUIRE_ATTRIBUTE),
+            Field<&ShapeTriggerData::faction>(FACTION_PICKER_ATTRIBUTE),
+        });
+        return schema;
+    }
 
-        std::string exit_trigger_name;
-        const bool found_exit_trigger_name =
-            FindAttribute(TRIGGER_NAME_EXIT_ATTRIBUTE, properties, exit_trigger_name, FallbackMode::REQUIRE_ATTRIBUTE);
+    bool UpdateShapeTrigger(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    {
+        // Only one of the trigger names is needed.
+        const ComponentSchema<ShapeTriggerData>& schema = ShapeTriggerSchema();
+        const uint32_t trigger_names_mask =
+            schema.FieldMask(TRIGGER_NAME_ATTRIBUTE) | schema.FieldMask(TRIGGER_NAME_EXIT_ATTRIBUTE);
 
-        if(!found_trigger_name && !found_exit_trigger_name)
+        ShapeTriggerData data;
+        const uint32_t found_mask = schema.ReadFields(properties, data);
+        if((found_mask & trigger_names_mask) == 0)
         {
             System::Log("GameComponentFunctions|Missing trigger name parameter, unable to update component");
             return false;
         }
 
-        uint32_t faction;
-        FindAttribute(FACTION_PICKER_ATTRIBUTE, properties, faction, FallbackMode::SET_DEFAULT);
-
-        const uint32_t enter_trigger_hash = hash::Hash(enter_trigger_name.c_str());
-        const uint32_t exit_trigger_hash = hash::Hash(exit_trigger_name.c_str());
+        if(!(found_mask & schema.FieldMask(TRIGGER_NAME_ATTRIBUTE)))
+            data.enter_trigger.value = hash::Hash("");
+        if(!(found_mask & schema.FieldMask(TRIGGER_NAME_EXIT_ATTRIBUTE)))
+            data.exit_trigger.value = hash::Hash("");
 
         game::TriggerSystem* trigger_system = context->GetSystem<game::TriggerSystem>();
-        trigger_system->AddShapeTrigger(entity->id, enter_trigger_hash, exit_trigger_hash, faction);
-
-        hash::HashRegisterString(enter_trigger_name.c_str());
-        hash::HashRegisterString(exit_trigger_name.c_str());
-
+        trigger_system->AddShapeTrigger(entity->id, data.enter_trigger.value, data.exit_trigger.value, data.faction);
         return true;
     }
 
@@ -320,26 +428,25 @@ namespace
         return true;
     }
 
-    bool UpdateDestroyedTrigger(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct DestroyedTriggerData
     {
-        std::string trigger_name;
-        const bool found_trigger_name =
-            FindAttribute(TRIGGER_NAME_ATTRIBUTE, properties, trigger_name, FallbackMode::REQUIRE_ATTRIBUTE);
+        StringHash trigger;
+        shared::DestroyedTriggerType trigger_type;
+    };
 
-        if(!found_trigger_name)
-        {
-            System::Log("GameComponentFunctions|Missing trigger name parameter, unable to update component");
-            return false;
-        }
-
-        int trigger_type;
-        FindAttribute(DESTROYED_TRIGGER_TYPE_ATTRIBUTE, properties, trigger_type, FallbackMode::SET_DEFAULT);
+    const ComponentSchema<DestroyedTriggerData>& DestroyedTriggerSchema()
+    {
+        static const ComponentSchema<DestroyedTriggerData> schema(DESTROYED_TRIGGER_COMPONENT, {
+            Field<&DestroyedTriggerData::trigger>(TRIGGER_NAME_ATTRIBUTE, FallbackMode::REQUIRE_ATTRIBUTE),
+            Field<&DestroyedTriggerData::trigger_type>(DESTROYED_TRIGGER_TYPE_ATTRIBUTE),
+        });
+        return schema;
+    }
 
-        const uint32_t trigger_hash = hash::Hash(trigger_name.c_str());
+    bool UpdateDestroyedTrigger(mono::Entity* entity, const DestroyedTriggerData& data, mono::SystemContext* context)
+    {
         game::TriggerSystem* trigger_system = context->GetSystem<game::TriggerSystem>();
-        trigger_system->AddDestroyedTrigger(entity->id, trigger_hash, shared::DestroyedTriggerType(trigger_type));
-        hash::HashRegisterString(trigger_name.c_str());
-
+        trigger_system->AddDestroyedTrigger(entity->id, data.trigger.value, data.trigger_type);
         return true;
     }
 
@@ -357,36 +464,38 @@ namespace
         return true;
     }
 
-    bool UpdateAreaTrigger(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct AreaTriggerData
     {
-        std::string trigger_name;
-        const bool found_trigger_name =
-            FindAttribute(TRIGGER_NAME_ATTRIBUTE, properties, trigger_name, FallbackMode::REQUIRE_ATTRIBUTE);
-        if(!found_trigger_name)
-            return false;
-
+        StringHash trigger;
         math::Vector size;
         uint32_t faction;
-        int operation;
+        shared::AreaTriggerOperation operation;
         int n_entities;
+    };
 
-        FindAttribute(SIZE_ATTRIBUTE, properties, size, FallbackMode::SET_DEFAULT);
-        FindAttribute(FACTION_PICKER_ATTRIBUTE, properties, faction, FallbackMode::SET_DEFAULT);
-        FindAttribute(LOGIC_OP_ATTRIBUTE, properties, operation, FallbackMode::SET_DEFAULT);
-        FindAttribute(N_ENTITIES_ATTRIBUTE, properties, n_entities, FallbackMode::SET_DEFAULT);
+    const ComponentSchema<AreaTriggerData>& AreaTriggerSchema()
+    {
+        static const ComponentSchema<AreaTriggerData> schema(AREA_TRIGGER_COMPONENT, {
+            Field<&AreaTriggerData::trigger>(TRIGGER_NAME_ATTRIBUTE, FallbackMode::REQUIRE_ATTRIBUTE),
+            Field<&AreaTriggerData::size>(SIZE_ATTRIBUTE),
+            Field<&AreaTriggerData::faction>(FACTION_PICKER_ATTRIBUTE),
+            Field<&AreaTriggerData::operation>(LOGIC_OP_ATTRIBUTE),
+            Field<&AreaTriggerData::n_entities>(N_ENTITIES_ATTRIBUTE),
+        });
+        return schema;
+    }
 
-        const math::Vector half_width_height = size / 2.0f;
+    bool UpdateAreaTrigger(mono::Entity* entity, const AreaTriggerData& data, mono::SystemContext* context)
+    {
+        const math::Vector half_width_height = data.size / 2.0f;
 
         mono::TransformSystem* transform_system = context->GetSystem<mono::TransformSystem>();
         const math::Matrix& world_transform = transform_system->GetWorld(entity->id);
         const math::Quad world_bb = math::Transform(world_transform, math::Quad(-half_width_height, half_width_height));
 
-        const uint32_t trigger_hash = hash::Hash(trigger_name.c_str());
-
         game::TriggerSystem* trigger_system = context->GetSystem<game::TriggerSystem>();
         trigger_system->AddAreaEntityTrigger(
-            entity->id, trigger_hash, world_bb, faction, shared::AreaTriggerOperation(operation), n_entities);
-        hash::HashRegisterString(trigger_name.c_str());
+            entity->id, data.trigger.value, world_bb, data.faction, data.operation, data.n_entities);
 
         return true;
     }
@@ -405,24 +514,27 @@ namespace
         return true;
     }
 
-    bool UpdateTimeTrigger(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct TimeTriggerData
     {
-        std::string trigger_name;
-        const bool found_trigger_name =
-            FindAttribute(TRIGGER_NAME_ATTRIBUTE, properties, trigger_name, FallbackMode::REQUIRE_ATTRIBUTE);
-        if(!found_trigger_name)
-            return false;
-
+        StringHash trigger;
         int timeout_ms;
         bool repeating;
-        FindAttribute(TIME_STAMP_ATTRIBUTE, properties, timeout_ms, FallbackMode::SET_DEFAULT);
-        FindAttribute(REPEATING_ATTRIBUTE, properties, repeating, FallbackMode::SET_DEFAULT);
+    };
 
-        const uint32_t trigger_hash = hash::Hash(trigger_name.c_str());
-        game::TriggerSystem* trigger_system = context->GetSystem<game::TriggerSystem>();
-        trigger_system->AddTimeTrigger(entity->id, trigger_hash, timeout_ms, repeating);
-        hash::HashRegisterString(trigger_name.c_str());
+    const ComponentSchema<TimeTriggerData>& TimeTriggerSchema()
+    {
+        static const ComponentSchema<TimeTriggerData> schema(TIME_TRIGGER_COMPONENT, {
+            Field<&TimeTriggerData::trigger>(TRIGGER_NAME_ATTRIBUTE, FallbackMode::REQUIRE_ATTRIBUTE),
+            Field<&TimeTriggerData::timeout_ms>(TIME_STAMP_ATTRIBUTE),
+            Field<&TimeTriggerData::repeating>(REPEATING_ATTRIBUTE),
+        });
+        return schema;
+    }
 
+    bool UpdateTimeTrigger(mono::Entity* entity, const TimeTriggerData& data, mono::SystemContext* context)
+    {
+        game::TriggerSystem* trigger_system = context->GetSystem<game::TriggerSystem>();
+        trigger_system->AddTimeTrigger(entity->id, data.trigger.value, data.timeout_ms, data.repeating);
         return true;
     }
 
@@ -440,31 +552,30 @@ namespace
         return true;
     }
 
-    bool UpdateCounterTrigger(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct CounterTriggerData
     {
-        std::string trigger_name;
-        std::string trigger_name_completed;
-        const bool found_trigger_name =
-            FindAttribute(TRIGGER_NAME_ATTRIBUTE, properties, trigger_name, FallbackMode::REQUIRE_ATTRIBUTE);
-        const bool found_trigger_name_completed =
-            FindAttribute(TRIGGER_NAME_COMPLETED_ATTRIBUTE, properties, trigger_name_completed, FallbackMode::REQUIRE_ATTRIBUTE);
-        if(!found_trigger_name || !found_trigger_name_completed)
-            return false;
-
+        StringHash trigger;
+        StringHash completed_trigger;
         int count;
         bool reset_on_completed;
-        FindAttribute(COUNT_ATTRIBUTE, properties, count, FallbackMode::SET_DEFAULT);
-        FindAttribute(RESET_ON_COMPLETED_ATTRIBUTE, properties, reset_on_completed, FallbackMode::SET_DEFAULT);
+    };
 
-        const uint32_t trigger_hash = hash::Hash(trigger_name.c_str());
-        const uint32_t completed_trigger_hash = hash::Hash(trigger_name_completed.c_str());
+    const ComponentSchema<CounterTriggerData>& CounterTriggerSchema()
+    {
+        static const ComponentSchema<CounterTriggerData> schema(COUNTER_TRIGGER_COMPONENT, {
+            Field<&CounterTriggerData::trigger>(TRIGGER_NAME_ATTRIBUTE, FallbackMode::REQUIRE_ATTRIBUTE),
+            Field<&CounterTriggerData::completed_trigger>(TRIGGER_NAME_COMPLETED_ATTRIBUTE, FallbackMode::REQUIRE_ATTRIBUTE),
+            Field<&CounterTriggerData::count>(COUNT_ATTRIBUTE),
+            Field<&CounterTriggerData::reset_on_completed>(RESET_ON_COMPLETED_ATTRIBUTE),
+        });
+        return schema;
+    }
 
+    bool UpdateCounterTrigger(mono::Entity* entity, const CounterTriggerData& data, mono::SystemContext* context)
+    {
         game::TriggerSystem* trigger_system = context->GetSystem<game::TriggerSystem>();
-        trigger_system->AddCounterTrigger(entity->id, trigger_hash, completed_trigger_hash, count, reset_on_completed);
-
-        hash::HashRegisterString(trigger_name.c_str());
-        hash::HashRegisterString(trigger_name_completed.c_str());
-
+        trigger_system->AddCounterTrigger(
+            entity->id, data.trigger.value, data.completed_trigger.value, data.count, data.reset_on_completed);
         return true;
     }
 
@@ -482,15 +593,19 @@ namespace
         return true;
     }
 
-    bool UpdatePickup(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    const ComponentSchema<game::Pickup>& PickupSchema()
     {
-        game::Pickup pickup;
-        FindAttribute(PICKUP_TYPE_ATTRIBUTE, properties, (int&)pickup.type, FallbackMode::SET_DEFAULT);
-        FindAttribute(AMOUNT_ATTRIBUTE, properties, pickup.amount, FallbackMode::SET_DEFAULT);
+        static const ComponentSchema<game::Pickup> schema(PICKUP_COMPONENT, {
+            Field<&game::Pickup::type>(PICKUP_TYPE_ATTRIBUTE),
+            Field<&game::Pickup::amount>(AMOUNT_ATTRIBUTE),
+        });
+        return schema;
+    }
 
+    bool UpdatePickup(mono::Entity* entity, const game::Pickup& pickup, mono::SystemContext* context)
+    {
         game::PickupSystem* pickup_system = context->GetSystem<game::PickupSystem>();
         pickup_system->SetPickupData(entity->id, pickup);
-
         return true;
     }
 
@@ -508,24 +623,25 @@ namespace
         return true;
     }
 
-    bool UpdateAnimation(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct AnimationData
     {
-        std::string trigger_name;
-        const bool found_trigger_name =
-            FindAttribute(TRIGGER_NAME_ATTRIBUTE, properties, trigger_name, FallbackMode::REQUIRE_ATTRIBUTE);
-
-        if(!found_trigger_name)
-        {
-            System::Log("GameComponentFunctions|Missing trigger name parameter, unable to update component");
-            return false;
-        }
-
+        StringHash trigger;
         int animation_index;
-        FindAttribute(ANIMATION_ATTRIBUTE, properties, animation_index, FallbackMode::SET_DEFAULT);
+    };
 
-        game::AnimationSystem* animation_system = context->GetSystem<game::AnimationSystem>();
-        animation_system->AddSpriteAnimation(entity->id, hash::Hash(trigger_name.c_str()), animation_index);
+    const ComponentSchema<AnimationData>& AnimationSchema()
+    {
+        static const ComponentSchema<AnimationData> schema(ANIMATION_COMPONENT, {
+            Field<&AnimationData::trigger>(TRIGGER_NAME_ATTRIBUTE, FallbackMode::REQUIRE_ATTRIBUTE),
+            Field<&AnimationData::animation_index>(ANIMATION_ATTRIBUTE),
+        });
+        return schema;
+    }
 
+    bool UpdateAnimation(mono::Entity* entity, const AnimationData& data, mono::SystemContext* context)
+    {
+        game::AnimationSystem* animation_system = context->GetSystem<game::AnimationSystem>();
+        animation_system->AddSpriteAnimation(entity->id, data.trigger.value, data.animation_index);
         return true;
     }
 
@@ -543,31 +659,32 @@ namespace
         return true;
     }
 
-    bool UpdateTranslation(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct TranslationData
     {
-        std::string trigger_name;
-        const bool found_trigger_name =
-            FindAttribute(TRIGGER_NAME_ATTRIBUTE, properties, trigger_name, FallbackMode::REQUIRE_ATTRIBUTE);
-
-        if(!found_trigger_name)
-        {
-            System::Log("GameComponentFunctions|Missing trigger name parameter, unable to update component");
-            return false;
-        }
-
+        StringHash trigger;
         math::Vector translation;
         float duration;
         int ease_func_index;
-        int animation_mode;
-        FindAttribute(POSITION_ATTRIBUTE, properties, translation, FallbackMode::SET_DEFAULT);
-        FindAttribute(DURATION_ATTRIBUTE, properties, duration, FallbackMode::SET_DEFAULT);
-        FindAttribute(EASING_FUNC_ATTRIBUTE, properties, ease_func_index, FallbackMode::SET_DEFAULT);
-        FindAttribute(ANIMATION_MODE_ATTRIBUTE, properties, animation_mode, FallbackMode::SET_DEFAULT);
+        shared::AnimationMode animation_mode;
+    };
 
+    const ComponentSchema<TranslationData>& TranslationSchema()
+    {
+        static const ComponentSchema<TranslationData> schema(TRANSLATION_COMPONENT, {
+            Field<&TranslationData::trigger>(TRIGGER_NAME_ATTRIBUTE, FallbackMode::REQUIRE_ATTRIBUTE),
+            Field<&TranslationData::translation>(POSITION_ATTRIBUTE),
+            Field<&TranslationData::duration>(DURATION_ATTRIBUTE),
+            Field<&TranslationData::ease_func_index>(EASING_FUNC_ATTRIBUTE),
+            Field<&TranslationData::animation_mode>(ANIMATION_MODE_ATTRIBUTE),
+        });
+        return schema;
+    }
+
+    bool UpdateTranslation(mono::Entity* entity, const TranslationData& data, mono::SystemContext* context)
+    {
         game::AnimationSystem* animation_system = context->GetSystem<game::AnimationSystem>();
         animation_system->AddTranslationComponent(
-            entity->id, hash::Hash(trigger_name.c_str()), duration, math::ease_functions[ease_func_index], shared::AnimationMode(animation_mode), translation);
-
+            entity->id, data.trigger.value, data.duration, math::ease_functions[data.ease_func_index], data.animation_mode, data.translation);
         return true;
     }
 
@@ -585,31 +702,32 @@ namespace
         return true;
     }
 
-    bool UpdateRotation(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct RotationData
     {
-        std::string trigger_name;
-        const bool found_trigger_name =
-            FindAttribute(TRIGGER_NAME_ATTRIBUTE, properties, trigger_name, FallbackMode::REQUIRE_ATTRIBUTE);
-
-        if(!found_trigger_name)
-        {
-            System::Log("GameComponentFunctions|Missing trigger name parameter, unable to update component");
-            return false;
-        }
-
+        StringHash trigger;
         float rotation;
         float duration;
         int ease_func_index;
-        int animation_mode;
-        FindAttribute(ROTATION_ATTRIBUTE, properties, rotation, FallbackMode::SET_DEFAULT);
-        FindAttribute(DURATION_ATTRIBUTE, properties, duration, FallbackMode::SET_DEFAULT);
-        FindAttribute(EASING_FUNC_ATTRIBUTE, properties, ease_func_index, FallbackMode::SET_DEFAULT);
-        FindAttribute(ANIMATION_MODE_ATTRIBUTE, properties, animation_mode, FallbackMode::SET_DEFAULT);
+        shared::AnimationMode animation_mode;
+    };
+
+    const ComponentSchema<RotationData>& RotationSchema()
+    {
+        static const ComponentSchema<RotationData> schema(ROTATION_COMPONENT, {
+            Field<&RotationData::trigger>(TRIGGER_NAME_ATTRIBUTE, FallbackMode::REQUIRE_ATTRIBUTE),
+            Field<&RotationData::rotation>(ROTATION_ATTRIBUTE),
+            Field<&RotationData::duration>(DURATION_ATTRIBUTE),
+            Field<&RotationData::ease_func_index>(EASING_FUNC_ATTRIBUTE),
+            Field<&RotationData::animation_mode>(ANIMATION_MODE_ATTRIBUTE),
+        });
+        return schema;
+    }
 
+    bool UpdateRotation(mono::Entity* entity, const RotationData& data, mono::SystemContext* context)
+    {
         game::AnimationSystem* animation_system = context->GetSystem<game::AnimationSystem>();
         animation_system->AddRotationComponent(
-            entity->id, hash::Hash(trigger_name.c_str()), duration, math::ease_functions[ease_func_index], shared::AnimationMode(animation_mode), rotation);
-
+            entity->id, data.trigger.value, data.duration, math::ease_functions[data.ease_func_index], data.animation_mode, data.rotation);
         return true;
     }
 
@@ -627,22 +745,25 @@ namespace
         return true;
     }
 
-    bool UpdateCameraZoom(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct CameraZoomData
     {
-        std::string trigger_name;
-        const bool found_trigger_name =
-            FindAttribute(TRIGGER_NAME_ATTRIBUTE, properties, trigger_name, FallbackMode::REQUIRE_ATTRIBUTE);
-        if(!found_trigger_name)
-        {
-            System::Log("GameComponentFunctions|Missing trigger name parameter, unable to update component");
-            return false;
-        }
+        StringHash trigger;
+        float zoom_level;
+    };
 
-        float zoom_value;
-        FindAttribute(ZOOM_LEVEL_ATTRIBUTE, properties, zoom_value, FallbackMode::SET_DEFAULT);
+    const ComponentSchema<CameraZoomData>& CameraZoomSchema()
+    {
+        static const ComponentSchema<CameraZoomData> schema(CAMERA_ZOOM_COMPONENT, {
+            Field<&CameraZoomData::trigger>(TRIGGER_NAME_ATTRIBUTE, FallbackMode::REQUIRE_ATTRIBUTE),
+            Field<&CameraZoomData::zoom_level>(ZOOM_LEVEL_ATTRIBUTE),
+        });
+        return schema;
+    }
 
+    bool UpdateCameraZoom(mono::Entity* entity, const CameraZoomData& data, mono::SystemContext* context)
+    {
         game::CameraSystem* camera_system = context->GetSystem<game::CameraSystem>();
-        camera_system->AddCameraAnimationComponent(entity->id, hash::Hash(trigger_name.c_str()), zoom_value);
+        camera_system->AddCameraAnimationComponent(entity->id, data.trigger.value, data.zoom_level);
         return true;
     }
 
@@ -660,22 +781,25 @@ namespace
         return true;
     }
 
-    bool UpdateCameraPoint(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct CameraPointData
     {
-        std::string trigger_name;
-        const bool found_trigger_name =
-            FindAttribute(TRIGGER_NAME_ATTRIBUTE, properties, trigger_name, FallbackMode::REQUIRE_ATTRIBUTE);
-        if(!found_trigger_name)
-        {
-            System::Log("GameComponentFunctions|Missing trigger name parameter, unable to update component");
-            return false;
-        }
-
+        StringHash trigger;
         math::Vector point;
-        FindAttribute(POSITION_ATTRIBUTE, properties, point, FallbackMode::SET_DEFAULT);
+    };
 
+    const ComponentSchema<CameraPointData>& CameraPointSchema()
+    {
+        static const ComponentSchema<CameraPointData> schema(CAMERA_POINT_COMPONENT, {
+            Field<&CameraPointData::trigger>(TRIGGER_NAME_ATTRIBUTE, FallbackMode::REQUIRE_ATTRIBUTE),
+            Field<&CameraPointData::point>(POSITION_ATTRIBUTE),
+        });
+        return schema;
+    }
+
+    bool UpdateCameraPoint(mono::Entity* entity, const CameraPointData& data, mono::SystemContext* context)
+    {
         game::CameraSystem* camera_system = context->GetSystem<game::CameraSystem>();
-        camera_system->AddCameraAnimationComponent(entity->id, hash::Hash(trigger_name.c_str()), point);
+        camera_system->AddCameraAnimationComponent(entity->id, data.trigger.value, data.point);
         return true;
     }
 
@@ -693,75 +817,74 @@ namespace
         return true;
     }
     
-    bool UpdateInteraction(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct InteractionData
     {
-        std::string trigger_name;
-        const bool found_trigger_name =
-            FindAttribute(TRIGGER_NAME_ATTRIBUTE, properties, trigger_name, FallbackMode::REQUIRE_ATTRIBUTE);
-        if(!found_trigger_name)
-        {
-            System::Log("GameComponentFunctions|Missing trigger name parameter, unable to update component");
-            return false;
-        }
-
+        StringHash trigger;
         shared::InteractionType interaction_type;
-        FindAttribute(INTERACTION_TYPE_ATTRIBUTE, properties, (int&)interaction_type, FallbackMode::SET_DEFAULT);
+    };
 
-        game::InteractionSystem* interaction_system = context->GetSystem<game::InteractionSystem>();
-        interaction_system->AddComponent(entity->id, hash::Hash(trigger_name.c_str()), interaction_type);
-        hash::HashRegisterString(trigger_name.c_str());
+    const ComponentSchema<InteractionData>& InteractionSchema()
+    {
+        static const ComponentSchema<InteractionData> schema(INTERACTION_COMPONENT, {
+            Field<&InteractionData::trigger>(TRIGGER_NAME_ATTRIBUTE, FallbackMode::REQUIRE_ATTRIBUTE),
+            Field<&InteractionData::interaction_type>(INTERACTION_TYPE_ATTRIBUTE),
+        });
+        return schema;
+    }
 
+    bool UpdateInteraction(mono::Entity* entity, const InteractionData& data, mono::SystemContext* context)
+    {
+        game::InteractionSystem* interaction_system = context->GetSystem<game::InteractionSystem>();
+        interaction_system->AddComponent(entity->id, data.trigger.value, data.interaction_type);
         return true;
     }
 
-    bool UpdateInteractionSwitch(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    struct InteractionSwitchData
     {
-        std::string on_trigger_name;
-        std::string off_trigger_name;
-        const bool found_trigger_name =
-            FindAttribute(TRIGGER_NAME_ATTRIBUTE, properties, on_trigger_name, FallbackMode::REQUIRE_ATTRIBUTE) &&
-            FindAttribute(TRIGGER_NAME_EXIT_ATTRIBUTE, properties, off_trigger_name, FallbackMode::REQUIRE_ATTRIBUTE);
-        if(!found_trigger_name)
-        {
-            System::Log("GameComponentFunctions|Missing trigger name parameter, unable to update component");
-            return false;
-        }
-
+        StringHash on_trigger;
+        StringHash off_trigger;
         shared::InteractionType interaction_type;
-        FindAttribute(INTERACTION_TYPE_ATTRIBUTE, properties, (int&)interaction_type, FallbackMode::SET_DEFAULT);
-        
-        game::InteractionSystem* interaction_system = context->GetSystem<game::InteractionSystem>();
-        interaction_system->AddComponent(
-            entity->id, hash::Hash(on_trigger_name.c_str()), hash::Hash(off_trigger_name.c_str()), interaction_type);
+    };
 
-        hash::HashRegisterString(on_trigger_name.c_str());
-        hash::HashRegisterString(off_trigger_name.c_str());
+    const ComponentSchema<InteractionSwitchData>& InteractionSwitchSchema()
+    {
+        static const ComponentSchema<InteractionSwitchData> schema(INTERACTION_SWITCH_COMPONENT, {
+            Field<&InteractionSwitchData::on_trigger>(TRIGGER_NAME_ATTRIBUTE, FallbackMode::REQUIRE_ATTRIBUTE),
+            Field<&InteractionSwitchData::off_trigger>(TRIGGER_NAME_EXIT_ATTRIBUTE, FallbackMode::REQUIRE_ATTRIBUTE),
+            Field<&InteractionSwitchData::interaction_type>(INTERACTION_TYPE_ATTRIBUTE),
+        });
+        return schema;
+    }
 
+    bool UpdateInteractionSwitch(mono::Entity* entity, const InteractionSwitchData& data, mono::SystemContext* context)
+    {
+        game::InteractionSystem* interaction_system = context->GetSystem<game::InteractionSystem>();
+        interaction_system->AddComponent(entity->id, data.on_trigger.value, data.off_trigger.value, data.interaction_type);
         return true;
     }
 }
 
 void game::RegisterGameComponents(mono::IEntityManager* entity_manager)
 {
-    entity_manager->RegisterComponent(PHYSICS_COMPONENT, CreatePhysics, ReleasePhysics, UpdatePhysics);
-    entity_manager->RegisterComponent(CIRCLE_SHAPE_COMPONENT, CreateShape, ReleaseShape, UpdateCircleShape);
-    entity_manager->RegisterComponent(BOX_SHAPE_COMPONENT, CreateShape, ReleaseShape, UpdateBoxShape);
-    entity_manager->RegisterComponent(SEGMENT_SHAPE_COMPONENT, CreateShape, ReleaseShape, UpdateSegmentShape);
-    entity_manager->RegisterComponent(POLYGON_SHAPE_COMPONENT, CreateShape, ReleaseShape, UpdatePolygonShape);
-    entity_manager->RegisterComponent(HEALTH_COMPONENT, CreateHealth, ReleaseHealth, UpdateHealth);
+    entity_manager->RegisterComponent(PHYSICS_COMPONENT, CreatePhysics, ReleasePhysics, UpdateComponent<PhysicsSchema, UpdatePhysics>);
+    entity_manager->RegisterComponent(CIRCLE_SHAPE_COMPONENT, CreateShape, ReleaseShape, UpdateComponent<CircleShapeSchema, UpdateCircleShape>);
+    entity_manager->RegisterComponent(BOX_SHAPE_COMPONENT, CreateShape, ReleaseShape, UpdateComponent<BoxShapeSchema, UpdateBoxShape>);
+    entity_manager->RegisterComponent(SEGMENT_SHAPE_COMPONENT, CreateShape, ReleaseShape, UpdateComponent<SegmentShapeSchema, UpdateSegmentShape>);
+    entity_manager->RegisterComponent(POLYGON_SHAPE_COMPONENT, CreateShape, ReleaseShape, UpdateComponent<PolygonShapeSchema, UpdatePolygonShape>);
+    entity_manager->RegisterComponent(HEALTH_COMPONENT, CreateHealth, ReleaseHealth, UpdateComponent<HealthSchema, UpdateHealth>);
     entity_manager->RegisterComponent(BEHAVIOUR_COMPONENT, CreateEntityLogic, ReleaseEntityLogic, UpdateEntityLogic);
-    entity_manager->RegisterComponent(SPAWN_POINT_COMPONENT, CreateSpawnPoint, ReleaseSpawnPoint, UpdateSpawnPoint);
+    entity_manager->RegisterComponent(SPAWN_POINT_COMPONENT, CreateSpawnPoint, ReleaseSpawnPoint, UpdateComponent<SpawnPointSchema, UpdateSpawnPoint>);
     entity_manager->RegisterComponent(SHAPE_TRIGGER_COMPONENT, CreateShapeTrigger, ReleaseShapeTrigger, UpdateShapeTrigger);
-    entity_manager->RegisterComponent(DESTROYED_TRIGGER_COMPONENT, CreateDestroyedTrigger, ReleaseDestroyedTrigger, UpdateDestroyedTrigger);
-    entity_manager->RegisterComponent(AREA_TRIGGER_COMPONENT, CreateAreaTrigger, ReleaseAreaTrigger, UpdateAreaTrigger);
-    entity_manager->RegisterComponent(TIME_TRIGGER_COMPONENT, CreateTimeTrigger, ReleaseTimeTrigger, UpdateTimeTrigger);
-    entity_manager->RegisterComponent(COUNTER_TRIGGER_COMPONENT, CreateCounterTrigger, ReleaseCounterTrigger, UpdateCounterTrigger);
-    entity_manager->RegisterComponent(PICKUP_COMPONENT, CreatePickup, ReleasePickup, UpdatePickup);
-    entity_manager->RegisterComponent(ANIMATION_COMPONENT, CreateAnimation, ReleaseAnimation, UpdateAnimation);
-    entity_manager->RegisterComponent(TRANSLATION_COMPONENT, CreateTranslation, ReleaseTranslation, UpdateTranslation);
-    entity_manager->RegisterComponent(ROTATION_COMPONENT, CreateRotation, ReleaseRotation, UpdateRotation);
-    entity_manager->RegisterComponent(CAMERA_ZOOM_COMPONENT, CreateCameraZoom, ReleaseCameraZoom, UpdateCameraZoom);
-    entity_manager->RegisterComponent(CAMERA_POINT_COMPONENT, CreateCameraPoint, ReleaseCameraPoint, UpdateCameraPoint);
-    entity_manager->RegisterComponent(INTERACTION_COMPONENT, CreateInteraction, ReleaseInteraction, UpdateInteraction);
-    entity_manager->RegisterComponent(INTERACTION_SWITCH_COMPONENT, CreateInteraction, ReleaseInteraction, UpdateInteractionSwitch);
+    entity_manager->RegisterComponent(DESTROYED_TRIGGER_COMPONENT, CreateDestroyedTrigger, ReleaseDestroyedTrigger, UpdateComponent<DestroyedTriggerSchema, UpdateDestroyedTrigger>);
+    entity_manager->RegisterComponent(AREA_TRIGGER_COMPONENT, CreateAreaTrigger, ReleaseAreaTrigger, UpdateComponent<AreaTriggerSchema, UpdateAreaTrigger>);
+    entity_manager->RegisterComponent(TIME_TRIGGER_COMPONENT, CreateTimeTrigger, ReleaseTimeTrigger, UpdateComponent<TimeTriggerSchema, UpdateTimeTrigger>);
+    entity_manager->RegisterComponent(COUNTER_TRIGGER_COMPONENT, CreateCounterTrigger, ReleaseCounterTrigger, UpdateComponent<CounterTriggerSchema, UpdateCounterTrigger>);
+    entity_manager->RegisterComponent(PICKUP_COMPONENT, CreatePickup, ReleasePickup, UpdateComponent<PickupSchema, UpdatePickup>);
+    entity_manager->RegisterComponent(ANIMATION_COMPONENT, CreateAnimation, ReleaseAnimation, UpdateComponent<AnimationSchema, UpdateAnimation>);
+    entity_manager->RegisterComponent(TRANSLATION_COMPONENT, CreateTranslation, ReleaseTranslation, UpdateComponent<TranslationSchema, UpdateTranslation>);
+    entity_manager->RegisterComponent(ROTATION_COMPONENT, CreateRotation, ReleaseRotation, UpdateComponent<RotationSchema, UpdateRotation>);
+    entity_manager->RegisterComponent(CAMERA_ZOOM_COMPONENT, CreateCameraZoom, ReleaseCameraZoom, UpdateComponent<CameraZoomSchema, UpdateCameraZoom>);
+    entity_manager->RegisterComponent(CAMERA_POINT_COMPONENT, CreateCameraPoint, ReleaseCameraPoint, UpdateComponent<CameraPointSchema, UpdateCameraPoint>);
+    entity_manager->RegisterComponent(INTERACTION_COMPONENT, CreateInteraction, ReleaseInteraction, UpdateComponent<InteractionSchema, UpdateInteraction>);
+    entity_manager->RegisterComponent(INTERACTION_SWITCH_COMPONENT, CreateInteraction, ReleaseInteraction, UpdateComponent<InteractionSwitchSchema, UpdateInteractionSwitch>);
 }
@@ -0,0 +1,274 @@
+
+#include "TweenEngine.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace game;
+
+namespace
+{
+    constexpr uint32_t INDEX_BITS = 20;
+    constexpr uint32_t INDEX_MASK = (1 << INDEX_BITS) - 1;
+    constexpr uint32_t GENERATION_MASK = (1 << (31 - INDEX_BITS)) - 1;
+
+    constexpr uint32_t FREE_LOCATION = std::numeric_limits<uint32_t>::max();
+
+    // A zero duration would divide by zero in the ease functions, this makes it snap to the end on the first update.
+    constexpr float min_duration = 0.0001f;
+
+    uint32_t MakeTweenId(uint32_t index, uint32_t generation)
+    {
+        return (generation << INDEX_BITS) | index;
+    }
+
+    // The normalized progress with the ease function known at compile time, so it's inlined into the loop.
+    template <math::EaseFunction ease_function>
+    void EaseProgress(const float* time, const float* duration, float* progress, uint32_t count)
+    {
+        for(uint32_t index = 0; index < count; ++index)
+            progress[index] = ease_function(time[index], duration[index], 0.0f, 1.0f);
+    }
+
+    struct InlinedEase
+    {
+        math::EaseFunction ease_function;
+        void (*progress_function)(const float* time, const float* duration, float* progress, uint32_t count);
+    };
+
+    const InlinedEase inlined_eases[] = {
+        { math::LinearTween,    EaseProgress<math::LinearTween> },
+        { math::EaseInCubic,    EaseProgress<math::EaseInCubic> },
+        { math::EaseOutCubic,   EaseProgress<math::EaseOutCubic> },
+        { math::EaseInOutCubic, EaseProgress<math::EaseInOutCubic> },
+    };
+
+    template <typename T>
+    void SwapRemoveElement(std::vector<T>& data, uint32_t index)
+    {
+        data[index] = data.back();
+        data.pop_back();
+    }
+}
+
+TweenEngine::TweenEngine()
+    : m_active_tweens(0)
+{ }
+
+uint32_t TweenEngine::AddTween(
+    uint32_t target_id,
+    TweenType type,
+    math::EaseFunction ease_function,
+    float duration,
+    float start_x,
+    float start_y,
+    float delta_x,
+    float delta_y,
+    uint32_t user_data)
+{
+    uint32_t location_index;
+    if(m_free_locations.empty())
+    {
+        location_index = m_locations.size();
+        m_locations.push_back({ FREE_LOCATION, 0, 0 });
+    }
+    else
+    {
+        location_index = m_free_locations.back();
+        m_free_locations.pop_back();
+    }
+
+    const uint32_t group_index = FindOrCreateGroup(ease_function, type);
+    TweenGroup& group = m_groups[group_index];
+
+    TweenLocation& location = m_locations[location_index];
+    location.group = group_index;
+    location.index = group.tween_ids.size();
+
+    const uint32_t tween_id = MakeTweenId(location_index, location.generation);
+
+    group.tween_ids.push_back(tween_id);
+    group.target_ids.push_back(target_id);
+    group.user_data.push_back(user_data);
+    group.time.push_back(0.0f);
+    group.duration.push_back(std::max(duration, min_duration));
+    group.start_x.push_back(start_x);
+    group.start_y.push_back(start_y);
+    group.delta_x.push_back(delta_x);
+    group.delta_y.push_back(delta_y);
+    group.progress.push_back(0.0f);
+    group.value_x.push_back(start_x);
+    group.value_y.push_back(start_y);
+
+    m_active_tweens++;
+
+    return tween_id;
+}
+
+bool TweenEngine::RemoveTween(uint32_t tween_id)
+{
+    const uint32_t location_index = FindTween(tween_id);
+    if(location_index == FREE_LOCATION)
+        return false;
+
+    const TweenLocation& location = m_locations[location_index];
+    TweenGroup& group = m_groups[location.group];
+
+    // Keep the finished count right if it's removed between Update and RemoveFinished.
+    if(group.time[location.index] >= group.duration[location.index])
+        group.n_finished--;
+
+    SwapRemove(location.group, location.index);
+    return true;
+}
+
+bool TweenEngine::IsActive(uint32_t tween_id) const
+{
+    return FindTween(tween_id) != FREE_LOCATION;
+}
+
+uint32_t TweenEngine::ActiveTweens() const
+{
+    return m_active_tweens;
+}
+
+void TweenEngine::Update(float delta_s)
+{
+    for(TweenGroup& group : m_groups)
+    {
+        const uint32_t n_tweens = group.tween_ids.size();
+
+        float* time = group.time.data();
+        const float* duration = group.duration.data();
+        float* progress = group.progress.data();
+
+        uint32_t n_finished = 0;
+        for(uint32_t index = 0; index < n_tweens; ++index)
+        {
+            time[index] = std::min(time[index] + delta_s, duration[index]);
+            n_finished += (time[index] >= duration[index]);
+        }
+
+        group.n_finished = n_finished;
+
+        // One call per group for the normalized progress, everything after that is the same for all. Ease functions
+        // without an inlined loop fall back to one indirect call per tween.
+        if(group.progress_function)
+        {
+            group.progress_function(time, duration, progress, n_tweens);
+        }
+        else
+        {
+            const math::EaseFunction ease_function = group.ease_function;
+            for(uint32_t index = 0; index < n_tweens; ++index)
+                progress[index] = ease_function(time[index], duration[index], 0.0f, 1.0f);
+        }
+
+        const float* start_x = group.start_x.data();
+        const float* delta_x = group.delta_x.data();
+        float* value_x = group.value_x.data();
+        for(uint32_t index = 0; index < n_tweens; ++index)
+            value_x[index] = start_x[index] + delta_x[index] * progress[index];
+
+        if(group.type == TweenType::TRANSLATION)
+        {
+            const float* start_y = group.start_y.data();
+            const float* delta_y = group.delta_y.data();
+            float* value_y = group.value_y.data();
+            for(uint32_t index = 0; index < n_tweens; ++index)
+                value_y[index] = start_y[index] + delta_y[index] * progress[index];
+        }
+    }
+}
+
+const std::vector<FinishedTween>& TweenEngine::RemoveFinished()
+{
+    m_finished.clear();
+
+    for(uint32_t group_index = 0; group_index < m_groups.size(); ++group_index)
+    {
+        TweenGroup& group = m_groups[group_index];
+
+        // Walk backwards so the tween that is swapped in has already been checked.
+        for(uint32_t index = group.tween_ids.size(); index > 0 && group.n_finished > 0; --index)
+        {
+            const uint32_t tween_index = index - 1;
+            if(group.time[tween_index] < group.duration[tween_index])
+                continue;
+
+            m_finished.push_back({ group.tween_ids[tween_index], group.user_data[tween_index] });
+            SwapRemove(group_index, tween_index);
+            group.n_finished--;
+        }
+    }
+
+    return m_finished;
+}
+
+uint32_t TweenEngine::FindOrCreateGroup(math::EaseFunction ease_function, TweenType type)
+{
+    for(uint32_t index = 0; index < m_groups.size(); ++index)
+    {
+        const TweenGroup& group = m_groups[index];
+        if(group.ease_function == ease_function && group.type == type)
+            return index;
+    }
+
+    TweenGroup new_group;
+    new_group.ease_function = ease_function;
+    new_group.progress_function = nullptr;
+    new_group.type = type;
+    new_group.n_finished = 0;
+
+    for(const InlinedEase& inlined_ease : inlined_eases)
+    {
+        if(inlined_ease.ease_function == ease_function)
+            new_group.progress_function = inlined_ease.progress_function;
+    }
+
+    m_groups.push_back(std::move(new_group));
+
+    return m_groups.size() - 1;
+}
+
+uint32_t TweenEngine::FindTween(uint32_t tween_id) const
+{
+    const uint32_t location_index = tween_id & INDEX_MASK;
+    if(location_index >= m_locations.size())
+        return FREE_LOCATION;
+
+    const TweenLocation& location = m_locations[location_index];
+    if(location.group == FREE_LOCATION || location.generation != (tween_id >> INDEX_BITS))
+        return FREE_LOCATION;
+
+    return location_index;
+}
+
+void TweenEngine::SwapRemove(uint32_t group_index, uint32_t index)
+{
+    TweenGroup& group = m_groups[group_index];
+
+    const uint32_t removed_location = group.tween_ids[index] & INDEX_MASK;
+    const uint32_t moved_location = group.tween_ids.back() & INDEX_MASK;
+    m_locations[moved_location].index = index;
+
+    SwapRemoveElement(group.tween_ids, index);
+    SwapRemoveElement(group.target_ids, index);
+    SwapRemoveElement(group.user_data, index);
+    SwapRemoveElement(group.time, index);
+    SwapRemoveElement(group.duration, index);
+    SwapRemoveElement(group.start_x, index);
+    SwapRemoveElement(group.start_y, index);
+    SwapRemoveElement(group.delta_x, index);
+    SwapRemoveElement(group.delta_y, index);
+    SwapRemoveElement(group.progress, index);
+    SwapRemoveElement(group.value_x, index);
+    SwapRemoveElement(group.value_y, index);
+
+    TweenLocation& location = m_locations[removed_location];
+    location.group = FREE_LOCATION;
+    location.generation = (location.generation + 1) & GENERATION_MASK;
+    m_free_locations.push_back(removed_location);
+
+    m_active_tweens--;
+}
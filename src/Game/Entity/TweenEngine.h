@@ -0,0 +1,113 @@
+
+#pragma once
+
+#include "Math/EasingFunctions.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace game
+{
+    enum class TweenType
+    {
+        TRANSLATION,
+        ROTATION
+    };
+
+    struct FinishedTween
+    {
+        uint32_t tween_id;
+        uint32_t user_data;
+    };
+
+    // Active tweens packed in arrays, one set of arrays per easing function and tween type. The progress of a
+    // group is evaluated by a loop made for its ease function, with the ease function inlined, and the rest is
+    // plain loops over floats that the compiler can vectorize. Unknown ease functions are called once per tween.
+    // Finished tweens are swapped out, so adding and removing a tween is O(1).
+    class TweenEngine
+    {
+    public:
+
+        static constexpr uint32_t NO_TWEEN = uint32_t(-1);
+
+        TweenEngine();
+
+        // Rotations only use the x values. The user data is handed back when the tween finishes.
+        uint32_t AddTween(
+            uint32_t target_id,
+            TweenType type,
+            math::EaseFunction ease_function,
+            float duration,
+            float start_x,
+            float start_y,
+            float delta_x,
+            float delta_y,
+            uint32_t user_data);
+
+        // Returns false if the tween has already finished or been removed.
+        bool RemoveTween(uint32_t tween_id);
+        bool IsActive(uint32_t tween_id) const;
+        uint32_t ActiveTweens() const;
+
+        // Moves all tweens forward and evaluates them. Tweens that reach the end keep their final value
+        // until RemoveFinished.
+        void Update(float delta_s);
+
+        // Calls func(type, count, target_ids, values_x, values_y) for each group with tweens in it.
+        template <typename T>
+        inline void ForEachGroup(T&& func) const
+        {
+            for(const TweenGroup& group : m_groups)
+            {
+                if(!group.tween_ids.empty())
+                    func(group.type, uint32_t(group.tween_ids.size()), group.target_ids.data(), group.value_x.data(), group.value_y.data());
+            }
+        }
+
+        // Removes the tweens that finished in the last update, valid until the next call.
+        const std::vector<FinishedTween>& RemoveFinished();
+
+    private:
+
+        using ProgressFunction = void (*)(const float* time, const float* duration, float* progress, uint32_t count);
+
+        struct TweenGroup
+        {
+            math::EaseFunction ease_function;
+            ProgressFunction progress_function;
+            TweenType type;
+
+            std::vector<uint32_t> tween_ids;
+            std::vector<uint32_t> target_ids;
+            std::vector<uint32_t> user_data;
+            std::vector<float> time;
+            std::vector<float> duration;
+            std::vector<float> start_x;
+            std::vector<float> start_y;
+            std::vector<float> delta_x;
+            std::vector<float> delta_y;
+            std::vector<float> progress;
+            std::vector<float> value_x;
+            std::vector<float> value_y;
+            uint32_t n_finished;
+        };
+
+        struct TweenLocation
+        {
+            uint32_t group;
+            uint32_t index;
+            uint32_t generation;
+        };
+
+        uint32_t FindOrCreateGroup(math::EaseFunction ease_function, TweenType type);
+        uint32_t FindTween(uint32_t tween_id) const;
+        void SwapRemove(uint32_t group_index, uint32_t index);
+
+        std::vector<TweenGroup> m_groups;
+        std::vector<TweenLocation> m_locations;
+        std::vector<uint32_t> m_free_locations;
+        uint32_t m_active_tweens;
+
+        std::vector<FinishedTween> m_finished;
+    };
+}
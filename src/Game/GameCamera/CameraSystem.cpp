@@ -1,5 +1,6 @@
 
 #include "CameraSystem.h"
+#include "Component.h"
 #include "TriggerSystem/TriggerSystem.h"
 #include "Player/PlayerInfo.h"
 
@@ -35,8 +36,8 @@ CameraSystem::CameraSystem(
     , m_entity_id(NO_ENTITY)
     , m_camera_shake_timer_ms(0)
 {
-    m_camera_components.resize(n);
-    m_active_camera_components.resize(n, false);
+    m_camera_components.EnsureSize(n);
+    m_active_camera_components.resize(m_camera_components.Size(), false);
 
     const event::KeyDownEventFunc key_down_func = [this](const event::KeyDownEvent& event) {
         const bool toggle_camera = (event.key == Keycode::D);
@@ -67,7 +68,15 @@ const char* CameraSystem::Name() const
     return "camerasystem";
 }
 
-void CameraSystem::Update(const mono::UpdateContext& update_context)
+SystemAccess CameraSystem::Access() const
+{
+    SystemAccess access;
+    access.reads = { TRANSFORM_COMPONENT };
+    access.writes = { CAMERA_ZOOM_COMPONENT, CAMERA_POINT_COMPONENT, CAMERA_RESOURCE, PLAYERS_RESOURCE };
+    return access;
+}
+
+void CameraSystem::ScheduledUpdate(const mono::UpdateContext& update_context)
 {
     if(m_entity_id != NO_ENTITY)
     {
@@ -138,7 +147,10 @@ void CameraSystem::Unfollow()
 
 CameraAnimationComponent* CameraSystem::AllocateCameraAnimation(uint32_t entity_id)
 {
+    m_camera_components.EnsureSize(entity_id + 1);
+    m_active_camera_components.resize(m_camera_components.Size(), false);
     m_active_camera_components[entity_id] = true;
+
     CameraAnimationComponent* allocated_component = &m_camera_components[entity_id];
     std::memset(allocated_component, 0, sizeof(CameraAnimationComponent));
     return allocated_component;
@@ -7,7 +7,8 @@
 #include "EventHandler/EventToken.h"
 #include "Events/EventFwd.h"
 #include "Math/MathFwd.h"
-#include "IGameSystem.h"
+#include "Scheduler/ScheduledSystem.h"
+#include "ChunkedArray.h"
 
 #include <vector>
 
@@ -35,7 +36,7 @@ namespace game
         };
     };
 
-    class CameraSystem : public mono::IGameSystem
+    class CameraSystem : public ScheduledSystem
     {
     public:
 
@@ -49,7 +50,8 @@ namespace game
 
         uint32_t Id() const override;
         const char* Name() const override;
-        void Update(const mono::UpdateContext& update_context) override;
+        void ScheduledUpdate(const mono::UpdateContext& update_context) override;
+        SystemAccess Access() const override;
 
         void Follow(uint32_t entity_id, const math::Vector& offset);
         void Unfollow();
@@ -74,7 +76,7 @@ namespace game
 
         int m_camera_shake_timer_ms;
 
-        std::vector<CameraAnimationComponent> m_camera_components;
+        ChunkedArray<CameraAnimationComponent> m_camera_components;
         std::vector<bool> m_active_camera_components;
         std::vector<CameraAnimationComponent*> m_camera_anims_to_process;
 
@@ -19,6 +19,12 @@ bool game::LoadConfig(const char* config_file, game::Config& config)
     config.port_range_end               = json.value("port_range_end", config.port_range_end);
     config.server_replication_interval  = json.value("server_replication_interval", config.server_replication_interval);
     config.client_time_offset           = json.value("client_time_offset", config.client_time_offset);
+    config.simulation_tick_rate         = json.value("simulation_tick_rate", config.simulation_tick_rate);
+    config.max_entities                 = json.value("max_entities", config.max_entities);
+    config.asset_cache_directory        = json.value("asset_cache_directory", config.asset_cache_directory);
+    config.preload_entity_files         = json.value("preload_entity_files", config.preload_entity_files);
+    config.world_load_budget_ms         = json.value("world_load_budget_ms", config.world_load_budget_ms);
+    config.world_load_by_distance       = json.value("world_load_by_distance", config.world_load_by_distance);
 
     return true;
 }
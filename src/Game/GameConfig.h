@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <string>
+
 namespace game
 {
     struct Config
@@ -12,6 +14,12 @@ namespace game
         int port_range_end = 22000;
         int server_replication_interval = 100;
         int client_time_offset = 200;
+        int simulation_tick_rate = 60;
+        int max_entities = 500;
+        std::string asset_cache_directory = "res/cache/";
+        bool preload_entity_files = true;
+        float world_load_budget_ms = 4.0f;
+        bool world_load_by_distance = true;
     };
 
     bool LoadConfig(const char* config_file, Config& config);
@@ -31,6 +31,8 @@ bool game::g_draw_network_stats = false;
 bool game::g_draw_position_prediction = false;
 bool game::g_draw_debug_players = false;
 bool game::g_draw_spawn_points = false;
+bool game::g_draw_system_timings = false;
+bool game::g_single_threaded_systems = false;
 
 void DrawDebugMenu(uint32_t fps)
 {
@@ -55,6 +57,8 @@ void DrawDebugMenu(uint32_t fps)
         ImGui::Checkbox("Prediction System",    &game::g_draw_position_prediction);
         ImGui::Checkbox("Players",              &game::g_draw_debug_players);
         ImGui::Checkbox("Spawn Points",         &game::g_draw_spawn_points);
+        ImGui::Checkbox("System Timings",       &game::g_draw_system_timings);
+        ImGui::Checkbox("Single Threaded Systems", &game::g_single_threaded_systems);
 
         ImGui::EndMenu();
     }
@@ -25,6 +25,8 @@ namespace game
     extern bool g_draw_position_prediction;
     extern bool g_draw_debug_players;
     extern bool g_draw_spawn_points;
+    extern bool g_draw_system_timings;
+    extern bool g_single_threaded_systems;
 
     class TriggerSystem;
 
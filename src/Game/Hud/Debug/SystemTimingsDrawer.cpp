@@ -0,0 +1,50 @@
+
+#include "SystemTimingsDrawer.h"
+#include "Scheduler/SystemScheduler.h"
+
+#include "Math/Quad.h"
+#include "GameDebug.h"
+
+#include "imgui/imgui.h"
+
+using namespace game;
+
+SystemTimingsDrawer::SystemTimingsDrawer(const SystemScheduler* system_scheduler)
+    : m_system_scheduler(system_scheduler)
+{ }
+
+void SystemTimingsDrawer::Draw(mono::IRenderer& renderer) const
+{
+    if(!game::g_draw_system_timings)
+        return;
+
+    constexpr int flags =
+        ImGuiWindowFlags_AlwaysAutoResize |
+        ImGuiWindowFlags_NoResize;
+
+    ImGui::Begin("System Timings", &game::g_draw_system_timings, flags);
+    const char* worker_note = "";
+    if(game::g_single_threaded_systems)
+        worker_note = "(disabled)";
+    else if(!m_system_scheduler->HasParallelWork())
+        worker_note = "(no parallel work)";
+
+    ImGui::Text("worker threads: %u %s", m_system_scheduler->WorkerThreads(), worker_note);
+
+    float total_ms = 0.0f;
+
+    for(const SystemTiming& timing : m_system_scheduler->GetSystemTimings())
+    {
+        ImGui::Text("%-20s %6.3f ms  thread %u", timing.name, timing.time_ms, timing.thread_index);
+        total_ms += timing.time_ms;
+    }
+
+    ImGui::Separator();
+    ImGui::Text("%-20s %6.3f ms", "total", total_ms);
+    ImGui::End();
+}
+
+math::Quad SystemTimingsDrawer::BoundingBox() const
+{
+    return math::InfQuad;
+}
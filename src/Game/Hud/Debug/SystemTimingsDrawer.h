@@ -0,0 +1,19 @@
+
+#pragma once
+
+#include "MonoFwd.h"
+#include "Rendering/IDrawable.h"
+
+namespace game
+{
+    class SystemTimingsDrawer : public mono::IDrawable
+    {
+    public:
+
+        SystemTimingsDrawer(const class SystemScheduler* system_scheduler);
+        void Draw(mono::IRenderer& renderer) const override;
+        math::Quad BoundingBox() const override;
+
+        const class SystemScheduler* m_system_scheduler;
+    };
+}
@@ -107,7 +107,7 @@ void HealthbarDrawer::Draw(mono::IRenderer& renderer) const
     std::vector<Healthbar> healthbars;
     std::vector<Healthbar> boss_healthbars;
 
-    const auto collect_func = [&](uint32_t entity_id, DamageRecord& record) {
+    const auto collect_func = [&](uint32_t entity_id, int health, const DamageRecord& record) {
         const bool ignore_record = (record.last_damaged_timestamp == max_uint);
         if(ignore_record)
             return;
@@ -116,12 +116,12 @@ void HealthbarDrawer::Draw(mono::IRenderer& renderer) const
         if(delta > 5000)
             return;
 
-        if(record.health <= 0)
+        if(health <= 0)
             return;
 
         Healthbar bar;
         bar.last_damaged_timestamp = record.last_damaged_timestamp;
-        bar.health_percentage = float(record.health) / float(record.full_health);
+        bar.health_percentage = float(health) / float(record.full_health);
         bar.name = m_entity_system->GetEntityName(entity_id);
         
         if(record.is_boss)
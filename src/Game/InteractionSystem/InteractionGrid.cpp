@@ -0,0 +1,120 @@
+
+#include "InteractionGrid.h"
+#include "Math/MathFunctions.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace game;
+
+namespace
+{
+    uint64_t MakeCellKey(int x, int y)
+    {
+        return (uint64_t(uint32_t(x)) << 32) | uint64_t(uint32_t(y));
+    }
+}
+
+InteractionGrid::InteractionGrid(float cell_size)
+    : m_cell_size(cell_size)
+{ }
+
+void InteractionGrid::Insert(uint32_t id, const math::Quad& bounds)
+{
+    m_entries.EnsureSize(id + 1);
+    GridEntry& entry = m_entries[id];
+
+    const CellRange cells = CellsFromBounds(bounds);
+    const bool same_cells =
+        entry.inserted &&
+        entry.cells.min_x == cells.min_x && entry.cells.min_y == cells.min_y &&
+        entry.cells.max_x == cells.max_x && entry.cells.max_y == cells.max_y;
+
+    entry.bounds = bounds;
+    if(same_cells)
+        return;
+
+    Remove(id);
+
+    for(int y = cells.min_y; y <= cells.max_y; ++y)
+    {
+        for(int x = cells.min_x; x <= cells.max_x; ++x)
+            m_cells[MakeCellKey(x, y)].push_back(id);
+    }
+
+    entry.inserted = true;
+    entry.cells = cells;
+}
+
+void InteractionGrid::Remove(uint32_t id)
+{
+    if(!Contains(id))
+        return;
+
+    GridEntry& entry = m_entries[id];
+    const CellRange& cells = entry.cells;
+
+    for(int y = cells.min_y; y <= cells.max_y; ++y)
+    {
+        for(int x = cells.min_x; x <= cells.max_x; ++x)
+        {
+            const auto cell_it = m_cells.find(MakeCellKey(x, y));
+            if(cell_it == m_cells.end())
+                continue;
+
+            std::vector<uint32_t>& cell_ids = cell_it->second;
+            const auto it = std::find(cell_ids.begin(), cell_ids.end(), id);
+            if(it != cell_ids.end())
+            {
+                *it = cell_ids.back();
+                cell_ids.pop_back();
+            }
+
+            if(cell_ids.empty())
+                m_cells.erase(cell_it);
+        }
+    }
+
+    entry.inserted = false;
+}
+
+bool InteractionGrid::Contains(uint32_t id) const
+{
+    return id < m_entries.Size() && m_entries[id].inserted;
+}
+
+void InteractionGrid::Query(const math::Quad& bounds, std::vector<uint32_t>& out_ids) const
+{
+    const size_t first_index = out_ids.size();
+    const CellRange cells = CellsFromBounds(bounds);
+
+    for(int y = cells.min_y; y <= cells.max_y; ++y)
+    {
+        for(int x = cells.min_x; x <= cells.max_x; ++x)
+        {
+            const auto cell_it = m_cells.find(MakeCellKey(x, y));
+            if(cell_it == m_cells.end())
+                continue;
+
+            for(uint32_t id : cell_it->second)
+            {
+                if(math::QuadOverlaps(m_entries[id].bounds, bounds))
+                    out_ids.push_back(id);
+            }
+        }
+    }
+
+    // Bounds that span several cells are found once per cell.
+    std::sort(out_ids.begin() + first_index, out_ids.end());
+    out_ids.erase(std::unique(out_ids.begin() + first_index, out_ids.end()), out_ids.end());
+}
+
+InteractionGrid::CellRange InteractionGrid::CellsFromBounds(const math::Quad& bounds) const
+{
+    CellRange cells;
+    cells.min_x = int(std::floor(bounds.mA.x / m_cell_size));
+    cells.min_y = int(std::floor(bounds.mA.y / m_cell_size));
+    cells.max_x = int(std::floor(bounds.mB.x / m_cell_size));
+    cells.max_y = int(std::floor(bounds.mB.y / m_cell_size));
+    return cells;
+}
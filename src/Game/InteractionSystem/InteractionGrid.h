@@ -0,0 +1,52 @@
+
+#pragma once
+
+#include "ChunkedArray.h"
+#include "Math/Quad.h"
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+namespace game
+{
+    // Uniform grid over the bounds of the interactions, indexed by entity id. Only the cells that exist are
+    // stored, so the size of the level does not matter.
+    class InteractionGrid
+    {
+    public:
+
+        InteractionGrid(float cell_size);
+
+        // Inserts the id, or moves it if it's already in the grid.
+        void Insert(uint32_t id, const math::Quad& bounds);
+        void Remove(uint32_t id);
+        bool Contains(uint32_t id) const;
+
+        // Appends the ids with bounds overlapping the query bounds, sorted and without duplicates.
+        void Query(const math::Quad& bounds, std::vector<uint32_t>& out_ids) const;
+
+    private:
+
+        struct CellRange
+        {
+            int min_x;
+            int min_y;
+            int max_x;
+            int max_y;
+        };
+
+        struct GridEntry
+        {
+            bool inserted;
+            math::Quad bounds;
+            CellRange cells;
+        };
+
+        CellRange CellsFromBounds(const math::Quad& bounds) const;
+
+        const float m_cell_size;
+        ChunkedArray<GridEntry> m_entries;
+        std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells;
+    };
+}
@@ -1,5 +1,6 @@
 
 #include "InteractionSystem.h"
+#include "Component.h"
 #include "Player/PlayerInfo.h"
 #include "TriggerSystem/TriggerSystem.h"
 
@@ -7,31 +8,42 @@
 #include "TransformSystem/TransformSystem.h"
 #include "System/Hash.h"
 
+#include <algorithm>
+
 using namespace game;
 
 namespace
 {
     constexpr uint32_t NO_HASH = std::numeric_limits<uint32_t>::max();
+    constexpr float grid_cell_size = 4.0f;
+    constexpr float interaction_padding = 0.25f;
 }
 
 InteractionSystem::InteractionSystem(
-    uint32_t n, mono::TransformSystem* transform_system, game::TriggerSystem* trigger_system)
+    uint32_t n,
+    mono::TransformSystem* transform_system,
+    game::TriggerSystem* trigger_system)
     : m_transform_system(transform_system)
     , m_trigger_system(trigger_system)
+    , m_grid(grid_cell_size)
 {
-    m_components.resize(n);
-    m_active.resize(n, false);
+    m_components.EnsureSize(n);
+    m_grid_bounds.EnsureSize(n);
+    m_active = SparseSet(n);
 }
 
 InteractionComponent* InteractionSystem::AllocateComponent(uint32_t entity_id)
 {
-    m_active[entity_id] = true;
+    m_active.Add(entity_id);
+    m_components.EnsureSize(entity_id + 1);
+    m_grid_bounds.EnsureSize(entity_id + 1);
     return &m_components[entity_id];
 }
 
 void InteractionSystem::ReleaseComponent(uint32_t entity_id)
 {
-    m_active[entity_id] = false;
+    m_active.Remove(entity_id);
+    m_grid.Remove(entity_id);
 }
 
 void InteractionSystem::AddComponent(uint32_t entity_id, uint32_t interaction_hash, shared::InteractionType interaction_type)
@@ -58,61 +70,102 @@ const char* InteractionSystem::Name() const
     return "interactionsystem";
 }
 
-void InteractionSystem::Update(const mono::UpdateContext& update_context)
+SystemAccess InteractionSystem::Access() const
+{
+    SystemAccess access;
+    access.reads = { TRANSFORM_COMPONENT, PLAYERS_RESOURCE };
+    access.writes = { INTERACTION_COMPONENT, INTERACTION_SWITCH_COMPONENT, TRIGGERS_RESOURCE };
+    return access;
+}
+
+void InteractionSystem::ScheduledUpdate(const mono::UpdateContext& update_context)
 {
     m_interaction_data.active.clear();
     m_interaction_data.deactivated.clear();
 
+    UpdateGrid();
+
     const game::PlayerArray active_players = game::GetActivePlayers();
 
-    const auto collect_active_interactions = [&, this](uint32_t interaction_id, InteractionComponent& interaction) {
-        
-        math::Quad interaction_bb = m_transform_system->GetWorldBoundingBox(interaction_id);
-        math::ResizeQuad(interaction_bb, 0.25f);
+    for(const PlayerInfo* player_info : active_players)
+    {
+        if(!player_info)
+            continue;
 
-        for(const PlayerInfo* player_info : active_players)
+        const bool player_triggered =
+            std::find(m_player_triggers.begin(), m_player_triggers.end(), player_info->entity_id) != m_player_triggers.end();
+
+        const math::Quad player_bb = m_transform_system->GetWorldBoundingBox(player_info->entity_id);
+
+        m_nearby_interactions.clear();
+        m_grid.Query(player_bb, m_nearby_interactions);
+
+        for(uint32_t interaction_id : m_nearby_interactions)
         {
-            if(!player_info)
-                continue;
+            InteractionComponent& interaction = m_components[interaction_id];
+            m_interaction_data.active.push_back({ interaction_id, player_info->entity_id, interaction.type });
 
-            const math::Quad player_bb = m_transform_system->GetWorldBoundingBox(player_info->entity_id);
-            const bool overlaps = math::QuadOverlaps(interaction_bb, player_bb);
-            if(overlaps)
+            if(player_triggered)
             {
-                m_interaction_data.active.push_back({ interaction_id, player_info->entity_id, interaction.type });
-
-                const auto it = std::find(m_player_triggers.begin(), m_player_triggers.end(), player_info->entity_id);
-                if(it != m_player_triggers.end())
-                {
-                    const bool has_off_hash = (interaction.off_interaction_hash != NO_HASH);
-                    const uint32_t hash =
-                        (interaction.triggered && has_off_hash) ? interaction.off_interaction_hash : interaction.on_interaction_hash;
-                    m_trigger_system->EmitTrigger(hash);
-
-                    interaction.triggered = !interaction.triggered;
-                }
+                const bool has_off_hash = (interaction.off_interaction_hash != NO_HASH);
+                const uint32_t hash =
+                    (interaction.triggered && has_off_hash) ? interaction.off_interaction_hash : interaction.on_interaction_hash;
+                m_trigger_system->EmitTrigger(hash);
+
+                interaction.triggered = !interaction.triggered;
             }
         }
+    }
+
+    const auto sort_by_interaction = [](const InteractionAndTrigger& left, const InteractionAndTrigger& right) {
+        return (left.interaction_id != right.interaction_id) ?
+            left.interaction_id < right.interaction_id : left.trigger_id < right.trigger_id;
     };
+    std::sort(m_interaction_data.active.begin(), m_interaction_data.active.end(), sort_by_interaction);
 
-    ForEach(collect_active_interactions);
+    // Both lists are sorted by interaction id, an interaction is deactivated when no player is near it anymore.
+    auto active_it = m_interaction_data.active.begin();
 
-    const auto comp = [](const InteractionAndTrigger& left, const InteractionAndTrigger& right) {
-        return left.interaction_id < right.interaction_id;
-    };
+    for(const InteractionAndTrigger& previous : m_previous_active_interactions)
+    {
+        while(active_it != m_interaction_data.active.end() && active_it->interaction_id < previous.interaction_id)
+            ++active_it;
 
-    std::set_difference(
-        m_previous_active_interactions.begin(),
-        m_previous_active_interactions.end(),
-        m_interaction_data.active.begin(),
-        m_interaction_data.active.end(),
-        std::back_inserter(m_interaction_data.deactivated),
-        comp);
+        const bool still_active = (active_it != m_interaction_data.active.end() && active_it->interaction_id == previous.interaction_id);
+        const bool already_added =
+            (!m_interaction_data.deactivated.empty() && m_interaction_data.deactivated.back().interaction_id == previous.interaction_id);
+        if(!still_active && !already_added)
+            m_interaction_data.deactivated.push_back(previous);
+    }
 
     m_previous_active_interactions = m_interaction_data.active;
     m_player_triggers.clear();
 }
 
+void InteractionSystem::UpdateGrid()
+{
+    // Physics, entity logic, animations and parent transforms can all move an interaction.
+    for(uint32_t interaction_id : m_active)
+        UpdateGridBounds(interaction_id);
+}
+
+void InteractionSystem::UpdateGridBounds(uint32_t interaction_id)
+{
+    math::Quad interaction_bb = m_transform_system->GetWorldBoundingBox(interaction_id);
+    math::ResizeQuad(interaction_bb, interaction_padding);
+
+    // Rotating changes the bounds too, not only moving.
+    math::Quad& grid_bounds = m_grid_bounds[interaction_id];
+    const bool changed =
+        interaction_bb.mA.x != grid_bounds.mA.x || interaction_bb.mA.y != grid_bounds.mA.y ||
+        interaction_bb.mB.x != grid_bounds.mB.x || interaction_bb.mB.y != grid_bounds.mB.y;
+    if(!changed && m_grid.Contains(interaction_id))
+        return;
+
+    m_grid.Insert(interaction_id, interaction_bb);
+    grid_bounds = interaction_bb;
+}
+
 void InteractionSystem::TryTriggerInteraction(uint32_t entity_id)
 {
     m_player_triggers.push_back(entity_id);
@@ -2,8 +2,12 @@
 #pragma once
 
 #include "MonoFwd.h"
-#include "IGameSystem.h"
+#include "Scheduler/ScheduledSystem.h"
+#include "SparseSet.h"
+#include "ChunkedArray.h"
 #include "InteractionType.h"
+#include "InteractionGrid.h"
+#include "Math/Quad.h"
 #include <vector>
 
 namespace game
@@ -29,11 +33,14 @@ namespace game
         std::vector<InteractionAndTrigger> deactivated;
     };
 
-    class InteractionSystem : public mono::IGameSystem
+    class InteractionSystem : public ScheduledSystem
     {
     public:
 
-        InteractionSystem(uint32_t n, mono::TransformSystem* transform_system, class TriggerSystem* trigger_system);
+        InteractionSystem(
+            uint32_t n,
+            mono::TransformSystem* transform_system,
+            class TriggerSystem* trigger_system);
 
         InteractionComponent* AllocateComponent(uint32_t entity_id);
         void ReleaseComponent(uint32_t entity_id);
@@ -42,7 +49,8 @@ namespace game
 
         uint32_t Id() const override;
         const char* Name() const override;
-        void Update(const mono::UpdateContext& update_context) override;
+        void ScheduledUpdate(const mono::UpdateContext& update_context) override;
+        SystemAccess Access() const override;
 
         void TryTriggerInteraction(uint32_t entity_id);
 
@@ -51,21 +59,25 @@ namespace game
         template <typename T>
         inline void ForEach(T&& callable)
         {
-            for(uint32_t index = 0; index < m_active.size(); ++index)
-            {
-                const bool is_active = m_active[index];
-                if(is_active)
-                    callable(index, m_components[index]);
-            }
+            for(uint32_t index : m_active)
+                callable(index, m_components[index]);
         }
 
     private:
 
+        void UpdateGrid();
+        void UpdateGridBounds(uint32_t interaction_id);
+
         mono::TransformSystem* m_transform_system;
         game::TriggerSystem* m_trigger_system;
 
-        std::vector<InteractionComponent> m_components;
-        std::vector<bool> m_active;
+        ChunkedArray<InteractionComponent> m_components;
+        SparseSet m_active;
+
+        // The world bounds are checked every update, an interaction is only moved in the grid when they changed.
+        InteractionGrid m_grid;
+        ChunkedArray<math::Quad> m_grid_bounds;
+        std::vector<uint32_t> m_nearby_interactions;
 
         std::vector<InteractionAndTrigger> m_previous_active_interactions;
         FrameInteractionData m_interaction_data;
@@ -0,0 +1,341 @@
+
+#include "AssetClient.h"
+#include "ClientManager.h"
+#include "NetworkMessage.h"
+#include "NetworkSerialize.h"
+
+#include "EventHandler/EventHandler.h"
+#include "System/File.h"
+#include "System/Hash.h"
+#include "System/System.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+using namespace game;
+
+namespace
+{
+    constexpr uint32_t max_chunks_in_flight = 32;
+    constexpr uint32_t chunk_request_timeout_ms = 500;
+    constexpr uint32_t manifest_request_timeout_ms = 1000;
+
+    bool LocalFileMatches(const std::string& filename, uint32_t content_hash)
+    {
+        file::FilePtr file = file::OpenBinaryFile(filename.c_str());
+        if(!file)
+            return false;
+
+        const std::vector<byte> file_data = file::FileRead(file);
+        return HashAssetContent(file_data.data(), file_data.size()) == content_hash;
+    }
+}
+
+AssetClient::AssetClient(
+    const std::string& cache_directory,
+    mono::EventHandler* event_handler,
+    ClientManager* client_manager,
+    const SyncCompletedCallback& sync_completed)
+    : m_cache(cache_directory)
+    , m_event_handler(event_handler)
+    , m_client_manager(client_manager)
+    , m_sync_completed(sync_completed)
+    , m_manifest_resolved(false)
+    , m_synced(false)
+    , m_manifest_rejected(false)
+    , m_manifest_entries_received(0)
+    , m_last_manifest_timestamp(0)
+    , m_total_bytes(0)
+    , m_received_bytes(0)
+{
+    using namespace std::placeholders;
+    const std::function<mono::EventResult (const AssetManifestMessage&)> manifest_func = std::bind(&AssetClient::HandleManifest, this, _1);
+    const std::function<mono::EventResult (const AssetChunkMessage&)> chunk_func = std::bind(&AssetClient::HandleChunk, this, _1);
+
+    m_manifest_token = m_event_handler->AddListener(manifest_func);
+    m_chunk_token = m_event_handler->AddListener(chunk_func);
+}
+
+AssetClient::~AssetClient()
+{
+    m_event_handler->RemoveListener(m_manifest_token);
+    m_event_handler->RemoveListener(m_chunk_token);
+}
+
+bool AssetClient::IsSynced() const
+{
+    return m_synced;
+}
+
+bool AssetClient::IsRejected() const
+{
+    return m_manifest_rejected;
+}
+
+float AssetClient::Progress() const
+{
+    if(m_synced)
+        return 1.0f;
+
+    if(!m_manifest_resolved || m_total_bytes == 0)
+        return 0.0f;
+
+    return float(m_received_bytes) / float(m_total_bytes);
+}
+
+const char* AssetClient::ResolveAssetPath(uint32_t filename_hash) const
+{
+    const auto find_by_hash = [filename_hash](const ManifestEntry& entry) {
+        return entry.filename_hash == filename_hash;
+    };
+
+    const auto it = std::find_if(m_manifest.begin(), m_manifest.end(), find_by_hash);
+    if(it != m_manifest.end() && !it->resolved_path.empty())
+        return it->resolved_path.c_str();
+
+    return hash::HashLookup(filename_hash);
+}
+
+void AssetClient::Update(const mono::UpdateContext& update_context)
+{
+    if(m_synced || m_manifest_rejected || m_client_manager->GetConnectionStatus() != ClientStatus::CONNECTED)
+        return;
+
+    const uint32_t timestamp = System::GetMilliseconds();
+
+    if(!m_manifest_resolved)
+    {
+        // The server sends the manifest on connect, ask for it again if it, or parts of it, got lost.
+        if(m_last_manifest_timestamp == 0)
+            m_last_manifest_timestamp = timestamp;
+
+        const bool timed_out = (timestamp - m_last_manifest_timestamp) > manifest_request_timeout_ms;
+        if(timed_out)
+        {
+            SendRequest(0, 0);
+            m_last_manifest_timestamp = timestamp;
+        }
+
+        return;
+    }
+
+    RequestChunks(timestamp);
+}
+
+mono::EventResult AssetClient::HandleManifest(const AssetManifestMessage& message)
+{
+    if(m_manifest_resolved || m_manifest_rejected)
+        return mono::EventResult::HANDLED;
+
+    if(m_manifest.size() != message.n_entries)
+    {
+        m_manifest.clear();
+        m_manifest.resize(message.n_entries, { std::string(), 0, 0, 0, false, std::string() });
+        m_manifest_entries_received = 0;
+    }
+
+    m_last_manifest_timestamp = System::GetMilliseconds();
+
+    if(message.entry_index >= m_manifest.size())
+        return mono::EventResult::HANDLED;
+
+    ManifestEntry& entry = m_manifest[message.entry_index];
+    if(!entry.received)
+    {
+        const size_t filename_length = strnlen(message.filename, std::size(message.filename));
+        if(filename_length == std::size(message.filename) || message.content_size > AssetMaxContentSize)
+        {
+            RejectManifest(message.entry_index);
+            return mono::EventResult::HANDLED;
+        }
+
+        const std::string filename(message.filename, filename_length);
+
+        entry.filename = filename;
+        entry.filename_hash = hash::Hash(filename.c_str());
+        entry.content_hash = message.content_hash;
+        entry.content_size = message.content_size;
+        entry.received = true;
+
+        // Make sure files that the client did not know about can be looked up by hash.
+        hash::HashRegisterString(filename.c_str());
+
+        ++m_manifest_entries_received;
+    }
+
+    if(m_manifest_entries_received == m_manifest.size())
+        ResolveManifest();
+
+    return mono::EventResult::HANDLED;
+}
+
+mono::EventResult AssetClient::HandleChunk(const AssetChunkMessage& message)
+{
+    const auto find_by_hash = [&message](const PendingBlob& blob) {
+        return blob.content_hash == message.content_hash;
+    };
+
+    const auto it = std::find_if(m_pending_blobs.begin(), m_pending_blobs.end(), find_by_hash);
+    if(it == m_pending_blobs.end())
+        return mono::EventResult::HANDLED;
+
+    PendingBlob& blob = *it;
+    if(message.chunk_index >= blob.chunk_received.size() || blob.chunk_received[message.chunk_index])
+        return mono::EventResult::HANDLED;
+
+    const uint32_t chunk_offset = message.chunk_index * AssetChunkSize;
+    const uint32_t expected_size = std::min<uint32_t>(AssetChunkSize, blob.content.size() - chunk_offset);
+    if(message.chunk_size != expected_size)
+    {
+        System::Log("AssetClient|Chunk size missmatch for blob %u, chunk %u.", message.content_hash, message.chunk_index);
+        return mono::EventResult::HANDLED;
+    }
+
+    std::memcpy(blob.content.data() + chunk_offset, message.data, message.chunk_size);
+    blob.chunk_received[message.chunk_index] = true;
+    blob.received_chunks++;
+    m_received_bytes += message.chunk_size;
+
+    if(blob.received_chunks < blob.chunk_received.size())
+        return mono::EventResult::HANDLED;
+
+    const uint32_t content_hash = HashAssetContent(blob.content.data(), blob.content.size());
+    if(content_hash != blob.content_hash)
+    {
+        System::Log("AssetClient|Content hash missmatch for blob %u, fetching it again.", blob.content_hash);
+        m_received_bytes -= blob.content.size();
+        blob.received_chunks = 0;
+        std::fill(blob.chunk_received.begin(), blob.chunk_received.end(), false);
+        std::fill(blob.chunk_request_timestamps.begin(), blob.chunk_request_timestamps.end(), 0);
+        return mono::EventResult::HANDLED;
+    }
+
+    if(!m_cache.WriteBlob(blob.content_hash, blob.content))
+        System::Log("AssetClient|Unable to write blob %u to the cache.", blob.content_hash);
+
+    for(ManifestEntry& entry : m_manifest)
+    {
+        if(entry.content_hash == blob.content_hash)
+            entry.resolved_path = m_cache.BlobPath(blob.content_hash);
+    }
+
+    m_pending_blobs.erase(it);
+
+    if(m_pending_blobs.empty())
+    {
+        System::Log("AssetClient|Asset sync completed, fetched %u bytes.", m_received_bytes);
+        m_synced = true;
+        m_sync_completed();
+    }
+
+    return mono::EventResult::HANDLED;
+}
+
+void AssetClient::ResolveManifest()
+{
+    m_manifest_resolved = true;
+
+    for(ManifestEntry& entry : m_manifest)
+    {
+        if(LocalFileMatches(entry.filename, entry.content_hash))
+        {
+            entry.resolved_path = entry.filename;
+            continue;
+        }
+
+        if(m_cache.HasBlob(entry.content_hash))
+        {
+            entry.resolved_path = m_cache.BlobPath(entry.content_hash);
+            continue;
+        }
+
+        const auto find_by_hash = [&entry](const PendingBlob& blob) {
+            return blob.content_hash == entry.content_hash;
+        };
+        if(std::any_of(m_pending_blobs.begin(), m_pending_blobs.end(), find_by_hash))
+            continue;
+
+        if(m_total_bytes + entry.content_size > AssetMaxTotalContentSize)
+        {
+            RejectManifest(std::distance(m_manifest.data(), &entry));
+            return;
+        }
+
+        const uint32_t n_chunks = NumberOfAssetChunks(entry.content_size);
+
+        PendingBlob blob;
+        blob.content_hash = entry.content_hash;
+        blob.received_chunks = 0;
+        blob.content.resize(entry.content_size);
+        blob.chunk_request_timestamps.resize(n_chunks, 0);
+        blob.chunk_received.resize(n_chunks, false);
+        m_pending_blobs.push_back(std::move(blob));
+
+        m_total_bytes += entry.content_size;
+    }
+
+    System::Log("AssetClient|%zu of %zu assets needs to be fetched.", m_pending_blobs.size(), m_manifest.size());
+
+    if(m_pending_blobs.empty())
+    {
+        m_synced = true;
+        m_sync_completed();
+    }
+}
+
+void AssetClient::RejectManifest(uint32_t entry_index)
+{
+    System::Log("AssetClient|Rejecting the asset manifest, entry %u is malformed or too large.", entry_index);
+
+    m_manifest_resolved = false;
+    m_manifest_rejected = true;
+    m_total_bytes = 0;
+    m_manifest.clear();
+    m_pending_blobs.clear();
+}
+
+void AssetClient::RequestChunks(uint32_t timestamp)
+{
+    uint32_t chunks_in_flight = 0;
+
+    for(const PendingBlob& blob : m_pending_blobs)
+    {
+        for(size_t index = 0; index < blob.chunk_received.size(); ++index)
+        {
+            const uint32_t request_timestamp = blob.chunk_request_timestamps[index];
+            if(!blob.chunk_received[index] && request_timestamp != 0 && (timestamp - request_timestamp) < chunk_request_timeout_ms)
+                chunks_in_flight++;
+        }
+    }
+
+    for(PendingBlob& blob : m_pending_blobs)
+    {
+        for(size_t index = 0; index < blob.chunk_received.size() && chunks_in_flight < max_chunks_in_flight; ++index)
+        {
+            if(blob.chunk_received[index])
+                continue;
+
+            uint32_t& request_timestamp = blob.chunk_request_timestamps[index];
+            const bool in_flight = (request_timestamp != 0 && (timestamp - request_timestamp) < chunk_request_timeout_ms);
+            if(in_flight)
+                continue;
+
+            SendRequest(blob.content_hash, index);
+            request_timestamp = timestamp;
+            chunks_in_flight++;
+        }
+    }
+}
+
+void AssetClient::SendRequest(uint32_t content_hash, uint32_t chunk_index)
+{
+    AssetRequestMessage request_message;
+    request_message.sender = m_client_manager->GetClientAddress();
+    request_message.content_hash = content_hash;
+    request_message.chunk_index = chunk_index;
+
+    NetworkMessage message;
+    message.payload = SerializeMessage(request_message);
+    m_client_manager->SendMessage(std::move(message));
+}
@@ -0,0 +1,95 @@
+
+#pragma once
+
+#include "MonoFwd.h"
+#include "IUpdatable.h"
+#include "EventHandler/EventToken.h"
+#include "AssetTransfer.h"
+
+#include <vector>
+#include <string>
+#include <functional>
+
+namespace game
+{
+    class ClientManager;
+    struct AssetManifestMessage;
+    struct AssetChunkMessage;
+
+    // Receives the servers asset manifest, checks the local files and the cache for each blob and
+    // fetches only the missing ones in chunks. Completed blobs are verified and written to the cache.
+    class AssetClient : public mono::IUpdatable
+    {
+    public:
+
+        using SyncCompletedCallback = std::function<void ()>;
+
+        AssetClient(
+            const std::string& cache_directory,
+            mono::EventHandler* event_handler,
+            ClientManager* client_manager,
+            const SyncCompletedCallback& sync_completed);
+        ~AssetClient();
+
+        bool IsSynced() const;
+
+        // True if the server sent a manifest with a blob, or in total, larger than the client accepts.
+        // A rejected manifest is never fetched.
+        bool IsRejected() const;
+        float Progress() const;
+
+        // Returns the path to load the file with filename hash from, either the local file if it
+        // matches the servers content or the blob in the cache. Falls back to the registered filename.
+        const char* ResolveAssetPath(uint32_t filename_hash) const;
+
+    private:
+
+        void Update(const mono::UpdateContext& update_context) override;
+
+        mono::EventResult HandleManifest(const AssetManifestMessage& message);
+        mono::EventResult HandleChunk(const AssetChunkMessage& message);
+
+        void ResolveManifest();
+        void RejectManifest(uint32_t entry_index);
+        void RequestChunks(uint32_t timestamp);
+        void SendRequest(uint32_t content_hash, uint32_t chunk_index);
+
+        struct ManifestEntry
+        {
+            std::string filename;
+            uint32_t filename_hash;
+            uint32_t content_hash;
+            uint32_t content_size;
+            bool received;
+            std::string resolved_path;
+        };
+
+        struct PendingBlob
+        {
+            uint32_t content_hash;
+            uint32_t received_chunks;
+            std::vector<byte> content;
+            std::vector<uint32_t> chunk_request_timestamps;
+            std::vector<bool> chunk_received;
+        };
+
+        AssetCache m_cache;
+        mono::EventHandler* m_event_handler;
+        ClientManager* m_client_manager;
+        SyncCompletedCallback m_sync_completed;
+
+        bool m_manifest_resolved;
+        bool m_synced;
+        bool m_manifest_rejected;
+        uint32_t m_manifest_entries_received;
+        uint32_t m_last_manifest_timestamp;
+        uint32_t m_total_bytes;
+        uint32_t m_received_bytes;
+
+        std::vector<ManifestEntry> m_manifest;
+        std::vector<PendingBlob> m_pending_blobs;
+
+        mono::EventToken<AssetManifestMessage> m_manifest_token;
+        mono::EventToken<AssetChunkMessage> m_chunk_token;
+    };
+}
@@ -0,0 +1,96 @@
+
+#include "AssetServer.h"
+#include "ServerManager.h"
+#include "NetworkMessage.h"
+#include "BatchedMessageSender.h"
+
+#include "EventHandler/EventHandler.h"
+#include "Events/PlayerConnectedEvent.h"
+#include "System/System.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace game;
+
+AssetServer::AssetServer(const char* world_file, mono::EventHandler* event_handler, ServerManager* server_manager)
+    : m_event_handler(event_handler)
+    , m_server_manager(server_manager)
+{
+    m_assets = CollectWorldAssets(world_file);
+    System::Log("AssetServer|Advertising %zu assets for world '%s'.", m_assets.size(), world_file);
+
+    using namespace std::placeholders;
+    const std::function<mono::EventResult (const PlayerConnectedEvent&)> connected_func = std::bind(&AssetServer::HandlePlayerConnected, this, _1);
+    const std::function<mono::EventResult (const AssetRequestMessage&)> request_func = std::bind(&AssetServer::HandleAssetRequest, this, _1);
+
+    m_connected_token = m_event_handler->AddListener(connected_func);
+    m_request_token = m_event_handler->AddListener(request_func);
+}
+
+AssetServer::~AssetServer()
+{
+    m_event_handler->RemoveListener(m_connected_token);
+    m_event_handler->RemoveListener(m_request_token);
+}
+
+mono::EventResult AssetServer::HandlePlayerConnected(const PlayerConnectedEvent& event)
+{
+    SendManifest(event.address);
+    return mono::EventResult::PASS_ON;
+}
+
+mono::EventResult AssetServer::HandleAssetRequest(const AssetRequestMessage& message)
+{
+    if(message.content_hash == 0)
+    {
+        SendManifest(message.sender);
+        return mono::EventResult::HANDLED;
+    }
+
+    const auto find_by_hash = [&message](const AssetEntry& entry) {
+        return entry.content_hash == message.content_hash;
+    };
+
+    const auto it = std::find_if(m_assets.begin(), m_assets.end(), find_by_hash);
+    if(it == m_assets.end())
+    {
+        System::Log("AssetServer|Client requested unknown blob %u.", message.content_hash);
+        return mono::EventResult::HANDLED;
+    }
+
+    AssetChunkMessage chunk_message;
+    if(!MakeAssetChunkMessage(*it, message.chunk_index, chunk_message))
+        return mono::EventResult::HANDLED;
+
+    NetworkMessage network_message;
+    network_message.payload = SerializeMessage(chunk_message);
+    m_server_manager->SendMessageTo(std::move(network_message), message.sender);
+
+    return mono::EventResult::HANDLED;
+}
+
+void AssetServer::SendManifest(const network::Address& address)
+{
+    std::vector<NetworkMessage> messages;
+
+    {
+        BatchedMessageSender batch_sender(address, messages);
+
+        for(size_t index = 0; index < m_assets.size(); ++index)
+        {
+            const AssetEntry& entry = m_assets[index];
+
+            // CollectWorldAssets leaves out files with names that does not fit.
+            AssetManifestMessage manifest_message;
+            const bool fits_in_message = MakeAssetManifestMessage(entry, index, m_assets.size(), manifest_message);
+            assert(fits_in_message);
+            (void)fits_in_message;
+
+            batch_sender.SendMessage(manifest_message);
+        }
+    }
+
+    for(NetworkMessage& message : messages)
+        m_server_manager->SendMessage(std::move(message));
+}
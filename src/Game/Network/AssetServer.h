@@ -0,0 +1,43 @@
+
+#pragma once
+
+#include "MonoFwd.h"
+#include "EventHandler/EventToken.h"
+#include "AssetTransfer.h"
+
+#include <vector>
+
+namespace network
+{
+    struct Address;
+}
+
+namespace game
+{
+    class ServerManager;
+    struct PlayerConnectedEvent;
+    struct AssetRequestMessage;
+
+    // Advertises content hashes for the world file and the assets it references to connecting clients,
+    // and serves the chunks of any blob a client is missing.
+    class AssetServer
+    {
+    public:
+
+        AssetServer(const char* world_file, mono::EventHandler* event_handler, ServerManager* server_manager);
+        ~AssetServer();
+
+    private:
+
+        mono::EventResult HandlePlayerConnected(const PlayerConnectedEvent& event);
+        mono::EventResult HandleAssetRequest(const AssetRequestMessage& message);
+        void SendManifest(const network::Address& address);
+
+        mono::EventHandler* m_event_handler;
+        ServerManager* m_server_manager;
+        std::vector<AssetEntry> m_assets;
+
+        mono::EventToken<PlayerConnectedEvent> m_connected_token;
+        mono::EventToken<AssetRequestMessage> m_request_token;
+    };
+}
@@ -0,0 +1,212 @@
+
+#include "AssetTransfer.h"
+#include "NetworkMessage.h"
+#include "System/File.h"
+#include "System/System.h"
+
+#include "nlohmann/json.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+static_assert(game::AssetChunkSize == sizeof(game::AssetChunkMessage::data));
+static_assert(game::AssetMaxFilenameLength == sizeof(game::AssetManifestMessage::filename));
+
+namespace
+{
+    bool HasExtension(const std::string& text, const char* extension)
+    {
+        return std::filesystem::path(text).extension() == extension;
+    }
+
+    // Resource attributes are either full paths or, for sprite and entity files, a bare filename that
+    // the component functions resolves relative to its resource folder.
+    bool ResolveResourcePath(const std::string& text, std::string& out_path)
+    {
+        if(text.compare(0, 4, "res/") == 0 && text.find('.') != std::string::npos)
+            out_path = text;
+        else if(HasExtension(text, ".sprite"))
+            out_path = "res/sprites/" + text;
+        else if(HasExtension(text, ".entity"))
+            out_path = "res/entities/" + text;
+        else
+            return false;
+
+        return true;
+    }
+
+    bool IsJsonAsset(const std::string& filename)
+    {
+        return
+            HasExtension(filename, ".entity") ||
+            HasExtension(filename, ".sprite") ||
+            HasExtension(filename, ".components") ||
+            HasExtension(filename, ".json");
+    }
+
+    void CollectResourcePaths(const nlohmann::json& json, std::vector<std::string>& out_paths)
+    {
+        if(json.is_string())
+        {
+            std::string resource_path;
+            if(ResolveResourcePath(json.get_ref<const std::string&>(), resource_path))
+                out_paths.push_back(resource_path);
+        }
+        else if(json.is_structured())
+        {
+            for(const nlohmann::json& child : json)
+                CollectResourcePaths(child, out_paths);
+        }
+    }
+
+    bool ReadAsset(const std::string& filename, game::AssetEntry& out_entry)
+    {
+        file::FilePtr file = file::OpenBinaryFile(filename.c_str());
+        if(!file)
+            return false;
+
+        out_entry.filename = filename;
+        out_entry.content = file::FileRead(file);
+        out_entry.content_hash = game::HashAssetContent(out_entry.content.data(), out_entry.content.size());
+        return true;
+    }
+}
+
+uint32_t game::HashAssetContent(const byte* data, size_t size)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for(size_t index = 0; index < size; ++index)
+    {
+        hash ^= data[index];
+        hash *= 16777619u;
+    }
+
+    // Zero is reserved for "no content"
+    return (hash != 0) ? hash : 1;
+}
+
+uint32_t game::NumberOfAssetChunks(uint32_t content_size)
+{
+    return std::max(1u, (content_size + AssetChunkSize - 1) / AssetChunkSize);
+}
+
+bool game::MakeAssetManifestMessage(
+    const AssetEntry& entry, uint32_t entry_index, uint32_t n_entries, AssetManifestMessage& out_message)
+{
+    // Room for the terminating null.
+    if(entry.filename.size() >= AssetMaxFilenameLength)
+        return false;
+
+    out_message.entry_index = entry_index;
+    out_message.n_entries = n_entries;
+    out_message.content_hash = entry.content_hash;
+    out_message.content_size = entry.content.size();
+    std::memset(out_message.filename, 0, std::size(out_message.filename));
+    std::memcpy(out_message.filename, entry.filename.data(), entry.filename.size());
+
+    return true;
+}
+
+bool game::MakeAssetChunkMessage(const AssetEntry& entry, uint32_t chunk_index, AssetChunkMessage& out_message)
+{
+    if(chunk_index >= NumberOfAssetChunks(entry.content.size()))
+        return false;
+
+    const uint32_t chunk_offset = chunk_index * AssetChunkSize;
+
+    out_message.content_hash = entry.content_hash;
+    out_message.chunk_index = chunk_index;
+    out_message.chunk_size = std::min<uint32_t>(AssetChunkSize, entry.content.size() - chunk_offset);
+    std::memcpy(out_message.data, entry.content.data() + chunk_offset, out_message.chunk_size);
+
+    return true;
+}
+
+std::vector<game::AssetEntry> game::CollectWorldAssets(const char* world_file)
+{
+    std::vector<AssetEntry> assets;
+    std::vector<std::string> files_to_visit = { world_file };
+
+    while(!files_to_visit.empty())
+    {
+        const std::string filename = files_to_visit.back();
+        files_to_visit.pop_back();
+
+        const auto same_filename = [&filename](const AssetEntry& entry) {
+            return entry.filename == filename;
+        };
+        if(std::any_of(assets.begin(), assets.end(), same_filename))
+            continue;
+
+        AssetEntry entry;
+        if(!ReadAsset(filename, entry))
+        {
+            System::Log("AssetTransfer|Unable to read referenced asset '%s'.", filename.c_str());
+            continue;
+        }
+
+        if(entry.filename.size() >= AssetMaxFilenameLength || entry.content.size() > AssetMaxContentSize)
+        {
+            System::Log("AssetTransfer|Asset '%s' is too large to transfer, skipping it.", filename.c_str());
+            continue;
+        }
+
+        if(IsJsonAsset(filename))
+        {
+            const nlohmann::json& json = nlohmann::json::parse(entry.content, nullptr, false);
+            if(!json.is_discarded())
+                CollectResourcePaths(json, files_to_visit);
+        }
+
+        assets.push_back(std::move(entry));
+    }
+
+    return assets;
+}
+
+game::AssetCache::AssetCache(const std::string& cache_directory)
+    : m_cache_directory(cache_directory)
+{
+    std::error_code error;
+    std::filesystem::create_directories(m_cache_directory, error);
+    if(error)
+        System::Log("AssetCache|Unable to create cache directory '%s'.", m_cache_directory.c_str());
+}
+
+bool game::AssetCache::HasBlob(uint32_t content_hash) const
+{
+    std::error_code error;
+    return std::filesystem::exists(BlobPath(content_hash), error);
+}
+
+bool game::AssetCache::WriteBlob(uint32_t content_hash, const std::vector<byte>& content)
+{
+    // Write to a temporary file first so that an interrupted write never leaves a corrupt blob behind.
+    const std::string blob_path = BlobPath(content_hash);
+    const std::string temp_path = blob_path + ".tmp";
+
+    {
+        file::FilePtr file = file::CreateBinaryFile(temp_path.c_str());
+        if(!file)
+            return false;
+
+        const size_t written = std::fwrite(content.data(), sizeof(byte), content.size(), file.get());
+        if(written != content.size())
+            return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temp_path, blob_path, error);
+    return !error;
+}
+
+std::string game::AssetCache::BlobPath(uint32_t content_hash) const
+{
+    char blob_name[32] = { 0 };
+    std::snprintf(blob_name, sizeof(blob_name), "%08x.blob", content_hash);
+    return (std::filesystem::path(m_cache_directory) / blob_name).string();
+}
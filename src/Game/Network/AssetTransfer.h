@@ -0,0 +1,58 @@
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+using byte = uint8_t;
+
+namespace game
+{
+    constexpr uint32_t AssetChunkSize = 512;
+    constexpr uint32_t AssetMaxFilenameLength = 64;
+
+    // Sizes in the manifest come from the network, anything above these is rejected before allocating.
+    constexpr uint32_t AssetMaxContentSize = 32 * 1024 * 1024;
+    constexpr uint32_t AssetMaxTotalContentSize = 256 * 1024 * 1024;
+
+    struct AssetManifestMessage;
+    struct AssetChunkMessage;
+
+    struct AssetEntry
+    {
+        std::string filename;
+        uint32_t content_hash;
+        std::vector<byte> content;
+    };
+
+    uint32_t HashAssetContent(const byte* data, size_t size);
+    uint32_t NumberOfAssetChunks(uint32_t content_size);
+
+    // Returns false if the filename does not fit in the message.
+    bool MakeAssetManifestMessage(
+        const AssetEntry& entry, uint32_t entry_index, uint32_t n_entries, AssetManifestMessage& out_message);
+
+    // Returns false if the chunk index is past the end of the content.
+    bool MakeAssetChunkMessage(const AssetEntry& entry, uint32_t chunk_index, AssetChunkMessage& out_message);
+
+    // Collects the world file and every file under res/ that it references, directly or through the
+    // referenced entity and sprite files. The world file is always the first entry. Files with a name or
+    // content too large to transfer are left out.
+    std::vector<AssetEntry> CollectWorldAssets(const char* world_file);
+
+    // Content addressed blob storage on the client, persisted between sessions.
+    class AssetCache
+    {
+    public:
+
+        AssetCache(const std::string& cache_directory);
+
+        bool HasBlob(uint32_t content_hash) const;
+        bool WriteBlob(uint32_t content_hash, const std::vector<byte>& content);
+        std::string BlobPath(uint32_t content_hash) const;
+
+    private:
+        const std::string m_cache_directory;
+    };
+}
@@ -2,27 +2,28 @@
 #pragma once
 
 #include "NetworkSerialize.h"
-#include <queue>
+#include <vector>
 
 namespace game
 {
-    struct NetworkMessage;
-
     class BatchedMessageSender
     {
     public:
 
-        BatchedMessageSender(const network::Address& address, std::queue<NetworkMessage>& out_messages)
-            : m_out_messages(out_messages)
+        BatchedMessageSender(const network::Address& address, std::vector<NetworkMessage>& out_messages)
+            : m_address(address)
+            , m_out_messages(out_messages)
         {
-            PrepareMessageBuffer(m_network_message.payload);
-            m_network_message.address = address;
+            PrepareNewMessage();
         }
 
         ~BatchedMessageSender()
         {
-            if(!m_network_message.payload.empty())
-                m_out_messages.push(m_network_message);
+            const NetworkMessageHeader header = GetMessageBufferHeader(m_network_message.payload);
+            if(header.n_messages > 0)
+                m_out_messages.push_back(std::move(m_network_message));
+            else
+                ReleaseMessageBuffer(std::move(m_network_message.payload));
         }
 
         template <typename T>
@@ -31,17 +32,24 @@ namespace game
             const bool success = SerializeMessageToBuffer(message, m_network_message.payload);
             if(!success)
             {
-                m_out_messages.push(m_network_message);
+                m_out_messages.push_back(std::move(m_network_message));
 
-                m_network_message.payload.clear();
-                PrepareMessageBuffer(m_network_message.payload);
+                PrepareNewMessage();
                 SerializeMessageToBuffer(message, m_network_message.payload);
             }
         }
 
     private:
 
-        std::queue<NetworkMessage>& m_out_messages;
+        void PrepareNewMessage()
+        {
+            m_network_message.address = m_address;
+            m_network_message.payload = AcquireMessageBuffer();
+            PrepareMessageBuffer(m_network_message.payload);
+        }
+
+        const network::Address m_address;
+        std::vector<NetworkMessage>& m_out_messages;
         NetworkMessage m_network_message;
     };
 }
@@ -61,7 +61,7 @@ void ClientManager::Disconnect()
     {
         NetworkMessage message;
         message.payload = SerializeMessage(DisconnectMessage());
-        SendMessage(message);
+        SendMessage(std::move(message));
     }
 
     m_states.TransitionTo(ClientStatus::DISCONNECTED);
@@ -102,14 +102,14 @@ uint32_t ClientManager::GetServerTimePredicted() const
     return m_server_time_predicted - m_game_config->client_time_offset;
 }
 
-void ClientManager::SendMessage(const NetworkMessage& message)
+void ClientManager::SendMessage(NetworkMessage&& message)
 {
-    m_remote_connection->SendData(message.payload, m_server_address);
+    m_remote_connection->SendData(std::move(message.payload), m_server_address);
 }
 
-void ClientManager::SendMessageTo(const NetworkMessage& message, const network::Address& address)
+void ClientManager::SendMessageTo(NetworkMessage&& message, const network::Address& address)
 {
-    m_remote_connection->SendData(message.payload, address);
+    m_remote_connection->SendData(std::move(message.payload), address);
 }
 
 ConnectionInfo ClientManager::GetConnectionInfo() const
@@ -213,7 +213,7 @@ void ClientManager::ToFoundServer()
 
     NetworkMessage message;
     message.payload = SerializeMessage(ConnectMessage());
-    SendMessage(message);
+    SendMessage(std::move(message));
 }
 
 void ClientManager::ToConnected()
@@ -247,7 +247,7 @@ void ClientManager::Connected(const mono::UpdateContext& update_context)
     {
         NetworkMessage message;
         message.payload = SerializeMessage(HeartBeatMessage());
-        SendMessage(message);
+        SendMessage(std::move(message));
     }
 
     const bool is_fifth_frame = (update_context.frame_count % 15) == 0;
@@ -259,7 +259,7 @@ void ClientManager::Connected(const mono::UpdateContext& update_context)
 
         NetworkMessage message;
         message.payload = SerializeMessage(ping_message);
-        SendMessage(message);
+        SendMessage(std::move(message));
     }
 }
 
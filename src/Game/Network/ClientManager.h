@@ -33,8 +33,8 @@ namespace game
         void StartClient();
         void Disconnect();
 
-        void SendMessage(const struct NetworkMessage& message) override;
-        void SendMessageTo(const NetworkMessage& message, const network::Address& address) override;
+        void SendMessage(struct NetworkMessage&& message) override;
+        void SendMessageTo(NetworkMessage&& message, const network::Address& address) override;
         ConnectionInfo GetConnectionInfo() const override;
 
         ClientStatus GetConnectionStatus() const;
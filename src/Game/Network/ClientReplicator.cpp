@@ -26,7 +26,7 @@ void ClientReplicator::Update(const mono::UpdateContext& update_context)
 
     NetworkMessage message;
     message.payload = SerializeMessage(remote_input);
-    m_remote_connection->SendMessage(message);
+    m_remote_connection->SendMessage(std::move(message));
 
     m_replicate_timer += update_context.delta_ms;
     if(m_replicate_timer > 16)
@@ -37,7 +37,7 @@ void ClientReplicator::Update(const mono::UpdateContext& update_context)
 
         NetworkMessage message;
         message.payload = SerializeMessage(camera_message);
-        m_remote_connection->SendMessage(message);
+        m_remote_connection->SendMessage(std::move(message));
 
         const math::Quad& viewport = m_camera->GetViewport();
 
@@ -47,7 +47,7 @@ void ClientReplicator::Update(const mono::UpdateContext& update_context)
 
         NetworkMessage message2;
         message2.payload = SerializeMessage(viewport_message);
-        m_remote_connection->SendMessage(message2);
+        m_remote_connection->SendMessage(std::move(message2));
 
         m_replicate_timer = 0;
     }
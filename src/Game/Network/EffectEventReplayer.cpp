@@ -0,0 +1,48 @@
+
+#include "EffectEventReplayer.h"
+#include "ClientManager.h"
+#include "NetworkMessage.h"
+
+#include "EventHandler/EventHandler.h"
+
+#include <algorithm>
+#include <iterator>
+
+using namespace game;
+
+EffectEventReplayer::EffectEventReplayer(mono::EventHandler* event_handler, const ClientManager* client_manager)
+    : m_event_handler(event_handler)
+    , m_client_manager(client_manager)
+{
+    using namespace std::placeholders;
+    const std::function<mono::EventResult (const EffectEventsMessage&)> effect_events_func
+        = std::bind(&EffectEventReplayer::HandleEffectEvents, this, _1);
+    m_effect_events_token = m_event_handler->AddListener(effect_events_func);
+}
+
+EffectEventReplayer::~EffectEventReplayer()
+{
+    m_event_handler->RemoveListener(m_effect_events_token);
+}
+
+void EffectEventReplayer::Update(const mono::UpdateContext& update_context)
+{
+    const uint32_t server_time = m_client_manager->GetServerTimePredicted();
+
+    const auto play_if_due = [server_time](const EffectEvent& effect_event) {
+        const bool is_due = (int32_t(server_time - effect_event.timestamp) >= 0);
+        if(is_due)
+            PlayEffectEvent(effect_event);
+        return is_due;
+    };
+
+    const auto it = std::remove_if(m_pending_events.begin(), m_pending_events.end(), play_if_due);
+    m_pending_events.erase(it, m_pending_events.end());
+}
+
+mono::EventResult EffectEventReplayer::HandleEffectEvents(const EffectEventsMessage& message)
+{
+    const uint32_t n_events = std::min<uint32_t>(message.n_events, std::size(message.events));
+    m_pending_events.insert(m_pending_events.end(), message.events, message.events + n_events);
+    return mono::EventResult::HANDLED;
+}
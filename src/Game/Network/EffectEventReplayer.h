@@ -0,0 +1,36 @@
+
+#pragma once
+
+#include "MonoFwd.h"
+#include "IUpdatable.h"
+#include "EventHandler/EventToken.h"
+#include "Effects/EffectEvents.h"
+
+#include <vector>
+
+namespace game
+{
+    class ClientManager;
+    struct EffectEventsMessage;
+
+    // Queues replicated effect events and plays them locally once the predicted server time reaches
+    // the event, so that they line up with the interpolated transforms.
+    class EffectEventReplayer : public mono::IUpdatable
+    {
+    public:
+
+        EffectEventReplayer(mono::EventHandler* event_handler, const ClientManager* client_manager);
+        ~EffectEventReplayer();
+
+        void Update(const mono::UpdateContext& update_context) override;
+
+    private:
+
+        mono::EventResult HandleEffectEvents(const EffectEventsMessage& message);
+
+        mono::EventHandler* m_event_handler;
+        const ClientManager* m_client_manager;
+        std::vector<EffectEvent> m_pending_events;
+        mono::EventToken<EffectEventsMessage> m_effect_events_token;
+    };
+}
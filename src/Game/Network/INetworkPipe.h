@@ -25,8 +25,8 @@ namespace game
     public:
 
         virtual ~INetworkPipe() = default;
-        virtual void SendMessage(const NetworkMessage& message) = 0;
-        virtual void SendMessageTo(const NetworkMessage& message, const network::Address& address) = 0;
+        virtual void SendMessage(NetworkMessage&& message) = 0;
+        virtual void SendMessageTo(NetworkMessage&& message, const network::Address& address) = 0;
         virtual ConnectionInfo GetConnectionInfo() const = 0;
     };
 }
@@ -0,0 +1,216 @@
+
+#include "JoinSnapshot.h"
+#include "System/System.h"
+
+#include "huffandpuff/huffman.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+using namespace game;
+
+static_assert(SnapshotFragmentSize == std::size(SnapshotFragmentMessage().data));
+
+namespace
+{
+    constexpr uint32_t snapshot_magic = 0x4e4a4853; // "SHJN"
+
+    struct SnapshotHeader
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t padding;
+        uint32_t timestamp;
+        uint32_t n_transforms;
+        uint32_t n_sprites;
+        uint32_t n_damage_infos;
+    };
+
+    template <typename T>
+    void WriteRecords(const std::vector<T>& records, std::vector<byte>& out_buffer)
+    {
+        const size_t offset = out_buffer.size();
+        out_buffer.resize(offset + records.size() * sizeof(T));
+        if(!records.empty())
+            std::memcpy(out_buffer.data() + offset, records.data(), records.size() * sizeof(T));
+    }
+
+    template <typename T>
+    bool ReadRecords(const std::vector<byte>& buffer, size_t& offset, uint32_t n_records, std::vector<T>& out_records)
+    {
+        const size_t records_size = size_t(n_records) * sizeof(T);
+        if(offset + records_size > buffer.size())
+            return false;
+
+        out_records.resize(n_records);
+        if(n_records > 0)
+            std::memcpy(out_records.data(), buffer.data() + offset, records_size);
+        offset += records_size;
+
+        return true;
+    }
+}
+
+CompressedSnapshot game::CompressJoinSnapshot(const JoinSnapshot& snapshot)
+{
+    SnapshotHeader header;
+    header.magic = snapshot_magic;
+    header.version = JoinSnapshotVersion;
+    header.padding = 0;
+    header.timestamp = snapshot.timestamp;
+    header.n_transforms = snapshot.transforms.size();
+    header.n_sprites = snapshot.sprites.size();
+    header.n_damage_infos = snapshot.damage_infos.size();
+
+    // Records of the same type are stored back to back, the similar layout compresses a lot better
+    // than the same records interleaved with message headers.
+    std::vector<byte> uncompressed(sizeof(SnapshotHeader));
+    std::memcpy(uncompressed.data(), &header, sizeof(SnapshotHeader));
+    WriteRecords(snapshot.transforms, uncompressed);
+    WriteRecords(snapshot.sprites, uncompressed);
+    WriteRecords(snapshot.damage_infos, uncompressed);
+
+    // The heap is too big for the stack of the game thread, and a snapshot is only built on join.
+    std::vector<unsigned char> huffbuf_heap(HUFFHEAP_SIZE);
+
+    CompressedSnapshot compressed;
+    compressed.uncompressed_size = uncompressed.size();
+    compressed.data.resize(uncompressed.size() + (uncompressed.size() / 2) + 256);
+
+    const unsigned long compressed_size = huffman_compress(
+        uncompressed.data(), uncompressed.size(), compressed.data.data(), compressed.data.size(), huffbuf_heap.data());
+
+    if(compressed_size == 0)
+    {
+        System::Log("JoinSnapshot|Failed to compress snapshot, sending it uncompressed.");
+        compressed.data = std::move(uncompressed);
+        compressed.uncompressed_size = 0;
+        return compressed;
+    }
+
+    compressed.data.resize(compressed_size);
+    return compressed;
+}
+
+bool game::DecompressJoinSnapshot(const byte* data, uint32_t size, uint32_t uncompressed_size, JoinSnapshot& out_snapshot)
+{
+    if(size > JoinSnapshotMaxSize || uncompressed_size > JoinSnapshotMaxSize)
+    {
+        System::Log("JoinSnapshot|Snapshot of %u bytes is too large.", std::max(size, uncompressed_size));
+        return false;
+    }
+
+    std::vector<byte> uncompressed;
+
+    // An uncompressed size of zero means that compression failed and the data is stored as is.
+    if(uncompressed_size == 0)
+    {
+        uncompressed.assign(data, data + size);
+    }
+    else
+    {
+        std::vector<unsigned char> huffbuf_heap(HUFFHEAP_SIZE);
+        uncompressed.resize(uncompressed_size);
+
+        const unsigned long decompressed_size =
+            huffman_decompress(data, size, uncompressed.data(), uncompressed.size(), huffbuf_heap.data());
+        if(decompressed_size != uncompressed_size)
+        {
+            System::Log("JoinSnapshot|Failed to decompress snapshot, %lu / %u", decompressed_size, uncompressed_size);
+            return false;
+        }
+    }
+
+    if(uncompressed.size() < sizeof(SnapshotHeader))
+        return false;
+
+    SnapshotHeader header;
+    std::memcpy(&header, uncompressed.data(), sizeof(SnapshotHeader));
+
+    if(header.magic != snapshot_magic || header.version != JoinSnapshotVersion)
+    {
+        System::Log("JoinSnapshot|Snapshot version missmatch, have %u got %u.", JoinSnapshotVersion, header.version);
+        return false;
+    }
+
+    out_snapshot.timestamp = header.timestamp;
+
+    size_t offset = sizeof(SnapshotHeader);
+    return
+        ReadRecords(uncompressed, offset, header.n_transforms, out_snapshot.transforms) &&
+        ReadRecords(uncompressed, offset, header.n_sprites, out_snapshot.sprites) &&
+        ReadRecords(uncompressed, offset, header.n_damage_infos, out_snapshot.damage_infos);
+}
+
+uint16_t game::NumberOfSnapshotFragments(uint32_t compressed_size)
+{
+    return std::max(1u, (compressed_size + SnapshotFragmentSize - 1) / SnapshotFragmentSize);
+}
+
+SnapshotAssembler::SnapshotAssembler()
+    : m_snapshot_id(0)
+    , m_uncompressed_size(0)
+    , m_received_fragments(0)
+{ }
+
+bool SnapshotAssembler::AddFragment(const SnapshotFragmentMessage& fragment)
+{
+    if(fragment.version != JoinSnapshotVersion)
+    {
+        System::Log("JoinSnapshot|Ignoring fragment with version %u, expected %u.", fragment.version, JoinSnapshotVersion);
+        return false;
+    }
+
+    const bool valid_fragment =
+        fragment.compressed_size <= JoinSnapshotMaxSize &&
+        fragment.uncompressed_size <= JoinSnapshotMaxSize &&
+        fragment.fragment_index < fragment.n_fragments &&
+        fragment.n_fragments == NumberOfSnapshotFragments(fragment.compressed_size) &&
+        fragment.data_size <= SnapshotFragmentSize &&
+        size_t(fragment.fragment_index) * SnapshotFragmentSize + fragment.data_size <= fragment.compressed_size;
+    if(!valid_fragment)
+        return false;
+
+    // A new snapshot replaces an unfinished one, the server only keeps the latest one for each client.
+    if(fragment.snapshot_id != m_snapshot_id || m_received.empty())
+    {
+        if(IsComplete())
+            return false;
+
+        m_snapshot_id = fragment.snapshot_id;
+        m_uncompressed_size = fragment.uncompressed_size;
+        m_received_fragments = 0;
+        m_data.assign(fragment.compressed_size, 0);
+        m_received.assign(fragment.n_fragments, false);
+    }
+
+    if(m_received[fragment.fragment_index])
+        return true;
+
+    std::memcpy(m_data.data() + size_t(fragment.fragment_index) * SnapshotFragmentSize, fragment.data, fragment.data_size);
+    m_received[fragment.fragment_index] = true;
+    m_received_fragments++;
+
+    return true;
+}
+
+bool SnapshotAssembler::IsComplete() const
+{
+    return !m_received.empty() && m_received_fragments == m_received.size();
+}
+
+uint32_t SnapshotAssembler::SnapshotId() const
+{
+    return m_snapshot_id;
+}
+
+uint32_t SnapshotAssembler::UncompressedSize() const
+{
+    return m_uncompressed_size;
+}
+
+const std::vector<byte>& SnapshotAssembler::Data() const
+{
+    return m_data;
+}
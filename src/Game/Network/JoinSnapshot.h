@@ -0,0 +1,63 @@
+
+#pragma once
+
+#include "NetworkMessage.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace game
+{
+    // Bump when the layout of the snapshot, or any of the messages in it, changes.
+    constexpr uint16_t JoinSnapshotVersion = 1;
+    constexpr uint32_t SnapshotFragmentSize = 640;
+
+    // The sizes in a fragment come from the network, larger snapshots are rejected before allocating.
+    constexpr uint32_t JoinSnapshotMaxSize = 8 * 1024 * 1024;
+
+    // The complete replicated state at the time the snapshot was taken, applied by a joining client
+    // in one pass before it starts consuming delta updates.
+    struct JoinSnapshot
+    {
+        uint32_t timestamp = 0;
+        std::vector<TransformMessage> transforms;
+        std::vector<SpriteMessage> sprites;
+        std::vector<DamageInfoMessage> damage_infos;
+    };
+
+    struct CompressedSnapshot
+    {
+        uint32_t uncompressed_size = 0;
+        std::vector<byte> data;
+    };
+
+    CompressedSnapshot CompressJoinSnapshot(const JoinSnapshot& snapshot);
+    bool DecompressJoinSnapshot(const byte* data, uint32_t size, uint32_t uncompressed_size, JoinSnapshot& out_snapshot);
+
+    uint16_t NumberOfSnapshotFragments(uint32_t compressed_size);
+
+    // Collects the fragments of one snapshot on the client, duplicates and fragments from other
+    // snapshots or versions are ignored.
+    class SnapshotAssembler
+    {
+    public:
+
+        SnapshotAssembler();
+
+        // Returns true if the fragment belongs to the snapshot being assembled and should be acked.
+        bool AddFragment(const SnapshotFragmentMessage& fragment);
+        bool IsComplete() const;
+
+        uint32_t SnapshotId() const;
+        uint32_t UncompressedSize() const;
+        const std::vector<byte>& Data() const;
+
+    private:
+
+        uint32_t m_snapshot_id;
+        uint32_t m_uncompressed_size;
+        uint32_t m_received_fragments;
+        std::vector<byte> m_data;
+        std::vector<bool> m_received;
+    };
+}
@@ -53,21 +53,28 @@ MessageDispatcher::MessageDispatcher(mono::EventHandler* event_handler)
     REGISTER_MESSAGE_HANDLER_WITH_SENDER(HeartBeatMessage);
 
     REGISTER_MESSAGE_HANDLER(LevelMetadataMessage);
+    REGISTER_MESSAGE_HANDLER(AssetManifestMessage);
+    REGISTER_MESSAGE_HANDLER_WITH_SENDER(AssetRequestMessage);
+    REGISTER_MESSAGE_HANDLER(AssetChunkMessage);
     REGISTER_MESSAGE_HANDLER(ClientPlayerSpawned);
     REGISTER_MESSAGE_HANDLER(TextMessage);
     REGISTER_MESSAGE_HANDLER(TransformMessage);
     REGISTER_MESSAGE_HANDLER(SpawnMessage);
     REGISTER_MESSAGE_HANDLER(SpriteMessage);
     REGISTER_MESSAGE_HANDLER(DamageInfoMessage);
+    REGISTER_MESSAGE_HANDLER(EffectEventsMessage);
+    REGISTER_MESSAGE_HANDLER(SnapshotFragmentMessage);
+    REGISTER_MESSAGE_HANDLER_WITH_SENDER(SnapshotAckMessage);
     REGISTER_MESSAGE_HANDLER_WITH_SENDER(RemoteInputMessage);
     REGISTER_MESSAGE_HANDLER(RemoteCameraMessage);
     REGISTER_MESSAGE_HANDLER_WITH_SENDER(ViewportMessage);
+    REGISTER_MESSAGE_HANDLER(ProjectileEventsMessage);
 }
 
-void MessageDispatcher::PushNewMessage(const NetworkMessage& message)
+void MessageDispatcher::PushNewMessage(NetworkMessage&& message)
 {
     std::lock_guard<std::mutex> lock(m_message_mutex);
-    m_push_messages->push_back(message);
+    m_push_messages->push_back(std::move(message));
 }
 
 void MessageDispatcher::Update(const mono::UpdateContext& update_context)
@@ -80,19 +87,23 @@ void MessageDispatcher::Update(const mono::UpdateContext& update_context)
         m_push_messages = (m_push_messages == &m_message_buffer_1) ? &m_message_buffer_2 : &m_message_buffer_1;
     }
 
-    for(const NetworkMessage& network_message : *unhandled_messages)
+    for(NetworkMessage& network_message : *unhandled_messages)
     {
-        const std::vector<byte_view>& n_messages = UnpackMessageBuffer(network_message.payload);
-        for(size_t index = 0; index < n_messages.size(); ++index)
+        MessageBufferIterator message_iterator(network_message.payload);
+
+        byte_view message_view;
+        while(message_iterator.Next(message_view))
         {
-            const byte_view& message_view = n_messages[index];
             const uint32_t message_type = PeekMessageType(message_view);
 
             const auto handler_it = m_handlers.find(message_type);
             if(handler_it == m_handlers.end())
             {
                 System::Log(
-                    "network|Failed to find a handler for message of type: %u, message: %lu/%lu", message_type, index, n_messages.size());
+                    "network|Failed to find a handler for message of type: %u, message: %u/%u",
+                    message_type,
+                    message_iterator.MessageIndex(),
+                    message_iterator.MessageCount());
                 continue;
             }
 
@@ -100,6 +111,8 @@ void MessageDispatcher::Update(const mono::UpdateContext& update_context)
             if(!handled_message)
                 System::Log("network|Failed to deserialize message of type: %u", message_type);
         }
+
+        ReleaseMessageBuffer(std::move(network_message.payload));
     }
 
     unhandled_messages->clear();
@@ -23,7 +23,7 @@ namespace game
     public:
 
         MessageDispatcher(mono::EventHandler* event_handler);
-        void PushNewMessage(const NetworkMessage& message);
+        void PushNewMessage(NetworkMessage&& message);
         void Update(const mono::UpdateContext& update_context) override;
 
     private:
@@ -0,0 +1,53 @@
+
+#include "NetworkBufferPool.h"
+#include "NetworkSerialize.h"
+
+#include <mutex>
+
+namespace
+{
+    // Release on a buffer that has not been acquired from the pool is fine, but will grow the pool,
+    // so cap the number of free buffers to not hold on to memory after a burst.
+    constexpr uint32_t max_free_buffers = 256;
+
+    std::mutex g_buffer_mutex;
+    std::vector<std::vector<byte>> g_free_buffers;
+    uint32_t g_allocated_buffers = 0;
+}
+
+std::vector<byte> game::AcquireMessageBuffer()
+{
+    {
+        std::lock_guard<std::mutex> lock(g_buffer_mutex);
+        if(!g_free_buffers.empty())
+        {
+            std::vector<byte> buffer = std::move(g_free_buffers.back());
+            g_free_buffers.pop_back();
+            return buffer;
+        }
+
+        ++g_allocated_buffers;
+    }
+
+    std::vector<byte> buffer;
+    buffer.reserve(NetworkMessageBufferTotalSize);
+    return buffer;
+}
+
+void game::ReleaseMessageBuffer(std::vector<byte>&& buffer)
+{
+    if(buffer.capacity() < NetworkMessageBufferTotalSize)
+        return;
+
+    buffer.clear();
+
+    std::lock_guard<std::mutex> lock(g_buffer_mutex);
+    if(g_free_buffers.size() < max_free_buffers)
+        g_free_buffers.push_back(std::move(buffer));
+}
+
+game::NetworkBufferPoolStats game::GetMessageBufferPoolStats()
+{
+    std::lock_guard<std::mutex> lock(g_buffer_mutex);
+    return { g_allocated_buffers, uint32_t(g_free_buffers.size()) };
+}
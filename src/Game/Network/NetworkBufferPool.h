@@ -0,0 +1,23 @@
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+using byte = uint8_t;
+
+namespace game
+{
+    struct NetworkBufferPoolStats
+    {
+        uint32_t allocated_buffers;
+        uint32_t free_buffers;
+    };
+
+    // Message buffers are recycled through a shared pool so that once the pool is warm, serializing,
+    // batching, sending and receiving packets does not touch the heap. The pool is thread safe since
+    // buffers are acquired and released on both the main thread and the network threads.
+    std::vector<byte> AcquireMessageBuffer();
+    void ReleaseMessageBuffer(std::vector<byte>&& buffer);
+    NetworkBufferPoolStats GetMessageBufferPoolStats();
+}
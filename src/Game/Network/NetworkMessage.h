@@ -1,13 +1,18 @@
 
 #pragma once
 
+#include "AssetTransfer.h"
 #include "Math/Vector.h"
 #include "Math/Quad.h"
+#include "Effects/EffectEvents.h"
+#include "Weapons/ProjectileEvent.h"
 #include "System/Network.h"
 #include "System/System.h"
 
 #include <cstdint>
 
+using byte = uint8_t;
+
 
 #define DECLARE_NETWORK_MESSAGE() \
     static constexpr uint32_t message_type  = __COUNTER__; \
@@ -78,6 +83,35 @@ namespace game
         uint32_t background_texture_hash;
     };
 
+    // One entry of the servers asset manifest, the client collects all n_entries before fetching anything.
+    struct AssetManifestMessage
+    {
+        DECLARE_NETWORK_MESSAGE();
+        uint16_t entry_index;
+        uint16_t n_entries;
+        uint32_t content_hash;
+        uint32_t content_size;
+        char filename[AssetMaxFilenameLength] = { 0 };
+    };
+
+    // Requests a chunk of the blob with content_hash, a content_hash of zero requests the manifest again.
+    struct AssetRequestMessage
+    {
+        DECLARE_NETWORK_MESSAGE();
+        network::Address sender;
+        uint32_t content_hash;
+        uint32_t chunk_index;
+    };
+
+    struct AssetChunkMessage
+    {
+        DECLARE_NETWORK_MESSAGE();
+        uint32_t content_hash;
+        uint32_t chunk_index;
+        uint16_t chunk_size;
+        byte data[AssetChunkSize];
+    };
+
     struct TransformMessage
     {
         DECLARE_NETWORK_MESSAGE();
@@ -120,6 +154,35 @@ namespace game
         uint32_t damage_timestamp;
     };
 
+    struct EffectEventsMessage
+    {
+        DECLARE_NETWORK_MESSAGE();
+        uint8_t n_events;
+        EffectEvent events[32];
+    };
+
+    // One fragment of the compressed join snapshot, see JoinSnapshot.h.
+    struct SnapshotFragmentMessage
+    {
+        DECLARE_NETWORK_MESSAGE();
+        uint32_t snapshot_id;
+        uint32_t uncompressed_size;
+        uint32_t compressed_size;
+        uint16_t version;
+        uint16_t fragment_index;
+        uint16_t n_fragments;
+        uint16_t data_size;
+        byte data[640];
+    };
+
+    struct SnapshotAckMessage
+    {
+        DECLARE_NETWORK_MESSAGE();
+        network::Address sender;
+        uint32_t snapshot_id;
+        uint16_t fragment_index;
+    };
+
     struct RemoteInputMessage
     {
         DECLARE_NETWORK_MESSAGE();
@@ -141,6 +204,13 @@ namespace game
         math::Quad viewport;
     };
 
+    struct ProjectileEventsMessage
+    {
+        DECLARE_NETWORK_MESSAGE();
+        uint8_t n_events;
+        ProjectileEvent events[24];
+    };
+
     inline void PrintNetworkMessageSize()
     {
         #define PRINT_NETWORK_MESSAGE_SIZE(message_name) \
@@ -157,12 +227,20 @@ namespace game
         PRINT_NETWORK_MESSAGE_SIZE(DisconnectMessage);
         PRINT_NETWORK_MESSAGE_SIZE(HeartBeatMessage);
         PRINT_NETWORK_MESSAGE_SIZE(TextMessage);
+        PRINT_NETWORK_MESSAGE_SIZE(LevelMetadataMessage);
+        PRINT_NETWORK_MESSAGE_SIZE(AssetManifestMessage);
+        PRINT_NETWORK_MESSAGE_SIZE(AssetRequestMessage);
+        PRINT_NETWORK_MESSAGE_SIZE(AssetChunkMessage);
         PRINT_NETWORK_MESSAGE_SIZE(TransformMessage);
         PRINT_NETWORK_MESSAGE_SIZE(SpawnMessage);
         PRINT_NETWORK_MESSAGE_SIZE(SpriteMessage);
         PRINT_NETWORK_MESSAGE_SIZE(DamageInfoMessage);
+        PRINT_NETWORK_MESSAGE_SIZE(EffectEventsMessage);
+        PRINT_NETWORK_MESSAGE_SIZE(SnapshotFragmentMessage);
+        PRINT_NETWORK_MESSAGE_SIZE(SnapshotAckMessage);
         PRINT_NETWORK_MESSAGE_SIZE(RemoteInputMessage);
         PRINT_NETWORK_MESSAGE_SIZE(RemoteCameraMessage);
         PRINT_NETWORK_MESSAGE_SIZE(ViewportMessage);
+        PRINT_NETWORK_MESSAGE_SIZE(ProjectileEventsMessage);
     }
 }
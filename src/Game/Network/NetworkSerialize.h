@@ -3,19 +3,26 @@
 
 #include "System/Network.h"
 #include "System/System.h"
+#include "NetworkBufferPool.h"
 
 #include <vector>
 #include <cstdint>
 #include <string_view>
 #include <cstring>
 
-using byte = uint8_t;
 using byte_view = std::basic_string_view<byte>;
 
 namespace game
 {
+    // Move only, the payload is handed from the serializer to the send thread and then back to the buffer pool.
     struct NetworkMessage
     {
+        NetworkMessage() = default;
+        NetworkMessage(NetworkMessage&& other) = default;
+        NetworkMessage& operator = (NetworkMessage&& other) = default;
+        NetworkMessage(const NetworkMessage& other) = delete;
+        NetworkMessage& operator = (const NetworkMessage& other) = delete;
+
         network::Address address;
         std::vector<byte> payload;
     };
@@ -131,7 +138,7 @@ namespace game
     template <typename T>
     inline std::vector<byte> SerializeMessage(const T& message)
     {
-        std::vector<byte> message_buffer;
+        std::vector<byte> message_buffer = AcquireMessageBuffer();
         PrepareMessageBuffer(message_buffer);
         SerializeMessageToBuffer(message, message_buffer);
         return message_buffer;
@@ -159,4 +166,58 @@ namespace game
 
         return buffer_views;
     }
+
+    // Iterates the messages in a message buffer without allocating, use this instead of UnpackMessageBuffer on hot paths.
+    class MessageBufferIterator
+    {
+    public:
+
+        MessageBufferIterator(const std::vector<byte>& message_buffer)
+            : m_message_buffer(message_buffer)
+            , m_n_messages(GetMessageBufferHeader(message_buffer).n_messages)
+            , m_message_index(0)
+            , m_position(sizeof(NetworkMessageHeader))
+        { }
+
+        bool Next(byte_view& message_view)
+        {
+            constexpr size_t payload_data_size = sizeof(uint32_t);
+
+            if(m_message_index >= m_n_messages)
+                return false;
+
+            if(m_position + payload_data_size > m_message_buffer.size())
+                return false;
+
+            uint32_t payload_length = 0;
+            std::memcpy(&payload_length, m_message_buffer.data() + m_position, payload_data_size);
+
+            const size_t payload_start = m_position + payload_data_size;
+            if(payload_start + payload_length > m_message_buffer.size())
+                return false;
+
+            message_view = byte_view(m_message_buffer.data() + payload_start, payload_length);
+            m_position = payload_start + payload_length;
+            ++m_message_index;
+
+            return true;
+        }
+
+        uint32_t MessageIndex() const
+        {
+            return m_message_index;
+        }
+
+        uint32_t MessageCount() const
+        {
+            return m_n_messages;
+        }
+
+    private:
+
+        const std::vector<byte>& m_message_buffer;
+        const uint32_t m_n_messages;
+        uint32_t m_message_index;
+        size_t m_position;
+    };
 }
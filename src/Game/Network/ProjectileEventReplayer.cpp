@@ -0,0 +1,96 @@
+
+#include "ProjectileEventReplayer.h"
+#include "ClientManager.h"
+#include "NetworkMessage.h"
+
+#include "EventHandler/EventHandler.h"
+#include "Weapons/ProjectileSystem.h"
+
+#include <algorithm>
+#include <iterator>
+
+using namespace game;
+
+namespace
+{
+    // The destroy event normally arrives before the local projectile runs out, the extra life covers
+    // the latency so that the projectile does not vanish right before the hit.
+    constexpr uint32_t extra_life_ms = 250;
+}
+
+ProjectileEventReplayer::ProjectileEventReplayer(
+    mono::EventHandler* event_handler, const ClientManager* client_manager, ProjectileSystem* projectile_system)
+    : m_event_handler(event_handler)
+    , m_client_manager(client_manager)
+    , m_projectile_system(projectile_system)
+{
+    using namespace std::placeholders;
+    const std::function<mono::EventResult (const ProjectileEventsMessage&)> projectile_events_func
+        = std::bind(&ProjectileEventReplayer::HandleProjectileEvents, this, _1);
+    m_projectile_events_token = m_event_handler->AddListener(projectile_events_func);
+}
+
+ProjectileEventReplayer::~ProjectileEventReplayer()
+{
+    m_event_handler->RemoveListener(m_projectile_events_token);
+}
+
+void ProjectileEventReplayer::Update(const mono::UpdateContext& update_context)
+{
+    const uint32_t server_time = m_client_manager->GetServerTimePredicted();
+
+    const auto play_if_due = [this, server_time](const ProjectileEvent& projectile_event) {
+        const bool is_due = (int32_t(server_time - projectile_event.timestamp) >= 0);
+        if(is_due)
+            PlayProjectileEvent(projectile_event);
+        return is_due;
+    };
+
+    const auto it = std::remove_if(m_pending_events.begin(), m_pending_events.end(), play_if_due);
+    m_pending_events.erase(it, m_pending_events.end());
+}
+
+mono::EventResult ProjectileEventReplayer::HandleProjectileEvents(const ProjectileEventsMessage& message)
+{
+    const uint32_t n_events = std::min<uint32_t>(message.n_events, std::size(message.events));
+    m_pending_events.insert(m_pending_events.end(), message.events, message.events + n_events);
+    return mono::EventResult::HANDLED;
+}
+
+void ProjectileEventReplayer::PlayProjectileEvent(const ProjectileEvent& projectile_event)
+{
+    const auto it = m_remote_to_local.find(projectile_event.projectile_id);
+    const bool has_local = (it != m_remote_to_local.end() && m_projectile_system->IsAlive(it->second));
+
+    switch(projectile_event.type)
+    {
+    case ProjectileEventType::SPAWN:
+    {
+        if(has_local)
+            m_projectile_system->ReleaseProjectile(it->second);
+
+        const uint32_t local_id = m_projectile_system->SpawnVisualProjectile(
+            projectile_event.sprite_hash,
+            projectile_event.flags,
+            projectile_event.position,
+            projectile_event.velocity,
+            projectile_event.life_ms + extra_life_ms);
+        m_remote_to_local[projectile_event.projectile_id] = local_id;
+        break;
+    }
+    case ProjectileEventType::REDIRECT:
+    {
+        if(has_local)
+            m_projectile_system->RedirectProjectile(it->second, projectile_event.position, projectile_event.velocity);
+        break;
+    }
+    case ProjectileEventType::DESTROY:
+    {
+        if(has_local)
+            m_projectile_system->ReleaseProjectile(it->second);
+        if(it != m_remote_to_local.end())
+            m_remote_to_local.erase(it);
+        break;
+    }
+    }
+}
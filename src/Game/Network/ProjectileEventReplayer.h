@@ -0,0 +1,41 @@
+
+#pragma once
+
+#include "MonoFwd.h"
+#include "IUpdatable.h"
+#include "EventHandler/EventToken.h"
+#include "Weapons/ProjectileEvent.h"
+
+#include <vector>
+#include <unordered_map>
+
+namespace game
+{
+    class ClientManager;
+    class ProjectileSystem;
+    struct ProjectileEventsMessage;
+
+    // Queues replicated projectile events and spawns, redirects and removes local visual projectiles once
+    // the predicted server time reaches the event. The projectiles move on their own in between.
+    class ProjectileEventReplayer : public mono::IUpdatable
+    {
+    public:
+
+        ProjectileEventReplayer(mono::EventHandler* event_handler, const ClientManager* client_manager, ProjectileSystem* projectile_system);
+        ~ProjectileEventReplayer();
+
+        void Update(const mono::UpdateContext& update_context) override;
+
+    private:
+
+        mono::EventResult HandleProjectileEvents(const ProjectileEventsMessage& message);
+        void PlayProjectileEvent(const ProjectileEvent& projectile_event);
+
+        mono::EventHandler* m_event_handler;
+        const ClientManager* m_client_manager;
+        ProjectileSystem* m_projectile_system;
+        std::vector<ProjectileEvent> m_pending_events;
+        std::unordered_map<uint16_t, uint32_t> m_remote_to_local;
+        mono::EventToken<ProjectileEventsMessage> m_projectile_events_token;
+    };
+}
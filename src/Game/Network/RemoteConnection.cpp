@@ -19,15 +19,16 @@ namespace
         unsigned char huffbuf_heap[HUFFHEAP_SIZE];
         std::vector<byte> message_buffer(NetworkMessageBufferTotalSize, '\0');
 
-        NetworkMessage message;
-        message.payload.resize(NetworkMessageBufferTotalSize);
-
         while(!stop)
         {
-            const int bytes_received = socket->Receive(message_buffer, &message.address);
+            network::Address address;
+            const int bytes_received = socket->Receive(message_buffer, &address);
             if(bytes_received > 0)
             {
-                std::fill(message.payload.begin(), message.payload.begin() + message.payload.size(), '\0');
+                NetworkMessage message;
+                message.address = address;
+                message.payload = AcquireMessageBuffer();
+                message.payload.resize(NetworkMessageBufferTotalSize, '\0');
 
                 const unsigned long decompressed_size = huffman_decompress(
                     message_buffer.data(), bytes_received, message.payload.data(), message.payload.size(), huffbuf_heap);
@@ -38,7 +39,7 @@ namespace
                 connection_stats.total_byte_received += decompressed_size;
                 connection_stats.total_compressed_byte_received += bytes_received;
 
-                dispatcher->PushNewMessage(message);
+                dispatcher->PushNewMessage(std::move(message));
             }
         }
     };
@@ -51,12 +52,20 @@ namespace
         std::vector<byte> compressed_bytes;
         compressed_bytes.resize(NetworkMessageBufferTotalSize, '\0');
 
+        // Swapped with the shared queue so that the lock is not held while compressing and sending,
+        // both vectors keeps their capacity so this does not allocate once warm.
+        std::vector<RemoteConnection::Message> messages_to_send;
+
         while(!stop)
         {
-            std::unique_lock<std::mutex> lock(out_messages->message_mutex);
-            out_messages->message_signal.wait(lock);
+            {
+                std::unique_lock<std::mutex> lock(out_messages->message_mutex);
+                out_messages->message_signal.wait(
+                    lock, [out_messages, &stop] { return stop || !out_messages->unhandled_messages.empty(); });
+                std::swap(messages_to_send, out_messages->unhandled_messages);
+            }
 
-            for(const RemoteConnection::Message& message : out_messages->unhandled_messages)
+            for(RemoteConnection::Message& message : messages_to_send)
             {
                 const unsigned long compressed_size = huffman_compress(
                     message.payload.data(), message.payload.size(), compressed_bytes.data(), compressed_bytes.size(), huffbuf_heap);
@@ -64,6 +73,7 @@ namespace
                 if(compressed_size == 0)
                 {
                     System::Log("RemoteConnection|Failed to compress message.");
+                    ReleaseMessageBuffer(std::move(message.payload));
                     continue;
                 }
 
@@ -80,18 +90,17 @@ namespace
                         */
                 }
 
-                for(const network::Address& address : message.addresses)
+                if(socket->Send(compressed_bytes.data(), compressed_size, message.address))
                 {
-                    if(socket->Send(compressed_bytes.data(), compressed_size, address))
-                    {
-                        connection_stats.total_packages_sent++;
-                        connection_stats.total_byte_sent += message.payload.size();
-                        connection_stats.total_compressed_byte_sent += compressed_size;
-                    }
+                    connection_stats.total_packages_sent++;
+                    connection_stats.total_byte_sent += message.payload.size();
+                    connection_stats.total_compressed_byte_sent += compressed_size;
                 }
+
+                ReleaseMessageBuffer(std::move(message.payload));
             }
 
-            out_messages->unhandled_messages.clear();
+            messages_to_send.clear();
         }
     }
 }
@@ -108,32 +117,28 @@ RemoteConnection::RemoteConnection(MessageDispatcher* dispatcher, network::ISock
 
 RemoteConnection::~RemoteConnection()
 {
-    m_stop = true;
+    {
+        std::lock_guard<std::mutex> lock(m_messages.message_mutex);
+        m_stop = true;
+    }
     m_messages.message_signal.notify_one();
 
     m_receive_thread.join();
     m_send_thread.join();
 }
 
-void RemoteConnection::SendData(const std::vector<byte>& data, const network::Address& target)
-{
-    const std::vector<network::Address> addresses = { target };
-    SendData(data, addresses);
-}
-
-void RemoteConnection::SendData(const std::vector<byte>& data, const std::vector<network::Address>& addresses)
+void RemoteConnection::SendData(std::vector<byte>&& data, const network::Address& target)
 {
     {
         std::lock_guard<std::mutex> lock(m_messages.message_mutex);
 
         ++m_sequence_id;
 
-        std::vector<byte>& mutable_data = const_cast<std::vector<byte>&>(data);
-        NetworkMessageHeader header = GetMessageBufferHeader(mutable_data);
+        NetworkMessageHeader header = GetMessageBufferHeader(data);
         header.id = m_sequence_id;
-        SetMessageBufferHeader(mutable_data, header);
+        SetMessageBufferHeader(data, header);
 
-        m_messages.unhandled_messages.push_back({ data, addresses });
+        m_messages.unhandled_messages.push_back({ std::move(data), target });
     }
 
     m_messages.message_signal.notify_one();
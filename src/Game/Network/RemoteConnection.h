@@ -18,14 +18,13 @@ namespace game
         RemoteConnection(class MessageDispatcher* dispatcher, network::ISocketPtr socket);
         ~RemoteConnection();
 
-        void SendData(const std::vector<byte>& data, const network::Address& target);
-        void SendData(const std::vector<byte>& data, const std::vector<network::Address>& addresses);
+        void SendData(std::vector<byte>&& data, const network::Address& target);
         const ConnectionStats& GetConnectionStats() const;
 
         struct Message
         {
             std::vector<byte> payload;
-            std::vector<network::Address> addresses;
+            network::Address address;
         };
 
         struct OutgoingMessages
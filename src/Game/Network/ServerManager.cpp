@@ -2,6 +2,7 @@
 #include "ServerManager.h"
 #include "EventHandler/EventHandler.h"
 #include "RemoteConnection.h"
+#include "NetworkBufferPool.h"
 #include "GameConfig.h"
 #include "Events/PlayerConnectedEvent.h"
 
@@ -70,23 +71,24 @@ void ServerManager::StartServer()
 
 void ServerManager::QuitServer()
 {
-    NetworkMessage message;
-    message.payload = SerializeMessage(ServerQuitMessage());
-
     for(const auto& client : m_connected_clients)
-        SendMessageTo(message, client.first);
+    {
+        NetworkMessage message;
+        message.payload = SerializeMessage(ServerQuitMessage());
+        SendMessageTo(std::move(message), client.first);
+    }
 
     m_remote_connection = nullptr;
 }
 
-void ServerManager::SendMessage(const NetworkMessage& message)
+void ServerManager::SendMessage(NetworkMessage&& message)
 {
-    m_remote_connection->SendData(message.payload, message.address);
+    m_remote_connection->SendData(std::move(message.payload), message.address);
 }
 
-void ServerManager::SendMessageTo(const NetworkMessage& message, const network::Address& address)
+void ServerManager::SendMessageTo(NetworkMessage&& message, const network::Address& address)
 {
-    m_remote_connection->SendData(message.payload, address);
+    m_remote_connection->SendData(std::move(message.payload), address);
 }
 
 ConnectionInfo ServerManager::GetConnectionInfo() const
@@ -103,6 +105,10 @@ ConnectionInfo ServerManager::GetConnectionInfo() const
     info.additional_info.push_back("");
     info.additional_info.push_back("server time: " + std::to_string(m_server_time));
 
+    const NetworkBufferPoolStats pool_stats = GetMessageBufferPoolStats();
+    info.additional_info.push_back(
+        "message buffers: " + std::to_string(pool_stats.allocated_buffers) + " / " + std::to_string(pool_stats.free_buffers) + " free");
+
     info.additional_info.push_back("");
     info.additional_info.push_back("clients");
     for(const auto& pair : m_connected_clients)
@@ -131,7 +137,7 @@ mono::EventResult ServerManager::HandlePingMessage(const PingMessage& ping_messa
 
     NetworkMessage message;
     message.payload = SerializeMessage(local_ping_message);
-    SendMessageTo(message, local_ping_message.sender);
+    SendMessageTo(std::move(message), local_ping_message.sender);
 
     return mono::EventResult::HANDLED;
 }
@@ -149,7 +155,7 @@ mono::EventResult ServerManager::HandleConnectMessage(const ConnectMessage& mess
 
         NetworkMessage reply_message;
         reply_message.payload = SerializeMessage(ConnectAcceptedMessage());
-        SendMessageTo(reply_message, message.sender);
+        SendMessageTo(std::move(reply_message), message.sender);
 
         m_event_handler->DispatchEvent(PlayerConnectedEvent(message.sender));
     }
@@ -237,7 +243,7 @@ void ServerManager::Update(const mono::UpdateContext& update_context)
     {
         NetworkMessage message;
         message.payload = SerializeMessage(ServerBeaconMessage());
-        SendMessageTo(message, m_broadcast_address);
+        SendMessageTo(std::move(message), m_broadcast_address);
 
         m_beacon_timer = 0;
     }
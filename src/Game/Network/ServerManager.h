@@ -39,8 +39,8 @@ namespace game
         void StartServer();
         void QuitServer();
 
-        void SendMessage(const NetworkMessage& message) override;
-        void SendMessageTo(const NetworkMessage& message, const network::Address& address) override;
+        void SendMessage(NetworkMessage&& message) override;
+        void SendMessageTo(NetworkMessage&& message, const network::Address& address) override;
         ConnectionInfo GetConnectionInfo() const override;
 
         const std::unordered_map<network::Address, ClientData>& GetConnectedClients() const;
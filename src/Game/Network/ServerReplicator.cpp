@@ -23,137 +23,422 @@
 #include "Player/PlayerInfo.h"
 #include "WorldFile.h"
 #include "DamageSystem.h"
+#include "Entity/EntityPoolSystem.h"
+#include "SimulationClock.h"
+#include "Effects/EffectEvents.h"
+#include "Weapons/ProjectileSystem.h"
 
 #include "Math/MathFunctions.h"
 #include "Camera/ICamera.h"
 #include "Component.h"
 
-#include <unordered_set>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
 
 using namespace game;
 
+namespace
+{
+    constexpr uint32_t snapshot_fragment_resend_ms = 250;
+    constexpr uint32_t snapshot_timeout_ms = 10000;
+    constexpr uint32_t max_snapshot_fragments_per_tick = 8;
+}
+
 ServerReplicator::ServerReplicator(
     mono::EventHandler* event_handler,
     mono::EntitySystem* entity_system,
+    EntityPoolSystem* entity_pool,
     mono::TransformSystem* transform_system,
     mono::SpriteSystem* sprite_system,
     DamageSystem* damage_system,
+    ProjectileSystem* projectile_system,
     ServerManager* server_manager,
+    const SimulationClock* simulation_clock,
+    const char* world_file,
     const shared::LevelMetadata& level_metadata,
     uint32_t replication_interval)
     : m_event_handler(event_handler)
     , m_entity_system(entity_system)
+    , m_entity_pool(entity_pool)
     , m_transform_system(transform_system)
     , m_sprite_system(sprite_system)
     , m_damage_system(damage_system)
+    , m_projectile_system(projectile_system)
     , m_server_manager(server_manager)
+    , m_simulation_clock(simulation_clock)
     , m_replication_interval(replication_interval)
+    , m_snapshot_id_counter(0)
 {
-    std::memset(&m_transform_data, 0, sizeof(m_transform_data));
-    std::memset(&m_sprite_data, 0, sizeof(m_sprite_data));
-    std::memset(&m_health_data, 0, sizeof(m_health_data));
+    const uint32_t world_file_hash = hash::Hash(world_file);
 
-    const PlayerConnectedFunc connected_func = [server_manager, level_metadata](const PlayerConnectedEvent& event) {
+    const PlayerConnectedFunc connected_func = [server_manager, level_metadata, world_file_hash](const PlayerConnectedEvent& event) {
 
         LevelMetadataMessage metadata_message;
         metadata_message.camera_position = level_metadata.camera_position;
         metadata_message.camera_size = level_metadata.camera_size;
         metadata_message.background_texture_hash = hash::Hash(level_metadata.background_texture.c_str());
-        metadata_message.world_file_hash = 0;
+        metadata_message.world_file_hash = world_file_hash;
 
         NetworkMessage message;
         message.address = event.address;
         message.payload = SerializeMessage(metadata_message);
-        server_manager->SendMessage(message);
+        server_manager->SendMessage(std::move(message));
 
         return mono::EventResult::PASS_ON;
     };
     m_connected_token = m_event_handler->AddListener(connected_func);
+
+    using namespace std::placeholders;
+    const std::function<mono::EventResult (const SnapshotAckMessage&)> snapshot_ack_func =
+        std::bind(&ServerReplicator::HandleSnapshotAck, this, _1);
+    m_snapshot_ack_token = m_event_handler->AddListener(snapshot_ack_func);
+
+    SetRecordEffectEvents(true);
+    m_projectile_system->SetRecordEvents(true);
 }
 
 ServerReplicator::~ServerReplicator()
 {
     m_event_handler->RemoveListener(m_connected_token);
+    m_event_handler->RemoveListener(m_snapshot_ack_token);
+    SetRecordEffectEvents(false);
+    m_projectile_system->SetRecordEvents(false);
 }
 
-void ServerReplicator::Update(const mono::UpdateContext& update_context)
+void ServerReplicator::Update(const mono::UpdateContext& frame_update_context)
 {
     //SCOPED_TIMER_AUTO();
 
-    std::vector<uint32_t> transforms_to_replicate;
-    std::vector<uint32_t> sprites_to_replicate;
-    std::vector<uint32_t> damage_info_to_replicate;
-    std::vector<uint32_t> spawns_this_frame;
+    // The replication cadence follows the simulation ticks so that it doesn't depend on the frame rate. The
+    // timestamps stays on the engine time since that is what the clients synchronize against.
+    mono::UpdateContext update_context = frame_update_context;
+    update_context.delta_ms = m_simulation_clock->FrameContext().delta_ms;
+
+    // The collections are members and only cleared, to not allocate every replication tick.
+    m_transforms_to_replicate.clear();
+    m_sprites_to_replicate.clear();
+    m_damage_info_to_replicate.clear();
+    m_spawns_this_frame.clear();
+
+    std::swap(m_local_entities, m_last_local_entities);
+    m_local_entities.clear();
+
+    const auto collect_entities = [this](const mono::Entity& entity) {
+        if(entity.properties & EntityProperties::LOCAL)
+        {
+            m_local_entities.push_back(entity.id);
+            return;
+        }
+
+        // Idle entities in a pool are despawned on the clients.
+        if(m_entity_pool->IsPooled(entity.id))
+            return;
+
+        EnsureReplicationData(entity.id);
 
-    const auto collect_entities = [&](const mono::Entity& entity) {
-        transforms_to_replicate.push_back(entity.id);
+        m_transforms_to_replicate.push_back(entity.id);
 
         if(mono::contains(entity.components, SPRITE_COMPONENT))
-            sprites_to_replicate.push_back(entity.id);
+            m_sprites_to_replicate.push_back(entity.id);
 
         if(mono::contains(entity.components, HEALTH_COMPONENT))
-            damage_info_to_replicate.push_back(entity.id);
+            m_damage_info_to_replicate.push_back(entity.id);
     };
     m_entity_system->ForEachEntity(collect_entities);
 
-    for(const auto& spawn_event : m_entity_system->GetSpawnEvents())
-    {
-        if(spawn_event.spawned)
-            spawns_this_frame.push_back(spawn_event.entity_id);
-    }
+    const auto collect_spawns = [this](const std::vector<mono::IEntityManager::SpawnEvent>& spawn_events) {
+        for(const auto& spawn_event : spawn_events)
+        {
+            if(spawn_event.spawned && !mono::contains(m_local_entities, spawn_event.entity_id))
+                m_spawns_this_frame.push_back(spawn_event.entity_id);
+        }
+    };
+    collect_spawns(m_entity_system->GetSpawnEvents());
+    collect_spawns(m_entity_pool->GetSpawnEvents());
 
-    std::unordered_set<network::Address> known_clients;
+    m_replicated_clients.clear();
 
     const std::unordered_map<network::Address, ClientData>& clients = m_server_manager->GetConnectedClients();
+
+    const auto is_disconnected = [&clients](const PendingSnapshot& pending_snapshot) {
+        return clients.find(pending_snapshot.address) == clients.end();
+    };
+    mono::remove_if(m_pending_snapshots, is_disconnected);
+
     for(const auto& client : clients)
     {
-        const bool force_replicate = (m_known_clients.find(client.first) == m_known_clients.end());
-
         BatchedMessageSender batch_sender(client.first, m_message_queue);
         ReplicateSpawns(batch_sender, update_context);
 
-        const int replicated_transforms =
-            ReplicateTransforms(transforms_to_replicate, spawns_this_frame, force_replicate, batch_sender, client.second.viewport, update_context);
-        const int replicated_sprites =
-            ReplicateSprites(sprites_to_replicate, spawns_this_frame, force_replicate, batch_sender, update_context);
-        const int replicated_damages =
-            ReplicateDamageInfos(damage_info_to_replicate, spawns_this_frame, force_replicate, batch_sender, update_context);
+        // A new client gets the complete state in the join snapshot, so no deltas are sent to it this tick.
+        const bool new_client = !mono::contains(m_known_clients, client.first);
+        if(new_client)
+            BuildJoinSnapshot(client.first, update_context);
+
+        int replicated_transforms = 0;
+        int replicated_sprites = 0;
+        int replicated_damages = 0;
+
+        if(!new_client)
+        {
+            replicated_transforms = ReplicateTransforms(
+                m_transforms_to_replicate, m_spawns_this_frame, batch_sender, client.second.viewport, update_context);
+            replicated_sprites =
+                ReplicateSprites(m_sprites_to_replicate, m_spawns_this_frame, batch_sender, update_context);
+            replicated_damages =
+                ReplicateDamageInfos(m_damage_info_to_replicate, m_spawns_this_frame, batch_sender, update_context);
+        }
+
+        const int replicated_effects =
+            ReplicateEffectEvents(batch_sender, client.second.viewport, update_context);
+        const int replicated_projectiles =
+            ReplicateProjectileEvents(client.first, batch_sender, client.second.viewport, update_context);
     
         System::Log(
-            "replications, transforms: %u, sprites: %u, damages: %u",
+            "replications, transforms: %u, sprites: %u, damages: %u, effects: %u, projectiles: %u",
             replicated_transforms,
             replicated_sprites,
-            replicated_damages);
+            replicated_damages,
+            replicated_effects,
+            replicated_projectiles);
 
-        known_clients.insert(client.first);
+        m_replicated_clients.push_back(client.first);
     }
 
-    m_known_clients = known_clients;
+    SendSnapshotFragments(update_context);
+
+    std::swap(m_known_clients, m_replicated_clients);
 
-    while(!m_message_queue.empty())
+    for(auto it = m_sent_projectiles.begin(); it != m_sent_projectiles.end();)
     {
-        m_server_manager->SendMessage(m_message_queue.front());
-        m_message_queue.pop();
+        if(clients.find(it->first) == clients.end())
+            it = m_sent_projectiles.erase(it);
+        else
+            ++it;
     }
+    ClearRecordedEffectEvents();
+    m_projectile_system->ClearRecordedEvents();
+
+    for(NetworkMessage& message : m_message_queue)
+        m_server_manager->SendMessage(std::move(message));
+
+    m_message_queue.clear();
 }
 
-void ServerReplicator::ReplicateSpawns(BatchedMessageSender& batched_sender, const mono::UpdateContext& update_context)
+void ServerReplicator::BuildJoinSnapshot(const network::Address& client_address, const mono::UpdateContext& update_context)
+{
+    m_snapshot.timestamp = update_context.timestamp;
+    m_snapshot.transforms.clear();
+    m_snapshot.sprites.clear();
+    m_snapshot.damage_infos.clear();
+
+    for(uint32_t entity_id : m_transforms_to_replicate)
+    {
+        const math::Matrix& transform = m_transform_system->GetTransform(entity_id);
+
+        TransformMessage& transform_message = m_snapshot.transforms.emplace_back();
+        transform_message.timestamp = update_context.timestamp;
+        transform_message.entity_id = entity_id;
+        transform_message.parent_transform = m_transform_system->GetParent(entity_id);
+        transform_message.position = math::GetPosition(transform);
+        transform_message.rotation = math::GetZRotation(transform);
+    }
+
+    for(uint32_t entity_id : m_sprites_to_replicate)
+    {
+        mono::ISprite* sprite = m_sprite_system->GetSprite(entity_id);
+
+        SpriteMessage& sprite_message = m_snapshot.sprites.emplace_back();
+        sprite_message.entity_id = entity_id;
+        sprite_message.filename_hash = sprite->GetSpriteHash();
+        sprite_message.hex_color = mono::Color::ToHex(sprite->GetShade());
+        sprite_message.animation_id = sprite->GetActiveAnimation();
+        sprite_message.properties = sprite->GetProperties();
+        sprite_message.layer = m_sprite_system->GetSpriteLayer(entity_id);
+        sprite_message.shadow_size = sprite->GetShadowSize();
+
+        const math::Vector shadow_offset = sprite->GetShadowOffset();
+        sprite_message.shadow_offset_x = shadow_offset.x;
+        sprite_message.shadow_offset_y = shadow_offset.y;
+    }
+
+    for(uint32_t entity_id : m_damage_info_to_replicate)
+    {
+        const DamageRecord* damage_record = m_damage_system->GetDamageRecord(entity_id);
+
+        DamageInfoMessage& damage_info = m_snapshot.damage_infos.emplace_back();
+        damage_info.entity_id = entity_id;
+        damage_info.health = m_damage_system->GetHealth(entity_id);
+        damage_info.full_health = damage_record->full_health;
+        damage_info.damage_timestamp = damage_record->last_damaged_timestamp;
+        damage_info.is_boss = damage_record->is_boss;
+    }
+
+    CompressedSnapshot compressed_snapshot = CompressJoinSnapshot(m_snapshot);
+    const uint16_t n_fragments = NumberOfSnapshotFragments(compressed_snapshot.data.size());
+
+    // Zero is never used as an id, that is what the client starts out with.
+    m_snapshot_id_counter++;
+    if(m_snapshot_id_counter == 0)
+        m_snapshot_id_counter++;
+
+    const auto same_address = [&client_address](const PendingSnapshot& pending_snapshot) {
+        return pending_snapshot.address == client_address;
+    };
+    mono::remove_if(m_pending_snapshots, same_address);
+
+    PendingSnapshot& pending_snapshot = m_pending_snapshots.emplace_back();
+    pending_snapshot.address = client_address;
+    pending_snapshot.snapshot_id = m_snapshot_id_counter;
+    pending_snapshot.uncompressed_size = compressed_snapshot.uncompressed_size;
+    pending_snapshot.created_timestamp = update_context.timestamp;
+    pending_snapshot.acked_fragments = 0;
+    pending_snapshot.data = std::move(compressed_snapshot.data);
+    pending_snapshot.fragment_sent_timestamps.assign(n_fragments, 0);
+    pending_snapshot.fragment_acked.assign(n_fragments, false);
+
+    System::Log(
+        "ServerReplicator|Join snapshot %u for %s, transforms: %zu, sprites: %zu, damages: %zu, %u -> %zu bytes in %u fragments.",
+        pending_snapshot.snapshot_id,
+        network::AddressToString(client_address).c_str(),
+        m_snapshot.transforms.size(),
+        m_snapshot.sprites.size(),
+        m_snapshot.damage_infos.size(),
+        pending_snapshot.uncompressed_size,
+        pending_snapshot.data.size(),
+        n_fragments);
+}
+
+void ServerReplicator::SendSnapshotFragments(const mono::UpdateContext& update_context)
+{
+    const auto is_done = [this, &update_context](const PendingSnapshot& pending_snapshot) {
+        const uint32_t time_pending = update_context.timestamp - pending_snapshot.created_timestamp;
+
+        if(pending_snapshot.acked_fragments == pending_snapshot.fragment_acked.size())
+        {
+            System::Log(
+                "ServerReplicator|Join snapshot %u acked by %s after %u ms.",
+                pending_snapshot.snapshot_id,
+                network::AddressToString(pending_snapshot.address).c_str(),
+                time_pending);
+            return true;
+        }
+
+        if(time_pending > snapshot_timeout_ms)
+        {
+            System::Log(
+                "ServerReplicator|Join snapshot %u for %s timed out, %u of %zu fragments acked.",
+                pending_snapshot.snapshot_id,
+                network::AddressToString(pending_snapshot.address).c_str(),
+                pending_snapshot.acked_fragments,
+                pending_snapshot.fragment_acked.size());
+
+            // Forget the client, it is treated as new next tick and gets a snapshot of the state at that time.
+            mono::remove(m_replicated_clients, pending_snapshot.address);
+            return true;
+        }
+
+        return false;
+    };
+    mono::remove_if(m_pending_snapshots, is_done);
+
+    for(PendingSnapshot& pending_snapshot : m_pending_snapshots)
+    {
+        BatchedMessageSender batch_sender(pending_snapshot.address, m_message_queue);
+
+        const uint32_t n_fragments = pending_snapshot.fragment_acked.size();
+        uint32_t fragments_sent = 0;
+
+        for(uint32_t index = 0; index < n_fragments && fragments_sent < max_snapshot_fragments_per_tick; ++index)
+        {
+            if(pending_snapshot.fragment_acked[index])
+                continue;
+
+            uint32_t& sent_timestamp = pending_snapshot.fragment_sent_timestamps[index];
+            const bool should_send =
+                (sent_timestamp == 0) || (update_context.timestamp - sent_timestamp) > snapshot_fragment_resend_ms;
+            if(!should_send)
+                continue;
+
+            const uint32_t offset = index * SnapshotFragmentSize;
+
+            SnapshotFragmentMessage fragment_message;
+            fragment_message.snapshot_id = pending_snapshot.snapshot_id;
+            fragment_message.uncompressed_size = pending_snapshot.uncompressed_size;
+            fragment_message.compressed_size = pending_snapshot.data.size();
+            fragment_message.version = JoinSnapshotVersion;
+            fragment_message.fragment_index = index;
+            fragment_message.n_fragments = n_fragments;
+            fragment_message.data_size = std::min<uint32_t>(SnapshotFragmentSize, pending_snapshot.data.size() - offset);
+            std::memcpy(fragment_message.data, pending_snapshot.data.data() + offset, fragment_message.data_size);
+
+            batch_sender.SendMessage(fragment_message);
+
+            // Zero means not sent, so nudge the timestamp in the unlikely case that it is zero.
+            sent_timestamp = std::max(update_context.timestamp, 1u);
+            fragments_sent++;
+        }
+    }
+}
+
+mono::EventResult ServerReplicator::HandleSnapshotAck(const SnapshotAckMessage& ack_message)
 {
-    for(const mono::IEntityManager::SpawnEvent& spawn_event : m_entity_system->GetSpawnEvents())
+    for(PendingSnapshot& pending_snapshot : m_pending_snapshots)
     {
-        SpawnMessage spawn_message;
-        spawn_message.timestamp = update_context.timestamp;
-        spawn_message.entity_id = spawn_event.entity_id;
-        spawn_message.spawn = spawn_event.spawned;
+        const bool is_snapshot =
+            pending_snapshot.address == ack_message.sender && pending_snapshot.snapshot_id == ack_message.snapshot_id;
+        if(!is_snapshot || ack_message.fragment_index >= pending_snapshot.fragment_acked.size())
+            continue;
 
-        batched_sender.SendMessage(spawn_message);
+        if(!pending_snapshot.fragment_acked[ack_message.fragment_index])
+        {
+            pending_snapshot.fragment_acked[ack_message.fragment_index] = true;
+            pending_snapshot.acked_fragments++;
+        }
     }
+
+    return mono::EventResult::HANDLED;
+}
+
+void ServerReplicator::EnsureReplicationData(uint32_t entity_id)
+{
+    if(entity_id < m_transform_data.size())
+        return;
+
+    const size_t new_size = std::max(size_t(entity_id) + 1, m_transform_data.size() * 2);
+    m_transform_data.resize(new_size, TransformData());
+    m_sprite_data.resize(new_size, SpriteData());
+    m_health_data.resize(new_size, HealthData());
+}
+
+void ServerReplicator::ReplicateSpawns(BatchedMessageSender& batched_sender, const mono::UpdateContext& update_context)
+{
+    const auto replicate_spawns = [&, this](const std::vector<mono::IEntityManager::SpawnEvent>& spawn_events) {
+        for(const mono::IEntityManager::SpawnEvent& spawn_event : spawn_events)
+        {
+            const bool is_local =
+                mono::contains(m_local_entities, spawn_event.entity_id) || mono::contains(m_last_local_entities, spawn_event.entity_id);
+            if(is_local)
+                continue;
+
+            SpawnMessage spawn_message;
+            spawn_message.timestamp = update_context.timestamp;
+            spawn_message.entity_id = spawn_event.entity_id;
+            spawn_message.spawn = spawn_event.spawned;
+
+            batched_sender.SendMessage(spawn_message);
+        }
+    };
+
+    // Entities taken out of and put back into a pool are spawned and despawned like any other on the clients.
+    replicate_spawns(m_entity_system->GetSpawnEvents());
+    replicate_spawns(m_entity_pool->GetSpawnEvents());
 }
 
 int ServerReplicator::ReplicateTransforms(
     const std::vector<uint32_t>& entities,
     const std::vector<uint32_t>& spawn_entities,
-    bool force_replicate,
     BatchedMessageSender& batched_sender,
     const math::Quad& client_viewport,
     const mono::UpdateContext& update_context)
@@ -163,15 +448,14 @@ int ServerReplicator::ReplicateTransforms(
     const auto transform_func = [&, this](const math::Matrix& transform, uint32_t id) {
 
         TransformData& last_transform_message = m_transform_data[id];
-        last_transform_message.time_to_replicate -= update_context.delta_ms;
 
-        const bool time_to_replicate = (last_transform_message.time_to_replicate < 0);
+        const bool time_to_replicate = (update_context.timestamp >= last_transform_message.replicate_timestamp);
         const bool spawned_this_frame = mono::contains(spawn_entities, id);
 
-        if(!time_to_replicate && !force_replicate && !spawned_this_frame)
+        if(!time_to_replicate && !spawned_this_frame)
             return;
 
-        if(!force_replicate && !spawned_this_frame)
+        if(!spawned_this_frame)
         {
              // Expand by 5 meter to send positions before in sight
             const math::Quad& client_bb = math::ResizeQuad(client_viewport, 5.0f);
@@ -194,14 +478,14 @@ int ServerReplicator::ReplicateTransforms(
             math::IsPrettyMuchEquals(last_transform_message.rotation, transform_message.rotation, 0.001f) &&
             last_transform_message.parent_transform == transform_message.parent_transform;
 
-        if(!same_as_last_time || spawned_this_frame || force_replicate)
+        if(!same_as_last_time || spawned_this_frame)
         {
             batched_sender.SendMessage(transform_message);
 
             last_transform_message.position = transform_message.position;
             last_transform_message.rotation = transform_message.rotation;
             last_transform_message.parent_transform = transform_message.parent_transform;
-            last_transform_message.time_to_replicate = m_replication_interval;
+            last_transform_message.replicate_timestamp = update_context.timestamp + m_replication_interval;
 
             replicated_transforms++;
        }
@@ -216,7 +500,6 @@ int ServerReplicator::ReplicateTransforms(
 int ServerReplicator::ReplicateSprites(
     const std::vector<uint32_t>& entities,
     const std::vector<uint32_t>& spawn_entities,
-    bool force_replicate,
     BatchedMessageSender& batched_sender,
     const mono::UpdateContext& update_context)
 {
@@ -247,7 +530,7 @@ int ServerReplicator::ReplicateSprites(
             last_sprite_data.properties == sprite_message.properties;
         const bool spawned_this_frame = mono::contains(spawn_entities, id);
 
-        if(!same_as_last_time || spawned_this_frame || force_replicate)
+        if(!same_as_last_time || spawned_this_frame)
         {
             batched_sender.SendMessage(sprite_message);
             
@@ -269,7 +552,6 @@ int ServerReplicator::ReplicateSprites(
 int ServerReplicator::ReplicateDamageInfos(
     const std::vector<uint32_t>& entities,
     const std::vector<uint32_t>& spawn_entities,
-    bool force_replicate,
     BatchedMessageSender& batch_sender,
     const mono::UpdateContext& update_context)
 {
@@ -279,17 +561,18 @@ int ServerReplicator::ReplicateDamageInfos(
 
         HealthData& last_health = m_health_data[entity_id];
 
-        const bool same_as_last_time = (last_health.health == damage_record->health);
+        const int health = m_damage_system->GetHealth(entity_id);
+        const bool same_as_last_time = (last_health.health == health);
         const bool spawned_this_frame = mono::contains(spawn_entities, entity_id);
 
-        if(same_as_last_time && !spawned_this_frame && !force_replicate)
+        if(same_as_last_time && !spawned_this_frame)
             return;
 
-        last_health.health = damage_record->health;
+        last_health.health = health;
 
         DamageInfoMessage damage_info;
         damage_info.entity_id = entity_id;
-        damage_info.health = damage_record->health;
+        damage_info.health = health;
         damage_info.full_health = damage_record->full_health;
         damage_info.damage_timestamp = damage_record->last_damaged_timestamp;
         damage_info.is_boss = damage_record->is_boss;
@@ -304,3 +587,112 @@ int ServerReplicator::ReplicateDamageInfos(
 
     return replicated_damages;
 }
+
+int ServerReplicator::ReplicateEffectEvents(
+    BatchedMessageSender& batch_sender,
+    const math::Quad& client_viewport,
+    const mono::UpdateContext& update_context)
+{
+    int replicated_effects = 0;
+
+    const math::Quad& client_bb = math::ResizeQuad(client_viewport, 5.0f);
+
+    EffectEventsMessage effects_message;
+    effects_message.n_events = 0;
+
+    for(const EffectEvent& effect_event : GetRecordedEffectEvents())
+    {
+        if(!math::PointInsideQuad(effect_event.position, client_bb))
+            continue;
+
+        EffectEvent& replicated_event = effects_message.events[effects_message.n_events++];
+        replicated_event = effect_event;
+        replicated_event.timestamp = update_context.timestamp;
+        replicated_effects++;
+
+        if(effects_message.n_events == std::size(effects_message.events))
+        {
+            batch_sender.SendMessage(effects_message);
+            effects_message.n_events = 0;
+        }
+    }
+
+    if(effects_message.n_events > 0)
+        batch_sender.SendMessage(effects_message);
+
+    return replicated_effects;
+}
+
+int ServerReplicator::ReplicateProjectileEvents(
+    const network::Address& address,
+    BatchedMessageSender& batch_sender,
+    const math::Quad& client_viewport,
+    const mono::UpdateContext& update_context)
+{
+    int replicated_projectiles = 0;
+
+    // Projectiles are only replicated when they spawn or change direction, so a projectile is sent when the
+    // path it will fly until the next event crosses the viewport. Once sent, the client gets the rest of its events.
+    const math::Quad& client_bb = math::ResizeQuad(client_viewport, 2.0f);
+    std::vector<bool>& sent_projectiles = m_sent_projectiles[address];
+
+    ProjectileEventsMessage projectiles_message;
+    projectiles_message.n_events = 0;
+
+    for(const ProjectileEvent& projectile_event : m_projectile_system->GetRecordedEvents())
+    {
+        const uint32_t projectile_id = projectile_event.projectile_id;
+        if(projectile_id >= sent_projectiles.size())
+            sent_projectiles.resize(projectile_id + 1, false);
+
+        const bool was_sent = sent_projectiles[projectile_id];
+        ProjectileEventType replicated_type = projectile_event.type;
+
+        if(projectile_event.type == ProjectileEventType::DESTROY)
+        {
+            sent_projectiles[projectile_id] = false;
+            if(!was_sent)
+                continue;
+        }
+        else
+        {
+            // A spawn reuses the id of an earlier projectile.
+            if(projectile_event.type == ProjectileEventType::SPAWN)
+                sent_projectiles[projectile_id] = false;
+
+            if(!sent_projectiles[projectile_id])
+            {
+                const math::Vector& start = projectile_event.position;
+                const math::Vector end =
+                    start + projectile_event.velocity * (float(projectile_event.life_ms) / 1000.0f);
+                const math::Quad path_bb(
+                    math::Vector(std::min(start.x, end.x), std::min(start.y, end.y)),
+                    math::Vector(std::max(start.x, end.x), std::max(start.y, end.y)));
+
+                if(!math::QuadOverlaps(client_bb, path_bb))
+                    continue;
+
+                // The client does not have this projectile, a redirect is where it first comes into view.
+                replicated_type = ProjectileEventType::SPAWN;
+                sent_projectiles[projectile_id] = true;
+            }
+        }
+
+        ProjectileEvent& replicated_event = projectiles_message.events[projectiles_message.n_events++];
+        replicated_event = projectile_event;
+        replicated_event.type = replicated_type;
+        replicated_event.timestamp = update_context.timestamp;
+        replicated_projectiles++;
+
+        if(projectiles_message.n_events == std::size(projectiles_message.events))
+        {
+            batch_sender.SendMessage(projectiles_message);
+            projectiles_message.n_events = 0;
+        }
+    }
+
+    if(projectiles_message.n_events > 0)
+        batch_sender.SendMessage(projectiles_message);
+
+    return replicated_projectiles;
+}
@@ -6,9 +6,10 @@
 #include "IUpdatable.h"
 #include "NetworkMessage.h"
 #include "NetworkSerialize.h"
+#include "JoinSnapshot.h"
 
-#include <queue>
-#include <unordered_set>
+#include <vector>
+#include <unordered_map>
 
 namespace shared
 {
@@ -21,6 +22,9 @@ namespace game
     class ServerManager;
     class BatchedMessageSender;
     class DamageSystem;
+    class EntityPoolSystem;
+    class ProjectileSystem;
+    class SimulationClock;
     struct PlayerConnectedEvent;
 
     class ServerReplicator : public mono::IUpdatable
@@ -30,10 +34,14 @@ namespace game
         ServerReplicator(
             mono::EventHandler* event_handler,
             mono::EntitySystem* entity_system,
+            EntityPoolSystem* entity_pool,
             mono::TransformSystem* transform_system,
             mono::SpriteSystem* sprite_system,
             DamageSystem* damage_system,
+            ProjectileSystem* projectile_system,
             ServerManager* server_manager,
+            const SimulationClock* simulation_clock,
+            const char* world_file,
             const shared::LevelMetadata& level_metadata,
             uint32_t replication_interval);
         ~ServerReplicator();
@@ -41,44 +49,61 @@ namespace game
     private:
         void Update(const mono::UpdateContext& update_context) override;
 
+        void BuildJoinSnapshot(const network::Address& client_address, const mono::UpdateContext& update_context);
+        void SendSnapshotFragments(const mono::UpdateContext& update_context);
+        mono::EventResult HandleSnapshotAck(const SnapshotAckMessage& ack_message);
+
+        void EnsureReplicationData(uint32_t entity_id);
         void ReplicateSpawns(BatchedMessageSender& batched_sender, const mono::UpdateContext& update_context);
         int ReplicateTransforms(
             const std::vector<uint32_t>& entities,
             const std::vector<uint32_t>& spawn_entities,
-            bool force_replicate,
             BatchedMessageSender& batched_sender,
             const math::Quad& client_viewport,
             const mono::UpdateContext& update_context);
         int ReplicateSprites(
             const std::vector<uint32_t>& entities,
             const std::vector<uint32_t>& spawn_entities,
-            bool force_replicate,
             BatchedMessageSender& batched_sender,
             const mono::UpdateContext& update_context);
         int ReplicateDamageInfos(
             const std::vector<uint32_t>& entities,
             const std::vector<uint32_t>& spawn_entities,
-            bool force_replicate,
             BatchedMessageSender& batch_sender,
             const mono::UpdateContext& update_context);
+        int ReplicateEffectEvents(
+            BatchedMessageSender& batch_sender,
+            const math::Quad& client_viewport,
+            const mono::UpdateContext& update_context);
+        int ReplicateProjectileEvents(
+            const network::Address& address,
+            BatchedMessageSender& batch_sender,
+            const math::Quad& client_viewport,
+            const mono::UpdateContext& update_context);
 
         mono::EventHandler* m_event_handler;
         mono::EntitySystem* m_entity_system;
+        EntityPoolSystem* m_entity_pool;
         mono::TransformSystem* m_transform_system;
         mono::SpriteSystem* m_sprite_system;
         DamageSystem* m_damage_system;
+        ProjectileSystem* m_projectile_system;
         ServerManager* m_server_manager;
+        const SimulationClock* m_simulation_clock;
         uint32_t m_replication_interval;
 
         mono::EventToken<PlayerConnectedEvent> m_connected_token;
+        mono::EventToken<SnapshotAckMessage> m_snapshot_ack_token;
 
+        // Last replicated state per entity id, grows with the entity ids.
         struct TransformData
         {
-            int time_to_replicate;
+            uint32_t replicate_timestamp;
             math::Vector position;
             float rotation;
             uint16_t parent_transform;
-        } m_transform_data[500];
+        };
+        std::vector<TransformData> m_transform_data;
 
         struct SpriteData
         {
@@ -86,14 +111,45 @@ namespace game
             uint32_t hex_color;
             uint32_t properties;
             short animation_id;
-        } m_sprite_data[500];
+        };
+        std::vector<SpriteData> m_sprite_data;
 
         struct HealthData
         {
             int health;
-        } m_health_data[500];
+        };
+        std::vector<HealthData> m_health_data;
+
+        std::vector<uint32_t> m_transforms_to_replicate;
+        std::vector<uint32_t> m_sprites_to_replicate;
+        std::vector<uint32_t> m_damage_info_to_replicate;
+        std::vector<uint32_t> m_spawns_this_frame;
+        std::vector<uint32_t> m_local_entities;
+        std::vector<uint32_t> m_last_local_entities;
+
+        // Join snapshots waiting for acks, one per client. Unacked fragments are resent until the
+        // client has all of them or the snapshot times out.
+        struct PendingSnapshot
+        {
+            network::Address address;
+            uint32_t snapshot_id;
+            uint32_t uncompressed_size;
+            uint32_t created_timestamp;
+            uint32_t acked_fragments;
+            std::vector<byte> data;
+            std::vector<uint32_t> fragment_sent_timestamps;
+            std::vector<bool> fragment_acked;
+        };
+
+        uint32_t m_snapshot_id_counter;
+        JoinSnapshot m_snapshot;
+        std::vector<PendingSnapshot> m_pending_snapshots;
+
+        std::vector<NetworkMessage> m_message_queue;
+        std::vector<network::Address> m_known_clients;
+        std::vector<network::Address> m_replicated_clients;
 
-        std::queue<NetworkMessage> m_message_queue;
-        std::unordered_set<network::Address> m_known_clients;
+        // Projectile ids each client has been sent a spawn for, so that the later events follow.
+        std::unordered_map<network::Address, std::vector<bool>> m_sent_projectiles;
     };
 }
@@ -1,78 +1,47 @@
 
 #include "PickupSystem.h"
+#include "Component.h"
+#include "CollisionConfiguration.h"
+#include "Entity/EntityPoolSystem.h"
 
 #include "System/Hash.h"
+#include "Math/MathFunctions.h"
+#include "Physics/IBody.h"
+#include "Physics/IShape.h"
 #include "Physics/PhysicsSystem.h"
+#include "Physics/PhysicsSpace.h"
 
-#include "EntitySystem/IEntityManager.h"
+#include <algorithm>
 
 using namespace game;
 
 namespace
 {
-    class PickupHandler : public mono::ICollisionHandler
-    {
-    public:
-
-        PickupHandler(PickupSystem* pickup_system, uint32_t pickup_id)
-            : m_pickup_system(pickup_system)
-            , m_pickup_id(pickup_id)
-        { }
-
-        mono::CollisionResolve OnCollideWith(
-            mono::IBody* body, const math::Vector& collision_point, const math::Vector& collision_normal, uint32_t categories) override
-        {
-            const uint32_t target_id = mono::PhysicsSystem::GetIdFromBody(body);
-            m_pickup_system->HandlePickup(m_pickup_id, target_id);
-
-            return mono::CollisionResolve::IGNORE;
-        }
-
-        void OnSeparateFrom(mono::IBody* body) override
-        { }
-
-        PickupSystem* m_pickup_system;
-        uint32_t m_pickup_id;
-    };
+    // Reach of a target, pickups with a shape this close to the bounds of the target's shapes are picked up.
+    constexpr float pickup_reach = 0.1f;
 }
 
-PickupSystem::PickupSystem(uint32_t n, mono::PhysicsSystem* physics_system, mono::IEntityManager* entity_manager)
+PickupSystem::PickupSystem(uint32_t n, mono::PhysicsSystem* physics_system, EntityPoolSystem* entity_pool)
     : m_physics_system(physics_system)
-    , m_entity_manager(entity_manager)
+    , m_entity_pool(entity_pool)
+    , m_updating(false)
 {
-    m_pickups.resize(n);
-    m_active.resize(n, false);
-    m_collision_handlers.resize(n);
+    m_pickups.EnsureSize(n);
+    m_active = SparseSet(n);
 
     m_pickup_sound = audio::CreateSound("res/sound/item_pickup.wav", audio::SoundPlayback::ONCE);
 }
 
 game::Pickup* PickupSystem::AllocatePickup(uint32_t entity_id)
 {
-    m_active[entity_id] = true;
-    game::Pickup* allocated_pickup = &m_pickups[entity_id];
-
-    mono::IBody* body = m_physics_system->GetBody(entity_id);
-    if(body)
-    {
-        auto handler = std::make_unique<PickupHandler>(this, entity_id);
-        body->AddCollisionHandler(handler.get());
-        m_collision_handlers[entity_id] = std::move(handler);
-    }
-
-    return allocated_pickup;
+    m_active.Add(entity_id);
+    m_pickups.EnsureSize(entity_id + 1);
+    return &m_pickups[entity_id];
 }
 
 void PickupSystem::ReleasePickup(uint32_t entity_id)
 {
-    auto& handler = m_collision_handlers[entity_id];
-
-    mono::IBody* body = m_physics_system->GetBody(entity_id);
-    if(body)
-        body->RemoveCollisionHandler(handler.get());
-
-    m_active[entity_id] = false;
-    m_collision_handlers[entity_id] = nullptr;
+    m_active.Remove(entity_id);
 }
 
 void PickupSystem::SetPickupData(uint32_t id, const Pickup& pickup_data)
@@ -80,19 +49,43 @@ void PickupSystem::SetPickupData(uint32_t id, const Pickup& pickup_data)
     m_pickups[id] = pickup_data;
 }
 
-void PickupSystem::HandlePickup(uint32_t pickup_id, uint32_t target_id)
+void PickupSystem::SetPickupEnabled(uint32_t id, bool enabled)
 {
-    m_pickups_to_process.push_back( { pickup_id, target_id } );
+    m_active.Set(id, enabled);
 }
 
 void PickupSystem::RegisterPickupTarget(uint32_t target_id, PickupCallback callback)
 {
-    m_pickup_targets[target_id] = callback;
+    if(m_updating)
+    {
+        m_pending_targets.push_back({ target_id, callback });
+        return;
+    }
+
+    const auto it = std::find_if(m_pickup_targets.begin(), m_pickup_targets.end(), [target_id](const PickupTarget& target) {
+        return target.target_id == target_id;
+    });
+
+    if(it != m_pickup_targets.end())
+        it->callback = callback;
+    else
+        m_pickup_targets.push_back({ target_id, callback });
 }
 
 void PickupSystem::UnregisterPickupTarget(uint32_t target_id)
 {
-    m_pickup_targets.erase(target_id);
+    if(m_updating)
+    {
+        m_pending_targets.push_back({ target_id, nullptr });
+        return;
+    }
+
+    const auto it = std::find_if(m_pickup_targets.begin(), m_pickup_targets.end(), [target_id](const PickupTarget& target) {
+        return target.target_id == target_id;
+    });
+
+    if(it != m_pickup_targets.end())
+        m_pickup_targets.erase(it);
 }
 
 uint32_t PickupSystem::Id() const
@@ -105,23 +98,71 @@ const char* PickupSystem::Name() const
     return "pickupsystem";
 }
 
-void PickupSystem::Update(const mono::UpdateContext& update_context)
+SystemAccess PickupSystem::Access() const
+{
+    // The pickup callbacks can do anything, and releasing to the entity pool touches most component systems.
+    SystemAccess access;
+    access.exclusive = true;
+    return access;
+}
+
+void PickupSystem::ScheduledUpdate(const mono::UpdateContext& update_context)
 {
-    for(const PickupToTarget& pickup : m_pickups_to_process)
+    if(m_active.Empty())
+        return;
+
+    mono::PhysicsSpace* space = m_physics_system->GetSpace();
+
+    m_updating = true;
+
+    for(const PickupTarget& target : m_pickup_targets)
     {
-        const auto it = m_pickup_targets.find(pickup.target_id);
-        if(it != m_pickup_targets.end())
+        const mono::IBody* target_body = m_physics_system->GetBody(target.target_id);
+        if(!target_body)
+            continue;
+
+        math::Quad target_bb = { math::INF, math::INF, -math::INF, -math::INF };
+        for(const mono::IShape* shape : m_physics_system->GetShapesAttachedToBody(target.target_id))
+            target_bb |= shape->GetBoundingBox();
+
+        // A target without shapes only reaches around the center of its body.
+        if(target_bb.mA.x > target_bb.mB.x)
+            target_bb = math::Quad(target_body->GetPosition(), target_body->GetPosition());
+
+        math::ResizeQuad(target_bb, pickup_reach);
+
+        m_found_bodies.clear();
+        space->QueryBox(target_bb, shared::CollisionCategory::PICKUPS, m_found_bodies);
+
+        for(mono::IBody* body : m_found_bodies)
         {
-            const Pickup& pickup_data = m_pickups[pickup.pickup_id];
-            it->second(pickup_data.type, pickup_data.amount);
+            const uint32_t pickup_id = mono::PhysicsSystem::GetIdFromBody(body);
+
+            // Already taken by a target before this one.
+            if(!m_active.Contains(pickup_id))
+                continue;
 
+            m_active.Remove(pickup_id);
+
+            const Pickup& pickup_data = m_pickups[pickup_id];
+            target.callback(pickup_data.type, pickup_data.amount);
             PlayPickupSound(pickup_data.type);
+
+            m_entity_pool->ReleaseEntity(pickup_id);
         }
+    }
 
-        m_entity_manager->ReleaseEntity(pickup.pickup_id);
+    m_updating = false;
+
+    for(const PickupTarget& pending_target : m_pending_targets)
+    {
+        if(pending_target.callback)
+            RegisterPickupTarget(pending_target.target_id, pending_target.callback);
+        else
+            UnregisterPickupTarget(pending_target.target_id);
     }
 
-    m_pickups_to_process.clear();
+    m_pending_targets.clear();
 }
 
 void PickupSystem::PlayPickupSound(shared::PickupType type)
@@ -1,7 +1,9 @@
 
 #pragma once
 
-#include "IGameSystem.h"
+#include "Scheduler/ScheduledSystem.h"
+#include "SparseSet.h"
+#include "ChunkedArray.h"
 #include "MonoFwd.h"
 
 #include "PickupTypes.h"
@@ -9,9 +11,7 @@
 #include "System/Audio.h"
 
 #include <vector>
-#include <memory>
 #include <functional>
-#include <unordered_map>
 
 namespace game
 {
@@ -23,44 +23,55 @@ namespace game
 
     using PickupCallback = std::function<void (shared::PickupType type, int amount)>;
 
-    class PickupSystem : public mono::IGameSystem
+    class EntityPoolSystem;
+
+    class PickupSystem : public ScheduledSystem
     {
     public:
         
-        PickupSystem(uint32_t n, mono::PhysicsSystem* physics_system, mono::IEntityManager* entity_manager);
+        PickupSystem(uint32_t n, mono::PhysicsSystem* physics_system, EntityPoolSystem* entity_pool);
 
         Pickup* AllocatePickup(uint32_t id);
         void ReleasePickup(uint32_t id);
         void SetPickupData(uint32_t id, const Pickup& pickup_data);
 
-        void HandlePickup(uint32_t pickup_id, uint32_t target_id);
+        // A disabled pickup can not be picked up, used while the entity waits in a pool.
+        void SetPickupEnabled(uint32_t id, bool enabled);
+
         void RegisterPickupTarget(uint32_t target_id, PickupCallback callback);
         void UnregisterPickupTarget(uint32_t target_id);
 
         // IGameSystem
         uint32_t Id() const override;
         const char* Name() const override;
-        void Update(const mono::UpdateContext& update_context) override;
+        void ScheduledUpdate(const mono::UpdateContext& update_context) override;
+        SystemAccess Access() const override;
 
     private:
 
         void PlayPickupSound(shared::PickupType type);
 
         mono::PhysicsSystem* m_physics_system;
-        mono::IEntityManager* m_entity_manager;
+        EntityPoolSystem* m_entity_pool;
 
-        std::vector<Pickup> m_pickups;
-        std::vector<bool> m_active;
-        std::vector<std::unique_ptr<mono::ICollisionHandler>> m_collision_handlers;
-        std::unordered_map<uint32_t, PickupCallback> m_pickup_targets;
+        ChunkedArray<Pickup> m_pickups;
+        SparseSet m_active;
 
-        struct PickupToTarget
+        struct PickupTarget
         {
-            uint32_t pickup_id;
             uint32_t target_id;
+            PickupCallback callback;
         };
 
-        std::vector<PickupToTarget> m_pickups_to_process;
+        // Few targets, one per player, each looks for pickups around it once per update. The query results
+        // go in the same buffer every time.
+        std::vector<PickupTarget> m_pickup_targets;
+        std::vector<mono::IBody*> m_found_bodies;
+
+        // Targets registered or unregistered from a pickup callback, applied after the update. No callback
+        // means unregister.
+        bool m_updating;
+        std::vector<PickupTarget> m_pending_targets;
 
         audio::ISoundPtr m_pickup_sound;
     };
@@ -55,8 +55,7 @@ namespace
         game::EntityLogicSystem* logic_system = system_context->GetSystem<EntityLogicSystem>();
         entity_system->AddComponent(player_entity.id, BEHAVIOUR_COMPONENT);
 
-        IEntityLogic* player_logic = new PlayerLogic(player_entity.id, player_info, event_handler, controller, system_context);
-        logic_system->AddLogic(player_entity.id, player_logic);
+        logic_system->CreateLogic<PlayerLogic>(player_entity.id, player_entity.id, player_info, event_handler, controller, system_context);
 
         player_info->entity_id = player_entity.id;
         player_info->player_state = game::PlayerState::ALIVE;
@@ -260,7 +259,7 @@ mono::EventResult PlayerDaemon::RemotePlayerConnected(const PlayerConnectedEvent
     NetworkMessage reply_message;
     reply_message.payload = SerializeMessage(client_spawned_message);
 
-    m_remote_connection->SendMessageTo(reply_message, event.address);
+    m_remote_connection->SendMessageTo(std::move(reply_message), event.address);
 
     return mono::EventResult::HANDLED;
 }
@@ -328,7 +327,7 @@ mono::EventResult PlayerDaemon::OnRespawnPlayer(const RespawnPlayerEvent& event)
 
         game::DamageSystem* damage_system = m_system_context->GetSystem<game::DamageSystem>();
         game::DamageRecord* record = damage_system->GetDamageRecord(event.entity_id);
-        record->health = record->full_health;
+        damage_system->SetHealth(event.entity_id, record->full_health);
         record->last_damaged_timestamp = 0;
 
         player_info->player_state = game::PlayerState::ALIVE;
@@ -71,8 +71,7 @@ PlayerLogic::PlayerLogic(
             break;
         case shared::PickupType::HEALTH:
         {
-            DamageRecord* record = damage_system->GetDamageRecord(m_entity_id);
-            record->health += amount;
+            damage_system->SetHealth(m_entity_id, damage_system->GetHealth(m_entity_id) + amount);
             break;
         }
         case shared::PickupType::SCORE:
@@ -21,13 +21,12 @@ PositionPredictionSystem::PositionPredictionSystem(
     size_t num_records,
     const ClientManager* client_manager,
     mono::TransformSystem* transform_system)
-    : m_client_manager(client_manager)
+    : m_max_records(num_records)
+    , m_client_manager(client_manager)
     , m_transform_system(transform_system)
 {
-    m_prediction_data.resize(num_records);
-
-    for(uint32_t index = 0; index < num_records; ++index)
-        ClearPredictionsForEntity(index);
+    if(num_records > 0)
+        EnsureRecord(num_records - 1);
 }
 
 uint32_t PositionPredictionSystem::Id() const
@@ -99,13 +98,22 @@ void PositionPredictionSystem::Update(const mono::UpdateContext& update_context)
         transform = math::CreateMatrixFromZRotation(prediction_data.predicted_rotation);
         math::Position(transform, prediction_data.predicted_position);
 
-        if(new_parent_transform != no_parent_16)
+        if(new_parent_transform != no_parent_16 && new_parent_transform < m_max_records)
             m_transform_system->ChildTransform(index, new_parent_transform);
     }
 }
 
 void PositionPredictionSystem::HandlePredicitonMessage(const TransformMessage& transform_message)
 {
+    if(!EnsureRecord(transform_message.entity_id))
+    {
+        System::Log(
+            "PositionPredictionSystem|Transform message for entity %u, outside of the %zu records, will skip.",
+            transform_message.entity_id,
+            m_max_records);
+        return;
+    }
+
     PredictionData& prediction_data = m_prediction_data[transform_message.entity_id];
     RemoteTransformBuffer& prediction_buffer = prediction_data.prediction_buffer;
 
@@ -132,6 +140,12 @@ void PositionPredictionSystem::HandlePredicitonMessage(const TransformMessage& t
 
 void PositionPredictionSystem::ClearPredictionsForEntity(uint32_t entity_id)
 {
+    if(entity_id >= m_prediction_data.size())
+    {
+        EnsureRecord(entity_id);
+        return;
+    }
+
     PredictionData& prediction_data = m_prediction_data[entity_id];
     prediction_data.predicted_position = math::ZeroVec;
 
@@ -144,6 +158,22 @@ void PositionPredictionSystem::ClearPredictionsForEntity(uint32_t entity_id)
     }
 }
 
+bool PositionPredictionSystem::EnsureRecord(uint32_t entity_id)
+{
+    if(entity_id >= m_max_records)
+        return false;
+
+    const size_t old_size = m_prediction_data.size();
+    if(entity_id < old_size)
+        return true;
+
+    m_prediction_data.resize(std::min(std::max(size_t(entity_id) + 1, old_size * 2), m_max_records));
+    for(size_t index = old_size; index < m_prediction_data.size(); ++index)
+        ClearPredictionsForEntity(index);
+
+    return true;
+}
+
 uint32_t PositionPredictionSystem::FindBestPredictionIndex(uint32_t timestamp, const RemoteTransformBuffer& prediction_buffer)
 {
     uint32_t best_index = 0;
@@ -29,6 +29,11 @@ namespace game
         void HandlePredicitonMessage(const struct TransformMessage& transform_message);
         void ClearPredictionsForEntity(uint32_t entity_id);
 
+        // The records grow when a message arrives for an entity outside of them. The predicted transforms are written
+        // to the engine transform system, which has room for num_records entities, so ids past that are rejected.
+        bool EnsureRecord(uint32_t entity_id);
+
+        const size_t m_max_records;
         const ClientManager* m_client_manager;
         mono::TransformSystem* m_transform_system;
 
@@ -0,0 +1,52 @@
+
+#pragma once
+
+#include "IGameSystem.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace game
+{
+    // Non component data that systems share, declared the same way as the component stores.
+    extern const uint32_t ENTITY_MANAGER_RESOURCE;
+    extern const uint32_t TRIGGERS_RESOURCE;
+    extern const uint32_t CAMERA_RESOURCE;
+    extern const uint32_t PLAYERS_RESOURCE;
+    extern const uint32_t AUDIO_RESOURCE;
+
+    // The component stores (component hashes from Component.h) and resources a system reads and writes
+    // in its update. An exclusive system can touch anything, typically through callbacks, and runs alone.
+    struct SystemAccess
+    {
+        std::vector<uint32_t> reads;
+        std::vector<uint32_t> writes;
+        bool exclusive = false;
+    };
+
+    bool AccessConflicts(const SystemAccess& first, const SystemAccess& second);
+
+    // A game system that can be updated by the SystemScheduler. When it is added to a scheduler the
+    // regular update from the engine does nothing, without one it updates like any other system.
+    class ScheduledSystem : public mono::IGameSystem
+    {
+    public:
+
+        void Update(const mono::UpdateContext& update_context) final
+        {
+            if(!m_scheduled)
+                ScheduledUpdate(update_context);
+        }
+
+        virtual void ScheduledUpdate(const mono::UpdateContext& update_context) = 0;
+        virtual SystemAccess Access() const = 0;
+
+        void SetScheduled(bool scheduled)
+        {
+            m_scheduled = scheduled;
+        }
+
+    private:
+        bool m_scheduled = false;
+    };
+}
@@ -0,0 +1,272 @@
+
+#include "SystemScheduler.h"
+#include "GameDebug.h"
+#include "System/Hash.h"
+#include "System/System.h"
+#include "Util/Algorithm.h"
+
+using namespace game;
+
+const uint32_t game::ENTITY_MANAGER_RESOURCE = hash::Hash("entity_manager_resource");
+const uint32_t game::TRIGGERS_RESOURCE = hash::Hash("triggers_resource");
+const uint32_t game::CAMERA_RESOURCE = hash::Hash("camera_resource");
+const uint32_t game::PLAYERS_RESOURCE = hash::Hash("players_resource");
+const uint32_t game::AUDIO_RESOURCE = hash::Hash("audio_resource");
+
+namespace
+{
+    bool AnyOf(const std::vector<uint32_t>& first, const std::vector<uint32_t>& second)
+    {
+        for(uint32_t value : first)
+        {
+            if(mono::contains(second, value))
+                return true;
+        }
+
+        return false;
+    }
+}
+
+bool game::AccessConflicts(const SystemAccess& first, const SystemAccess& second)
+{
+    if(first.exclusive || second.exclusive)
+        return true;
+
+    return
+        AnyOf(first.writes, second.writes) ||
+        AnyOf(first.writes, second.reads) ||
+        AnyOf(first.reads, second.writes);
+}
+
+SystemScheduler::SystemScheduler(uint32_t n_worker_threads)
+    : m_n_worker_threads(n_worker_threads)
+    , m_graph_dirty(false)
+    , m_parallel_work(false)
+    , m_frame_time_ms(0.0f)
+    , m_update_context(nullptr)
+    , m_tasks_left(0)
+    , m_stop(false)
+{ }
+
+SystemScheduler::~SystemScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_work_signal.notify_all();
+
+    for(std::thread& worker : m_workers)
+        worker.join();
+
+    for(SystemNode& node : m_nodes)
+        node.system->SetScheduled(false);
+}
+
+void SystemScheduler::AddSystem(ScheduledSystem* system)
+{
+    SystemNode node;
+    node.system = system;
+    node.access = system->Access();
+    node.n_dependencies = 0;
+    m_nodes.push_back(node);
+
+    SystemTiming timing;
+    timing.name = system->Name();
+    timing.time_ms = 0.0f;
+    timing.thread_index = 0;
+    m_timings.push_back(timing);
+
+    system->SetScheduled(true);
+    m_graph_dirty = true;
+}
+
+uint32_t SystemScheduler::Id() const
+{
+    return hash::Hash(Name());
+}
+
+const char* SystemScheduler::Name() const
+{
+    return "systemscheduler";
+}
+
+void SystemScheduler::Update(const mono::UpdateContext& update_context)
+{
+    if(m_graph_dirty)
+        BuildGraph();
+
+    const uint64_t start_time = System::GetPerformanceCounter();
+
+    if(game::g_single_threaded_systems || !m_parallel_work || m_workers.empty())
+        RunSingleThreaded(update_context);
+    else
+        RunParallel(update_context);
+
+    const uint64_t end_time = System::GetPerformanceCounter();
+    m_frame_time_ms = float(end_time - start_time) * 1000.0f / System::GetPerformanceFrequency();
+}
+
+const std::vector<SystemTiming>& SystemScheduler::GetSystemTimings() const
+{
+    return m_timings;
+}
+
+float SystemScheduler::FrameTimeMs() const
+{
+    return m_frame_time_ms;
+}
+
+uint32_t SystemScheduler::WorkerThreads() const
+{
+    return m_workers.size();
+}
+
+bool SystemScheduler::HasParallelWork() const
+{
+    return m_parallel_work;
+}
+
+void SystemScheduler::BuildGraph()
+{
+    // A system depends on every earlier system it conflicts with, which keeps the order between
+    // them the same as the order they were added in.
+    for(uint32_t index = 0; index < m_nodes.size(); ++index)
+    {
+        SystemNode& node = m_nodes[index];
+        node.dependents.clear();
+        node.n_dependencies = 0;
+
+        for(uint32_t earlier_index = 0; earlier_index < index; ++earlier_index)
+        {
+            SystemNode& earlier_node = m_nodes[earlier_index];
+            if(AccessConflicts(earlier_node.access, node.access))
+            {
+                earlier_node.dependents.push_back(index);
+                node.n_dependencies++;
+            }
+        }
+    }
+
+    // Edges only go to later systems, so when every system conflicts with the one before it the graph
+    // is a chain and nothing can overlap. Then it's cheaper to skip the workers and the handoffs.
+    m_parallel_work = false;
+    for(uint32_t index = 1; index < m_nodes.size(); ++index)
+    {
+        if(!AccessConflicts(m_nodes[index - 1].access, m_nodes[index].access))
+        {
+            m_parallel_work = true;
+            break;
+        }
+    }
+
+    // The workers are started the first time there is something for them to do.
+    if(m_parallel_work && m_workers.empty())
+    {
+        for(uint32_t index = 0; index < m_n_worker_threads; ++index)
+            m_workers.emplace_back(&SystemScheduler::WorkerFunc, this, index + 1);
+    }
+
+    m_remaining_dependencies.resize(m_nodes.size());
+    m_graph_dirty = false;
+}
+
+void SystemScheduler::RunSingleThreaded(const mono::UpdateContext& update_context)
+{
+    for(uint32_t index = 0; index < m_nodes.size(); ++index)
+    {
+        const uint64_t start_time = System::GetPerformanceCounter();
+        m_nodes[index].system->ScheduledUpdate(update_context);
+        const uint64_t end_time = System::GetPerformanceCounter();
+
+        SystemTiming& timing = m_timings[index];
+        timing.time_ms = float(end_time - start_time) * 1000.0f / System::GetPerformanceFrequency();
+        timing.thread_index = 0;
+    }
+}
+
+void SystemScheduler::RunParallel(const mono::UpdateContext& update_context)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_update_context = &update_context;
+    m_tasks_left = m_nodes.size();
+    m_ready_tasks.clear();
+
+    for(uint32_t index = 0; index < m_nodes.size(); ++index)
+    {
+        m_remaining_dependencies[index] = m_nodes[index].n_dependencies;
+        if(m_remaining_dependencies[index] == 0)
+            m_ready_tasks.push_back(index);
+    }
+
+    m_work_signal.notify_all();
+
+    // The main thread works on the graph as well until every system is done.
+    while(m_tasks_left > 0)
+    {
+        m_work_signal.wait(lock, [this] { return !m_ready_tasks.empty() || m_tasks_left == 0; });
+        if(!m_ready_tasks.empty())
+        {
+            const uint32_t task_index = m_ready_tasks.back();
+            m_ready_tasks.pop_back();
+            RunTask(task_index, 0, lock);
+        }
+    }
+
+    m_update_context = nullptr;
+}
+
+void SystemScheduler::WorkerFunc(uint32_t thread_index)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while(true)
+    {
+        m_work_signal.wait(lock, [this] { return m_stop || !m_ready_tasks.empty(); });
+        if(m_stop)
+            break;
+
+        const uint32_t task_index = m_ready_tasks.back();
+        m_ready_tasks.pop_back();
+        RunTask(task_index, thread_index, lock);
+    }
+}
+
+void SystemScheduler::RunTask(uint32_t task_index, uint32_t thread_index, std::unique_lock<std::mutex>& lock)
+{
+    const mono::UpdateContext& update_context = *m_update_context;
+    SystemNode& node = m_nodes[task_index];
+
+    lock.unlock();
+
+    const uint64_t start_time = System::GetPerformanceCounter();
+    node.system->ScheduledUpdate(update_context);
+    const uint64_t end_time = System::GetPerformanceCounter();
+
+    lock.lock();
+
+    SystemTiming& timing = m_timings[task_index];
+    timing.time_ms = float(end_time - start_time) * 1000.0f / System::GetPerformanceFrequency();
+    timing.thread_index = thread_index;
+
+    bool notify = false;
+
+    for(uint32_t dependent_index : node.dependents)
+    {
+        m_remaining_dependencies[dependent_index]--;
+        if(m_remaining_dependencies[dependent_index] == 0)
+        {
+            m_ready_tasks.push_back(dependent_index);
+            notify = true;
+        }
+    }
+
+    m_tasks_left--;
+    if(m_tasks_left == 0)
+        notify = true;
+
+    if(notify)
+        m_work_signal.notify_all();
+}
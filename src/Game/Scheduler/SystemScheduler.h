@@ -0,0 +1,82 @@
+
+#pragma once
+
+#include "IGameSystem.h"
+#include "ScheduledSystem.h"
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+namespace game
+{
+    struct SystemTiming
+    {
+        const char* name;
+        float time_ms;
+        uint32_t thread_index;
+    };
+
+    // Updates the scheduled systems as a dependency graph. Systems are ordered as they were added, two systems
+    // only run concurrently when their declared access doesn't conflict, so the result is the same as updating
+    // them one after the other. When the graph is a chain the systems are updated in order on the calling
+    // thread and no workers are started. Create it where the scheduled systems would otherwise have been updated.
+    class SystemScheduler : public mono::IGameSystem
+    {
+    public:
+
+        SystemScheduler(uint32_t n_worker_threads);
+        ~SystemScheduler();
+
+        void AddSystem(ScheduledSystem* system);
+
+        uint32_t Id() const override;
+        const char* Name() const override;
+        void Update(const mono::UpdateContext& update_context) override;
+
+        const std::vector<SystemTiming>& GetSystemTimings() const;
+
+        // Wall time of the last update of all systems, safe to read from a system while it's updated.
+        float FrameTimeMs() const;
+        uint32_t WorkerThreads() const;
+        bool HasParallelWork() const;
+
+    private:
+
+        void BuildGraph();
+        void RunSingleThreaded(const mono::UpdateContext& update_context);
+        void RunParallel(const mono::UpdateContext& update_context);
+
+        void WorkerFunc(uint32_t thread_index);
+        void RunTask(uint32_t task_index, uint32_t thread_index, std::unique_lock<std::mutex>& lock);
+
+        struct SystemNode
+        {
+            ScheduledSystem* system;
+            SystemAccess access;
+            std::vector<uint32_t> dependents;
+            uint32_t n_dependencies;
+        };
+
+        std::vector<SystemNode> m_nodes;
+        std::vector<SystemTiming> m_timings;
+        uint32_t m_n_worker_threads;
+        bool m_graph_dirty;
+        bool m_parallel_work;
+        float m_frame_time_ms;
+
+        // Per frame state, all guarded by m_mutex. The systems are few and heavy so a shared ready
+        // list is enough, the lock is only held while picking and completing tasks.
+        const mono::UpdateContext* m_update_context;
+        std::vector<uint32_t> m_remaining_dependencies;
+        std::vector<uint32_t> m_ready_tasks;
+        uint32_t m_tasks_left;
+        bool m_stop;
+
+        std::mutex m_mutex;
+        std::condition_variable m_work_signal;
+        std::vector<std::thread> m_workers;
+    };
+}
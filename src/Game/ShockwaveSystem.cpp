@@ -0,0 +1,290 @@
+
+#include "ShockwaveSystem.h"
+#include "DamageSystem.h"
+#include "CollisionConfiguration.h"
+
+#include "Math/MathFunctions.h"
+#include "Math/Quad.h"
+#include "Physics/IBody.h"
+#include "Physics/IShape.h"
+#include "Physics/PhysicsSystem.h"
+#include "Physics/PhysicsSpace.h"
+#include "System/Hash.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace game;
+
+float game::ShockwaveFalloff(FalloffCurve curve, float distance, float radius)
+{
+    if(distance > radius)
+        return 0.0f;
+
+    const float scale = (radius > 0.0f) ? (1.0f - distance / radius) : 1.0f;
+
+    switch(curve)
+    {
+    case FalloffCurve::CONSTANT:
+        return 1.0f;
+    case FalloffCurve::LINEAR:
+        return scale;
+    case FalloffCurve::QUADRATIC:
+        return scale * scale;
+    }
+
+    return 1.0f;
+}
+
+void game::ClusterShockwaves(const std::vector<ShockwaveParams>& shockwaves, std::vector<math::Quad>& out_bounds)
+{
+    const size_t first_bounds = out_bounds.size();
+
+    for(const ShockwaveParams& shockwave : shockwaves)
+    {
+        math::Quad bounds(
+            math::Vector(shockwave.position.x - shockwave.radius, shockwave.position.y - shockwave.radius),
+            math::Vector(shockwave.position.x + shockwave.radius, shockwave.position.y + shockwave.radius));
+
+        // The merged bounds grow, so start over after a merge until nothing overlaps.
+        size_t index = first_bounds;
+        while(index < out_bounds.size())
+        {
+            const math::Quad& cluster = out_bounds[index];
+            const bool overlaps =
+                bounds.mA.x <= cluster.mB.x && cluster.mA.x <= bounds.mB.x &&
+                bounds.mA.y <= cluster.mB.y && cluster.mA.y <= bounds.mB.y;
+            if(!overlaps)
+            {
+                ++index;
+                continue;
+            }
+
+            bounds.mA.x = std::min(bounds.mA.x, cluster.mA.x);
+            bounds.mA.y = std::min(bounds.mA.y, cluster.mA.y);
+            bounds.mB.x = std::max(bounds.mB.x, cluster.mB.x);
+            bounds.mB.y = std::max(bounds.mB.y, cluster.mB.y);
+
+            out_bounds[index] = out_bounds.back();
+            out_bounds.pop_back();
+            index = first_bounds;
+        }
+
+        out_bounds.push_back(bounds);
+    }
+}
+
+void game::AccumulateShockwaves(
+    const std::vector<ShockwaveParams>& shockwaves,
+    const std::vector<ShockwaveBody>& bodies,
+    std::vector<ShockwaveImpulse>& out_impulses,
+    std::vector<ShockwaveDamage>& out_damage)
+{
+    const uint32_t n_bodies = bodies.size();
+
+    // The spin around the body's position is summed separately, and turned into an application point at the end.
+    out_impulses.assign(n_bodies, { math::Vector(0.0f, 0.0f), 0.0f, math::Vector(0.0f, 0.0f) });
+
+    const size_t first_damage = out_damage.size();
+
+    for(const ShockwaveParams& shockwave : shockwaves)
+    {
+        const float radius_squared = shockwave.radius * shockwave.radius;
+
+        for(uint32_t index = 0; index < n_bodies; ++index)
+        {
+            const ShockwaveBody& body = bodies[index];
+
+            // Where the shockwave hits the body, the center if it's inside of the bounds.
+            const float hit_x = std::clamp(shockwave.position.x, body.bounds.mA.x, body.bounds.mB.x);
+            const float hit_y = std::clamp(shockwave.position.y, body.bounds.mA.y, body.bounds.mB.y);
+
+            float delta_x = hit_x - shockwave.position.x;
+            float delta_y = hit_y - shockwave.position.y;
+            const float distance_squared = delta_x * delta_x + delta_y * delta_y;
+            if(distance_squared > radius_squared)
+                continue;
+
+            const float distance = std::sqrt(distance_squared);
+
+            // Inside of the bounds the body is pushed away from the center, right at its position it has no
+            // direction to be pushed in, but still takes the damage.
+            if(distance == 0.0f)
+            {
+                delta_x = body.position.x - shockwave.position.x;
+                delta_y = body.position.y - shockwave.position.y;
+            }
+
+            const float direction_length = std::sqrt(delta_x * delta_x + delta_y * delta_y);
+            if(direction_length > 0.0f)
+            {
+                const float impulse =
+                    shockwave.magnitude * ShockwaveFalloff(shockwave.impulse_falloff, distance, shockwave.radius) / direction_length;
+                const float impulse_x = delta_x * impulse;
+                const float impulse_y = delta_y * impulse;
+
+                out_impulses[index].impulse.x += impulse_x;
+                out_impulses[index].impulse.y += impulse_y;
+                out_impulses[index].torque += (hit_x - body.position.x) * impulse_y - (hit_y - body.position.y) * impulse_x;
+            }
+
+            if(shockwave.damage > 0)
+            {
+                const float damage_scale = ShockwaveFalloff(shockwave.damage_falloff, distance, shockwave.radius);
+                const int damage = int(float(shockwave.damage) * damage_scale + 0.5f);
+                if(damage > 0)
+                    out_damage.push_back({ body.entity_id, shockwave.who_did_damage, damage });
+            }
+        }
+    }
+
+    // An impulse J at the offset -(T / |J|^2) * (-J.y, J.x) from the position gives the torque T.
+    for(uint32_t index = 0; index < n_bodies; ++index)
+    {
+        ShockwaveImpulse& impulse = out_impulses[index];
+        impulse.point = bodies[index].position;
+
+        const float length_squared = impulse.impulse.x * impulse.impulse.x + impulse.impulse.y * impulse.impulse.y;
+        if(length_squared > 0.0f)
+        {
+            const float scale = impulse.torque / length_squared;
+            impulse.point.x += scale * impulse.impulse.y;
+            impulse.point.y -= scale * impulse.impulse.x;
+        }
+    }
+
+    const auto sort_by_id_and_who = [](const ShockwaveDamage& first, const ShockwaveDamage& second) {
+        return (first.entity_id != second.entity_id) ?
+            first.entity_id < second.entity_id : first.who_did_damage < second.who_did_damage;
+    };
+    std::sort(out_damage.begin() + first_damage, out_damage.end(), sort_by_id_and_who);
+
+    // Merge the damage from the same dealer on the same body.
+    size_t write_index = first_damage;
+    for(size_t index = first_damage; index < out_damage.size(); ++index)
+    {
+        const ShockwaveDamage& damage = out_damage[index];
+        if(write_index > first_damage)
+        {
+            ShockwaveDamage& last_damage = out_damage[write_index - 1];
+            if(last_damage.entity_id == damage.entity_id && last_damage.who_did_damage == damage.who_did_damage)
+            {
+                last_damage.damage += damage.damage;
+                continue;
+            }
+        }
+
+        out_damage[write_index++] = damage;
+    }
+
+    out_damage.resize(write_index);
+}
+
+ShockwaveSystem::ShockwaveSystem(mono::PhysicsSystem* physics_system, DamageSystem* damage_system)
+    : m_physics_system(physics_system)
+    , m_damage_system(damage_system)
+{ }
+
+void ShockwaveSystem::ShockwaveAt(const math::Vector& world_position, float magnitude)
+{
+    ShockwaveParams params;
+    params.position = world_position;
+    params.magnitude = magnitude;
+    AddShockwave(params);
+}
+
+void ShockwaveSystem::ShockwaveAndDamageAt(const math::Vector& world_position, float magnitude, int damage, uint32_t who_did_damage)
+{
+    ShockwaveParams params;
+    params.position = world_position;
+    params.magnitude = magnitude;
+    params.damage = damage;
+    params.who_did_damage = who_did_damage;
+    AddShockwave(params);
+}
+
+void ShockwaveSystem::AddShockwave(const ShockwaveParams& params)
+{
+    std::lock_guard<std::mutex> lock(m_shockwave_mutex);
+    m_shockwaves.push_back(params);
+}
+
+uint32_t ShockwaveSystem::Id() const
+{
+    return hash::Hash(Name());
+}
+
+const char* ShockwaveSystem::Name() const
+{
+    return "shockwavesystem";
+}
+
+SystemAccess ShockwaveSystem::Access() const
+{
+    // Pushes bodies and applies damage, which runs the damage callbacks.
+    SystemAccess access;
+    access.exclusive = true;
+    return access;
+}
+
+void ShockwaveSystem::ScheduledUpdate(const mono::UpdateContext& update_context)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_shockwave_mutex);
+        m_resolve_shockwaves.swap(m_shockwaves);
+    }
+
+    if(m_resolve_shockwaves.empty())
+        return;
+
+    m_cluster_bounds.clear();
+    ClusterShockwaves(m_resolve_shockwaves, m_cluster_bounds);
+
+    // A body can reach into more than one cluster, it's only resolved once.
+    m_query_bodies.clear();
+    for(const math::Quad& cluster_bounds : m_cluster_bounds)
+    {
+        m_found_bodies.clear();
+        m_physics_system->GetSpace()->QueryBox(cluster_bounds, shared::CollisionCategory::ALL, m_found_bodies);
+        m_query_bodies.insert(m_query_bodies.end(), m_found_bodies.begin(), m_found_bodies.end());
+    }
+
+    if(m_cluster_bounds.size() > 1)
+    {
+        std::sort(m_query_bodies.begin(), m_query_bodies.end());
+        m_query_bodies.erase(std::unique(m_query_bodies.begin(), m_query_bodies.end()), m_query_bodies.end());
+    }
+
+    m_bodies.clear();
+
+    for(mono::IBody* body : m_query_bodies)
+    {
+        const uint32_t entity_id = mono::PhysicsSystem::GetIdFromBody(body);
+        const math::Vector position = body->GetPosition();
+
+        math::Quad bounds = { math::INF, math::INF, -math::INF, -math::INF };
+        for(const mono::IShape* shape : m_physics_system->GetShapesAttachedToBody(entity_id))
+            bounds |= shape->GetBoundingBox();
+
+        // A body without shapes is reached at its position.
+        if(bounds.mA.x > bounds.mB.x)
+            bounds = math::Quad(position, position);
+
+        m_bodies.push_back({ entity_id, position, bounds });
+    }
+
+    m_damage.clear();
+    AccumulateShockwaves(m_resolve_shockwaves, m_bodies, m_impulses, m_damage);
+
+    for(uint32_t index = 0; index < m_query_bodies.size(); ++index)
+    {
+        const ShockwaveImpulse& impulse = m_impulses[index];
+        if(impulse.impulse.x != 0.0f || impulse.impulse.y != 0.0f)
+            m_query_bodies[index]->ApplyImpulse(impulse.impulse, impulse.point);
+    }
+
+    for(const ShockwaveDamage& damage : m_damage)
+        m_damage_system->ApplyDamage(damage.entity_id, damage.damage, damage.who_did_damage);
+
+    m_resolve_shockwaves.clear();
+}
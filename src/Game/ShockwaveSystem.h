@@ -0,0 +1,112 @@
+
+#pragma once
+
+#include "Scheduler/ScheduledSystem.h"
+#include "MonoFwd.h"
+#include "Math/Vector.h"
+#include "Math/Quad.h"
+
+#include <cstdint>
+#include <vector>
+#include <mutex>
+
+namespace game
+{
+    class DamageSystem;
+
+    enum class FalloffCurve
+    {
+        CONSTANT,
+        LINEAR,
+        QUADRATIC
+    };
+
+    struct ShockwaveParams
+    {
+        math::Vector position;
+        float radius = 3.0f;
+
+        float magnitude = 0.0f;
+        FalloffCurve impulse_falloff = FalloffCurve::CONSTANT;
+
+        int damage = 0;
+        FalloffCurve damage_falloff = FalloffCurve::CONSTANT;
+        uint32_t who_did_damage = 0;
+    };
+
+    struct ShockwaveDamage
+    {
+        uint32_t entity_id;
+        uint32_t who_did_damage;
+        int damage;
+    };
+
+    // A body in reach of the shockwaves, the bounds are the bounds of its shapes.
+    struct ShockwaveBody
+    {
+        uint32_t entity_id;
+        math::Vector position;
+        math::Quad bounds;
+    };
+
+    // The total impulse on a body and its spin around the body's position. Applied at the point it gives the
+    // same spin as all the impulses together.
+    struct ShockwaveImpulse
+    {
+        math::Vector impulse;
+        float torque;
+        math::Vector point;
+    };
+
+    // Scale at the distance from the center, 1 at the center and 0 outside of the radius.
+    float ShockwaveFalloff(FalloffCurve curve, float distance, float radius);
+
+    // Merges the bounds of shockwaves that overlap, the bounds that come out do not overlap each other.
+    void ClusterShockwaves(const std::vector<ShockwaveParams>& shockwaves, std::vector<math::Quad>& out_bounds);
+
+    // Sums the impulse from all shockwaves on each body, and the damage per body and damage dealer. The distance
+    // is measured to the closest point of the body's bounds, where the impulse pushes it away from the center.
+    // The impulses line up with the bodies, the damage comes out sorted by entity id and damage dealer.
+    void AccumulateShockwaves(
+        const std::vector<ShockwaveParams>& shockwaves,
+        const std::vector<ShockwaveBody>& bodies,
+        std::vector<ShockwaveImpulse>& out_impulses,
+        std::vector<ShockwaveDamage>& out_damage);
+
+    // Explosions and shockwaves are queued and resolved together once per update, with one query per cluster
+    // of overlapping shockwaves. A chain of explosions in one frame costs about the same as a single one.
+    class ShockwaveSystem : public ScheduledSystem
+    {
+    public:
+
+        ShockwaveSystem(mono::PhysicsSystem* physics_system, DamageSystem* damage_system);
+
+        void ShockwaveAt(const math::Vector& world_position, float magnitude);
+        void ShockwaveAndDamageAt(const math::Vector& world_position, float magnitude, int damage, uint32_t who_did_damage);
+
+        // Safe to call from physics callbacks and from systems running in parallel.
+        void AddShockwave(const ShockwaveParams& params);
+
+        uint32_t Id() const override;
+        const char* Name() const override;
+        void ScheduledUpdate(const mono::UpdateContext& update_context) override;
+        SystemAccess Access() const override;
+
+    private:
+
+        mono::PhysicsSystem* m_physics_system;
+        DamageSystem* m_damage_system;
+
+        std::mutex m_shockwave_mutex;
+        std::vector<ShockwaveParams> m_shockwaves;
+
+        // Kept between updates so resolving only allocates for the shape lookups once the sizes have settled.
+        std::vector<ShockwaveParams> m_resolve_shockwaves;
+        std::vector<math::Quad> m_cluster_bounds;
+        std::vector<mono::IBody*> m_found_bodies;
+        std::vector<mono::IBody*> m_query_bodies;
+        std::vector<ShockwaveBody> m_bodies;
+        std::vector<ShockwaveImpulse> m_impulses;
+        std::vector<ShockwaveDamage> m_damage;
+    };
+}
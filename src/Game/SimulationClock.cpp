@@ -0,0 +1,108 @@
+
+#include "SimulationClock.h"
+#include "System/Hash.h"
+
+#include <algorithm>
+
+using namespace game;
+
+namespace
+{
+    // If a frame is really slow only this many ticks are run, the rest of the time is dropped
+    // so that the simulation doesn't spiral while trying to catch up.
+    constexpr uint32_t max_ticks_per_frame = 5;
+    constexpr uint32_t tick_length = 1000;
+}
+
+SimulationClock::SimulationClock(uint32_t tick_rate)
+    : m_tick_rate(std::max(tick_rate, 1u))
+    , m_time_origin(0)
+    , m_last_timestamp(0)
+    , m_accumulator(0)
+    , m_tick_count(0)
+    , m_ticks_this_frame(0)
+{ }
+
+uint32_t SimulationClock::Id() const
+{
+    return hash::Hash(Name());
+}
+
+const char* SimulationClock::Name() const
+{
+    return "simulationclock";
+}
+
+void SimulationClock::Update(const mono::UpdateContext& update_context)
+{
+    if(m_last_timestamp == 0)
+    {
+        m_time_origin = update_context.timestamp;
+        m_last_timestamp = update_context.timestamp;
+    }
+
+    const uint32_t delta_ms = update_context.timestamp - m_last_timestamp;
+    m_last_timestamp = update_context.timestamp;
+
+    m_accumulator += delta_ms * m_tick_rate;
+    m_ticks_this_frame = m_accumulator / tick_length;
+    m_accumulator -= m_ticks_this_frame * tick_length;
+
+    if(m_ticks_this_frame > max_ticks_per_frame)
+    {
+        // The simulation time falls behind the engine time here, move the origin so they stay close.
+        const uint32_t dropped_ticks = m_ticks_this_frame - max_ticks_per_frame;
+        m_time_origin += (uint64_t(dropped_ticks) * 1000) / m_tick_rate;
+        m_ticks_this_frame = max_ticks_per_frame;
+    }
+
+    m_tick_count += m_ticks_this_frame;
+}
+
+uint32_t SimulationClock::TickRate() const
+{
+    return m_tick_rate;
+}
+
+uint32_t SimulationClock::TicksThisFrame() const
+{
+    return m_ticks_this_frame;
+}
+
+mono::UpdateContext SimulationClock::TickContext(uint32_t tick_index) const
+{
+    const uint64_t tick = m_tick_count - m_ticks_this_frame + tick_index + 1;
+    const uint32_t timestamp = TickTimestamp(tick);
+
+    mono::UpdateContext tick_context;
+    tick_context.frame_count = tick;
+    tick_context.timestamp = timestamp;
+    tick_context.delta_ms = timestamp - TickTimestamp(tick - 1);
+    tick_context.delta_s = 1.0f / float(m_tick_rate);
+
+    return tick_context;
+}
+
+mono::UpdateContext SimulationClock::FrameContext() const
+{
+    const uint32_t timestamp = TickTimestamp(m_tick_count);
+
+    mono::UpdateContext frame_context;
+    frame_context.frame_count = m_tick_count;
+    frame_context.timestamp = timestamp;
+    frame_context.delta_ms = timestamp - TickTimestamp(m_tick_count - m_ticks_this_frame);
+    frame_context.delta_s = float(m_ticks_this_frame) / float(m_tick_rate);
+
+    return frame_context;
+}
+
+float SimulationClock::InterpolationAlpha() const
+{
+    return float(m_accumulator) / float(tick_length);
+}
+
+uint32_t SimulationClock::TickTimestamp(uint64_t tick) const
+{
+    // Computed from the tick count so that the ticks with a fractional length in milliseconds don't drift.
+    return m_time_origin + uint32_t((tick * 1000) / m_tick_rate);
+}
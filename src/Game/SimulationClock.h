@@ -0,0 +1,55 @@
+
+#pragma once
+
+#include "IGameSystem.h"
+#include <cstdint>
+
+namespace game
+{
+    // Turns the variable frame time from the engine into a whole number of fixed simulation ticks. Create it
+    // before the systems that use it so that it is updated first each frame.
+    class SimulationClock : public mono::IGameSystem
+    {
+    public:
+
+        SimulationClock(uint32_t tick_rate);
+
+        uint32_t Id() const override;
+        const char* Name() const override;
+        void Update(const mono::UpdateContext& update_context) override;
+
+        uint32_t TickRate() const;
+        uint32_t TicksThisFrame() const;
+
+        // Context for one of the ticks this frame, with a fixed delta and the simulation time at the end of the tick.
+        mono::UpdateContext TickContext(uint32_t tick_index) const;
+
+        // Context covering all ticks this frame, for updates that run once per frame but should
+        // still advance in whole ticks. The delta is zero when there are no ticks this frame.
+        mono::UpdateContext FrameContext() const;
+
+        // How far between the last two simulation ticks the frame is, [0, 1).
+        float InterpolationAlpha() const;
+
+    private:
+
+        uint32_t TickTimestamp(uint64_t tick) const;
+
+        const uint32_t m_tick_rate;
+
+        // Time not yet ticked in milliseconds times the tick rate, so a tick is exactly 1000 and nothing is
+        // lost to rounding the tick length.
+        uint32_t m_time_origin;
+        uint32_t m_last_timestamp;
+        uint32_t m_accumulator;
+        uint64_t m_tick_count;
+        uint32_t m_ticks_this_frame;
+    };
+
+    template <typename T>
+    inline void ForEachSimulationTick(const SimulationClock* simulation_clock, T&& tick_func)
+    {
+        for(uint32_t tick_index = 0; tick_index < simulation_clock->TicksThisFrame(); ++tick_index)
+            tick_func(simulation_clock->TickContext(tick_index));
+    }
+}
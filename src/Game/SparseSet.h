@@ -0,0 +1,122 @@
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+namespace game
+{
+    // Set of ids in the range [0, capacity). Add, Remove and Contains are O(1) and iteration only touches
+    // the ids that are in the set, so systems with a large capacity but few live components don't pay for
+    // a full scan. Removal swaps the last id into the hole, so iteration order is not stable. Adding an id
+    // outside of the capacity grows it.
+    class SparseSet
+    {
+    public:
+
+        static constexpr uint32_t npos = uint32_t(-1);
+
+        SparseSet()
+        { }
+
+        SparseSet(size_t capacity)
+            : m_sparse(capacity, npos)
+        {
+            m_dense.reserve(capacity);
+        }
+
+        bool Add(uint32_t id)
+        {
+            if(Contains(id))
+                return false;
+
+            if(id >= m_sparse.size())
+                m_sparse.resize(std::max(size_t(id) + 1, m_sparse.size() * 2), npos);
+
+            m_sparse[id] = static_cast<uint32_t>(m_dense.size());
+            m_dense.push_back(id);
+            return true;
+        }
+
+        bool Remove(uint32_t id)
+        {
+            if(!Contains(id))
+                return false;
+
+            const uint32_t dense_index = m_sparse[id];
+            const uint32_t last_id = m_dense.back();
+
+            m_dense[dense_index] = last_id;
+            m_sparse[last_id] = dense_index;
+
+            m_dense.pop_back();
+            m_sparse[id] = npos;
+            return true;
+        }
+
+        void Set(uint32_t id, bool in_set)
+        {
+            if(in_set)
+                Add(id);
+            else
+                Remove(id);
+        }
+
+        bool Contains(uint32_t id) const
+        {
+            return id < m_sparse.size() && m_sparse[id] != npos;
+        }
+
+        void Clear()
+        {
+            for(uint32_t id : m_dense)
+                m_sparse[id] = npos;
+            m_dense.clear();
+        }
+
+        size_t Size() const
+        {
+            return m_dense.size();
+        }
+
+        bool Empty() const
+        {
+            return m_dense.empty();
+        }
+
+        size_t Capacity() const
+        {
+            return m_sparse.size();
+        }
+
+        const std::vector<uint32_t>& Ids() const
+        {
+            return m_dense;
+        }
+
+        std::vector<uint32_t>::const_iterator begin() const
+        {
+            return m_dense.begin();
+        }
+
+        std::vector<uint32_t>::const_iterator end() const
+        {
+            return m_dense.end();
+        }
+
+        // Iterates backwards so that the callable may remove the id it is called with.
+        template <typename T>
+        void ForEach(T&& callable) const
+        {
+            for(size_t index = m_dense.size(); index > 0; --index)
+                callable(m_dense[index - 1]);
+        }
+
+    private:
+
+        std::vector<uint32_t> m_sparse;
+        std::vector<uint32_t> m_dense;
+    };
+}
@@ -0,0 +1,158 @@
+
+#include "SpawnDirector.h"
+#include "Util/Random.h"
+
+#include <algorithm>
+
+using namespace game;
+
+namespace
+{
+    // Weight of the latest frame in the average frame cost.
+    constexpr float frame_cost_smoothing = 0.1f;
+}
+
+SpawnDirector::SpawnDirector()
+    : m_frame_cost_ms(0.0f)
+    , m_stats{}
+{ }
+
+void SpawnDirector::SetConfig(const SpawnDirectorConfig& config)
+{
+    m_config = config;
+}
+
+const SpawnDirectorConfig& SpawnDirector::Config() const
+{
+    return m_config;
+}
+
+void SpawnDirector::SetDefinitions(const std::vector<SpawnDefinition>& definitions)
+{
+    m_definitions = definitions;
+
+    const auto sort_by_value = [](const SpawnDefinition& first, const SpawnDefinition& second) {
+        return first.value < second.value;
+    };
+    std::stable_sort(m_definitions.begin(), m_definitions.end(), sort_by_value);
+}
+
+const std::vector<SpawnDefinition>& SpawnDirector::Definitions() const
+{
+    return m_definitions;
+}
+
+void SpawnDirector::AddFrameCost(float frame_time_ms)
+{
+    m_frame_cost_ms += (frame_time_ms - m_frame_cost_ms) * frame_cost_smoothing;
+}
+
+float SpawnDirector::FrameCost() const
+{
+    return m_frame_cost_ms;
+}
+
+SpawnDecision SpawnDirector::RequestSpawn(uint32_t spawner_id)
+{
+    if(Population() >= m_config.max_population)
+    {
+        m_stats.population_capped++;
+        return SpawnDecision::POPULATION_CAPPED;
+    }
+
+    if(Population(spawner_id) >= m_config.max_spawn_point_population)
+    {
+        m_stats.spawn_point_capped++;
+        return SpawnDecision::SPAWN_POINT_CAPPED;
+    }
+
+    if(m_frame_cost_ms > m_config.frame_budget_ms)
+    {
+        m_stats.throttled++;
+        return SpawnDecision::THROTTLED;
+    }
+
+    return SpawnDecision::SPAWN;
+}
+
+uint32_t SpawnDirector::SpawnRoom(uint32_t spawner_id) const
+{
+    const uint32_t population = Population();
+    const uint32_t spawner_population = Population(spawner_id);
+
+    if(population >= m_config.max_population || spawner_population >= m_config.max_spawn_point_population)
+        return 0;
+
+    return std::min(m_config.max_population - population, m_config.max_spawn_point_population - spawner_population);
+}
+
+void SpawnDirector::SelectDefinitions(int spawn_score, uint32_t max_count, std::vector<uint32_t>& out_definitions) const
+{
+    if(m_definitions.empty() || max_count == 0)
+        return;
+
+    // The definitions are sorted by value, so the affordable ones are always the first n.
+    const auto n_affordable = [this](int score) {
+        uint32_t count = 0;
+        while(count < m_definitions.size() && m_definitions[count].value <= score)
+            count++;
+        return count;
+    };
+
+    int score_left = spawn_score;
+    uint32_t count = 0;
+
+    while(count < max_count)
+    {
+        const uint32_t n_definitions = n_affordable(score_left);
+        if(n_definitions == 0)
+        {
+            // Even a spawn point with too little score spawns the cheapest thing there is, once.
+            if(count == 0)
+                out_definitions.push_back(0);
+            break;
+        }
+
+        const uint32_t random_index = std::min(uint32_t(mono::Random(0.0f, float(n_definitions))), n_definitions - 1);
+        out_definitions.push_back(random_index);
+
+        score_left -= std::max(m_definitions[random_index].value, 1);
+        count++;
+    }
+}
+
+void SpawnDirector::EntitySpawned(uint32_t spawner_id, uint32_t entity_id)
+{
+    m_entity_to_spawner[entity_id] = spawner_id;
+    m_spawner_population[spawner_id]++;
+    m_stats.spawned++;
+}
+
+void SpawnDirector::EntityReleased(uint32_t entity_id)
+{
+    const auto it = m_entity_to_spawner.find(entity_id);
+    if(it == m_entity_to_spawner.end())
+        return;
+
+    const auto population_it = m_spawner_population.find(it->second);
+    if(population_it != m_spawner_population.end() && --population_it->second == 0)
+        m_spawner_population.erase(population_it);
+
+    m_entity_to_spawner.erase(it);
+}
+
+uint32_t SpawnDirector::Population() const
+{
+    return m_entity_to_spawner.size();
+}
+
+uint32_t SpawnDirector::Population(uint32_t spawner_id) const
+{
+    const auto it = m_spawner_population.find(spawner_id);
+    return (it != m_spawner_population.end()) ? it->second : 0;
+}
+
+const SpawnDirectorStats& SpawnDirector::Stats() const
+{
+    return m_stats;
+}
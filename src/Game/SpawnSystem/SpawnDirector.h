@@ -0,0 +1,87 @@
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+namespace game
+{
+    struct SpawnDefinition
+    {
+        int value;
+        std::string entity_file;
+    };
+
+    struct SpawnDirectorConfig
+    {
+        uint32_t max_population = 150;
+        uint32_t max_spawn_point_population = 20;
+
+        // Spawns are held back while the systems take longer than this per frame, on average.
+        float frame_budget_ms = 8.0f;
+        uint32_t retry_delay_ms = 1000;
+    };
+
+    // How many times the director said yes and no, since it was created.
+    struct SpawnDirectorStats
+    {
+        uint32_t spawned;
+        uint32_t throttled;
+        uint32_t population_capped;
+        uint32_t spawn_point_capped;
+    };
+
+    enum class SpawnDecision
+    {
+        SPAWN,
+        THROTTLED,
+        POPULATION_CAPPED,
+        SPAWN_POINT_CAPPED,
+    };
+
+    // Decides what the spawn points spawn and if there's room for it. Counts the live entities from each
+    // spawn point, and holds back spawns while the simulation is over its frame budget.
+    class SpawnDirector
+    {
+    public:
+
+        SpawnDirector();
+
+        void SetConfig(const SpawnDirectorConfig& config);
+        const SpawnDirectorConfig& Config() const;
+
+        void SetDefinitions(const std::vector<SpawnDefinition>& definitions);
+        const std::vector<SpawnDefinition>& Definitions() const;
+
+        // Time of the last frame for all systems, averaged over a few frames.
+        void AddFrameCost(float frame_time_ms);
+        float FrameCost() const;
+
+        SpawnDecision RequestSpawn(uint32_t spawner_id);
+
+        // Number of entities the spawn point can add right now.
+        uint32_t SpawnRoom(uint32_t spawner_id) const;
+
+        // Picks definitions worth at most spawn_score in total, but always at least one and at most max_count.
+        void SelectDefinitions(int spawn_score, uint32_t max_count, std::vector<uint32_t>& out_definitions) const;
+
+        void EntitySpawned(uint32_t spawner_id, uint32_t entity_id);
+        void EntityReleased(uint32_t entity_id);
+
+        uint32_t Population() const;
+        uint32_t Population(uint32_t spawner_id) const;
+        const SpawnDirectorStats& Stats() const;
+
+    private:
+
+        SpawnDirectorConfig m_config;
+        std::vector<SpawnDefinition> m_definitions;
+        float m_frame_cost_ms;
+        SpawnDirectorStats m_stats;
+
+        std::unordered_map<uint32_t, uint32_t> m_entity_to_spawner;
+        std::unordered_map<uint32_t, uint32_t> m_spawner_population;
+    };
+}
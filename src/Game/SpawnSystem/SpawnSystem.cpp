@@ -1,14 +1,20 @@
 
 #include "SpawnSystem.h"
-#include "EntitySystem/IEntityManager.h"
+#include "Entity/EntityPoolSystem.h"
 #include "TransformSystem/TransformSystem.h"
 #include "TriggerSystem/TriggerSystem.h"
+#include "SimulationClock.h"
+#include "TimerSystem.h"
+#include "Scheduler/SystemScheduler.h"
+
+#include "EntitySystem/IEntityManager.h"
 
 #include "Math/MathFunctions.h"
 #include "System/Hash.h"
 #include "Util/Random.h"
 #include "Util/Algorithm.h"
 #include "System/File.h"
+#include "System/System.h"
 
 #include "nlohmann/json.hpp"
 
@@ -16,14 +22,26 @@
 
 using namespace game;
 
-SpawnSystem::SpawnSystem(uint32_t n, TriggerSystem* trigger_system, mono::IEntityManager* entity_manager, mono::TransformSystem* transform_system)
+SpawnSystem::SpawnSystem(
+    uint32_t n,
+    TriggerSystem* trigger_system,
+    EntityPoolSystem* entity_pool,
+    mono::IEntityManager* entity_manager,
+    mono::TransformSystem* transform_system,
+    TimerSystem* timer_system,
+    const SystemScheduler* system_scheduler,
+    const SimulationClock* simulation_clock)
     : m_trigger_system(trigger_system)
+    , m_entity_pool(entity_pool)
     , m_entity_manager(entity_manager)
     , m_transform_system(transform_system)
+    , m_timer_system(timer_system)
+    , m_system_scheduler(system_scheduler)
+    , m_simulation_clock(simulation_clock)
 {
-    m_spawn_points.resize(n);
-    m_spawn_points_internal.resize(n);
-    m_alive.resize(n, false);
+    m_spawn_points.EnsureSize(n);
+    m_spawn_points_internal.EnsureSize(n);
+    m_alive = SparseSet(n);
 
     file::FilePtr config_file = file::OpenAsciiFile("res/spawn_config.json");
     if(config_file)
@@ -31,33 +49,55 @@ SpawnSystem::SpawnSystem(uint32_t n, TriggerSystem* trigger_system, mono::IEntit
         const std::vector<byte> file_data = file::FileRead(config_file);
         const nlohmann::json& json = nlohmann::json::parse(file_data);
 
+        std::vector<SpawnDefinition> spawn_definitions;
+
         for(const auto& spawn_props : json["spawn_definitions"])
         {
             SpawnDefinition spawn_def;
             spawn_def.value = spawn_props["value"];
             spawn_def.entity_file = spawn_props["entity"];
-            m_spawn_definitions.push_back(spawn_def);
+            spawn_definitions.push_back(spawn_def);
+        }
+
+        m_director.SetDefinitions(spawn_definitions);
+
+        if(json.contains("director"))
+        {
+            const nlohmann::json& director_json = json["director"];
+
+            SpawnDirectorConfig config;
+            config.max_population               = director_json.value("max_population", config.max_population);
+            config.max_spawn_point_population   = director_json.value("max_spawn_point_population", config.max_spawn_point_population);
+            config.frame_budget_ms              = director_json.value("frame_budget_ms", config.frame_budget_ms);
+            config.retry_delay_ms               = director_json.value("retry_delay_ms", config.retry_delay_ms);
+            m_director.SetConfig(config);
         }
     }
 }
 
 SpawnSystem::SpawnPointComponent* SpawnSystem::AllocateSpawnPoint(uint32_t entity_id)
 {
-    assert(!m_alive[entity_id]);
-    m_alive[entity_id] = true;
+    const bool added = m_alive.Add(entity_id);
+    assert(added);
+    (void)added;
+
+    m_spawn_points.EnsureSize(entity_id + 1);
+    m_spawn_points_internal.EnsureSize(entity_id + 1);
 
     SpawnPointComponent& spawn_point = m_spawn_points[entity_id];
     std::memset(&spawn_point, 0, sizeof(SpawnPointComponent));
 
     SpawnPointInternalData& internal_data = m_spawn_points_internal[entity_id];
     std::memset(&internal_data, 0, sizeof(SpawnPointInternalData));
+    internal_data.timer_id = TimerSystem::NO_TIMER;
 
     return &spawn_point;
 }
 
 void SpawnSystem::ReleaseSpawnPoint(uint32_t entity_id)
 {
-    m_alive[entity_id] = false;
+    SetSpawnPointActive(entity_id, false);
+    m_alive.Remove(entity_id);
 
     SpawnPointComponent& spawn_point = m_spawn_points[entity_id];
     SpawnPointInternalData& internal_data = m_spawn_points_internal[entity_id];
@@ -71,12 +111,12 @@ void SpawnSystem::ReleaseSpawnPoint(uint32_t entity_id)
 
 bool SpawnSystem::IsAllocated(uint32_t entity_id)
 {
-    return m_alive[entity_id];
+    return m_alive.Contains(entity_id);
 }
 
 void SpawnSystem::SetSpawnPointData(uint32_t entity_id, const SpawnSystem::SpawnPointComponent& component_data)
 {
-    assert(m_alive[sprite_id]);
+    assert(m_alive.Contains(entity_id));
     assert(component_data.interval > spawn_delay_frames);
 
     SpawnPointComponent& spawn_point = m_spawn_points[entity_id];
@@ -86,21 +126,43 @@ void SpawnSystem::SetSpawnPointData(uint32_t entity_id, const SpawnSystem::Spawn
 
     if(spawn_point.enable_trigger != 0)
     {
-        const game::TriggerCallback enable_callback = [&internal_data](uint32_t entity_id) {
-            internal_data.active = true;
+        const game::TriggerCallback enable_callback = [this, entity_id](uint32_t trigger_id) {
+            SetSpawnPointActive(entity_id, true);
         };
         internal_data.enable_callback_id = m_trigger_system->RegisterTriggerCallback(spawn_point.enable_trigger, enable_callback, entity_id);
     }
 
     if(spawn_point.disable_trigger != 0)
     {
-        const game::TriggerCallback disable_callback = [&internal_data](uint32_t entity_id) {
-            internal_data.active = false;
+        const game::TriggerCallback disable_callback = [this, entity_id](uint32_t trigger_id) {
+            SetSpawnPointActive(entity_id, false);
         };
         internal_data.disable_callback_id = m_trigger_system->RegisterTriggerCallback(spawn_point.disable_trigger, disable_callback, entity_id);
     }
 
-    internal_data.active = false;
+    SetSpawnPointActive(entity_id, false);
+}
+
+void SpawnSystem::SetSpawnPointActive(uint32_t entity_id, bool active)
+{
+    SpawnPointInternalData& internal_data = m_spawn_points_internal[entity_id];
+    if(internal_data.active == active)
+        return;
+
+    internal_data.active = active;
+
+    if(active)
+    {
+        const auto timer_callback = [this, entity_id](uint32_t timer_id) {
+            m_expired_spawn_points.push_back(entity_id);
+        };
+        internal_data.timer_id = m_timer_system->StartRepeatingTimer(m_spawn_points[entity_id].interval, timer_callback);
+    }
+    else
+    {
+        m_timer_system->CancelTimer(internal_data.timer_id);
+        internal_data.timer_id = TimerSystem::NO_TIMER;
+    }
 }
 
 const std::vector<SpawnSystem::SpawnEvent>& SpawnSystem::GetSpawnEvents() const
@@ -108,6 +170,11 @@ const std::vector<SpawnSystem::SpawnEvent>& SpawnSystem::GetSpawnEvents() const
     return m_spawn_events;
 }
 
+const SpawnDirector& SpawnSystem::GetSpawnDirector() const
+{
+    return m_director;
+}
+
 uint32_t SpawnSystem::Id() const
 {
     return hash::Hash(Name());
@@ -118,63 +185,153 @@ const char* SpawnSystem::Name() const
     return "spawnsystem";
 }
 
-void SpawnSystem::Update(const mono::UpdateContext& update_context)
+SystemAccess SpawnSystem::Access() const
+{
+    // Spawning creates the entity with all its components, which touches every component system.
+    SystemAccess access;
+    access.exclusive = true;
+    return access;
+}
+
+void SpawnSystem::ScheduledUpdate(const mono::UpdateContext& update_context)
 {
-    for(uint32_t index = 0; index < m_alive.size(); ++index)
+    if(m_system_scheduler)
+        m_director.AddFrameCost(m_system_scheduler->FrameTimeMs());
+
+    // Released entities from either place, the director only knows about the ones it spawned.
+    const auto collect_released = [this](const std::vector<mono::IEntityManager::SpawnEvent>& spawn_events) {
+        for(const mono::IEntityManager::SpawnEvent& spawn_event : spawn_events)
+        {
+            if(!spawn_event.spawned)
+                m_director.EntityReleased(spawn_event.entity_id);
+        }
+    };
+    collect_released(m_entity_manager->GetSpawnEvents());
+    collect_released(m_entity_pool->GetSpawnEvents());
+
+    const auto tick_func = [this](const mono::UpdateContext& tick_context) {
+        UpdateTick(tick_context);
+    };
+    ForEachSimulationTick(m_simulation_clock, tick_func);
+}
+
+void SpawnSystem::UpdateTick(const mono::UpdateContext& update_context)
+{
+    for(uint32_t index : m_expired_spawn_points)
     {
-        if(!m_alive[index])
+        // Released or disabled after the timer expired, or already waiting for the director.
+        if(!m_alive.Contains(index))
             continue;
 
-        SpawnPointInternalData& internal_data = m_spawn_points_internal[index];
-        if(!internal_data.active)
+        const SpawnPointInternalData& internal_data = m_spawn_points_internal[index];
+        if(!internal_data.active || internal_data.deferred)
             continue;
 
-        SpawnPointComponent& spawn_point = m_spawn_points[index];
+        RequestSpawn(index, update_context);
+    }
+
+    m_expired_spawn_points.clear();
 
-        internal_data.counter += update_context.delta_ms;
-        if(internal_data.counter < spawn_point.interval)
+    for(size_t index = 0; index < m_deferred_spawns.size();)
+    {
+        const DeferredSpawn deferred_spawn = m_deferred_spawns[index];
+        if(deferred_spawn.retry_timestamp > update_context.timestamp)
+        {
+            ++index;
             continue;
+        }
 
-        const float random_length = mono::Random(0.0f, spawn_point.radius);
-        const math::Vector random_vector = math::VectorFromAngle(mono::Random(0.0f, math::PI() * 2.0f)) * random_length;
+        m_deferred_spawns[index] = m_deferred_spawns.back();
+        m_deferred_spawns.pop_back();
 
-        math::Matrix world_transform = m_transform_system->GetWorld(index);
-        math::Translate(world_transform, random_vector);
+        if(!m_alive.Contains(deferred_spawn.spawner_id))
+            continue;
 
-        SpawnEvent spawn_event;
-        spawn_event.spawner_id = index;
-        spawn_event.spawned_entity_id = 0;
-        spawn_event.transform = world_transform;
-        spawn_event.timestamp_to_spawn = update_context.timestamp + spawn_delay_time_ms;
-        m_spawn_events.push_back(spawn_event);
+        SpawnPointInternalData& internal_data = m_spawn_points_internal[deferred_spawn.spawner_id];
+        internal_data.deferred = false;
 
-        internal_data.counter = 0;
+        if(internal_data.active)
+            RequestSpawn(deferred_spawn.spawner_id, update_context);
     }
 
     for(SpawnEvent& spawn_event : m_spawn_events)
     {
-        // From spawn_score, lookup some entities to spawn. 
-        //spawn_point.spawn_score;
-
+        // Spawned events are removed in Sync, so with several ticks in a frame it might already be spawned.
         const bool time_to_spawn = (spawn_event.timestamp_to_spawn < update_context.timestamp);
-        if(!time_to_spawn)
+        if(!time_to_spawn || spawn_event.done)
             continue;
 
-        const SpawnDefinition&  spawn_definition = m_spawn_definitions.front();
-        mono::Entity spawned_entity = m_entity_manager->CreateEntity(spawn_definition.entity_file.c_str());
+        SpawnEntities(spawn_event);
+        spawn_event.done = true;
+    }
+}
+
+void SpawnSystem::RequestSpawn(uint32_t spawner_id, const mono::UpdateContext& update_context)
+{
+    const SpawnDecision decision = m_director.RequestSpawn(spawner_id);
+    if(decision == SpawnDecision::THROTTLED)
+    {
+        m_spawn_points_internal[spawner_id].deferred = true;
+        m_deferred_spawns.push_back({ spawner_id, update_context.timestamp + m_director.Config().retry_delay_ms });
+        return;
+    }
 
-        m_transform_system->SetTransform(spawned_entity.id, spawn_event.transform);
-        m_transform_system->SetTransformState(spawned_entity.id, mono::TransformState::CLIENT);
+    // Full, the spawn point tries again when its timer expires next time.
+    if(decision != SpawnDecision::SPAWN)
+        return;
 
-        spawn_event.spawned_entity_id = spawned_entity.id;
+    const SpawnPointComponent& spawn_point = m_spawn_points[spawner_id];
+
+    const float random_length = mono::Random(0.0f, spawn_point.radius);
+    const math::Vector random_vector = math::VectorFromAngle(mono::Random(0.0f, math::PI() * 2.0f)) * random_length;
+
+    math::Matrix world_transform = m_transform_system->GetWorld(spawner_id);
+    math::Translate(world_transform, random_vector);
+
+    SpawnEvent spawn_event;
+    spawn_event.spawner_id = spawner_id;
+    spawn_event.done = false;
+    spawn_event.transform = world_transform;
+    spawn_event.timestamp_to_spawn = update_context.timestamp + spawn_delay_time_ms;
+    m_spawn_events.push_back(spawn_event);
+}
+
+void SpawnSystem::SpawnEntities(SpawnEvent& spawn_event)
+{
+    // The spawn point might have been released while the spawn was on its way, the score is zero then.
+    const int spawn_score = m_alive.Contains(spawn_event.spawner_id) ? m_spawn_points[spawn_event.spawner_id].spawn_score : 0;
+
+    // Other spawn points could have filled up the population since the spawn was requested.
+    m_selected_definitions.clear();
+    m_director.SelectDefinitions(spawn_score, m_director.SpawnRoom(spawn_event.spawner_id), m_selected_definitions);
+
+    const std::vector<SpawnDefinition>& spawn_definitions = m_director.Definitions();
+
+    for(uint32_t definition_index : m_selected_definitions)
+    {
+        const SpawnDefinition& spawn_definition = spawn_definitions[definition_index];
+        const uint32_t spawned_entity_id = m_entity_pool->SpawnEntity(spawn_definition.entity_file.c_str());
+
+        m_transform_system->SetTransform(spawned_entity_id, spawn_event.transform);
+        m_transform_system->SetTransformState(spawned_entity_id, mono::TransformState::CLIENT);
+
+        m_director.EntitySpawned(spawn_event.spawner_id, spawned_entity_id);
     }
 }
 
 void SpawnSystem::Sync()
 {
     const auto remove_if_spawned = [](const SpawnEvent& spawn_event) {
-        return (spawn_event.spawned_entity_id != 0);
+        return spawn_event.done;
     };
 
     mono::remove_if(m_spawn_events, remove_if_spawned);
 }
+
+void SpawnSystem::Destroy()
+{
+    const SpawnDirectorStats& stats = m_director.Stats();
+    System::Log(
+        "SpawnSystem|Spawned %u entities, throttled %u times, population capped %u times, spawn point capped %u times.",
+        stats.spawned, stats.throttled, stats.population_capped, stats.spawn_point_capped);
+}
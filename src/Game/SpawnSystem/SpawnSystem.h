@@ -1,7 +1,10 @@
 
 #pragma once
 
-#include "IGameSystem.h"
+#include "Scheduler/ScheduledSystem.h"
+#include "SparseSet.h"
+#include "ChunkedArray.h"
+#include "SpawnDirector.h"
 #include "Math/Vector.h"
 #include "Math/Matrix.h"
 #include "MonoFwd.h"
@@ -11,7 +14,7 @@
 
 namespace game
 {
-    class SpawnSystem : public mono::IGameSystem
+    class SpawnSystem : public ScheduledSystem
     {
     public:
 
@@ -29,69 +32,90 @@ namespace game
         struct SpawnPointInternalData
         {
             bool active;
-            int counter;
+            bool deferred;
+            uint32_t timer_id;
             uint32_t enable_callback_id;
             uint32_t disable_callback_id;
         };
 
-        struct SpawnDefinition
-        {
-            int value;
-            std::string entity_file;
-        };
-
         struct SpawnEvent
         {
             uint32_t spawner_id;
-            uint32_t spawned_entity_id;
+            bool done;
             math::Matrix transform;
             uint32_t timestamp_to_spawn;
         };
 
         static const uint32_t spawn_delay_time_ms = 500;
 
-        SpawnSystem(uint32_t n, class TriggerSystem* trigger_system, mono::IEntityManager* entity_manager, mono::TransformSystem* transform_system);
+        SpawnSystem(
+            uint32_t n,
+            class TriggerSystem* trigger_system,
+            class EntityPoolSystem* entity_pool,
+            mono::IEntityManager* entity_manager,
+            mono::TransformSystem* transform_system,
+            class TimerSystem* timer_system,
+            const class SystemScheduler* system_scheduler,
+            const class SimulationClock* simulation_clock);
 
         SpawnPointComponent* AllocateSpawnPoint(uint32_t entity_id);
         void ReleaseSpawnPoint(uint32_t entity_id);
         bool IsAllocated(uint32_t entity_id);
         void SetSpawnPointData(uint32_t entity_id, const SpawnPointComponent& component_data);
+        void SetSpawnPointActive(uint32_t entity_id, bool active);
 
         const std::vector<SpawnEvent>& GetSpawnEvents() const;
+        const SpawnDirector& GetSpawnDirector() const;
 
         uint32_t Id() const override;
         const char* Name() const override;
-        void Update(const mono::UpdateContext& update_context) override;
+        void ScheduledUpdate(const mono::UpdateContext& update_context) override;
+        SystemAccess Access() const override;
         void Sync() override;
+        void Destroy() override;
+
+        void UpdateTick(const mono::UpdateContext& update_context);
+        void RequestSpawn(uint32_t spawner_id, const mono::UpdateContext& update_context);
+        void SpawnEntities(SpawnEvent& spawn_event);
 
         template <typename T>
         inline void ForEeach(T&& func)
         {
-            for(uint32_t entity_id = 0; entity_id < m_spawn_points.size(); ++entity_id)
-            {
-                if(m_alive[entity_id])
-                    func(entity_id, m_spawn_points[entity_id]);
-            }
+            for(uint32_t entity_id : m_alive)
+                func(entity_id, m_spawn_points[entity_id]);
         }
 
         template <typename T>
         inline void ForEeachWithInternalData(T&& func)
         {
-            for(uint32_t entity_id = 0; entity_id < m_spawn_points.size(); ++entity_id)
-            {
-                if(m_alive[entity_id])
-                    func(entity_id, m_spawn_points[entity_id], m_spawn_points_internal[entity_id]);
-            }
+            for(uint32_t entity_id : m_alive)
+                func(entity_id, m_spawn_points[entity_id], m_spawn_points_internal[entity_id]);
         }
 
         game::TriggerSystem* m_trigger_system;
+        class EntityPoolSystem* m_entity_pool;
         mono::IEntityManager* m_entity_manager;
         mono::TransformSystem* m_transform_system;
-        std::vector<SpawnDefinition> m_spawn_definitions;
-        std::vector<SpawnPointComponent> m_spawn_points;
-        std::vector<SpawnPointInternalData> m_spawn_points_internal;
-        std::vector<bool> m_alive;
+        class TimerSystem* m_timer_system;
+        const class SystemScheduler* m_system_scheduler;
+        const class SimulationClock* m_simulation_clock;
+        SpawnDirector m_director;
+        ChunkedArray<SpawnPointComponent> m_spawn_points;
+        ChunkedArray<SpawnPointInternalData> m_spawn_points_internal;
+        SparseSet m_alive;
+
+        // Spawn points whose interval timer expired since the last tick.
+        std::vector<uint32_t> m_expired_spawn_points;
+
+        // Spawn points that were held back by the director, asked again after a while.
+        struct DeferredSpawn
+        {
+            uint32_t spawner_id;
+            uint32_t retry_timestamp;
+        };
+        std::vector<DeferredSpawn> m_deferred_spawns;
 
         std::vector<SpawnEvent> m_spawn_events;
+        std::vector<uint32_t> m_selected_definitions;
     };
 }
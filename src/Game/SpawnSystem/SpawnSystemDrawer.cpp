@@ -87,7 +87,13 @@ void SpawnSystemDrawer::Draw(mono::IRenderer& renderer) const
         const char* active_string = internal_data.active ? "Active" : "Inactive";
 
         char text_buffer[128] = { };
-        std::snprintf(text_buffer, std::size(text_buffer), "%s|%d/%d", active_string, internal_data.counter, spawn_point.interval);
+        std::snprintf(
+            text_buffer,
+            std::size(text_buffer),
+            "%s|%d|%u",
+            active_string,
+            spawn_point.interval,
+            m_spawn_system->GetSpawnDirector().Population(entity_id));
 
         const math::Matrix& world_transform = m_transform_system->GetWorld(entity_id);
         const auto scope = mono::MakeTransformScope(world_transform, &renderer);
@@ -42,6 +42,11 @@ bool game::LoadAllWorlds(const char* all_worlds_file)
     return LoadFileAndHashContent(all_worlds_file, "all_worlds");
 }
 
+bool game::LoadAllEntities(const char* all_entities_file)
+{
+    return LoadFileAndHashContent(all_entities_file, "all_entities");
+}
+
 const char* game::HashToFilename(uint32_t hash)
 {
     return hash::HashLookup(hash);
@@ -0,0 +1,273 @@
+
+#include "TimerSystem.h"
+#include "SimulationClock.h"
+#include "System/Hash.h"
+
+#include <algorithm>
+#include <limits>
+#include <cassert>
+
+using namespace game;
+
+namespace
+{
+    constexpr uint32_t INDEX_BITS = 20;
+    constexpr uint32_t INDEX_MASK = (1 << INDEX_BITS) - 1;
+    constexpr uint32_t GENERATION_MASK = (1 << (31 - INDEX_BITS)) - 1;
+
+    constexpr uint32_t NO_INDEX = std::numeric_limits<uint32_t>::max();
+    constexpr uint32_t FREE_SLOT = std::numeric_limits<uint32_t>::max();
+
+    uint32_t MakeTimerId(uint32_t index, uint32_t generation)
+    {
+        return (generation << INDEX_BITS) | index;
+    }
+}
+
+TimerSystem::TimerSystem(size_t n_timers, const SimulationClock* simulation_clock)
+    : m_simulation_clock(simulation_clock)
+    , m_time(0)
+    , m_active_timers(0)
+    , m_n_timers(0)
+{
+    m_timers.EnsureSize(n_timers);
+    std::fill(std::begin(m_slots), std::end(m_slots), NO_INDEX);
+}
+
+uint32_t TimerSystem::StartTimer(uint32_t timeout_ms, TimerCallback callback)
+{
+    return AllocateTimer(timeout_ms, 0, std::move(callback));
+}
+
+uint32_t TimerSystem::StartRepeatingTimer(uint32_t interval_ms, TimerCallback callback)
+{
+    return AllocateTimer(interval_ms, std::max(interval_ms, 1u), std::move(callback));
+}
+
+bool TimerSystem::CancelTimer(uint32_t timer_id)
+{
+    const uint32_t index = FindTimer(timer_id);
+    if(index == NO_INDEX)
+        return false;
+
+    Unlink(index);
+    FreeTimer(index);
+    return true;
+}
+
+bool TimerSystem::IsActive(uint32_t timer_id) const
+{
+    return FindTimer(timer_id) != NO_INDEX;
+}
+
+uint32_t TimerSystem::ActiveTimers() const
+{
+    return m_active_timers;
+}
+
+void TimerSystem::Advance(uint32_t delta_ms)
+{
+    // Nothing can expire, and the slots are all empty so the wheel doesn't have to turn.
+    if(m_active_timers == 0)
+    {
+        m_time += delta_ms;
+        return;
+    }
+
+    for(uint32_t step = 0; step < delta_ms; ++step)
+        Tick();
+}
+
+uint32_t TimerSystem::Time() const
+{
+    return m_time;
+}
+
+uint32_t TimerSystem::Id() const
+{
+    return hash::Hash(Name());
+}
+
+const char* TimerSystem::Name() const
+{
+    return "timersystem";
+}
+
+void TimerSystem::ScheduledUpdate(const mono::UpdateContext& update_context)
+{
+    const auto tick_func = [this](const mono::UpdateContext& tick_context) {
+        Advance(tick_context.delta_ms);
+    };
+    ForEachSimulationTick(m_simulation_clock, tick_func);
+}
+
+SystemAccess TimerSystem::Access() const
+{
+    // Timers call back into the trigger, spawn and entity logic code.
+    SystemAccess access;
+    access.exclusive = true;
+    return access;
+}
+
+uint32_t TimerSystem::AllocateTimer(uint32_t timeout_ms, uint32_t interval_ms, TimerCallback callback)
+{
+    uint32_t index;
+    if(m_free_timers.empty())
+    {
+        assert(m_n_timers <= INDEX_MASK);
+        index = m_n_timers++;
+        m_timers.EnsureSize(m_n_timers);
+        m_timers[index].generation = 0;
+    }
+    else
+    {
+        index = m_free_timers.back();
+        m_free_timers.pop_back();
+    }
+
+    // A timer always expires in the future, so it never ends up in the slot that is being expired.
+    Timer& timer = m_timers[index];
+    timer.expire_time = m_time + std::max(timeout_ms, 1u);
+    timer.interval_ms = interval_ms;
+    timer.callback = std::move(callback);
+    Insert(index);
+
+    m_active_timers++;
+
+    return MakeTimerId(index, timer.generation);
+}
+
+void TimerSystem::FreeTimer(uint32_t index)
+{
+    Timer& timer = m_timers[index];
+    timer.slot = FREE_SLOT;
+    timer.generation = (timer.generation + 1) & GENERATION_MASK;
+    timer.callback = nullptr;
+    m_free_timers.push_back(index);
+
+    m_active_timers--;
+}
+
+void TimerSystem::Insert(uint32_t index)
+{
+    Timer& timer = m_timers[index];
+
+    const uint32_t delta_ms = timer.expire_time - m_time;
+    uint32_t expire_time = timer.expire_time;
+    uint32_t level = 0;
+
+    while(level < N_LEVELS - 1 && delta_ms >= (1u << ((level + 1) * SLOT_BITS)))
+        level++;
+
+    // Beyond the range of the wheel, parked in the last slot of the top level and moved on when it cascades.
+    constexpr uint32_t max_delta_ms = (1u << (N_LEVELS * SLOT_BITS)) - 1;
+    if(delta_ms > max_delta_ms)
+        expire_time = m_time + max_delta_ms;
+
+    const uint32_t slot_index = (expire_time >> (level * SLOT_BITS)) & (N_SLOTS - 1);
+    const uint32_t slot = level * N_SLOTS + slot_index;
+
+    timer.slot = slot;
+    timer.prev = NO_INDEX;
+    timer.next = m_slots[slot];
+
+    if(timer.next != NO_INDEX)
+        m_timers[timer.next].prev = index;
+
+    m_slots[slot] = index;
+}
+
+void TimerSystem::Unlink(uint32_t index)
+{
+    Timer& timer = m_timers[index];
+
+    if(timer.prev != NO_INDEX)
+        m_timers[timer.prev].next = timer.next;
+    else
+        m_slots[timer.slot] = timer.next;
+
+    if(timer.next != NO_INDEX)
+        m_timers[timer.next].prev = timer.prev;
+
+    timer.next = NO_INDEX;
+    timer.prev = NO_INDEX;
+}
+
+void TimerSystem::Cascade(uint32_t level)
+{
+    const uint32_t slot_index = (m_time >> (level * SLOT_BITS)) & (N_SLOTS - 1);
+    const uint32_t slot = level * N_SLOTS + slot_index;
+
+    uint32_t index = m_slots[slot];
+    m_slots[slot] = NO_INDEX;
+
+    while(index != NO_INDEX)
+    {
+        const uint32_t next = m_timers[index].next;
+        Insert(index);
+        index = next;
+    }
+}
+
+void TimerSystem::Tick()
+{
+    m_time++;
+
+    // Every time a level has turned a full lap, the next slot of the level above is spread out on the levels below.
+    for(uint32_t level = 1; level < N_LEVELS; ++level)
+    {
+        const uint32_t lower_bits = m_time & ((1u << (level * SLOT_BITS)) - 1);
+        if(lower_bits != 0)
+            break;
+
+        Cascade(level);
+    }
+
+    const uint32_t slot = m_time & (N_SLOTS - 1);
+
+    while(m_slots[slot] != NO_INDEX)
+    {
+        const uint32_t index = m_slots[slot];
+        Unlink(index);
+
+        Timer& timer = m_timers[index];
+        const uint32_t generation = timer.generation;
+        const uint32_t timer_id = MakeTimerId(index, generation);
+
+        // The callback is moved out while it's called, since it might cancel its own timer.
+        TimerCallback callback = std::move(timer.callback);
+
+        if(timer.interval_ms == 0)
+        {
+            FreeTimer(index);
+            callback(timer_id);
+        }
+        else
+        {
+            timer.expire_time = m_time + timer.interval_ms;
+            Insert(index);
+
+            callback(timer_id);
+
+            Timer& repeating_timer = m_timers[index];
+            if(repeating_timer.generation == generation && repeating_timer.slot != FREE_SLOT)
+                repeating_timer.callback = std::move(callback);
+        }
+    }
+}
+
+uint32_t TimerSystem::FindTimer(uint32_t timer_id) const
+{
+    if(timer_id == NO_TIMER)
+        return NO_INDEX;
+
+    const uint32_t index = timer_id & INDEX_MASK;
+    if(index >= m_n_timers)
+        return NO_INDEX;
+
+    const Timer& timer = m_timers[index];
+    if(timer.slot == FREE_SLOT || timer.generation != (timer_id >> INDEX_BITS))
+        return NO_INDEX;
+
+    return index;
+}
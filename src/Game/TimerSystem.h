@@ -0,0 +1,86 @@
+
+#pragma once
+
+#include "Scheduler/ScheduledSystem.h"
+#include "ChunkedArray.h"
+
+#include <cstdint>
+#include <vector>
+#include <functional>
+
+namespace game
+{
+    using TimerCallback = std::function<void (uint32_t timer_id)>;
+
+    // Timers on a hierarchical timing wheel that is advanced with the simulation ticks. Starting and cancelling
+    // a timer is O(1) and a pending timer costs nothing until it expires or is moved down a level, so systems
+    // don't have to count down a timeout per component every frame.
+    //
+    // Timers are started and cancelled from component, trigger and timer callbacks, none of which run in
+    // parallel with the scheduled updates. A callback is free to start and cancel timers, itself included.
+    class TimerSystem : public ScheduledSystem
+    {
+    public:
+
+        static constexpr uint32_t NO_TIMER = uint32_t(-1);
+
+        TimerSystem(size_t n_timers, const class SimulationClock* simulation_clock);
+
+        // Calls the callback once, timeout_ms from now.
+        uint32_t StartTimer(uint32_t timeout_ms, TimerCallback callback);
+
+        // Calls the callback every interval_ms until it's cancelled.
+        uint32_t StartRepeatingTimer(uint32_t interval_ms, TimerCallback callback);
+
+        // Returns false if the timer already expired or was cancelled.
+        bool CancelTimer(uint32_t timer_id);
+        bool IsActive(uint32_t timer_id) const;
+        uint32_t ActiveTimers() const;
+
+        // Moves the time forward and calls the callbacks of the timers that expire, in order.
+        void Advance(uint32_t delta_ms);
+        uint32_t Time() const;
+
+        uint32_t Id() const override;
+        const char* Name() const override;
+        void ScheduledUpdate(const mono::UpdateContext& update_context) override;
+        SystemAccess Access() const override;
+
+    private:
+
+        static constexpr uint32_t SLOT_BITS = 6;
+        static constexpr uint32_t N_SLOTS = 1 << SLOT_BITS;
+        static constexpr uint32_t N_LEVELS = 4;
+
+        struct Timer
+        {
+            uint32_t expire_time;
+            uint32_t interval_ms;
+            uint32_t next;
+            uint32_t prev;
+            uint32_t slot;
+            uint32_t generation;
+            TimerCallback callback;
+        };
+
+        uint32_t AllocateTimer(uint32_t timeout_ms, uint32_t interval_ms, TimerCallback callback);
+        void FreeTimer(uint32_t index);
+        void Insert(uint32_t index);
+        void Unlink(uint32_t index);
+        void Cascade(uint32_t level);
+        void Tick();
+        uint32_t FindTimer(uint32_t timer_id) const;
+
+        const class SimulationClock* m_simulation_clock;
+        uint32_t m_time;
+        uint32_t m_active_timers;
+
+        // The timers never move, so a callback can start new timers while it's called.
+        ChunkedArray<Timer> m_timers;
+        uint32_t m_n_timers;
+        std::vector<uint32_t> m_free_timers;
+
+        // Head of the list of timers in each slot, level 0 has a slot per millisecond.
+        uint32_t m_slots[N_LEVELS * N_SLOTS];
+    };
+}
@@ -1,6 +1,10 @@
 
 #include "TriggerSystem.h"
+#include "Component.h"
+#include "CollisionConfiguration.h"
 #include "DamageSystem.h"
+#include "TimerSystem.h"
+#include "Entity/EntityProperties.h"
 #include "Util/Algorithm.h"
 #include "System/Hash.h"
 #include "Physics/IShape.h"
@@ -14,8 +18,10 @@
 #include "IDebugDrawer.h"
 #include "GameDebug.h"
 
+#include <algorithm>
 #include <cassert>
 #include <string>
+#include <utility>
 
 using namespace game;
 
@@ -48,34 +54,103 @@ namespace
         TriggerSystem* m_trigger_system;
     };
 
+    // Counts the bodies overlapping the area sensor, a body with several shapes inside is counted once.
+    class AreaTriggerHandler : public mono::ICollisionHandler
+    {
+    public:
+
+        AreaTriggerHandler(uint32_t entity_id, AreaEntityTriggerComponent* area_trigger, std::vector<uint32_t>* changed_area_triggers)
+            : m_entity_id(entity_id)
+            , m_area_trigger(area_trigger)
+            , m_changed_area_triggers(changed_area_triggers)
+        { }
+
+        mono::CollisionResolve OnCollideWith(
+            mono::IBody* body, const math::Vector& collision_point, const math::Vector& collision_normal, uint32_t categories) override
+        {
+            std::vector<mono::IBody*>& overlapping_bodies = m_area_trigger->overlapping_bodies;
+            const bool new_body = (std::find(overlapping_bodies.begin(), overlapping_bodies.end(), body) == overlapping_bodies.end());
+            overlapping_bodies.push_back(body);
+
+            if(new_body)
+            {
+                m_area_trigger->n_bodies++;
+                MarkChanged();
+            }
+
+            return mono::CollisionResolve::IGNORE;
+        }
+
+        void OnSeparateFrom(mono::IBody* body) override
+        {
+            std::vector<mono::IBody*>& overlapping_bodies = m_area_trigger->overlapping_bodies;
+            const auto it = std::find(overlapping_bodies.begin(), overlapping_bodies.end(), body);
+            if(it == overlapping_bodies.end())
+                return;
+
+            overlapping_bodies.erase(it);
+
+            const bool body_left = (std::find(overlapping_bodies.begin(), overlapping_bodies.end(), body) == overlapping_bodies.end());
+            if(body_left)
+            {
+                m_area_trigger->n_bodies--;
+                MarkChanged();
+            }
+        }
+
+        void MarkChanged()
+        {
+            if(!m_area_trigger->changed)
+            {
+                m_area_trigger->changed = true;
+                m_changed_area_triggers->push_back(m_entity_id);
+            }
+        }
+
+        const uint32_t m_entity_id;
+        AreaEntityTriggerComponent* m_area_trigger;
+        std::vector<uint32_t>* m_changed_area_triggers;
+    };
+
     constexpr uint32_t NO_CALLBACK_SET = std::numeric_limits<uint32_t>::max();
+    constexpr uint32_t NO_TRIGGER = std::numeric_limits<uint32_t>::max();
+    constexpr uint32_t NO_SENSOR_ENTITY = std::numeric_limits<uint32_t>::max();
 }
 
-TriggerSystem::TriggerSystem(size_t n_triggers, DamageSystem* damage_system, mono::PhysicsSystem* physics_system, mono::IEntityManager* entity_system)
+TriggerSystem::TriggerSystem(
+    size_t n_triggers,
+    DamageSystem* damage_system,
+    mono::PhysicsSystem* physics_system,
+    mono::IEntityManager* entity_system,
+    TimerSystem* timer_system)
     : m_damage_system(damage_system)
     , m_physics_system(physics_system)
     , m_entity_system(entity_system)
+    , m_timer_system(timer_system)
+    , m_n_listeners(0)
+    , m_listener_table_dirty(false)
+    , m_hold_area_triggers(false)
 {
-    m_shape_triggers.resize(n_triggers);
-    m_active_shape_triggers.resize(n_triggers, false);
+    m_shape_triggers.EnsureSize(n_triggers);
+    m_active_shape_triggers = SparseSet(n_triggers);
 
-    m_destroyed_triggers.resize(n_triggers);
-    m_active_destroyed_triggers.resize(n_triggers, false);
+    m_destroyed_triggers.EnsureSize(n_triggers);
+    m_active_destroyed_triggers = SparseSet(n_triggers);
 
-    m_area_triggers.resize(n_triggers);
-    m_active_area_triggers.resize(n_triggers, false);
-    m_area_trigger_timer = 0;
+    m_area_triggers.EnsureSize(n_triggers);
+    m_active_area_triggers = SparseSet(n_triggers);
 
-    m_time_triggers.resize(n_triggers);
-    m_active_time_triggers.resize(n_triggers, false);
+    m_time_triggers.EnsureSize(n_triggers);
+    m_active_time_triggers = SparseSet(n_triggers);
 
-    m_counter_triggers.resize(n_triggers);
-    m_active_counter_triggers.resize(n_triggers, false);
+    m_counter_triggers.EnsureSize(n_triggers);
+    m_active_counter_triggers = SparseSet(n_triggers);
 }
 
 ShapeTriggerComponent* TriggerSystem::AllocateShapeTrigger(uint32_t entity_id)
 {
-    m_active_shape_triggers[entity_id] = true;
+    m_active_shape_triggers.Add(entity_id);
+    m_shape_triggers.EnsureSize(entity_id + 1);
 
     ShapeTriggerComponent* allocated_trigger = &m_shape_triggers[entity_id];
     allocated_trigger->shape_trigger_handler = nullptr;
@@ -96,7 +171,7 @@ void TriggerSystem::ReleaseShapeTrigger(uint32_t entity_id)
         allocated_trigger->shape_trigger_handler = nullptr;
     }
 
-    m_active_shape_triggers[entity_id] = false;
+    m_active_shape_triggers.Remove(entity_id);
 }
 
 void TriggerSystem::AddShapeTrigger(
@@ -126,7 +201,8 @@ void TriggerSystem::AddShapeTrigger(
 
 DestroyedTriggerComponent* TriggerSystem::AllocateDestroyedTrigger(uint32_t entity_id)
 {
-    m_active_destroyed_triggers[entity_id] = true;
+    m_active_destroyed_triggers.Add(entity_id);
+    m_destroyed_triggers.EnsureSize(entity_id + 1);
 
     DestroyedTriggerComponent* allocated_trigger = &m_destroyed_triggers[entity_id];
     allocated_trigger->callback_id = NO_CALLBACK_SET;
@@ -149,7 +225,7 @@ void TriggerSystem::ReleaseDestroyedTrigger(uint32_t entity_id)
     };
     allocated_trigger.callback_id = NO_CALLBACK_SET;
 
-    m_active_destroyed_triggers[entity_id] = false;
+    m_active_destroyed_triggers.Remove(entity_id);
 }
 
 void TriggerSystem::AddDestroyedTrigger(uint32_t entity_id, uint32_t trigger_hash, shared::DestroyedTriggerType type)
@@ -188,16 +264,23 @@ void TriggerSystem::AddDestroyedTrigger(uint32_t entity_id, uint32_t trigger_has
 
 AreaEntityTriggerComponent* TriggerSystem::AllocateAreaTrigger(uint32_t entity_id)
 {
-    m_active_area_triggers[entity_id] = true;
+    m_active_area_triggers.Add(entity_id);
+    m_area_triggers.EnsureSize(entity_id + 1);
 
     AreaEntityTriggerComponent* allocated_trigger = &m_area_triggers[entity_id];
+    allocated_trigger->n_bodies = 0;
+    allocated_trigger->overlapping_bodies.clear();
+    allocated_trigger->sensor_entity_id = NO_SENSOR_ENTITY;
+    allocated_trigger->changed = false;
+    allocated_trigger->area_trigger_handler = nullptr;
+
     return allocated_trigger;
 }
 
 void TriggerSystem::ReleaseAreaTrigger(uint32_t entity_id)
 {
-    //AreaEntityTriggerComponent& allocated_trigger = m_area_triggers[entity_id];
-    m_active_area_triggers[entity_id] = false;
+    RemoveAreaTriggerSensor(entity_id);
+    m_active_area_triggers.Remove(entity_id);
 }
 
 void TriggerSystem::AddAreaEntityTrigger(
@@ -210,17 +293,95 @@ void TriggerSystem::AddAreaEntityTrigger(
     area_trigger.world_bb = world_bb;
     area_trigger.n_entities = n_entities;
     area_trigger.operation = operation;
+
+    RemoveAreaTriggerSensor(entity_id);
+
+    // The sensor gets a static body of its own, on a local entity, so it is not part of the collision
+    // setup of the trigger entity.
+    const mono::Entity sensor_entity = m_entity_system->CreateEntity("area_trigger_sensor", {});
+    m_entity_system->SetEntityProperties(sensor_entity.id, EntityProperties::LOCAL);
+    area_trigger.sensor_entity_id = sensor_entity.id;
+
+    mono::BodyComponent body_params;
+    body_params.mass = 1.0f;
+    body_params.inertia = 1.0f;
+    body_params.type = mono::BodyType::STATIC;
+
+    m_physics_system->AllocateBody(sensor_entity.id, body_params);
+    mono::IBody* body = m_physics_system->GetBody(sensor_entity.id);
+    body->SetPosition(math::Center(world_bb));
+
+    // The sensor has a category of its own that every faction collides with, the mask picks the factions
+    // that are counted.
+    mono::BoxComponent shape_params;
+    shape_params.size = math::Vector(math::Width(world_bb), math::Height(world_bb));
+    shape_params.offset = math::ZeroVec;
+    shape_params.is_sensor = true;
+    shape_params.category = shared::CollisionCategory::TRIGGER;
+    shape_params.mask = faction;
+    m_physics_system->AddShape(sensor_entity.id, shape_params);
+
+    area_trigger.area_trigger_handler = std::make_unique<AreaTriggerHandler>(entity_id, &area_trigger, &m_changed_area_triggers);
+    body->AddCollisionHandler(area_trigger.area_trigger_handler.get());
+
+    m_new_area_triggers.push_back(entity_id);
+}
+
+void TriggerSystem::RemoveAreaTriggerSensor(uint32_t entity_id)
+{
+    AreaEntityTriggerComponent& area_trigger = m_area_triggers[entity_id];
+    if(!area_trigger.area_trigger_handler)
+        return;
+
+    mono::IBody* body = m_physics_system->GetBody(area_trigger.sensor_entity_id);
+    if(body)
+        body->RemoveCollisionHandler(area_trigger.area_trigger_handler.get());
+
+    m_physics_system->ReleaseBody(area_trigger.sensor_entity_id);
+    m_entity_system->ReleaseEntity(area_trigger.sensor_entity_id);
+
+    area_trigger.area_trigger_handler = nullptr;
+    area_trigger.sensor_entity_id = NO_SENSOR_ENTITY;
+    area_trigger.n_bodies = 0;
+    area_trigger.overlapping_bodies.clear();
+}
+
+void TriggerSystem::HoldAreaTriggers(bool hold)
+{
+    if(hold == m_hold_area_triggers)
+        return;
+
+    m_hold_area_triggers = hold;
+    if(hold)
+        return;
+
+    // Checked like new triggers when released, the physics reports the bodies created last before that.
+    for(uint32_t entity_id : m_changed_area_triggers)
+    {
+        m_area_triggers[entity_id].changed = false;
+        m_new_area_triggers.push_back(entity_id);
+    }
+
+    m_changed_area_triggers.clear();
 }
 
 TimeTriggerComponent* TriggerSystem::AllocateTimeTrigger(uint32_t entity_id)
 {
-    m_active_time_triggers[entity_id] = true;
-    return &m_time_triggers[entity_id];
+    m_active_time_triggers.Add(entity_id);
+    m_time_triggers.EnsureSize(entity_id + 1);
+
+    TimeTriggerComponent& time_trigger = m_time_triggers[entity_id];
+    time_trigger.timer_id = TimerSystem::NO_TIMER;
+    return &time_trigger;
 }
 
 void TriggerSystem::ReleaseTimeTrigger(uint32_t entity_id)
 {
-    m_active_time_triggers[entity_id] = false;
+    TimeTriggerComponent& time_trigger = m_time_triggers[entity_id];
+    m_timer_system->CancelTimer(time_trigger.timer_id);
+    time_trigger.timer_id = TimerSystem::NO_TIMER;
+
+    m_active_time_triggers.Remove(entity_id);
 }
 
 void TriggerSystem::AddTimeTrigger(uint32_t entity_id, uint32_t trigger_hash, float timeout_ms, bool repeating)
@@ -229,13 +390,34 @@ void TriggerSystem::AddTimeTrigger(uint32_t entity_id, uint32_t trigger_hash, fl
 
     time_trigger.trigger_hash = trigger_hash;
     time_trigger.timeout_ms = timeout_ms;
-    time_trigger.timeout_counter_ms = timeout_ms;
     time_trigger.repeating = repeating;
+
+    m_timer_system->CancelTimer(time_trigger.timer_id);
+
+    const uint32_t timeout = static_cast<uint32_t>(std::max(timeout_ms, 0.0f));
+
+    if(repeating)
+    {
+        const auto timer_callback = [this, trigger_hash](uint32_t timer_id) {
+            EmitTrigger(trigger_hash);
+        };
+        time_trigger.timer_id = m_timer_system->StartRepeatingTimer(timeout, timer_callback);
+    }
+    else
+    {
+        const auto timer_callback = [this, entity_id, trigger_hash](uint32_t timer_id) {
+            EmitTrigger(trigger_hash);
+            m_time_triggers[entity_id].timer_id = TimerSystem::NO_TIMER;
+            m_active_time_triggers.Remove(entity_id);
+        };
+        time_trigger.timer_id = m_timer_system->StartTimer(timeout, timer_callback);
+    }
 }
 
 CounterTriggerComponent* TriggerSystem::AllocateCounterTrigger(uint32_t entity_id)
 {
-    m_active_counter_triggers[entity_id] = true;
+    m_active_counter_triggers.Add(entity_id);
+    m_counter_triggers.EnsureSize(entity_id + 1);
 
     CounterTriggerComponent& counter_trigger = m_counter_triggers[entity_id];
     counter_trigger.callback_id = NO_CALLBACK_SET;
@@ -253,61 +435,75 @@ void TriggerSystem::ReleaseCounterTrigger(uint32_t entity_id)
         counter_trigger.callback_id = NO_CALLBACK_SET;
     }
 
-    m_active_counter_triggers[entity_id] = false;
+    m_active_counter_triggers.Remove(entity_id);
 }
 
 void TriggerSystem::AddCounterTrigger(uint32_t entity_id, uint32_t listener_hash, uint32_t completed_hash, int count, bool reset_on_completed)
 {
     CounterTriggerComponent* counter_trigger = &m_counter_triggers[entity_id];
 
-    counter_trigger->listen_trigger_hash = listener_hash;
-    counter_trigger->completed_trigger_hash = completed_hash;
-    counter_trigger->count = count;
-    counter_trigger->reset_on_completed = reset_on_completed;
-
     if(counter_trigger->callback_id != NO_CALLBACK_SET)
     {
         RemoveTriggerCallback(counter_trigger->listen_trigger_hash, counter_trigger->callback_id, entity_id);
         counter_trigger->callback_id = NO_CALLBACK_SET;
     }
 
-    const auto counter_callback = [this, counter_trigger](uint32_t trigger_id)
+    // A count below one would complete forever when resetting, it completes on the first emit instead.
+    counter_trigger->listen_trigger_hash = listener_hash;
+    counter_trigger->completed_trigger_hash = completed_hash;
+    counter_trigger->count = std::max(count, 1);
+    counter_trigger->reset_on_completed = reset_on_completed;
+
+    const auto counter_callback = [this, counter_trigger](uint32_t trigger_id, uint32_t n_emits)
     {
-        counter_trigger->counter++;
-        if(counter_trigger->counter == counter_trigger->count)
+        const int previous_counter = counter_trigger->counter;
+        counter_trigger->counter += n_emits;
+
+        if(counter_trigger->reset_on_completed)
         {
-            EmitTrigger(counter_trigger->completed_trigger_hash);
-            if(counter_trigger->reset_on_completed)
-                counter_trigger->counter = 0;
-            else
+            while(counter_trigger->counter >= counter_trigger->count)
             {
-                // Remove?
+                EmitTrigger(counter_trigger->completed_trigger_hash);
+                counter_trigger->counter -= counter_trigger->count;
             }
         }
+        else if(previous_counter < counter_trigger->count && counter_trigger->counter >= counter_trigger->count)
+        {
+            EmitTrigger(counter_trigger->completed_trigger_hash);
+        }
     };
 
-    counter_trigger->callback_id = RegisterTriggerCallback(listener_hash, counter_callback, entity_id);
+    counter_trigger->callback_id = RegisterTriggerCountCallback(listener_hash, counter_callback, entity_id);
 }
 
 uint32_t TriggerSystem::RegisterTriggerCallback(uint32_t trigger_hash, TriggerCallback callback, uint32_t debug_entity_id)
 {
     m_entity_id_to_trigger_hashes[trigger_hash].push_back(debug_entity_id);
+    return AddListener(trigger_hash, std::move(callback), nullptr);
+}
 
-    TriggerCallbacks& callback_array = m_trigger_callbacks[trigger_hash];
-    const auto it = std::find(callback_array.begin(), callback_array.end(), nullptr);
-    if(it != callback_array.end())
-    {
-        (*it) = callback;
-        return std::distance(callback_array.begin(), it);
-    }
-
-    return std::numeric_limits<uint32_t>::max();
+uint32_t TriggerSystem::RegisterTriggerCountCallback(
+    uint32_t trigger_hash, TriggerCountCallback callback, uint32_t debug_entity_id)
+{
+    m_entity_id_to_trigger_hashes[trigger_hash].push_back(debug_entity_id);
+    return AddListener(trigger_hash, nullptr, std::move(callback));
 }
 
 void TriggerSystem::RemoveTriggerCallback(uint32_t trigger_hash, uint32_t callback_id, uint32_t debug_entity_id)
 {
-    m_trigger_callbacks[trigger_hash][callback_id] = nullptr;
     mono::remove(m_entity_id_to_trigger_hashes[trigger_hash], debug_entity_id);
+
+    if(callback_id >= m_n_listeners)
+        return;
+
+    // Only remove the listener if it still listens to this trigger, the id might have been reused by another one.
+    const auto it = m_trigger_indices.find(trigger_hash);
+    if(it == m_trigger_indices.end() || m_listeners[callback_id].trigger_index != it->second)
+        return;
+
+    // The callback is kept until the table is rebuilt, since it might be the one that is being called.
+    m_listeners[callback_id].trigger_index = NO_TRIGGER;
+    m_listener_table_dirty = true;
 }
 
 const std::unordered_map<uint32_t, std::vector<uint32_t>>& TriggerSystem::GetTriggerTargets() const
@@ -317,7 +513,11 @@ const std::unordered_map<uint32_t, std::vector<uint32_t>>& TriggerSystem::GetTri
 
 void TriggerSystem::EmitTrigger(uint32_t trigger_hash)
 {
-    m_triggers_to_emit.push_back(trigger_hash);
+    const uint32_t trigger_index = FindOrAddTriggerIndex(trigger_hash);
+    if(m_emit_counts[trigger_index] == 0)
+        m_emitted_triggers.push_back(trigger_index);
+
+    m_emit_counts[trigger_index]++;
 }
 
 uint32_t TriggerSystem::Id() const
@@ -330,29 +530,124 @@ const char* TriggerSystem::Name() const
     return "TriggerSystem";
 }
 
-void TriggerSystem::Update(const mono::UpdateContext& update_context)
+SystemAccess TriggerSystem::Access() const
+{
+    // Listeners are registered by most other systems and run from the dispatch.
+    SystemAccess access;
+    access.exclusive = true;
+    return access;
+}
+
+void TriggerSystem::ScheduledUpdate(const mono::UpdateContext& update_context)
+{
+    UpdateAreaEntityTriggers();
+
+    DispatchTriggers();
+}
+
+uint32_t TriggerSystem::FindOrAddTriggerIndex(uint32_t trigger_hash)
 {
-    m_area_trigger_timer += update_context.delta_ms;
-    if(m_area_trigger_timer >= 1000)
+    const auto it = m_trigger_indices.find(trigger_hash);
+    if(it != m_trigger_indices.end())
+        return it->second;
+
+    const uint32_t trigger_index = m_trigger_hashes.size();
+    m_trigger_indices[trigger_hash] = trigger_index;
+    m_trigger_hashes.push_back(trigger_hash);
+    m_emit_counts.push_back(0);
+
+    return trigger_index;
+}
+
+uint32_t TriggerSystem::AddListener(uint32_t trigger_hash, TriggerCallback callback, TriggerCountCallback count_callback)
+{
+    uint32_t listener_index;
+    if(m_free_listeners.empty())
+    {
+        listener_index = m_n_listeners++;
+        m_listeners.EnsureSize(m_n_listeners);
+    }
+    else
     {
-        UpdateAreaEntityTriggers(update_context);
-        m_area_trigger_timer = 0;
+        listener_index = m_free_listeners.back();
+        m_free_listeners.pop_back();
     }
 
-    UpdateTimeTriggers(update_context);
+    TriggerListener& listener = m_listeners[listener_index];
+    listener.trigger_index = FindOrAddTriggerIndex(trigger_hash);
+    listener.callback = std::move(callback);
+    listener.count_callback = std::move(count_callback);
+
+    m_listener_table_dirty = true;
 
-    const std::vector<uint32_t> local_triggers_to_emit = m_triggers_to_emit;
-    m_triggers_to_emit.clear();
+    return listener_index;
+}
+
+void TriggerSystem::RebuildListenerTable()
+{
+    m_listener_offsets.assign(m_trigger_hashes.size() + 1, 0);
 
-    for(uint32_t trigger_hash : local_triggers_to_emit)
+    for(uint32_t listener_index = 0; listener_index < m_n_listeners; ++listener_index)
     {
-        const auto it = m_trigger_callbacks.find(trigger_hash);
-        if(it != m_trigger_callbacks.end())
+        TriggerListener& listener = m_listeners[listener_index];
+        if(listener.trigger_index == NO_TRIGGER)
         {
-            for(TriggerCallback callback : it->second)
+            if(listener.callback || listener.count_callback)
             {
-                if(callback)
-                    callback(trigger_hash);
+                listener.callback = nullptr;
+                listener.count_callback = nullptr;
+                m_free_listeners.push_back(listener_index);
+            }
+            continue;
+        }
+
+        m_listener_offsets[listener.trigger_index + 1]++;
+    }
+
+    for(size_t index = 1; index < m_listener_offsets.size(); ++index)
+        m_listener_offsets[index] += m_listener_offsets[index - 1];
+
+    std::vector<uint32_t> insert_offsets(m_listener_offsets.begin(), m_listener_offsets.end() - 1);
+    m_listener_table.resize(m_listener_offsets.back());
+
+    for(uint32_t listener_index = 0; listener_index < m_n_listeners; ++listener_index)
+    {
+        const uint32_t trigger_index = m_listeners[listener_index].trigger_index;
+        if(trigger_index != NO_TRIGGER)
+            m_listener_table[insert_offsets[trigger_index]++] = listener_index;
+    }
+
+    m_listener_table_dirty = false;
+}
+
+void TriggerSystem::DispatchTriggers()
+{
+    if(m_listener_table_dirty)
+        RebuildListenerTable();
+
+    // Triggers emitted by the callbacks are dispatched next frame.
+    std::swap(m_emitted_triggers, m_dispatch_triggers);
+
+    for(uint32_t trigger_index : m_dispatch_triggers)
+    {
+        const uint32_t trigger_hash = m_trigger_hashes[trigger_index];
+        const uint32_t n_emits = m_emit_counts[trigger_index];
+        m_emit_counts[trigger_index] = 0;
+
+        // Triggers first seen after the table was built have no listeners yet.
+        if(trigger_index + 1 < m_listener_offsets.size())
+        {
+            const uint32_t listeners_end = m_listener_offsets[trigger_index + 1];
+            for(uint32_t table_index = m_listener_offsets[trigger_index]; table_index < listeners_end; ++table_index)
+            {
+                const TriggerListener& listener = m_listeners[m_listener_table[table_index]];
+                if(listener.trigger_index != trigger_index)
+                    continue;
+
+                if(listener.callback)
+                    listener.callback(trigger_hash);
+                else
+                    listener.count_callback(trigger_hash, n_emits);
             }
         }
 
@@ -362,62 +657,56 @@ void TriggerSystem::Update(const mono::UpdateContext& update_context)
             game::g_debug_drawer->DrawScreenTextFading(hash_string, math::Vector(1, 2), mono::Color::BLACK, 2000);
         }
     }
+
+    m_dispatch_triggers.clear();
 }
 
-void TriggerSystem::UpdateAreaEntityTriggers(const mono::UpdateContext& update_context)
+void TriggerSystem::UpdateAreaEntityTriggers()
 {
-    for(uint32_t index = 0; index < m_active_area_triggers.size(); ++index)
+    if(m_hold_area_triggers)
+        return;
+
+    for(uint32_t entity_id : m_changed_area_triggers)
     {
-        if(m_active_area_triggers[index])
-        {
-            AreaEntityTriggerComponent& area_trigger = m_area_triggers[index];
+        AreaEntityTriggerComponent& area_trigger = m_area_triggers[entity_id];
+        area_trigger.changed = false;
 
-            const std::vector<mono::IBody*> found_bodies
-                = m_physics_system->GetSpace()->QueryBox(area_trigger.world_bb, area_trigger.faction);
-            const int n_found_bodies = found_bodies.size();
+        if(!m_active_area_triggers.Contains(entity_id))
+            continue;
 
-            bool emit_trigger = false;
+        bool emit_trigger = false;
 
-            switch(area_trigger.operation)
-            {
-            case shared::AreaTriggerOperation::EQUAL_TO:
-                emit_trigger = (n_found_bodies == area_trigger.n_entities);
-                break;
-            case shared::AreaTriggerOperation::LESS_THAN:
-                emit_trigger = (n_found_bodies < area_trigger.n_entities);
-                break;
-            case shared::AreaTriggerOperation::GREATER_THAN:
-                emit_trigger = (n_found_bodies > area_trigger.n_entities);
-                break;
-            }
+        switch(area_trigger.operation)
+        {
+        case shared::AreaTriggerOperation::EQUAL_TO:
+            emit_trigger = (area_trigger.n_bodies == area_trigger.n_entities);
+            break;
+        case shared::AreaTriggerOperation::LESS_THAN:
+            emit_trigger = (area_trigger.n_bodies < area_trigger.n_entities);
+            break;
+        case shared::AreaTriggerOperation::GREATER_THAN:
+            emit_trigger = (area_trigger.n_bodies > area_trigger.n_entities);
+            break;
+        }
 
-            if(emit_trigger)
-            {
-                EmitTrigger(area_trigger.trigger_hash);
-                m_active_area_triggers[index] = false;
-            }
+        if(emit_trigger)
+        {
+            EmitTrigger(area_trigger.trigger_hash);
+            m_active_area_triggers.Remove(entity_id);
         }
     }
-}
 
-void TriggerSystem::UpdateTimeTriggers(const mono::UpdateContext& update_context)
-{
-    for(uint32_t index = 0; index < m_active_time_triggers.size(); ++index)
+    m_changed_area_triggers.clear();
+
+    for(uint32_t entity_id : m_new_area_triggers)
     {
-        if(m_active_time_triggers[index])
+        AreaEntityTriggerComponent& area_trigger = m_area_triggers[entity_id];
+        if(!area_trigger.changed)
         {
-            TimeTriggerComponent& time_trigger = m_time_triggers[index];
-            time_trigger.timeout_counter_ms -= update_context.delta_ms;
-
-            const bool emit_trigger = (time_trigger.timeout_counter_ms < 0.0f);
-            if(emit_trigger)
-            {
-                EmitTrigger(time_trigger.trigger_hash);
-                if(time_trigger.repeating)
-                    time_trigger.timeout_counter_ms = time_trigger.timeout_ms;
-                else
-                    m_active_time_triggers[index] = false;
-            }
+            area_trigger.changed = true;
+            m_changed_area_triggers.push_back(entity_id);
         }
     }
+
+    m_new_area_triggers.clear();
 }
@@ -1,7 +1,9 @@
 
 #pragma once
 
-#include "IGameSystem.h"
+#include "Scheduler/ScheduledSystem.h"
+#include "SparseSet.h"
+#include "ChunkedArray.h"
 #include "MonoFwd.h"
 #include "Math/Quad.h"
 
@@ -10,7 +12,6 @@
 
 #include <cstdint>
 #include <vector>
-#include <array>
 #include <unordered_map>
 #include <functional>
 #include <memory>
@@ -41,14 +42,23 @@ namespace game
         uint32_t faction;
         int n_entities;
         shared::AreaTriggerOperation operation;
+
+        // Internal data
+        int n_bodies;
+        std::vector<mono::IBody*> overlapping_bodies;
+        uint32_t sensor_entity_id;
+        bool changed;
+        std::unique_ptr<mono::ICollisionHandler> area_trigger_handler;
     };
 
     struct TimeTriggerComponent
     {
         uint32_t trigger_hash;
         float timeout_ms;
-        float timeout_counter_ms;
         bool repeating;
+
+        // Internal data
+        uint32_t timer_id;
     };
 
     struct CounterTriggerComponent
@@ -64,12 +74,18 @@ namespace game
     };
 
     using TriggerCallback = std::function<void (uint32_t trigger_id)>;
+    using TriggerCountCallback = std::function<void (uint32_t trigger_id, uint32_t n_emits)>;
 
-    class TriggerSystem : public mono::IGameSystem
+    class TriggerSystem : public ScheduledSystem
     {
     public:
 
-        TriggerSystem(size_t n_triggers, class DamageSystem* damage_system, mono::PhysicsSystem* physics_system, mono::IEntityManager* entity_system);
+        TriggerSystem(
+            size_t n_triggers,
+            class DamageSystem* damage_system,
+            mono::PhysicsSystem* physics_system,
+            mono::IEntityManager* entity_system,
+            class TimerSystem* timer_system);
 
         ShapeTriggerComponent* AllocateShapeTrigger(uint32_t entity_id);
         void ReleaseShapeTrigger(uint32_t entity_id);
@@ -85,6 +101,10 @@ namespace game
         void AddAreaEntityTrigger(
             uint32_t entity_id, uint32_t trigger_hash, const math::Quad& world_bb, uint32_t faction, shared::AreaTriggerOperation operation, int n_entities);
 
+        // Area triggers are not checked while held, the bodies are still counted. Hold them while the world is
+        // streamed in, an area could otherwise be checked before the entities in it are created.
+        void HoldAreaTriggers(bool hold);
+
         TimeTriggerComponent* AllocateTimeTrigger(uint32_t entity_id);
         void ReleaseTimeTrigger(uint32_t entity_id);
         void AddTimeTrigger(uint32_t entity_id, uint32_t trigger_hash, float timeout_ms, bool repeating);
@@ -94,8 +114,13 @@ namespace game
         void AddCounterTrigger(
             uint32_t entity_id, uint32_t listener_hash, uint32_t completed_hash, int count, bool reset_on_completed);
 
+        // Callbacks are called once per frame for a trigger, no matter how many times it was emitted that frame.
         [[nodiscard]]
         uint32_t RegisterTriggerCallback(uint32_t trigger_hash, TriggerCallback callback, uint32_t debug_entity_id);
+
+        // Same as above, but the callback also gets the number of times the trigger was emitted that frame.
+        [[nodiscard]]
+        uint32_t RegisterTriggerCountCallback(uint32_t trigger_hash, TriggerCountCallback callback, uint32_t debug_entity_id);
         void RemoveTriggerCallback(uint32_t trigger_hash, uint32_t callback_id, uint32_t debug_entity_id);
 
         const std::unordered_map<uint32_t, std::vector<uint32_t>>& GetTriggerTargets() const;
@@ -105,91 +130,108 @@ namespace game
         template<typename T>
         void ForEachShapeTrigger(T&& callable) const
         {
-            for(uint32_t index = 0; index < m_active_shape_triggers.size(); ++index)
-            {
-                const bool is_active = m_active_shape_triggers[index];
-                if(is_active)
-                    callable(index, m_shape_triggers[index]);
-            }
+            for(uint32_t index : m_active_shape_triggers)
+                callable(index, m_shape_triggers[index]);
         }
 
         template<typename T>
         void ForEachDestroyedTrigger(T&& callable) const
         {
-            for(uint32_t index = 0; index < m_active_destroyed_triggers.size(); ++index)
-            {
-                const bool is_active = m_active_destroyed_triggers[index];
-                if(is_active)
-                    callable(index, m_destroyed_triggers[index]);
-            }
+            for(uint32_t index : m_active_destroyed_triggers)
+                callable(index, m_destroyed_triggers[index]);
         }
 
         template<typename T>
         void ForEachAreaTrigger(T&& callable) const
         {
-            for(uint32_t index = 0; index < m_active_area_triggers.size(); ++index)
-            {
-                const bool is_active = m_active_area_triggers[index];
-                if(is_active)
-                    callable(index, m_area_triggers[index]);
-            }
+            for(uint32_t index : m_active_area_triggers)
+                callable(index, m_area_triggers[index]);
         }
 
         template<typename T>
         void ForEachTimeTrigger(T&& callable) const
         {
-            for(uint32_t index = 0; index < m_active_time_triggers.size(); ++index)
-            {
-                const bool is_active = m_active_time_triggers[index];
-                if(is_active)
-                    callable(index, m_time_triggers[index]);
-            }
+            for(uint32_t index : m_active_time_triggers)
+                callable(index, m_time_triggers[index]);
         }
 
         template<typename T>
         void ForEachCounterTrigger(T&& callable) const
         {
-            for(uint32_t index = 0; index < m_active_counter_triggers.size(); ++index)
-            {
-                const bool is_active = m_active_counter_triggers[index];
-                if(is_active)
-                    callable(index, m_counter_triggers[index]);
-            }
+            for(uint32_t index : m_active_counter_triggers)
+                callable(index, m_counter_triggers[index]);
         }
 
         uint32_t Id() const override;
         const char* Name() const override;
-        void Update(const mono::UpdateContext& update_context) override;
+        void ScheduledUpdate(const mono::UpdateContext& update_context) override;
+        SystemAccess Access() const override;
 
     private:
 
-        void UpdateAreaEntityTriggers(const mono::UpdateContext& update_context);
-        void UpdateTimeTriggers(const mono::UpdateContext& update_context);
+        void UpdateAreaEntityTriggers();
+        void RemoveAreaTriggerSensor(uint32_t entity_id);
+
+        uint32_t FindOrAddTriggerIndex(uint32_t trigger_hash);
+        uint32_t AddListener(uint32_t trigger_hash, TriggerCallback callback, TriggerCountCallback count_callback);
+        void RebuildListenerTable();
+        void DispatchTriggers();
 
         class DamageSystem* m_damage_system;
         mono::PhysicsSystem* m_physics_system;
         mono::IEntityManager* m_entity_system;
+        class TimerSystem* m_timer_system;
 
-        using TriggerCallbacks = std::array<TriggerCallback, 8>;
-        std::unordered_map<uint32_t, TriggerCallbacks> m_trigger_callbacks;
-
-        std::vector<ShapeTriggerComponent> m_shape_triggers;
-        std::vector<bool> m_active_shape_triggers;
-
-        std::vector<DestroyedTriggerComponent> m_destroyed_triggers;
-        std::vector<bool> m_active_destroyed_triggers;
-
-        std::vector<AreaEntityTriggerComponent> m_area_triggers;
-        std::vector<bool> m_active_area_triggers;
-        uint32_t m_area_trigger_timer;
+        // Trigger hashes are given a dense index the first time they are seen, which is when the components
+        // register and emit them during level load.
+        std::unordered_map<uint32_t, uint32_t> m_trigger_indices;
+        std::vector<uint32_t> m_trigger_hashes;
 
-        std::vector<TimeTriggerComponent> m_time_triggers;
-        std::vector<bool> m_active_time_triggers;
-
-        std::vector<CounterTriggerComponent> m_counter_triggers;
-        std::vector<bool> m_active_counter_triggers;
-
-        std::vector<uint32_t> m_triggers_to_emit;
+        struct TriggerListener
+        {
+            uint32_t trigger_index;
+            TriggerCallback callback;
+            TriggerCountCallback count_callback;
+        };
+
+        // The listeners never move, a callback can register and remove listeners while it is called. Removed
+        // listeners are cleared and reused when the table is rebuilt, outside of the dispatch.
+        ChunkedArray<TriggerListener> m_listeners;
+        uint32_t m_n_listeners;
+        std::vector<uint32_t> m_free_listeners;
+
+        // Listener indices grouped per trigger index, the listeners of trigger n are
+        // m_listener_table[m_listener_offsets[n] .. m_listener_offsets[n + 1]).
+        std::vector<uint32_t> m_listener_offsets;
+        std::vector<uint32_t> m_listener_table;
+        bool m_listener_table_dirty;
+
+        // Triggers emitted this frame, once per trigger, and the number of times each was emitted.
+        std::vector<uint32_t> m_emitted_triggers;
+        std::vector<uint32_t> m_dispatch_triggers;
+        std::vector<uint32_t> m_emit_counts;
+
+        ChunkedArray<ShapeTriggerComponent> m_shape_triggers;
+        SparseSet m_active_shape_triggers;
+
+        ChunkedArray<DestroyedTriggerComponent> m_destroyed_triggers;
+        SparseSet m_active_destroyed_triggers;
+
+        ChunkedArray<AreaEntityTriggerComponent> m_area_triggers;
+        SparseSet m_active_area_triggers;
+
+        // Area triggers are sensors in the physics space, the count of bodies inside is kept up to date by the
+        // collision callbacks and the condition is only checked when it changes. New triggers are checked once
+        // the physics has reported the bodies that are already inside.
+        std::vector<uint32_t> m_changed_area_triggers;
+        std::vector<uint32_t> m_new_area_triggers;
+        bool m_hold_area_triggers;
+
+        ChunkedArray<TimeTriggerComponent> m_time_triggers;
+        SparseSet m_active_time_triggers;
+
+        ChunkedArray<CounterTriggerComponent> m_counter_triggers;
+        SparseSet m_active_counter_triggers;
 
         // Debug data
         std::unordered_map<uint32_t, std::vector<uint32_t>> m_entity_id_to_trigger_hashes;
@@ -1,6 +1,6 @@
 
 #include "BulletWeapon.h"
-#include "BulletLogic.h"
+#include "ProjectileSystem.h"
 
 #include "Math/Vector.h"
 #include "Math/MathFunctions.h"
@@ -8,23 +8,10 @@
 #include "System/Audio.h"
 #include "Util/Random.h"
 
-#include "RenderLayers.h"
 #include "Effects/MuzzleFlash.h"
-#include "Effects/BulletTrailEffect.h"
 
 #include "SystemContext.h"
-#include "EntitySystem/IEntityManager.h"
-#include "Entity/EntityLogicSystem.h"
-
-#include "Physics/PhysicsSystem.h"
-#include "Physics/IBody.h"
-#include "Physics/IShape.h"
 #include "Particle/ParticleSystem.h"
-#include "TransformSystem/TransformSystem.h"
-
-#include "Component.h"
-
-//#include "System/System.h"
 
 #include <cmath>
 #include <algorithm>
@@ -54,20 +41,14 @@ Weapon::Weapon(const WeaponConfiguration& config, mono::IEntityManager* entity_m
     if(config.reload_sound)
         m_reload_sound = audio::CreateSound(config.reload_sound, audio::SoundPlayback::ONCE);
 
-    m_transform_system = system_context->GetSystem<mono::TransformSystem>();
-    m_physics_system = system_context->GetSystem<mono::PhysicsSystem>();
-    m_particle_system = system_context->GetSystem<mono::ParticleSystem>();
-    m_logic_system = system_context->GetSystem<EntityLogicSystem>();
+    m_projectile_system = system_context->GetSystem<ProjectileSystem>();
 
-    m_muzzle_flash = std::make_unique<MuzzleFlash>(m_particle_system, m_entity_manager);
-    m_bullet_trail = std::make_unique<BulletTrailEffect>(m_transform_system, m_particle_system, entity_manager);
+    mono::ParticleSystem* particle_system = system_context->GetSystem<mono::ParticleSystem>();
+    m_muzzle_flash = std::make_unique<MuzzleFlash>(particle_system, m_entity_manager);
 }
 
 Weapon::~Weapon()
-{
-    for(const auto& pair : m_bullet_id_to_callback)
-        m_entity_manager->RemoveReleaseCallback(pair.first, pair.second);
-}
+{ }
 
 WeaponState Weapon::Fire(const math::Vector& position, float direction, uint32_t timestamp)
 {
@@ -108,34 +89,7 @@ WeaponState Weapon::Fire(const math::Vector& position, float direction, uint32_t
         const math::Vector& unit = math::Normalized(math::VectorFromAngle(bullet_direction));
         const math::Vector& impulse = unit * m_weapon_config.bullet_force * force_multiplier;
 
-        mono::Entity bullet_entity = m_entity_manager->CreateEntity(m_weapon_config.bullet_config.entity_file);
-        BulletLogic* bullet_logic = new BulletLogic(bullet_entity.id, m_weapon_config.owner_id, m_weapon_config.bullet_config, m_physics_system);
-
-        m_entity_manager->AddComponent(bullet_entity.id, BEHAVIOUR_COMPONENT);
-        m_logic_system->AddLogic(bullet_entity.id, bullet_logic);
-
-        math::Matrix& transform = m_transform_system->GetTransform(bullet_entity.id);
-        transform = (m_weapon_config.bullet_want_direction) ? 
-            math::CreateMatrixWithPositionRotation(position, bullet_direction) : math::CreateMatrixWithPosition(position);
-        m_transform_system->SetTransformState(bullet_entity.id, mono::TransformState::CLIENT);
-
-        mono::IBody* body = m_physics_system->GetBody(bullet_entity.id);
-        body->SetVelocity(impulse);
-        body->SetNoDamping();
-        body->AddCollisionHandler(bullet_logic);
-
-        std::vector<mono::IShape*> shapes = m_physics_system->GetShapesAttachedToBody(bullet_entity.id);
-        for(mono::IShape* shape : shapes)
-            shape->SetCollisionFilter(m_weapon_config.bullet_config.collision_category, m_weapon_config.bullet_config.collision_mask);
-
-        m_bullet_trail->AttachEmitterToBullet(bullet_entity.id);
-
-        const ReleaseCallback release_callback = [this](uint32_t entity_id) {
-            m_bullet_trail->RemoveEmitterFromBullet(entity_id);
-            m_bullet_id_to_callback.erase(entity_id);
-        };
-        const uint32_t callback_id = m_entity_manager->AddReleaseCallback(bullet_entity.id, release_callback);
-        m_bullet_id_to_callback[bullet_entity.id] = callback_id;
+        m_projectile_system->SpawnProjectile(m_weapon_config.projectile_type, m_weapon_config.owner_id, position, impulse);
     }
 
     m_muzzle_flash->EmittAt(position, direction);
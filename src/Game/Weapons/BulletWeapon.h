@@ -8,11 +8,11 @@
 #include "System/Audio.h"
 #include "Math/MathFwd.h"
 
-#include <unordered_map>
+#include <memory>
 
 namespace game
 {
-    class EntityLogicSystem;
+    class ProjectileSystem;
 
     class Weapon : public IWeapon
     {
@@ -44,14 +44,7 @@ namespace game
         audio::ISoundPtr m_ooa_sound;
         audio::ISoundPtr m_reload_sound;
 
-        mono::TransformSystem* m_transform_system;
-        mono::PhysicsSystem* m_physics_system;
-        mono::ParticleSystem* m_particle_system;
-        EntityLogicSystem* m_logic_system;
-
+        ProjectileSystem* m_projectile_system;
         std::unique_ptr<class MuzzleFlash> m_muzzle_flash;
-        std::unique_ptr<class BulletTrailEffect> m_bullet_trail;
-
-        std::unordered_map<uint32_t, uint32_t> m_bullet_id_to_callback;
     };
 }
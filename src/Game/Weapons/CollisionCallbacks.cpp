@@ -2,74 +2,55 @@
 #include "CollisionCallbacks.h"
 
 #include "DamageSystem.h"
-#include "Effects/DamageEffect.h"
-#include "Effects/ImpactEffect.h"
+#include "Effects/EffectEvents.h"
+#include "Entity/EntityPoolSystem.h"
 
-#include "EntitySystem/IEntityManager.h"
 #include "Math/MathFwd.h"
 #include "Math/MathFunctions.h"
-#include "Particle/ParticleSystem.h"
 #include "Physics/IBody.h"
 #include "Physics/PhysicsSystem.h"
 #include "Rendering/Sprite/SpriteSystem.h"
 #include "Rendering/Sprite/Sprite.h"
 #include "SystemContext.h"
+#include "System/Hash.h"
 #include "TransformSystem/TransformSystem.h"
 
-namespace
-{
-    game::DamageEffect* g_damage_effect = nullptr;
-    game::ImpactEffect* g_impact_effect = nullptr;
-}
-
 void game::InitWeaponCallbacks(mono::SystemContext* system_context)
 {
-    mono::ParticleSystem* particle_system = system_context->GetSystem<mono::ParticleSystem>();
-    mono::IEntityManager* entity_system = system_context->GetSystem<mono::IEntityManager>();
-
-    g_damage_effect = new game::DamageEffect(particle_system, entity_system);
-    g_impact_effect = new game::ImpactEffect(particle_system, entity_system);
+    InitEffectEvents(system_context);
 }
 
 void game::CleanupWeaponCallbacks()
 {
-    delete g_damage_effect;
-    g_damage_effect = nullptr;
-
-    delete g_impact_effect;
-    g_impact_effect = nullptr;
+    CleanupEffectEvents();
 }
 
 void game::SpawnEntityWithAnimation(
     const char* entity_file,
     int animation_id,
     uint32_t position_at_transform_id,
-    mono::IEntityManager* entity_manager,
+    game::EntityPoolSystem* entity_pool,
     mono::TransformSystem* transform_system,
     mono::SpriteSystem* sprite_system)
 {
-    const mono::Entity spawned_entity = entity_manager->CreateEntity(entity_file);
-    math::Matrix& entity_transform = transform_system->GetTransform(spawned_entity.id);
+    const uint32_t spawned_entity_id = entity_pool->SpawnEntity(entity_file);
+    math::Matrix& entity_transform = transform_system->GetTransform(spawned_entity_id);
     entity_transform = transform_system->GetWorld(position_at_transform_id);
 
-    mono::Sprite* spawned_entity_sprite = sprite_system->GetSprite(spawned_entity.id);
+    mono::Sprite* spawned_entity_sprite = sprite_system->GetSprite(spawned_entity_id);
 
-    const auto remove_entity_callback = [spawned_entity, entity_manager]() {
-        entity_manager->ReleaseEntity(spawned_entity.id);
+    const auto remove_entity_callback = [spawned_entity_id, entity_pool]() {
+        entity_pool->ReleaseEntity(spawned_entity_id);
     };
     spawned_entity_sprite->SetAnimation(animation_id, remove_entity_callback);
 }
 
 void game::StandardCollision(
-    uint32_t entity_id,
     uint32_t owner_entity_id,
     game::BulletCollisionFlag flags,
     const CollisionDetails& details,
-    mono::IEntityManager* entity_manager,
     game::DamageSystem* damage_system,
-    mono::PhysicsSystem* physics_system,
-    mono::SpriteSystem* sprite_system,
-    mono::TransformSystem* transform_system)
+    mono::PhysicsSystem* physics_system)
 {
     bool did_damage = false;
 
@@ -82,50 +63,51 @@ void game::StandardCollision(
 
     if(details.colliding_body)
     {
-        const float direction = math::AngleFromVector(details.collision_normal);
+        EffectEvent effect_event = {};
+        effect_event.position = details.collision_point;
+        effect_event.direction = math::AngleFromVector(details.collision_normal);
+        effect_event.entity_id = other_entity_id;
+
         if(did_damage)
         {
-            g_damage_effect->EmitGibsAt(details.collision_point, direction);
-            mono::Sprite* sprite = sprite_system->GetSprite(other_entity_id);
-            sprite->FlashSprite();
+            effect_event.type = EffectEventType::DAMAGE_GIBS;
+            EmitEffectEvent(effect_event);
+
+            effect_event.type = EffectEventType::SPRITE_FLASH;
+            EmitEffectEvent(effect_event);
         }
         else
         {
-            g_impact_effect->EmittAt(details.collision_point, direction);
+            effect_event.type = EffectEventType::IMPACT;
+            EmitEffectEvent(effect_event);
         }
     }
-
-    if(flags & game::BulletCollisionFlag::DESTROY_THIS)
-        entity_manager->ReleaseEntity(entity_id);
 }
 
 void game::RocketCollision(
-    uint32_t entity_id,
     uint32_t owner_entity_id,
     game::BulletCollisionFlag flags,
     const CollisionDetails& details,
-    mono::IEntityManager* entity_manager,
     game::DamageSystem* damage_system,
-    mono::PhysicsSystem* physics_system,
-    mono::SpriteSystem* sprite_system,
-    mono::TransformSystem* transform_system)
+    mono::PhysicsSystem* physics_system)
 {
-    StandardCollision(entity_id, owner_entity_id, flags, details, entity_manager, damage_system, physics_system, sprite_system, transform_system);
-    //SpawnEntityWithAnimation("res/entities/explosion.entity", 0, entity_id, entity_manager, transform_system, sprite_system);
+    StandardCollision(owner_entity_id, flags, details, damage_system, physics_system);
+    //SpawnEntityWithAnimation("res/entities/explosion.entity", 0, entity_id, entity_pool, transform_system, sprite_system);
     //event_handler.DispatchEvent(game::ShockwaveEvent(explosion_config.position, 150));
 }
 
 void game::CacoPlasmaCollision(
-    uint32_t entity_id,
     uint32_t owner_entity_id,
     game::BulletCollisionFlag flags,
     const CollisionDetails& details,
-    mono::IEntityManager* entity_manager,
     game::DamageSystem* damage_system,
-    mono::PhysicsSystem* physics_system,
-    mono::SpriteSystem* sprite_system,
-    mono::TransformSystem* transform_system)
+    mono::PhysicsSystem* physics_system)
 {
-    StandardCollision(entity_id, owner_entity_id, flags, details, entity_manager, damage_system, physics_system, sprite_system, transform_system);
-    SpawnEntityWithAnimation("res/entities/caco_explosion.entity", 0, entity_id, entity_manager, transform_system, sprite_system);
+    StandardCollision(owner_entity_id, flags, details, damage_system, physics_system);
+
+    EffectEvent effect_event = {};
+    effect_event.position = details.collision_point;
+    effect_event.param = hash::Hash("res/entities/caco_explosion.entity");
+    effect_event.type = EffectEventType::ANIMATED_ENTITY;
+    EmitEffectEvent(effect_event);
 }
@@ -0,0 +1,36 @@
+
+#pragma once
+
+#include "Math/Vector.h"
+#include <cstdint>
+
+namespace game
+{
+    enum ProjectileFlags : uint8_t
+    {
+        WANT_DIRECTION = 1,     // Drawn rotated along the velocity
+        VISUAL_ONLY = 2,        // Replicated to a client, no collisions or callbacks
+        TRAIL = 4,              // Followed by a particle trail
+        LIGHT = 8,              // Followed by a light
+    };
+
+    enum class ProjectileEventType : uint8_t
+    {
+        SPAWN,
+        REDIRECT,
+        DESTROY,
+    };
+
+    // Projectiles are replicated as events, the clients move them along on their own in between.
+    struct ProjectileEvent
+    {
+        uint32_t timestamp;     // Server time, set when the event is replicated
+        uint32_t sprite_hash;
+        math::Vector position;
+        math::Vector velocity;
+        uint16_t projectile_id;
+        uint16_t life_ms;
+        ProjectileEventType type;
+        uint8_t flags;
+    };
+}
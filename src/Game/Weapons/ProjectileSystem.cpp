@@ -0,0 +1,525 @@
+
+#include "ProjectileSystem.h"
+#include "SimulationClock.h"
+
+#include "Math/MathFunctions.h"
+#include "Math/Quad.h"
+#include "Physics/PhysicsSystem.h"
+#include "Physics/PhysicsSpace.h"
+#include "Physics/IBody.h"
+#include "System/Hash.h"
+#include "Util/Random.h"
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cassert>
+
+namespace
+{
+    constexpr uint32_t NO_INDEX = std::numeric_limits<uint32_t>::max();
+    constexpr uint8_t HITS_PER_PROJECTILE = 3; // Jumps for a JUMPER, bounces for a BOUNCE
+    constexpr float SWEEP_SKIP_DISTANCE = 0.01f;
+    constexpr float JUMP_SEARCH_RADIUS = 2.0f;
+
+    template <typename T>
+    void SwapRemove(std::vector<T>& column, uint32_t index)
+    {
+        column[index] = column.back();
+        column.pop_back();
+    }
+}
+
+using namespace game;
+
+ProjectileHitResponse game::ProjectileHitBehaviour(BulletCollisionBehaviour behaviour, bool hit_static, uint8_t hits_left)
+{
+    ProjectileHitResponse response = { BulletCollisionFlag(APPLY_DAMAGE | DESTROY_THIS), false, false, false };
+
+    switch(behaviour)
+    {
+    case BulletCollisionBehaviour::NORMAL:
+        break;
+
+    case BulletCollisionBehaviour::BOUNCE:
+        if(hit_static && hits_left > 0)
+        {
+            response.collision_flags = BulletCollisionFlag(0);
+            response.reflect = true;
+        }
+        break;
+
+    case BulletCollisionBehaviour::JUMPER:
+        if(!hit_static && hits_left > 0)
+        {
+            response.collision_flags = APPLY_DAMAGE;
+            response.jump = true;
+            response.remember_hit = true;
+        }
+        break;
+
+    case BulletCollisionBehaviour::PASS_THROUGH:
+        if(!hit_static)
+        {
+            response.collision_flags = APPLY_DAMAGE;
+            response.remember_hit = true;
+        }
+        break;
+    }
+
+    return response;
+}
+
+ProjectileSystem::ProjectileSystem(uint32_t n_projectiles, mono::PhysicsSystem* physics_system, const SimulationClock* simulation_clock)
+    : m_physics_system(physics_system)
+    , m_simulation_clock(simulation_clock)
+    , m_id_to_dense(n_projectiles, NO_INDEX)
+    , m_generations(n_projectiles, 0)
+    , m_record_events(false)
+{
+    m_positions.reserve(n_projectiles);
+    m_velocities.reserve(n_projectiles);
+    m_life_ms.reserve(n_projectiles);
+    m_owner_ids.reserve(n_projectiles);
+    m_types_index.reserve(n_projectiles);
+    m_sprite_hashes.reserve(n_projectiles);
+    m_flags.reserve(n_projectiles);
+    m_hits_left.reserve(n_projectiles);
+    m_hit_ids.reserve(n_projectiles);
+    m_sounds.reserve(n_projectiles);
+    m_dense_to_id.reserve(n_projectiles);
+
+    m_free_ids.reserve(n_projectiles);
+    for(uint32_t id = n_projectiles; id > 0; --id)
+        m_free_ids.push_back(id - 1);
+}
+
+uint32_t ProjectileSystem::RegisterProjectileType(const BulletConfiguration& config)
+{
+    m_types.push_back(config);
+    m_type_sprite_hashes.push_back(config.sprite_file ? hash::Hash(config.sprite_file) : 0);
+
+    uint8_t flags = 0;
+    if(config.want_direction)
+        flags |= ProjectileFlags::WANT_DIRECTION;
+    if(config.trail)
+        flags |= ProjectileFlags::TRAIL;
+    if(config.light)
+        flags |= ProjectileFlags::LIGHT;
+    m_type_flags.push_back(flags);
+
+    return m_types.size() - 1;
+}
+
+uint32_t ProjectileSystem::SpawnProjectile(
+    uint32_t projectile_type, uint32_t owner_id, const math::Vector& position, const math::Vector& velocity)
+{
+    const uint32_t projectile_id = AllocateProjectile();
+    if(projectile_id == NO_INDEX)
+        return NO_INDEX;
+
+    const BulletConfiguration& config = m_types[projectile_type];
+    const float life_span = config.life_span + (mono::Random() * config.fuzzy_life_span);
+
+    const uint32_t index = m_id_to_dense[projectile_id];
+    m_positions[index] = position;
+    m_velocities[index] = velocity;
+    m_life_ms[index] = life_span * 1000.0f;
+    m_owner_ids[index] = owner_id;
+    m_types_index[index] = projectile_type;
+    m_sprite_hashes[index] = m_type_sprite_hashes[projectile_type];
+    m_flags[index] = m_type_flags[projectile_type];
+
+    if(config.sound_file)
+    {
+        m_sounds[index] = audio::CreateSound(config.sound_file, audio::SoundPlayback::LOOPING);
+        m_sounds[index]->Play();
+    }
+
+    RecordEvent(ProjectileEventType::SPAWN, index);
+    return projectile_id;
+}
+
+uint32_t ProjectileSystem::SpawnVisualProjectile(
+    uint32_t sprite_hash, uint8_t flags, const math::Vector& position, const math::Vector& velocity, uint32_t life_ms)
+{
+    const uint32_t projectile_id = AllocateProjectile();
+    if(projectile_id == NO_INDEX)
+        return NO_INDEX;
+
+    const uint32_t index = m_id_to_dense[projectile_id];
+    m_positions[index] = position;
+    m_velocities[index] = velocity;
+    m_life_ms[index] = life_ms;
+    m_sprite_hashes[index] = sprite_hash;
+    m_flags[index] = flags | ProjectileFlags::VISUAL_ONLY;
+
+    return projectile_id;
+}
+
+void ProjectileSystem::RedirectProjectile(uint32_t projectile_id, const math::Vector& position, const math::Vector& velocity)
+{
+    if(!IsAlive(projectile_id))
+        return;
+
+    const uint32_t index = m_id_to_dense[projectile_id];
+    m_positions[index] = position;
+    m_velocities[index] = velocity;
+}
+
+void ProjectileSystem::ReleaseProjectile(uint32_t projectile_id)
+{
+    assert(IsAlive(projectile_id));
+
+    const uint32_t index = m_id_to_dense[projectile_id];
+    const uint32_t last_index = m_dense_to_id.size() - 1;
+    const uint32_t moved_id = m_dense_to_id[last_index];
+
+    if(m_sounds[index])
+        m_sounds[index]->Stop();
+
+    SwapRemove(m_positions, index);
+    SwapRemove(m_velocities, index);
+    SwapRemove(m_life_ms, index);
+    SwapRemove(m_owner_ids, index);
+    SwapRemove(m_types_index, index);
+    SwapRemove(m_sprite_hashes, index);
+    SwapRemove(m_flags, index);
+    SwapRemove(m_hits_left, index);
+    SwapRemove(m_hit_ids, index);
+    SwapRemove(m_sounds, index);
+    SwapRemove(m_dense_to_id, index);
+
+    m_id_to_dense[moved_id] = index;
+    m_id_to_dense[projectile_id] = NO_INDEX;
+    m_generations[projectile_id]++;
+    m_free_ids.push_back(projectile_id);
+}
+
+void ProjectileSystem::ReleaseAllProjectiles()
+{
+    while(!m_dense_to_id.empty())
+        ReleaseProjectile(m_dense_to_id.back());
+}
+
+bool ProjectileSystem::IsAlive(uint32_t projectile_id) const
+{
+    return projectile_id < m_id_to_dense.size() && m_id_to_dense[projectile_id] != NO_INDEX;
+}
+
+uint32_t ProjectileSystem::ActiveProjectiles() const
+{
+    return m_dense_to_id.size();
+}
+
+void ProjectileSystem::SetRecordEvents(bool record)
+{
+    m_record_events = record;
+    m_recorded_events.clear();
+}
+
+const std::vector<ProjectileEvent>& ProjectileSystem::GetRecordedEvents() const
+{
+    return m_recorded_events;
+}
+
+void ProjectileSystem::ClearRecordedEvents()
+{
+    m_recorded_events.clear();
+}
+
+uint32_t ProjectileSystem::Id() const
+{
+    return hash::Hash(Name());
+}
+
+const char* ProjectileSystem::Name() const
+{
+    return "projectilesystem";
+}
+
+SystemAccess ProjectileSystem::Access() const
+{
+    // The collision callbacks apply damage, which runs the damage callbacks.
+    SystemAccess access;
+    access.exclusive = true;
+    return access;
+}
+
+void ProjectileSystem::ScheduledUpdate(const mono::UpdateContext& update_context)
+{
+    const auto tick_func = [this](const mono::UpdateContext& tick_context) {
+        UpdateTick(tick_context);
+    };
+    ForEachSimulationTick(m_simulation_clock, tick_func);
+}
+
+void ProjectileSystem::UpdateTick(const mono::UpdateContext& update_context)
+{
+    m_hits.clear();
+    m_timeouts.clear();
+
+    const uint32_t n_projectiles = m_dense_to_id.size();
+    for(uint32_t index = 0; index < n_projectiles; ++index)
+    {
+        m_life_ms[index] -= update_context.delta_ms;
+
+        const math::Vector start = m_positions[index];
+        const math::Vector end = start + m_velocities[index] * update_context.delta_s;
+
+        if(!(m_flags[index] & ProjectileFlags::VISUAL_ONLY))
+        {
+            ProjectileHit hit;
+            if(SweepQuery(index, start, end, hit))
+            {
+                // The hit point is on the surface, the center stops a radius out so the next sweep doesn't
+                // start in contact with what was hit.
+                const float radius = m_types[m_types_index[index]].radius;
+                m_positions[index] = hit.point + hit.normal * radius;
+                m_hits.push_back(hit);
+                continue;
+            }
+        }
+
+        if(m_life_ms[index] < 0)
+        {
+            const uint32_t projectile_id = m_dense_to_id[index];
+            m_timeouts.push_back({ projectile_id, m_generations[projectile_id] });
+        }
+
+        m_positions[index] = end;
+    }
+
+    // Resolved after all projectiles have moved, the callbacks might spawn new projectiles.
+    for(const ProjectileHit& hit : m_hits)
+        ResolveHit(hit);
+
+    for(const ProjectileRef& timeout : m_timeouts)
+        ResolveTimeout(timeout);
+}
+
+bool ProjectileSystem::SweepQuery(uint32_t index, const math::Vector& start, const math::Vector& end, ProjectileHit& out_hit) const
+{
+    const BulletConfiguration& config = m_types[m_types_index[index]];
+    const std::array<uint32_t, 4>& hit_ids = m_hit_ids[index];
+
+    const math::Vector delta = end - start;
+    const float length = math::Length(delta);
+    if(length == 0.0f)
+        return false;
+
+    const math::Vector direction = delta / length;
+    mono::PhysicsSpace* space = m_physics_system->GetSpace();
+
+    // The first shape along the segment, bodies the projectile already went through are skipped by
+    // querying again from just past where they were hit. At most once per remembered body.
+    math::Vector query_start = start;
+
+    for(uint32_t query = 0; query <= hit_ids.size(); ++query)
+    {
+        const mono::QueryResult result = space->QueryFirst(query_start, end, config.radius, config.collision_mask);
+        if(!result.body)
+            return false;
+
+        const uint32_t body_id = m_physics_system->GetIdFromBody(result.body);
+        const bool already_hit = (std::find(hit_ids.begin(), hit_ids.end(), body_id) != hit_ids.end());
+        if(!already_hit)
+        {
+            out_hit.projectile_id = m_dense_to_id[index];
+            out_hit.generation = m_generations[out_hit.projectile_id];
+            out_hit.body = result.body;
+            out_hit.point = result.point;
+            out_hit.normal = result.normal;
+            return true;
+        }
+
+        query_start = result.point + direction * SWEEP_SKIP_DISTANCE;
+        if(math::Dot(end - query_start, direction) <= 0.0f)
+            return false;
+    }
+
+    return false;
+}
+
+void ProjectileSystem::ResolveHit(const ProjectileHit& hit)
+{
+    const uint32_t projectile_id = hit.projectile_id;
+    if(!IsSameProjectile(projectile_id, hit.generation))
+        return;
+
+    uint32_t index = m_id_to_dense[projectile_id];
+    const BulletConfiguration& config = m_types[m_types_index[index]];
+    const bool hit_static = (hit.body->GetType() == mono::BodyType::STATIC);
+
+    const ProjectileHitResponse response = ProjectileHitBehaviour(config.bullet_behaviour, hit_static, m_hits_left[index]);
+    BulletCollisionFlag collision_flags = response.collision_flags;
+
+    if(response.remember_hit)
+        RememberHit(index, m_physics_system->GetIdFromBody(hit.body));
+
+    if(response.reflect)
+    {
+        const math::Vector velocity = m_velocities[index];
+        m_velocities[index] = velocity - hit.normal * (2.0f * math::Dot(velocity, hit.normal));
+        m_hits_left[index]--;
+        RecordEvent(ProjectileEventType::REDIRECT, index);
+    }
+
+    if(response.jump)
+    {
+        const bool found_target = FindJumpTarget(index, hit.point);
+        m_hits_left[index] = found_target ? m_hits_left[index] - 1 : 0;
+
+        if(found_target)
+            RecordEvent(ProjectileEventType::REDIRECT, index);
+
+        if(m_hits_left[index] == 0)
+            collision_flags = BulletCollisionFlag(collision_flags | DESTROY_THIS);
+    }
+
+    if(collision_flags != 0 && config.collision_callback)
+    {
+        CollisionDetails details;
+        details.colliding_body = hit.body;
+        details.collision_point = hit.point;
+        details.collision_normal = hit.normal;
+
+        config.collision_callback(m_owner_ids[index], collision_flags, details);
+
+        // The callback can release or redirect the projectile, or spawn one that is given its id.
+        if(!IsSameProjectile(projectile_id, hit.generation))
+            return;
+    }
+
+    if(collision_flags & DESTROY_THIS)
+    {
+        index = m_id_to_dense[projectile_id];
+        RecordEvent(ProjectileEventType::DESTROY, index);
+        ReleaseProjectile(projectile_id);
+    }
+}
+
+void ProjectileSystem::ResolveTimeout(const ProjectileRef& timeout)
+{
+    const uint32_t projectile_id = timeout.projectile_id;
+    if(!IsSameProjectile(projectile_id, timeout.generation))
+        return;
+
+    const uint32_t index = m_id_to_dense[projectile_id];
+    if(!(m_flags[index] & ProjectileFlags::VISUAL_ONLY))
+    {
+        const BulletConfiguration& config = m_types[m_types_index[index]];
+        if(config.collision_callback)
+        {
+            CollisionDetails details;
+            details.colliding_body = nullptr;
+            details.collision_point = m_positions[index];
+            details.collision_normal = math::ZeroVec;
+
+            config.collision_callback(m_owner_ids[index], BulletCollisionFlag::DESTROY_THIS, details);
+
+            if(!IsSameProjectile(projectile_id, timeout.generation))
+                return;
+        }
+
+        RecordEvent(ProjectileEventType::DESTROY, m_id_to_dense[projectile_id]);
+    }
+
+    ReleaseProjectile(projectile_id);
+}
+
+bool ProjectileSystem::IsSameProjectile(uint32_t projectile_id, uint32_t generation) const
+{
+    return IsAlive(projectile_id) && m_generations[projectile_id] == generation;
+}
+
+bool ProjectileSystem::FindJumpTarget(uint32_t index, const math::Vector& collision_point)
+{
+    const math::Vector projectile_position = m_positions[index];
+    const math::Vector projectile_velocity = m_velocities[index];
+    const math::Vector velocity_normalized = math::Normalized(projectile_velocity);
+    const std::array<uint32_t, 4>& hit_ids = m_hit_ids[index];
+
+    const mono::QueryFilter query_filter = [&](uint32_t entity_id, const math::Vector& point) {
+
+        const bool already_processed = (std::find(hit_ids.begin(), hit_ids.end(), entity_id) != hit_ids.end());
+        if(already_processed)
+            return false;
+
+        const math::Vector local_point = point - projectile_position;
+        const float dot_product = math::Dot(local_point, velocity_normalized);
+        if(dot_product < 0.0f) // if its less than zero its behind the projectile
+            return false;
+
+        const math::Vector normalized_local_point = math::Normalized(local_point);
+        const float radians1 = math::AngleFromVector(normalized_local_point);
+        const float radians2 = math::AngleFromVector(velocity_normalized);
+        const float radians = std::fabs(radians1 - radians2);
+
+        return (radians < math::ToRadians(45.0f));
+    };
+
+    mono::PhysicsSpace* space = m_physics_system->GetSpace();
+    const mono::IBody* found_body =
+        space->QueryNearest(collision_point, JUMP_SEARCH_RADIUS, shared::CollisionCategory::ENEMY, query_filter);
+    if(!found_body)
+        return false;
+
+    const math::Vector unit_direction = math::Normalized(found_body->GetPosition() - projectile_position);
+    m_velocities[index] = unit_direction * math::Length(projectile_velocity);
+    return true;
+}
+
+void ProjectileSystem::RememberHit(uint32_t index, uint32_t body_id)
+{
+    // Oldest hit is forgotten when full.
+    std::array<uint32_t, 4>& hit_ids = m_hit_ids[index];
+    std::rotate(hit_ids.begin(), hit_ids.begin() + 1, hit_ids.end());
+    hit_ids.back() = body_id;
+}
+
+void ProjectileSystem::RecordEvent(ProjectileEventType type, uint32_t index)
+{
+    if(!m_record_events)
+        return;
+
+    ProjectileEvent projectile_event;
+    projectile_event.timestamp = 0;
+    projectile_event.sprite_hash = m_sprite_hashes[index];
+    projectile_event.position = m_positions[index];
+    projectile_event.velocity = m_velocities[index];
+    projectile_event.projectile_id = m_dense_to_id[index];
+    projectile_event.life_ms = std::clamp(m_life_ms[index], 0, int(std::numeric_limits<uint16_t>::max()));
+    projectile_event.type = type;
+    projectile_event.flags = m_flags[index];
+
+    m_recorded_events.push_back(projectile_event);
+}
+
+uint32_t ProjectileSystem::AllocateProjectile()
+{
+    if(m_free_ids.empty())
+        return NO_INDEX;
+
+    const uint32_t projectile_id = m_free_ids.back();
+    m_free_ids.pop_back();
+
+    std::array<uint32_t, 4> no_hits;
+    no_hits.fill(NO_INDEX);
+
+    m_id_to_dense[projectile_id] = m_dense_to_id.size();
+    m_dense_to_id.push_back(projectile_id);
+
+    m_positions.emplace_back();
+    m_velocities.emplace_back();
+    m_life_ms.push_back(0);
+    m_owner_ids.push_back(NO_INDEX);
+    m_types_index.push_back(0);
+    m_sprite_hashes.push_back(0);
+    m_flags.push_back(0);
+    m_hits_left.push_back(HITS_PER_PROJECTILE);
+    m_hit_ids.push_back(no_hits);
+    m_sounds.emplace_back();
+
+    return projectile_id;
+}
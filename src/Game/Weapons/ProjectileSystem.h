@@ -0,0 +1,133 @@
+
+#pragma once
+
+#include "Scheduler/ScheduledSystem.h"
+#include "MonoFwd.h"
+#include "Physics/PhysicsFwd.h"
+#include "Math/Vector.h"
+#include "WeaponConfiguration.h"
+#include "ProjectileEvent.h"
+#include "System/Audio.h"
+
+#include <vector>
+#include <deque>
+#include <array>
+#include <cstdint>
+
+namespace game
+{
+    // What a projectile does when it hits a body, apart from the queries so that the behaviours can be tested.
+    struct ProjectileHitResponse
+    {
+        BulletCollisionFlag collision_flags;
+        bool reflect;       // Bounce off the hit normal
+        bool jump;          // Look for the next target, destroyed if there is none
+        bool remember_hit;  // Skip the body in later sweeps
+    };
+
+    ProjectileHitResponse ProjectileHitBehaviour(BulletCollisionBehaviour behaviour, bool hit_static, uint8_t hits_left);
+
+    // Bullets without entities. The projectiles are stored as parallel arrays, moved every simulation tick
+    // and swept against the physics space, the collision callbacks run after all projectiles have moved.
+    class ProjectileSystem : public ScheduledSystem
+    {
+    public:
+
+        ProjectileSystem(uint32_t n_projectiles, mono::PhysicsSystem* physics_system, const class SimulationClock* simulation_clock);
+
+        // The returned type is shared by all weapons that fire this kind of projectile.
+        uint32_t RegisterProjectileType(const BulletConfiguration& config);
+
+        uint32_t SpawnProjectile(uint32_t projectile_type, uint32_t owner_id, const math::Vector& position, const math::Vector& velocity);
+        uint32_t SpawnVisualProjectile(
+            uint32_t sprite_hash, uint8_t flags, const math::Vector& position, const math::Vector& velocity, uint32_t life_ms);
+        void RedirectProjectile(uint32_t projectile_id, const math::Vector& position, const math::Vector& velocity);
+        void ReleaseProjectile(uint32_t projectile_id);
+        void ReleaseAllProjectiles();
+        bool IsAlive(uint32_t projectile_id) const;
+        uint32_t ActiveProjectiles() const;
+
+        template <typename T>
+        inline void ForEachProjectile(T&& func) const
+        {
+            for(uint32_t index = 0; index < m_dense_to_id.size(); ++index)
+                func(m_positions[index], m_velocities[index], m_sprite_hashes[index], m_flags[index]);
+        }
+
+        template <typename T>
+        inline void ForEachProjectileWithId(T&& func) const
+        {
+            for(uint32_t index = 0; index < m_dense_to_id.size(); ++index)
+                func(m_dense_to_id[index], m_positions[index], m_flags[index]);
+        }
+
+        void SetRecordEvents(bool record);
+        const std::vector<ProjectileEvent>& GetRecordedEvents() const;
+        void ClearRecordedEvents();
+
+        uint32_t Id() const override;
+        const char* Name() const override;
+        void ScheduledUpdate(const mono::UpdateContext& update_context) override;
+        SystemAccess Access() const override;
+
+    private:
+
+        // The generation tells a projectile from a later one that was given the same id.
+        struct ProjectileRef
+        {
+            uint32_t projectile_id;
+            uint32_t generation;
+        };
+
+        struct ProjectileHit
+        {
+            uint32_t projectile_id;
+            uint32_t generation;
+            mono::IBody* body;
+            math::Vector point;
+            math::Vector normal;
+        };
+
+        void UpdateTick(const mono::UpdateContext& update_context);
+        bool SweepQuery(uint32_t index, const math::Vector& start, const math::Vector& end, ProjectileHit& out_hit) const;
+        void ResolveHit(const ProjectileHit& hit);
+        void ResolveTimeout(const ProjectileRef& timeout);
+        bool IsSameProjectile(uint32_t projectile_id, uint32_t generation) const;
+        bool FindJumpTarget(uint32_t index, const math::Vector& collision_point);
+        void RememberHit(uint32_t index, uint32_t body_id);
+        void RecordEvent(ProjectileEventType type, uint32_t index);
+
+        uint32_t AllocateProjectile();
+
+        mono::PhysicsSystem* m_physics_system;
+        const class SimulationClock* m_simulation_clock;
+
+        // A deque since the collision callbacks might create weapons that register new types.
+        std::deque<BulletConfiguration> m_types;
+        std::vector<uint32_t> m_type_sprite_hashes;
+        std::vector<uint8_t> m_type_flags;
+
+        // Dense arrays, indexed by m_id_to_dense. Removal swaps the last projectile into the hole.
+        std::vector<math::Vector> m_positions;
+        std::vector<math::Vector> m_velocities;
+        std::vector<int> m_life_ms;
+        std::vector<uint32_t> m_owner_ids;
+        std::vector<uint16_t> m_types_index;
+        std::vector<uint32_t> m_sprite_hashes;
+        std::vector<uint8_t> m_flags;
+        std::vector<uint8_t> m_hits_left;
+        std::vector<std::array<uint32_t, 4>> m_hit_ids;
+        std::vector<audio::ISoundPtr> m_sounds;
+
+        std::vector<uint32_t> m_dense_to_id;
+        std::vector<uint32_t> m_id_to_dense;
+        std::vector<uint32_t> m_generations;
+        std::vector<uint32_t> m_free_ids;
+
+        std::vector<ProjectileHit> m_hits;
+        std::vector<ProjectileRef> m_timeouts;
+
+        bool m_record_events;
+        std::vector<ProjectileEvent> m_recorded_events;
+    };
+}
@@ -0,0 +1,99 @@
+
+#include "ProjectileSystemDrawer.h"
+#include "ProjectileSystem.h"
+
+#include "Math/Quad.h"
+#include "Math/MathFunctions.h"
+
+#include "Rendering/IRenderer.h"
+#include "Rendering/RenderBuffer/IRenderBuffer.h"
+#include "Rendering/RenderBuffer/BufferFactory.h"
+#include "Rendering/Sprite/ISprite.h"
+#include "System/Hash.h"
+
+#include <algorithm>
+
+using namespace game;
+
+ProjectileSystemDrawer::ProjectileSystemDrawer(const ProjectileSystem* projectile_system)
+    : m_projectile_system(projectile_system)
+{
+    constexpr uint16_t indices[] = {
+        0, 1, 2, 0, 2, 3
+    };
+    m_indices = mono::CreateElementBuffer(mono::BufferType::STATIC, 6, indices);
+}
+
+void ProjectileSystemDrawer::Draw(mono::IRenderer& renderer) const
+{
+    m_draw_data.clear();
+
+    const auto collect_projectile = [this](const math::Vector& position, const math::Vector& velocity, uint32_t sprite_hash, uint8_t flags) {
+        if(sprite_hash == 0)
+            return;
+
+        const math::Matrix transform = (flags & ProjectileFlags::WANT_DIRECTION) ?
+            math::CreateMatrixWithPositionRotation(position, math::AngleFromVector(velocity)) : math::CreateMatrixWithPosition(position);
+        m_draw_data.push_back({ sprite_hash, transform });
+    };
+    m_projectile_system->ForEachProjectile(collect_projectile);
+
+    const auto sort_on_sprite = [](const ProjectileDrawData& first, const ProjectileDrawData& second) {
+        return first.sprite_hash < second.sprite_hash;
+    };
+    std::sort(m_draw_data.begin(), m_draw_data.end(), sort_on_sprite);
+
+    uint32_t current_sprite_hash = 0;
+    const SpriteData* sprite_data = nullptr;
+
+    for(const ProjectileDrawData& draw_data : m_draw_data)
+    {
+        if(draw_data.sprite_hash != current_sprite_hash)
+        {
+            current_sprite_hash = draw_data.sprite_hash;
+            sprite_data = GetSpriteData(current_sprite_hash);
+        }
+
+        if(!sprite_data)
+            continue;
+
+        const mono::ISpritePtr& sprite = sprite_data->sprite;
+        const mono::SpriteDrawBuffers& buffers = sprite_data->buffers;
+        const int offset = sprite->GetCurrentFrameIndex() * buffers.vertices_per_sprite;
+
+        const auto scope = mono::MakeTransformScope(draw_data.transform, &renderer);
+        renderer.DrawSprite(
+            sprite.get(),
+            buffers.vertices.get(),
+            buffers.offsets.get(),
+            buffers.uv.get(),
+            buffers.uv_flipped.get(),
+            buffers.heights.get(),
+            m_indices.get(),
+            sprite->GetTexture(),
+            offset);
+    }
+}
+
+math::Quad ProjectileSystemDrawer::BoundingBox() const
+{
+    return math::InfQuad;
+}
+
+const ProjectileSystemDrawer::SpriteData* ProjectileSystemDrawer::GetSpriteData(uint32_t sprite_hash) const
+{
+    const auto it = m_sprites.find(sprite_hash);
+    if(it != m_sprites.end())
+        return &it->second;
+
+    const char* sprite_file = hash::HashLookup(sprite_hash);
+    if(!sprite_file)
+        return nullptr;
+
+    SpriteData sprite_data;
+    sprite_data.sprite = mono::GetSpriteFactory()->CreateSprite(sprite_file);
+    sprite_data.buffers = mono::BuildSpriteDrawBuffers(sprite_data.sprite->GetSpriteData());
+
+    const auto insert_result = m_sprites.insert({ sprite_hash, std::move(sprite_data) });
+    return &insert_result.first->second;
+}
@@ -0,0 +1,47 @@
+
+#pragma once
+
+#include "Rendering/IDrawable.h"
+#include "Rendering/Sprite/ISpriteFactory.h"
+#include "Rendering/Sprite/SpriteBufferFactory.h"
+#include "Math/Matrix.h"
+
+#include <unordered_map>
+#include <vector>
+#include <memory>
+
+namespace game
+{
+    // Draws all projectiles in one pass, sorted on sprite so that each sprite is set up once per frame.
+    class ProjectileSystemDrawer : public mono::IDrawable
+    {
+    public:
+
+        ProjectileSystemDrawer(const class ProjectileSystem* projectile_system);
+
+        void Draw(mono::IRenderer& renderer) const override;
+        math::Quad BoundingBox() const override;
+
+    private:
+
+        struct SpriteData
+        {
+            mono::ISpritePtr sprite;
+            mono::SpriteDrawBuffers buffers;
+        };
+
+        const SpriteData* GetSpriteData(uint32_t sprite_hash) const;
+
+        const ProjectileSystem* m_projectile_system;
+        std::unique_ptr<mono::IElementBuffer> m_indices;
+
+        struct ProjectileDrawData
+        {
+            uint32_t sprite_hash;
+            math::Matrix transform;
+        };
+
+        mutable std::unordered_map<uint32_t, SpriteData> m_sprites;
+        mutable std::vector<ProjectileDrawData> m_draw_data;
+    };
+}
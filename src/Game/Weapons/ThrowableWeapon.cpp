@@ -67,7 +67,9 @@ WeaponState ThrowableWeapon::Fire(const math::Vector& position, const math::Vect
 
         mono::Entity thrown_entity = m_entity_manager->CreateEntity(m_config.thrown_entity);
 
-        ThrowableLogic* throwable_logic = new ThrowableLogic(
+        m_entity_manager->AddComponent(thrown_entity.id, BEHAVIOUR_COMPONENT);
+        m_logic_system->CreateLogic<ThrowableLogic>(
+            thrown_entity.id,
             thrown_entity.id,
             m_config.spawned_entity,
             position,
@@ -76,9 +78,6 @@ WeaponState ThrowableWeapon::Fire(const math::Vector& position, const math::Vect
             m_sprite_system,
             m_particle_system,
             m_entity_manager);
-
-        m_entity_manager->AddComponent(thrown_entity.id, BEHAVIOUR_COMPONENT);
-        m_logic_system->AddLogic(thrown_entity.id, throwable_logic);
     }
 
     m_ammunition--;
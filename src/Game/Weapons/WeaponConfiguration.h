@@ -23,12 +23,11 @@ namespace game
         math::Vector collision_normal;
     };
 
-    // entity_id is the bullet that collides with something
-    // owner_entity_id is the owner of this bullet
-    // imact_flags is what to do on impact
-    // details contains more data on the collision
+    // owner_entity_id is the owner of the projectile
+    // imact_flags is what to do on impact, the projectile system destroys the projectile
+    // details contains more data on the collision, the collision point is the projectile position when it times out
     using BulletImpactCallback =
-        std::function<void (uint32_t entity_id, uint32_t owner_entity_id, BulletCollisionFlag impact_flags, const CollisionDetails& details)>;
+        std::function<void (uint32_t owner_entity_id, BulletCollisionFlag impact_flags, const CollisionDetails& details)>;
 
     enum class BulletCollisionBehaviour
     {
@@ -43,8 +42,12 @@ namespace game
         float life_span = 1.0f;
         float fuzzy_life_span = 0.0f;
 
-        const char* entity_file = nullptr;
-        const char* sound_file = nullptr;
+        const char* sprite_file = nullptr;
+        const char* sound_file = nullptr;   // Looped while the projectile is alive
+        float radius = 0.1f;
+        bool want_direction = false;
+        bool trail = true;
+        bool light = false;
 
         BulletCollisionBehaviour bullet_behaviour = BulletCollisionBehaviour::NORMAL;
         shared::CollisionCategory collision_category = shared::CollisionCategory::STATIC;
@@ -63,7 +66,6 @@ namespace game
         float bullet_force = 1.0f;
         float bullet_spread_degrees = 0.0f;
         bool bullet_force_random = false;
-        bool bullet_want_direction = false;
 
         uint32_t reload_time_ms = 1000;
         
@@ -71,7 +73,7 @@ namespace game
         const char* out_of_ammo_sound = nullptr;
         const char* reload_sound = nullptr;
 
-        BulletConfiguration bullet_config;
+        uint32_t projectile_type = 0; // From ProjectileSystem::RegisterProjectileType
     };
 
     struct ThrowableWeaponConfig
@@ -3,12 +3,11 @@
 #include "Weapons/BulletWeapon.h"
 #include "Weapons/ThrowableWeapon.h"
 #include "Weapons/CollisionCallbacks.h"
+#include "Weapons/ProjectileSystem.h"
 #include "DamageSystem.h"
 
 #include "SystemContext.h"
 #include "Physics/PhysicsSystem.h"
-#include "Rendering/Sprite/SpriteSystem.h"
-#include "TransformSystem/TransformSystem.h"
 
 #include <functional>
 
@@ -41,12 +40,10 @@ IWeaponPtr WeaponFactory::CreateBulletWeapon(WeaponType weapon_type, WeaponFacti
 
     DamageSystem* damage_system = m_system_context->GetSystem<DamageSystem>();
     mono::PhysicsSystem* physics_system = m_system_context->GetSystem<mono::PhysicsSystem>();
-    mono::SpriteSystem* sprite_system = m_system_context->GetSystem<mono::SpriteSystem>();
-    mono::TransformSystem* transform_system = m_system_context->GetSystem<mono::TransformSystem>();
 
     WeaponConfiguration weapon_config;
     weapon_config.owner_id = owner_id;
-    BulletConfiguration& bullet_config = weapon_config.bullet_config;
+    BulletConfiguration bullet_config;
 
     const bool enemy_weapon = (faction == WeaponFaction::ENEMY);
     bullet_config.collision_category = enemy_weapon ? shared::CollisionCategory::ENEMY_BULLET : shared::CollisionCategory::PLAYER_BULLET;
@@ -60,9 +57,10 @@ IWeaponPtr WeaponFactory::CreateBulletWeapon(WeaponType weapon_type, WeaponFacti
             bullet_config.fuzzy_life_span = 0;
             bullet_config.bullet_behaviour = BulletCollisionBehaviour::JUMPER;
             bullet_config.collision_callback = std::bind(
-                StandardCollision, _1, _2, _3, _4, m_entity_manager, damage_system, physics_system, sprite_system, transform_system);
-            bullet_config.entity_file = "res/entities/plasma_bullet.entity";
-            bullet_config.sound_file = nullptr;
+                StandardCollision, _1, _2, _3, damage_system, physics_system);
+            bullet_config.sprite_file = "res/sprites/plasma.sprite";
+            bullet_config.radius = 0.125f;
+            bullet_config.light = true;
 
             weapon_config.reload_time_ms = 1000;
             weapon_config.magazine_size = 100;
@@ -83,15 +81,15 @@ IWeaponPtr WeaponFactory::CreateBulletWeapon(WeaponType weapon_type, WeaponFacti
             bullet_config.life_span = 2.0f;
             bullet_config.fuzzy_life_span = 0.3f;
             bullet_config.collision_callback
-                = std::bind(RocketCollision, _1, _2, _3, _4, m_entity_manager, damage_system, physics_system, sprite_system, transform_system);
-            bullet_config.entity_file = "res/entities/rocket_bullet.entity";
-            bullet_config.sound_file = nullptr;
+                = std::bind(RocketCollision, _1, _2, _3, damage_system, physics_system);
+            bullet_config.sprite_file = "res/sprites/rocket.sprite";
+            bullet_config.radius = 0.15f;
+            bullet_config.want_direction = true;
 
             weapon_config.reload_time_ms = 1000;
             weapon_config.magazine_size = 5;
             weapon_config.rounds_per_second = 1.5f;
             weapon_config.bullet_force = 10.0f;
-            weapon_config.bullet_want_direction = true;
             weapon_config.fire_sound = "res/sound/rocket_fire2.wav";
             weapon_config.reload_sound = "res/sound/shotgun_reload2.wav";
 
@@ -103,9 +101,10 @@ IWeaponPtr WeaponFactory::CreateBulletWeapon(WeaponType weapon_type, WeaponFacti
             bullet_config.life_span = 2.0f;
             bullet_config.fuzzy_life_span = 0.3f;
             bullet_config.collision_callback
-                = std::bind(CacoPlasmaCollision, _1, _2, _3, _4, m_entity_manager, damage_system, physics_system, sprite_system, transform_system);
-            bullet_config.entity_file = "res/entities/caco_bullet.entity";
-            bullet_config.sound_file = nullptr;
+                = std::bind(CacoPlasmaCollision, _1, _2, _3, damage_system, physics_system);
+            bullet_config.sprite_file = "res/sprites/caco_bullet.sprite";
+            bullet_config.radius = 0.15f;
+            bullet_config.light = true;
 
             weapon_config.reload_time_ms = 1000;
             weapon_config.magazine_size = 30;
@@ -123,9 +122,9 @@ IWeaponPtr WeaponFactory::CreateBulletWeapon(WeaponType weapon_type, WeaponFacti
             bullet_config.life_span = 10.0f;
             bullet_config.fuzzy_life_span = 0;
             bullet_config.collision_callback
-                = std::bind(StandardCollision, _1, _2, _3, _4, m_entity_manager, damage_system, physics_system, sprite_system, transform_system);
-            bullet_config.entity_file = "res/entities/green_blob.entity";
-            bullet_config.sound_file = nullptr;
+                = std::bind(StandardCollision, _1, _2, _3, damage_system, physics_system);
+            bullet_config.sprite_file = "res/sprites/generic.sprite";
+            bullet_config.radius = 0.2f;
 
             weapon_config.reload_time_ms = 1000;
             weapon_config.magazine_size = 40;
@@ -140,9 +139,9 @@ IWeaponPtr WeaponFactory::CreateBulletWeapon(WeaponType weapon_type, WeaponFacti
             bullet_config.life_span = 10.0f;
             bullet_config.fuzzy_life_span = 0;
             bullet_config.collision_callback
-                = std::bind(StandardCollision, _1, _2, _3, _4, m_entity_manager, damage_system, physics_system, sprite_system, transform_system);
-            bullet_config.entity_file = "res/entities/flak_bullet.entity";
-            bullet_config.sound_file = nullptr;
+                = std::bind(StandardCollision, _1, _2, _3, damage_system, physics_system);
+            bullet_config.sprite_file = "res/sprites/flak_bullet.sprite";
+            bullet_config.radius = 0.05f;
 
             weapon_config.projectiles_per_fire = 6;
             weapon_config.magazine_size = 30;
@@ -165,9 +164,10 @@ IWeaponPtr WeaponFactory::CreateBulletWeapon(WeaponType weapon_type, WeaponFacti
             bullet_config.fuzzy_life_span = 0;
             bullet_config.bullet_behaviour = BulletCollisionBehaviour::NORMAL;
             bullet_config.collision_callback = std::bind(
-                StandardCollision, _1, _2, _3, _4, m_entity_manager, damage_system, physics_system, sprite_system, transform_system);
-            bullet_config.entity_file = "res/entities/laser_bullet.entity";
-            bullet_config.sound_file = nullptr;
+                StandardCollision, _1, _2, _3, damage_system, physics_system);
+            bullet_config.sprite_file = "res/sprites/laser_small.sprite";
+            bullet_config.radius = 0.1f;
+            bullet_config.want_direction = true;
 
             weapon_config.reload_time_ms = 500;
             weapon_config.magazine_size = 50;
@@ -176,7 +176,6 @@ IWeaponPtr WeaponFactory::CreateBulletWeapon(WeaponType weapon_type, WeaponFacti
             weapon_config.max_fire_rate = 2.0f;
             weapon_config.bullet_force = 20.0f;
             weapon_config.bullet_spread_degrees = 1.0f;
-            weapon_config.bullet_want_direction = true;
             weapon_config.fire_sound = "res/sound/blaster-probe-gun.wav";
             weapon_config.reload_sound = "res/sound/shotgun_reload2.wav";
 
@@ -187,6 +186,19 @@ IWeaponPtr WeaponFactory::CreateBulletWeapon(WeaponType weapon_type, WeaponFacti
             break;
     }
 
+    const uint32_t projectile_key = (uint32_t(weapon_type) << 8) | uint32_t(faction);
+    const auto it = m_projectile_types.find(projectile_key);
+    if(it != m_projectile_types.end())
+    {
+        weapon_config.projectile_type = it->second;
+    }
+    else
+    {
+        ProjectileSystem* projectile_system = m_system_context->GetSystem<ProjectileSystem>();
+        weapon_config.projectile_type = projectile_system->RegisterProjectileType(bullet_config);
+        m_projectile_types[projectile_key] = weapon_config.projectile_type;
+    }
+
     return std::make_unique<game::Weapon>(weapon_config, m_entity_manager, m_system_context);
 }
 
@@ -4,6 +4,9 @@
 #include "IWeaponFactory.h"
 #include "MonoFwd.h"
 
+#include <unordered_map>
+#include <cstdint>
+
 namespace game
 {
     class WeaponFactory : public IWeaponFactory
@@ -21,5 +24,8 @@ namespace game
 
         mono::IEntityManager* m_entity_manager;
         mono::SystemContext* m_system_context;
+
+        // Weapon type and faction to projectile type, all weapons of a kind share the projectile type.
+        std::unordered_map<uint32_t, uint32_t> m_projectile_types;
     };
 }
@@ -3,6 +3,7 @@
 
 #include "Player/PlayerInfo.h"
 #include "Network/INetworkPipe.h"
+#include "Network/NetworkSerialize.h"
 #include "RenderLayers.h"
 #include "Player/PlayerDaemon.h"
 
@@ -17,10 +18,14 @@ namespace
     {
     public:
 
-        void SendMessage(const NetworkMessage& message) override
-        { }
-        void SendMessageTo(const NetworkMessage& message, const network::Address& address) override
-        { }
+        void SendMessage(NetworkMessage&& message) override
+        {
+            ReleaseMessageBuffer(std::move(message.payload));
+        }
+        void SendMessageTo(NetworkMessage&& message, const network::Address& address) override
+        {
+            ReleaseMessageBuffer(std::move(message.payload));
+        }
         ConnectionInfo GetConnectionInfo() const override
         {
             return ConnectionInfo();
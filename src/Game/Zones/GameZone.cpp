@@ -29,6 +29,7 @@
 #include "Hud/Debug/PhysicsStatsElement.h"
 #include "Hud/Debug/ConsoleDrawer.h"
 #include "Hud/Debug/ParticleStatusDrawer.h"
+#include "Hud/Debug/SystemTimingsDrawer.h"
 
 #include "Navigation/NavMeshVisualizer.h"
 
@@ -36,7 +37,8 @@
 
 #include "RenderLayers.h"
 #include "DamageSystem.h"
-#include "WorldFile.h"
+#include "WorldLoader.h"
+#include "GameConfig.h"
 #include "Camera/ICamera.h"
 #include "GameDebug.h"
 #include "GameDebugDrawer.h"
@@ -48,15 +50,98 @@
 #include "TriggerSystem/TriggerDebugDrawer.h"
 #include "SpawnSystem/SpawnSystem.h"
 #include "SpawnSystem/SpawnSystemDrawer.h"
+#include "Scheduler/SystemScheduler.h"
+#include "Entity/EntityPoolSystem.h"
+#include "Entity/LoadEntity.h"
+#include "Weapons/ProjectileSystem.h"
+#include "Weapons/ProjectileSystemDrawer.h"
+#include "Effects/BulletTrailEffect.h"
 
 #include "ImGuiImpl/ImGuiInputHandler.h"
+#include "IUpdatable.h"
+#include "System/System.h"
 
 using namespace game;
 
+namespace
+{
+    // Creates the world entities within the budget each frame, then preloads the entity files in the list the
+    // same way, so neither stalls the zone load.
+    class WorldLoadUpdater : public mono::IUpdatable
+    {
+    public:
+
+        WorldLoadUpdater(
+            shared::WorldLoader* world_loader,
+            mono::IEntityManager* entity_manager,
+            TriggerSystem* trigger_system,
+            std::vector<std::string> preload_files,
+            float budget_ms)
+            : m_world_loader(world_loader)
+            , m_entity_manager(entity_manager)
+            , m_trigger_system(trigger_system)
+            , m_preload_files(std::move(preload_files))
+            , m_next_preload_file(0)
+            , m_budget_ms(budget_ms)
+            , m_start_time(System::GetMilliseconds())
+            , m_world_done(false)
+        { }
+
+        void Update(const mono::UpdateContext& update_context) override
+        {
+            if(!m_world_done)
+            {
+                m_world_done = m_world_loader->IsDone() || m_world_loader->InstantiateEntities(m_entity_manager, nullptr, m_budget_ms);
+                if(m_world_done)
+                {
+                    System::Log(
+                        "GameZone|Created %zu world entities in %u ms.",
+                        m_world_loader->GetLevelData().loaded_entities.size(), System::GetMilliseconds() - m_start_time);
+                    m_trigger_system->HoldAreaTriggers(false);
+                }
+
+                return;
+            }
+
+            if(m_next_preload_file == m_preload_files.size())
+                return;
+
+            const uint64_t start_time = System::GetPerformanceCounter();
+            const uint64_t budget_ticks = uint64_t(m_budget_ms * System::GetPerformanceFrequency() / 1000.0f);
+
+            // At least one file per update, a budget of zero or less loads all of them.
+            do
+            {
+                shared::PreloadEntityFile(m_preload_files[m_next_preload_file].c_str());
+                m_next_preload_file++;
+            }
+            while(m_next_preload_file < m_preload_files.size() &&
+                (m_budget_ms <= 0.0f || (System::GetPerformanceCounter() - start_time) < budget_ticks));
+
+            if(m_next_preload_file == m_preload_files.size())
+                System::Log("GameZone|Preloaded %zu entity files.", m_preload_files.size());
+        }
+
+        shared::WorldLoader* m_world_loader;
+        mono::IEntityManager* m_entity_manager;
+        TriggerSystem* m_trigger_system;
+        const std::vector<std::string> m_preload_files;
+        size_t m_next_preload_file;
+        const float m_budget_ms;
+        const uint32_t m_start_time;
+        bool m_world_done;
+    };
+}
+
+// The world file is read on a background thread from here, while the previous zone is torn down.
 GameZone::GameZone(const ZoneCreationContext& context, const char* world_file)
     : m_system_context(context.system_context)
     , m_event_handler(context.event_handler)
     , m_world_file(world_file)
+    , m_world_load_budget_ms(context.game_config->world_load_budget_ms)
+    , m_world_load_by_distance(context.game_config->world_load_by_distance)
+    , m_preload_entity_files(context.game_config->preload_entity_files)
+    , m_world_loader(std::make_unique<shared::WorldLoader>(world_file, nullptr))
 { }
 
 GameZone::~GameZone()
@@ -81,8 +166,33 @@ void GameZone::OnLoad(mono::ICamera* camera, mono::IRenderer* renderer)
     TriggerSystem* trigger_system = m_system_context->GetSystem<TriggerSystem>();
     InteractionSystem* interaction_system = m_system_context->GetSystem<InteractionSystem>();
     SpawnSystem* spawn_system = m_system_context->GetSystem<SpawnSystem>();
+    const ProjectileSystem* projectile_system = m_system_context->GetSystem<ProjectileSystem>();
+    const SystemScheduler* system_scheduler = m_system_context->GetSystem<SystemScheduler>();
+
+    // Only the metadata is needed here, the entities are created over the next frames within the budget.
+    m_world_loader->WaitForParse();
+    m_leveldata.metadata = m_world_loader->GetLevelData().metadata;
+
+    if(m_world_load_by_distance)
+        m_world_loader->SortByDistance(m_leveldata.metadata.player_spawn_point);
+
+    // The entity templates live as long as the zone, so a zone does not keep what the previous one loaded. The
+    // files are loaded over the frames after the world entities are created.
+    std::vector<std::string> preload_files;
+    if(m_preload_entity_files)
+        preload_files = shared::ReadEntityFileList("res/entities/all_entities.json");
+
+    // An area could be checked before the entities in it are created, the loader releases them when done.
+    trigger_system->HoldAreaTriggers(true);
+
+    m_world_loader->InstantiateEntities(entity_system, nullptr, m_world_load_budget_ms);
+    AddUpdatable(
+        new WorldLoadUpdater(m_world_loader.get(), entity_system, trigger_system, std::move(preload_files), m_world_load_budget_ms));
+    AddUpdatable(new BulletTrailEffect(projectile_system, transform_system, particle_system, light_system, entity_system));
+
+    EntityPoolSystem* entity_pool_system = m_system_context->GetSystem<EntityPoolSystem>();
+    entity_pool_system->WarmUp();
 
-    m_leveldata = shared::ReadWorldComponentObjects(m_world_file, entity_system, nullptr);
     camera->SetPosition(m_leveldata.metadata.camera_position);
     camera->SetViewportSize(m_leveldata.metadata.camera_size);
     renderer->SetClearColor(m_leveldata.metadata.background_color);
@@ -96,6 +206,7 @@ void GameZone::OnLoad(mono::ICamera* camera, mono::IRenderer* renderer)
     AddDrawable(new mono::RoadBatchDrawer(road_system, path_system, transform_system), LayerId::BACKGROUND);
     AddDrawable(new mono::SpriteBatchDrawer(transform_system, sprite_system), LayerId::GAMEOBJECTS);
     AddDrawable(new mono::TextBatchDrawer(text_system, transform_system), LayerId::GAMEOBJECTS);
+    AddDrawable(new ProjectileSystemDrawer(projectile_system), LayerId::GAMEOBJECTS);
     AddDrawable(new mono::ParticleSystemDrawer(particle_system), LayerId::PARTICLES);
     AddDrawable(new mono::LightSystemDrawer(light_system, transform_system), LayerId::GAMEOBJECTS);
     AddDrawable(new InteractionSystemDrawer(interaction_system, sprite_system, transform_system), LayerId::UI);
@@ -105,6 +216,7 @@ void GameZone::OnLoad(mono::ICamera* camera, mono::IRenderer* renderer)
     AddDrawable(new GameDebugDrawer(), LayerId::GAMEOBJECTS_DEBUG);
     AddDrawable(new PhysicsStatsElement(physics_system), LayerId::UI);
     AddDrawable(new ParticleStatusDrawer(particle_system), LayerId::UI);
+    AddDrawable(new SystemTimingsDrawer(system_scheduler), LayerId::UI);
     AddDrawable(new NavmeshVisualizer(m_navmesh, *m_event_handler), LayerId::UI);
     AddDrawable(new mono::TransformSystemDrawer(g_draw_transformsystem, transform_system), LayerId::UI);
     AddDrawable(new mono::PhysicsDebugDrawer(g_draw_physics, g_interact_physics, g_draw_physics_subcomponents, physics_system, m_event_handler), LayerId::UI);
@@ -113,10 +225,27 @@ void GameZone::OnLoad(mono::ICamera* camera, mono::IRenderer* renderer)
     AddDrawable(new DebugUpdater(trigger_system, transform_system, m_event_handler), LayerId::UI);
 }
 
+float GameZone::LoadingProgress() const
+{
+    return m_world_loader->Progress();
+}
+
 int GameZone::OnUnload()
 {
+    EntityPoolSystem* entity_pool_system = m_system_context->GetSystem<EntityPoolSystem>();
+    entity_pool_system->ReleaseIdleEntities();
+
     mono::EntitySystem* entity_system = m_system_context->GetSystem<mono::EntitySystem>();
     entity_system->ReleaseAllEntities();
 
+    ProjectileSystem* projectile_system = m_system_context->GetSystem<ProjectileSystem>();
+    projectile_system->ReleaseAllProjectiles();
+
+    // Unloaded before the world was done, the next zone should not start with held triggers.
+    TriggerSystem* trigger_system = m_system_context->GetSystem<TriggerSystem>();
+    trigger_system->HoldAreaTriggers(false);
+
+    shared::ClearEntityFileCache();
+
     return 0;
 }
@@ -5,6 +5,7 @@
 #include "ZoneCreationContext.h"
 #include "Navigation/NavmeshData.h"
 #include "WorldFile.h"
+#include "WorldLoader.h"
 
 #include <memory>
 
@@ -21,12 +22,19 @@ namespace game
         void OnLoad(mono::ICamera* camera, mono::IRenderer* renderer) override;
         int OnUnload() override;
 
+        // Zero until the world file is read, then the share of the world entities that are created.
+        float LoadingProgress() const;
+
     protected:
 
         mono::SystemContext* m_system_context;
         mono::EventHandler* m_event_handler;
         const char* m_world_file;
+        const float m_world_load_budget_ms;
+        const bool m_world_load_by_distance;
+        const bool m_preload_entity_files;
 
+        std::unique_ptr<shared::WorldLoader> m_world_loader;
         shared::LevelData m_leveldata;
 
         std::unique_ptr<ImGuiInputHandler> m_debug_input;
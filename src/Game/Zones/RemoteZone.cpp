@@ -11,8 +11,13 @@
 #include "Hud/HealthbarDrawer.h"
 
 #include "Network/NetworkMessage.h"
+#include "Network/NetworkSerialize.h"
 #include "Network/ClientReplicator.h"
 #include "Network/ClientManager.h"
+#include "Network/AssetClient.h"
+#include "Network/EffectEventReplayer.h"
+#include "Network/ProjectileEventReplayer.h"
+#include "Network/JoinSnapshot.h"
 
 #include "Camera/ICamera.h"
 #include "EntitySystem/IEntityManager.h"
@@ -32,6 +37,8 @@
 #include "PredictionSystem/PositionPredictionSystemDebug.h"
 #include "PredictionSystem/SpawnPredictionSystem.h"
 #include "Player/ClientPlayerDaemon.h"
+#include "Weapons/ProjectileSystem.h"
+#include "Weapons/ProjectileSystemDrawer.h"
 
 #include "ImGuiImpl/ImGuiInputHandler.h"
 
@@ -44,6 +51,11 @@ RemoteZone::RemoteZone(const ZoneCreationContext& context)
     : m_system_context(context.system_context)
     , m_event_handler(context.event_handler)
     , m_game_config(*context.game_config)
+    , m_asset_client(nullptr)
+    , m_has_level_metadata(false)
+    , m_background_texture_hash(0)
+    , m_snapshot_applied(false)
+    , m_join_timestamp(0)
 {
     using namespace std::placeholders;
 
@@ -53,6 +65,7 @@ RemoteZone::RemoteZone(const ZoneCreationContext& context)
     const std::function<mono::EventResult (const SpriteMessage&)> sprite_func = std::bind(&RemoteZone::HandleSpriteMessage, this, _1);
     const std::function<mono::EventResult (const TransformMessage&)> transform_func = std::bind(&RemoteZone::HandleTransformMessage, this, _1);
     const std::function<mono::EventResult (const DamageInfoMessage&)> damage_func = std::bind(&RemoteZone::HandleDamageInfoMessage, this, _1);
+    const std::function<mono::EventResult (const SnapshotFragmentMessage&)> snapshot_func = std::bind(&RemoteZone::HandleSnapshotFragment, this, _1);
 
     m_metadata_token = m_event_handler->AddListener(metadata_func);
     m_text_token = m_event_handler->AddListener(text_func);
@@ -60,6 +73,7 @@ RemoteZone::RemoteZone(const ZoneCreationContext& context)
     m_sprite_token = m_event_handler->AddListener(sprite_func);
     m_transform_token = m_event_handler->AddListener(transform_func);
     m_damageinfo_token = m_event_handler->AddListener(damage_func);
+    m_snapshot_token = m_event_handler->AddListener(snapshot_func);
 }
 
 RemoteZone::~RemoteZone()
@@ -70,6 +84,7 @@ RemoteZone::~RemoteZone()
     m_event_handler->RemoveListener(m_sprite_token);
     m_event_handler->RemoveListener(m_transform_token);
     m_event_handler->RemoveListener(m_damageinfo_token);
+    m_event_handler->RemoveListener(m_snapshot_token);
 }
 
 void RemoteZone::OnLoad(mono::ICamera* camera, mono::IRenderer* renderer)
@@ -83,10 +98,14 @@ void RemoteZone::OnLoad(mono::ICamera* camera, mono::IRenderer* renderer)
     m_damage_system = m_system_context->GetSystem<DamageSystem>();
     CameraSystem* camera_system = m_system_context->GetSystem<CameraSystem>();
     ClientManager* client_manager = m_system_context->GetSystem<ClientManager>();
+    ProjectileSystem* projectile_system = m_system_context->GetSystem<ProjectileSystem>();
     client_manager->StartClient();
 
+    m_join_timestamp = System::GetMilliseconds();
+    m_snapshot_assembler = std::make_unique<SnapshotAssembler>();
+
     m_position_prediction_system =
-        m_system_context->CreateSystem<PositionPredictionSystem>(500, client_manager, transform_system);
+        m_system_context->CreateSystem<PositionPredictionSystem>(m_game_config.max_entities, client_manager, transform_system);
 
     m_spawn_prediction_system = m_system_context->CreateSystem<SpawnPredictionSystem>(
         client_manager, m_sprite_system, m_damage_system, m_position_prediction_system);
@@ -96,8 +115,18 @@ void RemoteZone::OnLoad(mono::ICamera* camera, mono::IRenderer* renderer)
     m_console_drawer = std::make_unique<ConsoleDrawer>();
 
     AddUpdatable(new ClientReplicator(camera, client_manager));
+    AddUpdatable(new EffectEventReplayer(m_event_handler, client_manager));
+    AddUpdatable(new ProjectileEventReplayer(m_event_handler, client_manager, projectile_system));
+
+    const auto assets_synced = [this]() {
+        if(m_has_level_metadata)
+            ApplyLevelMetadata();
+    };
+    m_asset_client = new AssetClient(m_game_config.asset_cache_directory, m_event_handler, client_manager, assets_synced);
+    AddUpdatable(m_asset_client);
 
     AddDrawable(new mono::SpriteBatchDrawer(transform_system, m_sprite_system), LayerId::GAMEOBJECTS);
+    AddDrawable(new ProjectileSystemDrawer(projectile_system), LayerId::GAMEOBJECTS);
     AddDrawable(new PredictionSystemDebugDrawer(m_position_prediction_system), LayerId::GAMEOBJECTS_DEBUG);
     AddDrawable(new mono::TransformSystemDrawer(g_draw_transformsystem, transform_system), LayerId::UI);
     AddDrawable(new HealthbarDrawer(m_damage_system, transform_system, m_entity_manager), LayerId::UI);
@@ -111,6 +140,9 @@ int RemoteZone::OnUnload()
     ClientManager* client_manager = m_system_context->GetSystem<ClientManager>();
     client_manager->Disconnect();
 
+    ProjectileSystem* projectile_system = m_system_context->GetSystem<ProjectileSystem>();
+    projectile_system->ReleaseAllProjectiles();
+
     RemoveDrawable(m_console_drawer.get());
     return TITLE_SCREEN;
 }
@@ -147,13 +179,23 @@ mono::EventResult RemoteZone::HandleLevelMetadata(const LevelMetadataMessage& me
     m_camera->SetPosition(metadata_message.camera_position);
     m_camera->SetViewportSize(metadata_message.camera_size);
 
-    const char* background_texture_filename = game::HashToFilename(metadata_message.background_texture_hash);
-    if(background_texture_filename)
-        AddDrawable(new mono::StaticBackground(background_texture_filename, mono::TextureModeFlags::REPEAT), LayerId::BACKGROUND);
+    // The background is setup once the assets are synced, since it might have to come from the asset cache.
+    m_has_level_metadata = true;
+    m_background_texture_hash = metadata_message.background_texture_hash;
+
+    if(m_asset_client->IsSynced())
+        ApplyLevelMetadata();
 
     return mono::EventResult::HANDLED;
 }
 
+void RemoteZone::ApplyLevelMetadata()
+{
+    const char* background_texture_filename = m_asset_client->ResolveAssetPath(m_background_texture_hash);
+    if(background_texture_filename)
+        AddDrawable(new mono::StaticBackground(background_texture_filename, mono::TextureModeFlags::REPEAT), LayerId::BACKGROUND);
+}
+
 mono::EventResult RemoteZone::HandleText(const TextMessage& text_message)
 {
     m_console_drawer->AddText(text_message.text, 1500);
@@ -167,12 +209,125 @@ mono::EventResult RemoteZone::HandleSpawnMessage(const SpawnMessage& spawn_messa
 }
 
 mono::EventResult RemoteZone::HandleSpriteMessage(const SpriteMessage& sprite_message)
+{
+    if(m_snapshot_applied)
+        ApplySpriteMessage(sprite_message);
+    else
+        m_pending_sprites.push_back(sprite_message);
+
+    return mono::EventResult::HANDLED;
+}
+
+mono::EventResult RemoteZone::HandleTransformMessage(const TransformMessage& transform_message)
+{
+    if(m_snapshot_applied)
+        m_position_prediction_system->HandlePredicitonMessage(transform_message);
+    else
+        m_pending_transforms.push_back(transform_message);
+
+    return mono::EventResult::HANDLED;
+}
+
+mono::EventResult RemoteZone::HandleDamageInfoMessage(const DamageInfoMessage& damageinfo_message)
+{
+    if(m_snapshot_applied)
+        ApplyDamageInfoMessage(damageinfo_message);
+    else
+        m_pending_damage_infos.push_back(damageinfo_message);
+
+    return mono::EventResult::HANDLED;
+}
+
+mono::EventResult RemoteZone::HandleSnapshotFragment(const SnapshotFragmentMessage& fragment_message)
+{
+    if(m_snapshot_applied)
+        return mono::EventResult::HANDLED;
+
+    const uint32_t snapshot_id = m_snapshot_assembler->SnapshotId();
+    const bool ack_fragment = m_snapshot_assembler->AddFragment(fragment_message);
+    if(!ack_fragment)
+        return mono::EventResult::HANDLED;
+
+    // The server only replaces a snapshot that timed out, the deltas collected so far are older than the new one.
+    if(snapshot_id != 0 && snapshot_id != m_snapshot_assembler->SnapshotId())
+    {
+        m_pending_transforms.clear();
+        m_pending_sprites.clear();
+        m_pending_damage_infos.clear();
+    }
+
+    ClientManager* client_manager = m_system_context->GetSystem<ClientManager>();
+
+    SnapshotAckMessage ack_message;
+    ack_message.sender = client_manager->GetClientAddress();
+    ack_message.snapshot_id = fragment_message.snapshot_id;
+    ack_message.fragment_index = fragment_message.fragment_index;
+
+    NetworkMessage message;
+    message.payload = SerializeMessage(ack_message);
+    client_manager->SendMessage(std::move(message));
+
+    if(m_snapshot_assembler->IsComplete())
+        ApplyJoinSnapshot();
+
+    return mono::EventResult::HANDLED;
+}
+
+void RemoteZone::ApplyJoinSnapshot()
+{
+    const std::vector<byte>& snapshot_data = m_snapshot_assembler->Data();
+
+    JoinSnapshot snapshot;
+    const bool success = DecompressJoinSnapshot(
+        snapshot_data.data(), snapshot_data.size(), m_snapshot_assembler->UncompressedSize(), snapshot);
+    if(!success)
+    {
+        // Fall back to only consuming deltas, the state fills in as the entities change on the server.
+        System::Log("RemoteZone|Unable to read join snapshot %u.", m_snapshot_assembler->SnapshotId());
+        snapshot = JoinSnapshot();
+    }
+
+    for(const TransformMessage& transform_message : snapshot.transforms)
+        m_position_prediction_system->HandlePredicitonMessage(transform_message);
+
+    for(const SpriteMessage& sprite_message : snapshot.sprites)
+        ApplySpriteMessage(sprite_message);
+
+    for(const DamageInfoMessage& damageinfo_message : snapshot.damage_infos)
+        ApplyDamageInfoMessage(damageinfo_message);
+
+    // Deltas received while waiting are newer than the snapshot, older transforms are skipped by the prediction.
+    for(const TransformMessage& transform_message : m_pending_transforms)
+        m_position_prediction_system->HandlePredicitonMessage(transform_message);
+
+    for(const SpriteMessage& sprite_message : m_pending_sprites)
+        ApplySpriteMessage(sprite_message);
+
+    for(const DamageInfoMessage& damageinfo_message : m_pending_damage_infos)
+        ApplyDamageInfoMessage(damageinfo_message);
+
+    System::Log(
+        "RemoteZone|Join snapshot %u applied %u ms after join, transforms: %zu, sprites: %zu, damages: %zu, replayed deltas: %zu.",
+        m_snapshot_assembler->SnapshotId(),
+        System::GetMilliseconds() - m_join_timestamp,
+        snapshot.transforms.size(),
+        snapshot.sprites.size(),
+        snapshot.damage_infos.size(),
+        m_pending_transforms.size() + m_pending_sprites.size() + m_pending_damage_infos.size());
+
+    m_pending_transforms.clear();
+    m_pending_sprites.clear();
+    m_pending_damage_infos.clear();
+    m_snapshot_applied = true;
+}
+
+void RemoteZone::ApplySpriteMessage(const SpriteMessage& sprite_message)
 {
     const bool is_allocated = m_sprite_system->IsAllocated(sprite_message.entity_id);
     if(!is_allocated)
     {
         mono::SpriteComponents sprite_data;
-        sprite_data.sprite_file = game::HashToFilename(sprite_message.filename_hash);
+        sprite_data.sprite_file = m_asset_client->ResolveAssetPath(sprite_message.filename_hash);
         m_sprite_system->AllocateSprite(sprite_message.entity_id, sprite_data);
     }
 
@@ -187,27 +342,17 @@ mono::EventResult RemoteZone::HandleSpriteMessage(const SpriteMessage& sprite_me
     sprite->SetProperties(sprite_message.properties);
 
     m_sprite_system->SetSpriteLayer(sprite_message.entity_id, sprite_message.layer);
-
-    return mono::EventResult::HANDLED;
 }
 
-mono::EventResult RemoteZone::HandleTransformMessage(const TransformMessage& transform_message)
-{
-    m_position_prediction_system->HandlePredicitonMessage(transform_message);
-    return mono::EventResult::HANDLED;
-}
-
-mono::EventResult RemoteZone::HandleDamageInfoMessage(const DamageInfoMessage& damageinfo_message)
+void RemoteZone::ApplyDamageInfoMessage(const DamageInfoMessage& damageinfo_message)
 {
     const bool is_allocated = m_damage_system->IsAllocated(damageinfo_message.entity_id);
     if(!is_allocated)
         m_damage_system->CreateRecord(damageinfo_message.entity_id);
 
     DamageRecord* damage_record = m_damage_system->GetDamageRecord(damageinfo_message.entity_id);
-    damage_record->health = damageinfo_message.health;
+    m_damage_system->SetHealth(damageinfo_message.entity_id, damageinfo_message.health);
     damage_record->full_health = damageinfo_message.full_health;
     damage_record->is_boss = damageinfo_message.is_boss;
     damage_record->last_damaged_timestamp = damageinfo_message.damage_timestamp;
-
-    return mono::EventResult::HANDLED;
 }
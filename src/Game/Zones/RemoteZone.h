@@ -8,6 +8,7 @@
 #include "EventHandler/EventToken.h"
 
 #include <memory>
+#include <vector>
 
 class ImGuiInputHandler;
 
@@ -24,6 +25,7 @@ namespace game
     struct SpriteMessage;
     struct TransformMessage;
     struct DamageInfoMessage;
+    struct SnapshotFragmentMessage;
 
     class DamageSystem;
 
@@ -43,26 +45,44 @@ namespace game
         mono::EventResult HandleSpriteMessage(const SpriteMessage& sprite_message);
         mono::EventResult HandleTransformMessage(const TransformMessage& transform_message);
         mono::EventResult HandleDamageInfoMessage(const DamageInfoMessage& damageinfo_message);
+        mono::EventResult HandleSnapshotFragment(const SnapshotFragmentMessage& fragment_message);
 
     private:
 
+        void ApplyLevelMetadata();
+        void ApplyJoinSnapshot();
+        void ApplySpriteMessage(const SpriteMessage& sprite_message);
+        void ApplyDamageInfoMessage(const DamageInfoMessage& damageinfo_message);
+
         mono::SystemContext* m_system_context;
         mono::EventHandler* m_event_handler;
         const game::Config m_game_config;
 
         mono::ICamera* m_camera;
+        class AssetClient* m_asset_client;
+        bool m_has_level_metadata;
+        uint32_t m_background_texture_hash;
         mono::SpriteSystem* m_sprite_system;
         mono::IEntityManager* m_entity_manager;
         game::DamageSystem* m_damage_system;
         class PositionPredictionSystem* m_position_prediction_system;
         class SpawnPredictionSystem* m_spawn_prediction_system;
 
+        // Deltas that arrive before the join snapshot is applied are held back and replayed on top of it.
+        bool m_snapshot_applied;
+        uint32_t m_join_timestamp;
+        std::unique_ptr<class SnapshotAssembler> m_snapshot_assembler;
+        std::vector<TransformMessage> m_pending_transforms;
+        std::vector<SpriteMessage> m_pending_sprites;
+        std::vector<DamageInfoMessage> m_pending_damage_infos;
+
         mono::EventToken<game::LevelMetadataMessage> m_metadata_token;
         mono::EventToken<game::TextMessage> m_text_token;
         mono::EventToken<game::SpawnMessage> m_spawn_token;
         mono::EventToken<game::SpriteMessage> m_sprite_token;
         mono::EventToken<game::TransformMessage> m_transform_token;
         mono::EventToken<game::DamageInfoMessage> m_damageinfo_token;
+        mono::EventToken<game::SnapshotFragmentMessage> m_snapshot_token;
 
         std::unique_ptr<class ConsoleDrawer> m_console_drawer;
         std::unique_ptr<class ClientPlayerDaemon> m_player_daemon;
@@ -25,12 +25,17 @@
 
 #include "Network/ServerManager.h"
 #include "Network/ServerReplicator.h"
+#include "Network/AssetServer.h"
+
+#include "Weapons/ProjectileSystem.h"
 
 #include "Factories.h"
 #include "RenderLayers.h"
 #include "Player/PlayerDaemon.h"
 #include "TriggerSystem/TriggerSystem.h"
 #include "DamageSystem.h"
+#include "SimulationClock.h"
+#include "Entity/EntityPoolSystem.h"
 
 #include "World/FogOverlay.h"
 #include "Effects/AngelDust.h"
@@ -69,10 +74,14 @@ void SystemTestZone::OnLoad(mono::ICamera* camera, mono::IRenderer* renderer)
     physics_system->GetSpace()->SetDamping(0.01f);
 
     game::DamageSystem* damage_system = m_system_context->GetSystem<game::DamageSystem>();
+    game::EntityPoolSystem* entity_pool_system = m_system_context->GetSystem<game::EntityPoolSystem>();
     game::TriggerSystem* trigger_system = m_system_context->GetSystem<game::TriggerSystem>();
+    game::ProjectileSystem* projectile_system = m_system_context->GetSystem<game::ProjectileSystem>();
     game::ServerManager* server_manager = m_system_context->GetSystem<game::ServerManager>();
     server_manager->StartServer();
 
+    const game::SimulationClock* simulation_clock = m_system_context->GetSystem<game::SimulationClock>();
+
     const auto level_completed_func = [this](uint32_t trigger_id) {
         m_event_handler->DispatchEvent(event::QuitEvent());
         m_next_zone = END_SCREEN;
@@ -83,14 +92,20 @@ void SystemTestZone::OnLoad(mono::ICamera* camera, mono::IRenderer* renderer)
     ServerReplicator* server_replicator = new ServerReplicator(
         m_event_handler,
         entity_system,
+        entity_pool_system,
         transform_system,
         sprite_system,
         damage_system,
+        projectile_system,
         server_manager,
+        simulation_clock,
+        m_world_file,
         m_leveldata.metadata,
         m_game_config.server_replication_interval);
     AddUpdatable(server_replicator);
 
+    m_asset_server = std::make_unique<AssetServer>(m_world_file, m_event_handler, server_manager);
+
     // Player
     m_player_daemon = std::make_unique<PlayerDaemon>(
         server_manager, entity_system, m_system_context, m_event_handler, m_leveldata.metadata.player_spawn_point);
@@ -121,6 +136,7 @@ int SystemTestZone::OnUnload()
 
     game::ServerManager* server_manager = m_system_context->GetSystem<game::ServerManager>();
     server_manager->QuitServer();
+    m_asset_server = nullptr;
 
     TriggerSystem* trigger_system = m_system_context->GetSystem<TriggerSystem>();
     trigger_system->RemoveTriggerCallback(level_completed_hash, m_level_completed_trigger, 0);
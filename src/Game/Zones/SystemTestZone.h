@@ -30,6 +30,7 @@ namespace game
         uint32_t m_level_completed_trigger;
         int m_next_zone;
 
+        std::unique_ptr<class AssetServer> m_asset_server;
         std::unique_ptr<class PlayerDaemon> m_player_daemon;
         std::unique_ptr<class GameOverScreen> m_gameover_screen;
         std::unique_ptr<class PlayerUIElement> m_player_ui;
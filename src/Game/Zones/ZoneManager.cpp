@@ -33,13 +33,19 @@ ZoneManager::ZoneManager(
 
 void ZoneManager::Run()
 {
+    game::IZonePtr zone;
+
     while(true)
     {
         if(m_active_zone == QUIT)
             break;
 
+        // Create the next zone before the previous one is destroyed, game zones start reading their world on
+        // a background thread when created.
         LoadFunction load_func = m_zones[m_active_zone];
-        game::IZonePtr zone = load_func(m_zone_context);
+        game::IZonePtr next_zone = load_func(m_zone_context);
+        zone = std::move(next_zone);
+
         m_active_zone = m_engine.Run(zone.get());
     }
 }
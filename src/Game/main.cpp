@@ -25,11 +25,17 @@
 #include "Zones/ZoneManager.h"
 
 #include "DamageSystem.h"
+#include "SimulationClock.h"
+#include "TimerSystem.h"
+#include "Scheduler/SystemScheduler.h"
 #include "Entity/AnimationSystem.h"
 #include "Entity/EntityLogicSystem.h"
+#include "Entity/EntityPoolSystem.h"
+#include "Weapons/ProjectileSystem.h"
 #include "GameCamera/CameraSystem.h"
 #include "InteractionSystem/InteractionSystem.h"
 #include "Pickups/PickupSystem.h"
+#include "ShockwaveSystem.h"
 #include "TriggerSystem/TriggerSystem.h"
 #include "SpawnSystem/SpawnSystem.h"
 #include "RoadSystem/RoadSystem.h"
@@ -42,10 +48,13 @@
 #include "Entity/GameComponentFuncs.h"
 #include "Entity/EntityLogicFactory.h"
 #include "Entity/LoadEntity.h"
+#include "WorldFileBinary.h"
 #include "Component.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <thread>
 
 namespace
 {
@@ -58,6 +67,7 @@ namespace
         int start_zone = 1;
         const char* game_config = "res/game_config.json";
         const char* log_file = "game_log.log";
+        bool compile_worlds = false;
     };
 
     Options ParseCommandline(int argc, char* argv[])
@@ -95,6 +105,10 @@ namespace
                 assert((index + 1) < argc);
                 options.log_file = argv[++index];
             }
+            else if(std::strcmp("--compile-worlds", arg) == 0)
+            {
+                options.compile_worlds = true;
+            }
         }
 
         return options;
@@ -103,18 +117,30 @@ namespace
 
 int main(int argc, char* argv[])
 {
-    constexpr size_t max_entities = 500;
+    constexpr uint32_t max_projectiles = 2000;
     const Options options = ParseCommandline(argc, argv);
 
     System::InitializeContext system_context;
     system_context.log_file = options.log_file;
     System::Initialize(system_context);
 
+    // Offline step, writes the compiled worlds next to the world files and exits.
+    if(options.compile_worlds)
+    {
+        const int n_failed = shared::CompileAllWorlds("res/worlds/all_worlds.json");
+        System::Shutdown();
+        return (n_failed == 0) ? 0 : 1;
+    }
+
     game::Config game_config;
     game::LoadConfig(options.game_config, game_config);
+
+    // The engine systems are created with this capacity, the game systems start with it and grow when needed.
+    const size_t max_entities = std::max(game_config.max_entities, 1);
     game::LoadAllSprites("res/sprites/all_sprite_files.json");
     game::LoadAllTextures("res/textures/all_textures.json");
     game::LoadAllWorlds("res/worlds/all_worlds.json");
+    game::LoadAllEntities("res/entities/all_entities.json");
 
     network::Initialize(game_config.port_range_start, game_config.port_range_end);
     game::PrintNetworkMessageSize();
@@ -145,6 +171,9 @@ int main(int argc, char* argv[])
         mono::SystemContext system_context;
         mono::Camera camera;
 
+        // Created first so that the simulation ticks for this frame are known when the other systems update.
+        game::SimulationClock* simulation_clock = system_context.CreateSystem<game::SimulationClock>(game_config.simulation_tick_rate);
+
         mono::TransformSystem* transform_system = system_context.CreateSystem<mono::TransformSystem>(max_entities);
         mono::EntitySystem* entity_system =
             system_context.CreateSystem<mono::EntitySystem>(max_entities, &system_context, shared::LoadEntityFile, ComponentNameFromHash);
@@ -157,16 +186,54 @@ int main(int argc, char* argv[])
         system_context.CreateSystem<mono::RoadSystem>(max_entities);
         system_context.CreateSystem<mono::LightSystem>(max_entities);
 
+        game::EntityPoolSystem* entity_pool_system = system_context.CreateSystem<game::EntityPoolSystem>(entity_system, &system_context);
+
+        // Updates the game systems below, where they would have been updated in the system order.
+        const uint32_t n_worker_threads = std::clamp(std::thread::hardware_concurrency(), 2u, 4u) - 1;
+        game::SystemScheduler* system_scheduler = system_context.CreateSystem<game::SystemScheduler>(n_worker_threads);
+
+        game::TimerSystem* timer_system =
+            system_context.CreateSystem<game::TimerSystem>(max_entities, simulation_clock);
         game::DamageSystem* damage_system =
-            system_context.CreateSystem<game::DamageSystem>(max_entities, entity_system, &event_handler);
+            system_context.CreateSystem<game::DamageSystem>(max_entities, entity_system, entity_pool_system, &event_handler);
         game::TriggerSystem* trigger_system =
-            system_context.CreateSystem<game::TriggerSystem>(max_entities, damage_system, physics_system, entity_system);
-        system_context.CreateSystem<game::EntityLogicSystem>(max_entities);
-        system_context.CreateSystem<game::SpawnSystem>(max_entities, trigger_system, entity_system, transform_system);
-        system_context.CreateSystem<game::PickupSystem>(max_entities, physics_system, entity_system);
-        system_context.CreateSystem<game::AnimationSystem>(max_entities, trigger_system, transform_system, sprite_system);
-        system_context.CreateSystem<game::CameraSystem>(max_entities, &camera, transform_system, &event_handler, trigger_system);
-        system_context.CreateSystem<game::InteractionSystem>(max_entities, transform_system, trigger_system);
+            system_context.CreateSystem<game::TriggerSystem>(max_entities, damage_system, physics_system, entity_system, timer_system);
+        game::EntityLogicSystem* logic_system =
+            system_context.CreateSystem<game::EntityLogicSystem>(max_entities, simulation_clock);
+        game::ProjectileSystem* projectile_system =
+            system_context.CreateSystem<game::ProjectileSystem>(max_projectiles, physics_system, simulation_clock);
+        game::SpawnSystem* spawn_system =
+            system_context.CreateSystem<game::SpawnSystem>(
+                max_entities,
+                trigger_system,
+                entity_pool_system,
+                entity_system,
+                transform_system,
+                timer_system,
+                system_scheduler,
+                simulation_clock);
+        game::ShockwaveSystem* shockwave_system =
+            system_context.CreateSystem<game::ShockwaveSystem>(physics_system, damage_system);
+        game::PickupSystem* pickup_system =
+            system_context.CreateSystem<game::PickupSystem>(max_entities, physics_system, entity_pool_system);
+        game::AnimationSystem* animation_system =
+            system_context.CreateSystem<game::AnimationSystem>(max_entities, trigger_system, transform_system, sprite_system);
+        game::CameraSystem* camera_system =
+            system_context.CreateSystem<game::CameraSystem>(max_entities, &camera, transform_system, &event_handler, trigger_system);
+        game::InteractionSystem* interaction_system =
+            system_context.CreateSystem<game::InteractionSystem>(max_entities, transform_system, trigger_system);
+
+        system_scheduler->AddSystem(timer_system);
+        system_scheduler->AddSystem(damage_system);
+        system_scheduler->AddSystem(trigger_system);
+        system_scheduler->AddSystem(logic_system);
+        system_scheduler->AddSystem(projectile_system);
+        system_scheduler->AddSystem(spawn_system);
+        system_scheduler->AddSystem(shockwave_system);
+        system_scheduler->AddSystem(pickup_system);
+        system_scheduler->AddSystem(animation_system);
+        system_scheduler->AddSystem(camera_system);
+        system_scheduler->AddSystem(interaction_system);
 
         system_context.CreateSystem<game::ServerManager>(&event_handler, &game_config);
         system_context.CreateSystem<game::ClientManager>(&event_handler, &game_config);
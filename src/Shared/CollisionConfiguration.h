@@ -16,9 +16,12 @@ namespace shared
         PROPS = 16,
         PICKUPS = 32,
         STATIC = 64,
+        TRIGGER = 128,
         ALL = (~(uint32_t)0)
     };
 
+    // Area trigger sensors have a category of their own, the bullets are swept through the space and never
+    // collide with them.
     constexpr uint32_t STATIC_MASK =
         CollisionCategory::PLAYER |
         CollisionCategory::PLAYER_BULLET |
@@ -32,7 +35,8 @@ namespace shared
         CollisionCategory::ENEMY_BULLET |
         CollisionCategory::PROPS |
         CollisionCategory::PICKUPS |
-        CollisionCategory::STATIC;
+        CollisionCategory::STATIC |
+        CollisionCategory::TRIGGER;
 
     constexpr uint32_t PLAYER_BULLET_MASK =
         CollisionCategory::ENEMY |
@@ -44,7 +48,8 @@ namespace shared
         CollisionCategory::PLAYER_BULLET |
         CollisionCategory::ENEMY |
         CollisionCategory::PROPS |
-        CollisionCategory::STATIC;
+        CollisionCategory::STATIC |
+        CollisionCategory::TRIGGER;
 
     constexpr uint32_t ENEMY_BULLET_MASK =
         CollisionCategory::PLAYER |
@@ -57,10 +62,12 @@ namespace shared
         CollisionCategory::ENEMY |
         CollisionCategory::ENEMY_BULLET |
         CollisionCategory::PROPS |
-        CollisionCategory::STATIC;
+        CollisionCategory::STATIC |
+        CollisionCategory::TRIGGER;
 
     constexpr uint32_t PICKUPS_MASK =
-        CollisionCategory::PLAYER;
+        CollisionCategory::PLAYER |
+        CollisionCategory::TRIGGER;
 
 
     struct FactionPair
@@ -111,6 +118,8 @@ namespace shared
             return "Pickups";
         case CollisionCategory::STATIC:
             return "Static";
+        case CollisionCategory::TRIGGER:
+            return "Trigger";
         case CollisionCategory::ALL:
             return "All";
         };
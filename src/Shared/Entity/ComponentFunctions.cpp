@@ -13,6 +13,100 @@
 #include "EntitySystem/IEntityManager.h"
 
 #include "Component.h"
+#include "ComponentSchema.h"
+
+using namespace shared;
+
+namespace
+{
+    struct TransformData
+    {
+        math::Vector position;
+        float rotation;
+    };
+
+    const ComponentSchema<TransformData>& TransformSchema()
+    {
+        static const ComponentSchema<TransformData> schema(TRANSFORM_COMPONENT, {
+            Field<&TransformData::position>(POSITION_ATTRIBUTE),
+            Field<&TransformData::rotation>(ROTATION_ATTRIBUTE),
+        });
+        return schema;
+    }
+
+    struct SpriteData
+    {
+        std::string sprite_file;
+        mono::Color::RGBA shade;
+        int animation_id;
+        uint32_t properties;
+        math::Vector shadow_offset;
+        float shadow_size;
+        int layer;
+        float sort_offset;
+        bool random_start_frame;
+    };
+
+    const ComponentSchema<SpriteData>& SpriteSchema()
+    {
+        static const ComponentSchema<SpriteData> schema(SPRITE_COMPONENT, {
+            Field<&SpriteData::sprite_file>(SPRITE_ATTRIBUTE, FallbackMode::REQUIRE_ATTRIBUTE),
+            Field<&SpriteData::animation_id>(ANIMATION_ATTRIBUTE),
+            Field<&SpriteData::layer>(LAYER_ATTRIBUTE),
+            Field<&SpriteData::sort_offset>(SORT_OFFSET_ATTRIBUTE),
+            Field<&SpriteData::shade>(COLOR_ATTRIBUTE),
+            Field<&SpriteData::properties>(SPRITE_PROPERTIES_ATTRIBUTE),
+            Field<&SpriteData::shadow_offset>(SHADOW_OFFSET_ATTRIBUTE),
+            Field<&SpriteData::shadow_size>(SHADOW_SIZE_ATTRIBUTE),
+            Field<&SpriteData::random_start_frame>(RANDOM_START_FRAME_ATTRIBUTE),
+        });
+        return schema;
+    }
+
+    const ComponentSchema<mono::TextComponent>& TextSchema()
+    {
+        static const ComponentSchema<mono::TextComponent> schema(TEXT_COMPONENT, {
+            Field<&mono::TextComponent::text>(TEXT_ATTRIBUTE),
+            Field<&mono::TextComponent::font_id>(FONT_ID_ATTRIBUTE),
+            Field<&mono::TextComponent::tint>(COLOR_ATTRIBUTE),
+            Field<&mono::TextComponent::center_flags>(CENTER_FLAGS_ATTRIBUTE),
+            Field<&mono::TextComponent::draw_shadow>(TEXT_SHADOW_ATTRIBUTE),
+        });
+        return schema;
+    }
+
+    const ComponentSchema<mono::PathComponent>& PathSchema()
+    {
+        // The points have no default, a path without points stays empty.
+        static const ComponentSchema<mono::PathComponent> schema(PATH_COMPONENT, {
+            Field<&mono::PathComponent::type>(PATH_TYPE_ATTRIBUTE),
+            Field<&mono::PathComponent::points>(PATH_POINTS_ATTRIBUTE, FallbackMode::REQUIRE_ATTRIBUTE),
+            Field<&mono::PathComponent::closed>(PATH_CLOSED_ATTRIBUTE),
+        });
+        return schema;
+    }
+
+    const ComponentSchema<mono::RoadComponent>& RoadSchema()
+    {
+        static const ComponentSchema<mono::RoadComponent> schema(ROAD_COMPONENT, {
+            Field<&mono::RoadComponent::width>(WIDTH_ATTRIBUTE),
+            Field<&mono::RoadComponent::texture_name>(TEXTURE_ATTRIBUTE),
+        });
+        return schema;
+    }
+
+    const ComponentSchema<mono::LightComponent>& LightSchema()
+    {
+        static const ComponentSchema<mono::LightComponent> schema(LIGHT_COMPONENT, {
+            Field<&mono::LightComponent::radius>(RADIUS_ATTRIBUTE),
+            Field<&mono::LightComponent::shade>(COLOR_ATTRIBUTE),
+            Field<&mono::LightComponent::flicker>(FLICKER_ATTRIBUTE),
+            Field<&mono::LightComponent::flicker_frequencey>(FREQUENCY_ATTRIBUTE),
+            Field<&mono::LightComponent::flicker_percentage>(PERCENTAGE_ATTRIBUTE),
+        });
+        return schema;
+    }
+}
 
 bool CreateTransform(mono::Entity* entity, mono::SystemContext* context)
 {
@@ -27,17 +121,12 @@ bool ReleaseTransform(mono::Entity* entity, mono::SystemContext* context)
     return true;
 }
 
-bool UpdateTransform(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+bool UpdateTransform(mono::Entity* entity, const TransformData& data, mono::SystemContext* context)
 {
-    math::Vector position;
-    float rotation = 0.0f;
-    FindAttribute(POSITION_ATTRIBUTE, properties, position, FallbackMode::SET_DEFAULT);
-    FindAttribute(ROTATION_ATTRIBUTE, properties, rotation, FallbackMode::SET_DEFAULT);
-
     mono::TransformSystem* transform_system = context->GetSystem<mono::TransformSystem>();
     math::Matrix& transform = transform_system->GetTransform(entity->id);
-    transform = math::CreateMatrixFromZRotation(rotation);
-    math::Position(transform, position);
+    transform = math::CreateMatrixFromZRotation(data.rotation);
+    math::Position(transform, data.position);
 
     return true;
 }
@@ -67,34 +156,25 @@ bool ReleaseSprite(mono::Entity* entity, mono::SystemContext* context)
     return true;
 }
 
-bool UpdateSprite(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+bool UpdateSprite(mono::Entity* entity, const SpriteData& data, mono::SystemContext* context)
 {
-    std::string sprite_file;
     mono::SpriteComponents sprite_args;
-
-    const bool success = FindAttribute(SPRITE_ATTRIBUTE, properties, sprite_file, FallbackMode::REQUIRE_ATTRIBUTE);
-    if(!success)
-    {
-        System::Log("ComponentFunctions|Missing sprite parameters, unable to update component");
-        return false;
-    }
-    
-    FindAttribute(COLOR_ATTRIBUTE, properties, sprite_args.shade, FallbackMode::SET_DEFAULT);
-    FindAttribute(ANIMATION_ATTRIBUTE, properties, sprite_args.animation_id, FallbackMode::SET_DEFAULT);
-    FindAttribute(SPRITE_PROPERTIES_ATTRIBUTE, properties, sprite_args.properties, FallbackMode::SET_DEFAULT);
-    FindAttribute(SHADOW_OFFSET_ATTRIBUTE, properties, sprite_args.shadow_offset, FallbackMode::SET_DEFAULT);
-    FindAttribute(SHADOW_SIZE_ATTRIBUTE, properties, sprite_args.shadow_size, FallbackMode::SET_DEFAULT);
-    FindAttribute(LAYER_ATTRIBUTE, properties, sprite_args.layer, FallbackMode::SET_DEFAULT);
-    FindAttribute(SORT_OFFSET_ATTRIBUTE, properties, sprite_args.sort_offset, FallbackMode::SET_DEFAULT);
-    FindAttribute(RANDOM_START_FRAME_ATTRIBUTE, properties, sprite_args.random_start_frame, FallbackMode::SET_DEFAULT);
+    sprite_args.shade = data.shade;
+    sprite_args.animation_id = data.animation_id;
+    sprite_args.properties = data.properties;
+    sprite_args.shadow_offset = data.shadow_offset;
+    sprite_args.shadow_size = data.shadow_size;
+    sprite_args.layer = data.layer;
+    sprite_args.sort_offset = data.sort_offset;
+    sprite_args.random_start_frame = data.random_start_frame;
 
     char sprite_path[1024] = { 0 };
-    std::sprintf(sprite_path, "res/sprites/%s", sprite_file.c_str());
+    std::sprintf(sprite_path, "res/sprites/%s", data.sprite_file.c_str());
     sprite_args.sprite_file = sprite_path;
 
     mono::SpriteSystem* sprite_system = context->GetSystem<mono::SpriteSystem>();
     sprite_system->SetSpriteData(entity->id, sprite_args);
-    return success;
+    return true;
 }
 
 bool CreateText(mono::Entity* entity, mono::SystemContext* context)
@@ -111,16 +191,8 @@ bool ReleaseText(mono::Entity* entity, mono::SystemContext* context)
     return true;
 }
 
-bool UpdateText(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+bool UpdateText(mono::Entity* entity, const mono::TextComponent& text_component, mono::SystemContext* context)
 {
-    mono::TextComponent text_component;
-
-    FindAttribute(TEXT_ATTRIBUTE, properties, text_component.text, FallbackMode::SET_DEFAULT);
-    FindAttribute(FONT_ID_ATTRIBUTE, properties, text_component.font_id, FallbackMode::SET_DEFAULT);
-    FindAttribute(COLOR_ATTRIBUTE, properties, text_component.tint, FallbackMode::SET_DEFAULT);
-    FindAttribute(CENTER_FLAGS_ATTRIBUTE, properties, (uint32_t&)text_component.center_flags, FallbackMode::SET_DEFAULT);
-    FindAttribute(TEXT_SHADOW_ATTRIBUTE, properties, text_component.draw_shadow, FallbackMode::SET_DEFAULT);
-
     mono::TextSystem* text_system = context->GetSystem<mono::TextSystem>();
     text_system->SetTextData(entity->id, text_component);
 
@@ -143,14 +215,8 @@ bool ReleasePath(mono::Entity* entity, mono::SystemContext* context)
 
 bool UpdatePath(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
 {
-    int path_type;
-    FindAttribute(PATH_TYPE_ATTRIBUTE, properties, path_type, FallbackMode::SET_DEFAULT);
-
     mono::PathComponent component;
-    component.type = mono::PathType(path_type);
-
-    FindAttribute(PATH_POINTS_ATTRIBUTE, properties, component.points, FallbackMode::REQUIRE_ATTRIBUTE);
-    FindAttribute(PATH_CLOSED_ATTRIBUTE, properties, component.closed, FallbackMode::SET_DEFAULT);
+    PathSchema().ReadFields(properties, component);
 
     mono::PathSystem* path_system = context->GetSystem<mono::PathSystem>();
     path_system->SetPathData(entity->id, component);
@@ -172,12 +238,8 @@ bool ReleaseRoad(mono::Entity* entity, mono::SystemContext* context)
     return true;
 }
 
-bool UpdateRoad(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+bool UpdateRoad(mono::Entity* entity, const mono::RoadComponent& component, mono::SystemContext* context)
 {
-    mono::RoadComponent component;
-    FindAttribute(WIDTH_ATTRIBUTE, properties, component.width, FallbackMode::SET_DEFAULT);
-    FindAttribute(TEXTURE_ATTRIBUTE, properties, component.texture_name, FallbackMode::SET_DEFAULT);
-
     mono::RoadSystem* road_system = context->GetSystem<mono::RoadSystem>();
     road_system->SetData(entity->id, component);
 
@@ -198,15 +260,8 @@ bool ReleaseLight(mono::Entity* entity, mono::SystemContext* context)
     return true;
 }
 
-bool UpdateLight(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+bool UpdateLight(mono::Entity* entity, const mono::LightComponent& component, mono::SystemContext* context)
 {
-    mono::LightComponent component;
-    FindAttribute(RADIUS_ATTRIBUTE, properties, component.radius, FallbackMode::SET_DEFAULT);
-    FindAttribute(COLOR_ATTRIBUTE, properties, component.shade, FallbackMode::SET_DEFAULT);
-    FindAttribute(FLICKER_ATTRIBUTE, properties, component.flicker, FallbackMode::SET_DEFAULT);
-    FindAttribute(FREQUENCY_ATTRIBUTE, properties, component.flicker_frequencey, FallbackMode::SET_DEFAULT);
-    FindAttribute(PERCENTAGE_ATTRIBUTE, properties, component.flicker_percentage, FallbackMode::SET_DEFAULT);
-
     mono::LightSystem* light_system = context->GetSystem<mono::LightSystem>();
     light_system->SetData(entity->id, component);
 
@@ -215,10 +270,11 @@ bool UpdateLight(mono::Entity* entity, const std::vector<Attribute>& properties,
 
 void shared::RegisterSharedComponents(mono::IEntityManager* entity_manager)
 {
-    entity_manager->RegisterComponent(TRANSFORM_COMPONENT, CreateTransform, ReleaseTransform, UpdateTransform, GetTransform);
-    entity_manager->RegisterComponent(SPRITE_COMPONENT, CreateSprite, ReleaseSprite, UpdateSprite);
-    entity_manager->RegisterComponent(TEXT_COMPONENT, CreateText, ReleaseText, UpdateText);
+    entity_manager->RegisterComponent(
+        TRANSFORM_COMPONENT, CreateTransform, ReleaseTransform, UpdateComponent<TransformSchema, UpdateTransform>, GetTransform);
+    entity_manager->RegisterComponent(SPRITE_COMPONENT, CreateSprite, ReleaseSprite, UpdateComponent<SpriteSchema, UpdateSprite>);
+    entity_manager->RegisterComponent(TEXT_COMPONENT, CreateText, ReleaseText, UpdateComponent<TextSchema, UpdateText>);
     entity_manager->RegisterComponent(PATH_COMPONENT, CreatePath, ReleasePath, UpdatePath);
-    entity_manager->RegisterComponent(ROAD_COMPONENT, CreateRoad, ReleaseRoad, UpdateRoad);
-    entity_manager->RegisterComponent(LIGHT_COMPONENT, CreateLight, ReleaseLight, UpdateLight);
+    entity_manager->RegisterComponent(ROAD_COMPONENT, CreateRoad, ReleaseRoad, UpdateComponent<RoadSchema, UpdateRoad>);
+    entity_manager->RegisterComponent(LIGHT_COMPONENT, CreateLight, ReleaseLight, UpdateComponent<LightSchema, UpdateLight>);
 }
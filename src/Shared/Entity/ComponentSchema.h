@@ -0,0 +1,208 @@
+
+#pragma once
+
+#include "MonoFwd.h"
+#include "Component.h"
+#include "System/Hash.h"
+#include "System/System.h"
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <type_traits>
+#include <initializer_list>
+#include <cassert>
+
+namespace shared
+{
+    // A string attribute that is only used as a hash, like a trigger name. The string is hashed in place when the
+    // component is read, never copied.
+    struct StringHash
+    {
+        uint32_t value = 0;
+    };
+
+    template <typename T>
+    struct SchemaField
+    {
+        uint32_t attribute;
+        FallbackMode fallback_mode;
+        bool (*read)(T& data, const Variant& value);
+    };
+
+    namespace detail
+    {
+        template <typename T>
+        struct MemberTraits;
+
+        template <typename C, typename M>
+        struct MemberTraits<M C::*>
+        {
+            using Class = C;
+            using Type = M;
+        };
+
+        template <auto member>
+        bool ReadMember(typename MemberTraits<decltype(member)>::Class& data, const Variant& value)
+        {
+            using Type = typename MemberTraits<decltype(member)>::Type;
+
+            if constexpr(std::is_same_v<Type, StringHash>)
+            {
+                const std::string* string = std::get_if<std::string>(&value);
+                if(!string)
+                    return false;
+
+                (data.*member).value = hash::Hash(string->c_str());
+                hash::HashRegisterString(string->c_str());
+                return true;
+            }
+            else if constexpr(std::is_enum_v<Type>)
+            {
+                // Enums are stored as int or uint32_t, depending on the attribute.
+                if(const int* int_value = std::get_if<int>(&value))
+                    data.*member = Type(*int_value);
+                else if(const uint32_t* uint_value = std::get_if<uint32_t>(&value))
+                    data.*member = Type(*uint_value);
+                else
+                    return false;
+
+                return true;
+            }
+            else
+            {
+                const Type* typed_value = std::get_if<Type>(&value);
+                if(!typed_value)
+                    return false;
+
+                data.*member = *typed_value;
+                return true;
+            }
+        }
+    }
+
+    // Binds an attribute to a member, the member type has to be the variant type of the attribute, an enum or a
+    // StringHash for string attributes.
+    template <auto member>
+    inline SchemaField<typename detail::MemberTraits<decltype(member)>::Class> Field(
+        uint32_t attribute, FallbackMode fallback_mode = FallbackMode::SET_DEFAULT)
+    {
+        return { attribute, fallback_mode, detail::ReadMember<member> };
+    }
+
+    // The attributes of a component read into a plain struct. The attribute hashes and defaults are resolved once
+    // when the schema is created, reading a component is a copy of the defaults and one pass over the properties.
+    template <typename T>
+    class ComponentSchema
+    {
+    public:
+
+        using DataType = T;
+
+        ComponentSchema(uint32_t component_hash, std::initializer_list<SchemaField<T>> fields)
+            : m_component_hash(component_hash)
+            , m_fields(fields)
+            , m_defaults{}
+            , m_required_mask(0)
+        {
+            assert(m_fields.size() <= 32);
+
+            for(uint32_t index = 0; index < m_fields.size(); ++index)
+            {
+                const SchemaField<T>& field = m_fields[index];
+                if(field.fallback_mode == FallbackMode::REQUIRE_ATTRIBUTE)
+                    m_required_mask |= (1u << index);
+                else
+                    field.read(m_defaults, DefaultAttributeFromHash(field.attribute));
+            }
+        }
+
+        // Returns a mask with a bit set for each field found in the properties, in the order of the fields.
+        uint32_t ReadFields(const std::vector<Attribute>& properties, T& out) const
+        {
+            out = m_defaults;
+
+            uint32_t found_mask = 0;
+            uint32_t field_index = 0;
+            const uint32_t n_fields = m_fields.size();
+
+            // The properties are usually in the same order as the fields, so the search starts after the last match.
+            for(const Attribute& attribute : properties)
+            {
+                for(uint32_t count = 0; count < n_fields; ++count)
+                {
+                    const SchemaField<T>& field = m_fields[field_index];
+                    const uint32_t field_bit = (1u << field_index);
+
+                    field_index = (field_index + 1) % n_fields;
+
+                    if(field.attribute != attribute.id)
+                        continue;
+
+                    if(!(found_mask & field_bit) && field.read(out, attribute.value))
+                        found_mask |= field_bit;
+
+                    break;
+                }
+            }
+
+            return found_mask;
+        }
+
+        // Returns false if a required attribute is missing.
+        bool Read(const std::vector<Attribute>& properties, T& out) const
+        {
+            const uint32_t found_mask = ReadFields(properties, out);
+            const uint32_t missing_mask = m_required_mask & ~found_mask;
+
+            for(uint32_t index = 0; missing_mask != 0 && index < m_fields.size(); ++index)
+            {
+                if(missing_mask & (1u << index))
+                {
+                    System::Log(
+                        "ComponentSchema|Missing attribute '%s' in component '%s', unable to update component",
+                        AttributeNameFromHash(m_fields[index].attribute),
+                        ComponentNameFromHash(m_component_hash));
+                }
+            }
+
+            return (missing_mask == 0);
+        }
+
+        uint32_t FieldMask(uint32_t attribute) const
+        {
+            uint32_t mask = 0;
+            for(uint32_t index = 0; index < m_fields.size(); ++index)
+            {
+                if(m_fields[index].attribute == attribute)
+                    mask |= (1u << index);
+            }
+
+            return mask;
+        }
+
+    private:
+
+        const uint32_t m_component_hash;
+        const std::vector<SchemaField<T>> m_fields;
+        T m_defaults;
+        uint32_t m_required_mask;
+    };
+
+    // Adapts a typed update function to the entity manager, the schema function returns the schema of the
+    // component.
+    //
+    //      entity_manager->RegisterComponent(LIGHT_COMPONENT, CreateLight, ReleaseLight, UpdateComponent<LightSchema, UpdateLight>);
+    //
+    template <auto schema, auto update>
+    inline bool UpdateComponent(mono::Entity* entity, const std::vector<Attribute>& properties, mono::SystemContext* context)
+    {
+        using DataType = typename std::decay_t<decltype(schema())>::DataType;
+
+        DataType data;
+        if(!schema().Read(properties, data))
+            return false;
+
+        return update(entity, data, context);
+    }
+}
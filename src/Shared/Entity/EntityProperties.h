@@ -8,11 +8,13 @@ enum EntityProperties : uint32_t
 {
     REPLICATE = 1,
     CTF_FLAG = 2,
+    LOCAL = 4,
 };
 
 static const std::vector<uint32_t> all_entity_properties = {
     EntityProperties::REPLICATE,
     EntityProperties::CTF_FLAG,
+    EntityProperties::LOCAL,
 };
 
 inline const char* EntityPropertyToString(uint32_t property)
@@ -23,6 +25,8 @@ inline const char* EntityPropertyToString(uint32_t property)
         return "Replicate";
     case CTF_FLAG:
         return "CTF Flag";
+    case LOCAL:
+        return "Local";
     }
 
     return "Unknown";
@@ -5,36 +5,136 @@
 #include "Serialize.h"
 
 #include "System/File.h"
+#include "System/Hash.h"
 #include "nlohmann/json.hpp"
 
-mono::EntityData shared::LoadEntityFile(const char* entity_file)
+#include <unordered_map>
+#include <filesystem>
+#include <mutex>
+#include <string>
+
+namespace
 {
-    file::FilePtr file = file::OpenAsciiFile(entity_file);
-    if(!file)
-        return { };
+    struct EntityTemplate
+    {
+        mono::EntityData entity_data;
+        std::filesystem::file_time_type write_time;
+    };
+
+    std::unordered_map<uint32_t, EntityTemplate> g_entity_templates;
+    std::mutex g_entity_templates_mutex;
+    bool g_reload_changed_files = false;
+
+    std::filesystem::file_time_type FileWriteTime(const char* entity_file)
+    {
+        std::error_code error;
+        const std::filesystem::file_time_type write_time = std::filesystem::last_write_time(entity_file, error);
+        return error ? std::filesystem::file_time_type() : write_time;
+    }
+
+    bool ParseEntityFile(const char* entity_file, mono::EntityData& entity_data)
+    {
+        file::FilePtr file = file::OpenAsciiFile(entity_file);
+        if(!file)
+            return false;
 
-    std::vector<byte> file_data = file::FileRead(file);
-    file_data.push_back('\0');
+        std::vector<byte> file_data = file::FileRead(file);
+        file_data.push_back('\0');
 
-    const nlohmann::json& json = nlohmann::json::parse((const char*)file_data.data());
-    //const nlohmann::json& entities = json["entities"];
-    const nlohmann::json& first_entity = json["entities"][0];
+        const nlohmann::json& json = nlohmann::json::parse((const char*)file_data.data());
+        //const nlohmann::json& entities = json["entities"];
+        const nlohmann::json& first_entity = json["entities"][0];
 
-    mono::EntityData entity_data;
-    entity_data.entity_uuid = first_entity.value("uuid_hash", 0);
-    entity_data.entity_name = first_entity.value("name", "Unnamed");
-    entity_data.entity_properties = first_entity.value("entity_properties", 0);
+        entity_data.entity_uuid = first_entity.value("uuid_hash", 0);
+        entity_data.entity_name = first_entity.value("name", "Unnamed");
+        entity_data.entity_properties = first_entity.value("entity_properties", 0);
 
-    for(const nlohmann::json& component : first_entity["components"])
+        for(const nlohmann::json& component : first_entity["components"])
+        {
+            mono::ComponentData component_data;
+            component_data.name = component["name"];
+
+            std::vector<Attribute> loaded_properties;
+            for(const nlohmann::json& property : component["properties"])
+                loaded_properties.push_back(property);
+
+            // Unknown components keep only what is in the file.
+            const Component default_component = DefaultComponentFromHash(hash::Hash(component_data.name.c_str()));
+            component_data.properties = default_component.properties;
+            MergeAttributes(component_data.properties, loaded_properties);
+
+            entity_data.entity_components.push_back(std::move(component_data));
+        }
+
+        return true;
+    }
+
+    const EntityTemplate* FindOrLoadTemplate(const char* entity_file)
     {
-        mono::ComponentData component_data;
-        component_data.name = component["name"];
+        const uint32_t file_hash = hash::Hash(entity_file);
+
+        const auto it = g_entity_templates.find(file_hash);
+        if(it != g_entity_templates.end())
+        {
+            const bool is_current = !g_reload_changed_files || it->second.write_time == FileWriteTime(entity_file);
+            if(is_current)
+                return &it->second;
+        }
+
+        EntityTemplate entity_template;
+        if(!ParseEntityFile(entity_file, entity_template.entity_data))
+            return nullptr;
 
-        for(const nlohmann::json& property : component["properties"])
-            component_data.properties.push_back(property);
+        entity_template.write_time = FileWriteTime(entity_file);
 
-        entity_data.entity_components.push_back(std::move(component_data));
+        EntityTemplate& stored_template = g_entity_templates[file_hash];
+        stored_template = std::move(entity_template);
+        return &stored_template;
     }
+}
+
+mono::EntityData shared::LoadEntityFile(const char* entity_file)
+{
+    std::lock_guard<std::mutex> lock(g_entity_templates_mutex);
+
+    const EntityTemplate* entity_template = FindOrLoadTemplate(entity_file);
+    if(!entity_template)
+        return { };
+
+    return entity_template->entity_data;
+}
+
+std::vector<std::string> shared::ReadEntityFileList(const char* all_entities_file)
+{
+    std::vector<std::string> entity_files;
+
+    file::FilePtr file = file::OpenAsciiFile(all_entities_file);
+    if(!file)
+        return entity_files;
+
+    const std::vector<byte> file_data = file::FileRead(file);
+    const nlohmann::json& json = nlohmann::json::parse(file_data);
 
-    return entity_data;
+    for(const auto& list_entry : json["all_entities"])
+        entity_files.push_back(list_entry);
+
+    return entity_files;
+}
+
+void shared::PreloadEntityFile(const char* entity_file)
+{
+    std::lock_guard<std::mutex> lock(g_entity_templates_mutex);
+    FindOrLoadTemplate(entity_file);
+}
+
+void shared::SetEntityFileReload(bool enable)
+{
+    std::lock_guard<std::mutex> lock(g_entity_templates_mutex);
+    g_reload_changed_files = enable;
+}
+
+void shared::ClearEntityFileCache()
+{
+    std::lock_guard<std::mutex> lock(g_entity_templates_mutex);
+    g_entity_templates.clear();
 }
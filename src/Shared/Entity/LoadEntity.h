@@ -3,7 +3,26 @@
 
 #include "EntitySystem/IEntityManager.h"
 
+#include <string>
+#include <vector>
+
 namespace shared
 {
+    // Returns the entity template for the file, the file is read and parsed the first time and the template is
+    // cached on the filename hash. The components in the template have their attributes merged with the defaults.
     mono::EntityData LoadEntityFile(const char* entity_file);
+
+    // The entity files in the list, empty if the list could not be read.
+    std::vector<std::string> ReadEntityFileList(const char* all_entities_file);
+
+    // Loads the template for the file if it's not cached, so it's not read when an entity is created later. Load the
+    // files from ReadEntityFileList a few at a time to spread the cost over frames.
+    void PreloadEntityFile(const char* entity_file);
+
+    // When enabled the file modification time is checked on every load and changed files are parsed again,
+    // for the editor where entity files are edited while running.
+    void SetEntityFileReload(bool enable);
+
+    // Drops all templates, the game zones clear the cache when they are unloaded.
+    void ClearEntityFileCache();
 }
@@ -0,0 +1,770 @@
+
+#include "WorldFileBinary.h"
+#include "Math/Serialize.h"
+#include "Rendering/Serialize.h"
+
+#include "Component.h"
+#include "Entity/Serialize.h"
+
+#include "System/File.h"
+#include "System/System.h"
+
+#include "nlohmann/json.hpp"
+
+#include <unordered_map>
+#include <filesystem>
+#include <cstdio>
+#include <cstring>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    class StringTable
+    {
+    public:
+
+        StringTable()
+        {
+            // Offset zero is the empty string.
+            m_data.push_back('\0');
+            m_offsets[std::string()] = 0;
+        }
+
+        uint32_t Add(const std::string& text)
+        {
+            const auto it = m_offsets.find(text);
+            if(it != m_offsets.end())
+                return it->second;
+
+            const uint32_t offset = m_data.size();
+            m_data.insert(m_data.end(), text.begin(), text.end());
+            m_data.push_back('\0');
+            m_offsets[text] = offset;
+
+            return offset;
+        }
+
+        const std::vector<char>& Data() const
+        {
+            return m_data;
+        }
+
+    private:
+
+        std::vector<char> m_data;
+        std::unordered_map<std::string, uint32_t> m_offsets;
+    };
+
+    struct AttributeEncoder
+    {
+        void operator()(bool value)
+        {
+            attribute.value[0] = value ? 1 : 0;
+        }
+        void operator()(int value)
+        {
+            std::memcpy(attribute.value, &value, sizeof(value));
+        }
+        void operator()(uint32_t value)
+        {
+            attribute.value[0] = value;
+        }
+        void operator()(float value)
+        {
+            std::memcpy(attribute.value, &value, sizeof(value));
+        }
+        void operator()(const math::Vector& value)
+        {
+            const float values[] = { value.x, value.y };
+            std::memcpy(attribute.value, values, sizeof(values));
+        }
+        void operator()(const mono::Color::RGBA& value)
+        {
+            const float values[] = { value.red, value.green, value.blue, value.alpha };
+            std::memcpy(attribute.value, values, sizeof(values));
+        }
+        void operator()(const std::string& value)
+        {
+            attribute.value[0] = strings.Add(value);
+            attribute.value[1] = value.length();
+        }
+        void operator()(const std::vector<math::Vector>& value)
+        {
+            attribute.value[0] = points.size() / 2;
+            attribute.value[1] = value.size();
+
+            for(const math::Vector& point : value)
+            {
+                points.push_back(point.x);
+                points.push_back(point.y);
+            }
+        }
+
+        shared::CompiledAttribute& attribute;
+        StringTable& strings;
+        std::vector<float>& points;
+    };
+
+    template <typename T>
+    void AppendSection(std::vector<std::byte>& blob, const std::vector<T>& section, uint32_t& out_offset)
+    {
+        out_offset = blob.size();
+
+        const size_t n_bytes = section.size() * sizeof(T);
+        blob.resize(blob.size() + n_bytes);
+        if(n_bytes > 0)
+            std::memcpy(blob.data() + out_offset, section.data(), n_bytes);
+
+        // Keep the next section four byte aligned.
+        blob.resize((blob.size() + 3) & ~size_t(3));
+    }
+
+    bool InRange(uint64_t offset, uint64_t count, uint64_t element_size, uint64_t size)
+    {
+        return (offset % 4) == 0 && (offset + count * element_size) <= size;
+    }
+
+    std::filesystem::file_time_type FileWriteTime(const char* filename, std::error_code& error)
+    {
+        return std::filesystem::last_write_time(filename, error);
+    }
+
+    uint32_t HashBytes(uint32_t hash, const void* data, size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for(size_t index = 0; index < size; ++index)
+        {
+            hash ^= bytes[index];
+            hash *= 16777619u;
+        }
+
+        return hash;
+    }
+
+    template <typename T>
+    T& EmplaceOrAssign(Variant& value)
+    {
+        T* existing = std::get_if<T>(&value);
+        return existing ? *existing : value.emplace<T>();
+    }
+}
+
+std::string shared::CompiledWorldFilename(const char* world_filename)
+{
+    std::string compiled_filename = world_filename;
+
+    const size_t extension_start = compiled_filename.find_last_of('.');
+    const size_t filename_start = compiled_filename.find_last_of("/\\");
+    const bool has_extension =
+        (extension_start != std::string::npos) && (filename_start == std::string::npos || extension_start > filename_start);
+    if(has_extension)
+        compiled_filename.erase(extension_start);
+
+    return compiled_filename + ".compiled";
+}
+
+uint32_t shared::ComponentDefaultsHash()
+{
+    static const uint32_t defaults_hash = []() {
+        StringTable strings;
+        std::vector<float> points;
+        uint32_t hash = 2166136261u;
+
+        for(const Component* component : GetAllDefaultComponents())
+        {
+            const uint32_t component_values[] = { component->hash, component->depends_on, component->allow_multiple };
+            hash = HashBytes(hash, component_values, sizeof(component_values));
+
+            for(const Attribute& attribute : component->properties)
+            {
+                CompiledAttribute compiled_attribute = {};
+                compiled_attribute.id = attribute.id;
+                compiled_attribute.variant_type = attribute.value.index();
+                std::visit(AttributeEncoder { compiled_attribute, strings, points }, attribute.value);
+                hash = HashBytes(hash, &compiled_attribute, sizeof(compiled_attribute));
+            }
+        }
+
+        hash = HashBytes(hash, strings.Data().data(), strings.Data().size());
+        return HashBytes(hash, points.data(), points.size() * sizeof(float));
+    }();
+
+    return defaults_hash;
+}
+
+bool shared::IsCompiledWorldCurrent(const char* world_filename, const char* compiled_filename)
+{
+    std::error_code world_error;
+    std::error_code compiled_error;
+    const std::filesystem::file_time_type world_time = FileWriteTime(world_filename, world_error);
+    const std::filesystem::file_time_type compiled_time = FileWriteTime(compiled_filename, compiled_error);
+
+    const bool is_newer = !compiled_error && (world_error || compiled_time >= world_time);
+    if(!is_newer)
+        return false;
+
+    file::FilePtr file = file::OpenBinaryFile(compiled_filename);
+    if(!file)
+        return false;
+
+    CompiledWorldHeader header = {};
+    const bool read_header = (std::fread(&header, sizeof(header), 1, file.get()) == 1);
+
+    return
+        read_header &&
+        header.magic == COMPILED_WORLD_MAGIC &&
+        header.version == COMPILED_WORLD_VERSION &&
+        header.component_defaults_hash == ComponentDefaultsHash();
+}
+
+bool shared::CompileWorld(const char* world_filename, std::vector<std::byte>& out_blob)
+{
+    file::FilePtr file = file::OpenAsciiFile(world_filename);
+    if(!file)
+        return false;
+
+    const std::vector<byte> file_data = file::FileRead(file);
+    const nlohmann::json& json = nlohmann::json::parse(file_data);
+
+    StringTable strings;
+    std::vector<uint32_t> component_types;
+    std::vector<CompiledEntity> compiled_entities;
+    std::vector<CompiledComponent> compiled_components;
+    std::vector<CompiledAttribute> compiled_attributes;
+    std::vector<float> points;
+
+    CompiledWorldHeader header = {};
+    header.magic = COMPILED_WORLD_MAGIC;
+    header.version = COMPILED_WORLD_VERSION;
+    header.component_defaults_hash = ComponentDefaultsHash();
+
+    LevelMetadata metadata;
+    metadata.camera_position = math::ZeroVec;
+    metadata.camera_size = math::ZeroVec;
+    metadata.player_spawn_point = math::ZeroVec;
+
+    const bool has_metadata = json.contains("metadata");
+    if(has_metadata)
+    {
+        const nlohmann::json& json_metadata = json["metadata"];
+        metadata.camera_position = json_metadata.value("camera_position", math::ZeroVec);
+        metadata.camera_size = json_metadata.value("camera_size", math::ZeroVec);
+        metadata.player_spawn_point = json_metadata.value("player_spawn_point", math::ZeroVec);
+        metadata.background_color = json_metadata.value("background_color", mono::Color::BLACK);
+        metadata.ambient_shade = json_metadata.value("ambient_shade", mono::Color::WHITE);
+        metadata.background_texture = json_metadata.value("background_texture", "");
+    }
+
+    const auto write_vector = [](const math::Vector& vector, float* out_values) {
+        out_values[0] = vector.x;
+        out_values[1] = vector.y;
+    };
+    const auto write_color = [](const mono::Color::RGBA& color, float* out_values) {
+        out_values[0] = color.red;
+        out_values[1] = color.green;
+        out_values[2] = color.blue;
+        out_values[3] = color.alpha;
+    };
+
+    write_vector(metadata.camera_position, header.camera_position);
+    write_vector(metadata.camera_size, header.camera_size);
+    write_vector(metadata.player_spawn_point, header.player_spawn_point);
+    write_color(metadata.background_color, header.background_color);
+    write_color(metadata.ambient_shade, header.ambient_shade);
+    header.background_texture = strings.Add(metadata.background_texture);
+
+    const auto component_type_index = [&component_types](uint32_t component_hash) -> uint32_t {
+        const auto it = std::find(component_types.begin(), component_types.end(), component_hash);
+        if(it != component_types.end())
+            return std::distance(component_types.begin(), it);
+
+        component_types.push_back(component_hash);
+        return component_types.size() - 1;
+    };
+
+    for(const nlohmann::json& json_entity : json["entities"])
+    {
+        const std::string& entity_name = json_entity["name"];
+
+        CompiledEntity compiled_entity = {};
+        compiled_entity.name = strings.Add(entity_name);
+        compiled_entity.folder = strings.Add(json_entity.value("folder", ""));
+        compiled_entity.entity_properties = json_entity["entity_properties"];
+        compiled_entity.first_component = compiled_components.size();
+
+        if(json_entity.contains("uuid_hash"))
+        {
+            compiled_entity.uuid_hash = json_entity["uuid_hash"];
+            compiled_entity.flags |= HAS_UUID;
+        }
+
+        std::vector<Component> components;
+
+        for(const nlohmann::json& json_component : json_entity["components"])
+        {
+            const uint32_t component_hash = json_component["hash"];
+
+            std::vector<Attribute> loaded_properties;
+            for(const nlohmann::json& property : json_component["properties"])
+                loaded_properties.push_back(property);
+
+            Component component = DefaultComponentFromHash(component_hash);
+            component.hash = component_hash;
+            MergeAttributes(component.properties, loaded_properties);
+            components.push_back(std::move(component));
+        }
+
+        // Patch the exported entities to have name and folder component, remove later.
+        if(!FindComponentFromHash(NAME_FOLDER_COMPONENT, components))
+        {
+            Component name_folder_component = DefaultComponentFromHash(NAME_FOLDER_COMPONENT);
+            SetAttribute(NAME_ATTRIBUTE, name_folder_component.properties, entity_name);
+            components.push_back(name_folder_component);
+            compiled_entity.flags |= PATCHED_NAME_FOLDER;
+        }
+
+        for(const Component& component : components)
+        {
+            CompiledComponent compiled_component;
+            compiled_component.type_index = component_type_index(component.hash);
+            compiled_component.first_attribute = compiled_attributes.size();
+            compiled_component.n_attributes = component.properties.size();
+            compiled_components.push_back(compiled_component);
+
+            for(const Attribute& attribute : component.properties)
+            {
+                CompiledAttribute compiled_attribute = {};
+                compiled_attribute.id = attribute.id;
+                compiled_attribute.variant_type = attribute.value.index();
+                std::visit(AttributeEncoder { compiled_attribute, strings, points }, attribute.value);
+                compiled_attributes.push_back(compiled_attribute);
+            }
+        }
+
+        compiled_entity.n_components = components.size();
+        compiled_entities.push_back(compiled_entity);
+    }
+
+    header.n_component_types = component_types.size();
+    header.n_entities = compiled_entities.size();
+    header.n_components = compiled_components.size();
+    header.n_attributes = compiled_attributes.size();
+    header.n_points = points.size() / 2;
+    header.strings_size = strings.Data().size();
+
+    std::vector<std::byte>& blob = out_blob;
+    blob.assign(sizeof(CompiledWorldHeader), std::byte(0));
+    AppendSection(blob, component_types, header.component_types_offset);
+    AppendSection(blob, compiled_entities, header.entities_offset);
+    AppendSection(blob, compiled_components, header.components_offset);
+    AppendSection(blob, compiled_attributes, header.attributes_offset);
+    AppendSection(blob, points, header.points_offset);
+    AppendSection(blob, strings.Data(), header.strings_offset);
+
+    header.file_size = blob.size();
+    std::memcpy(blob.data(), &header, sizeof(header));
+
+    return true;
+}
+
+bool shared::CompileWorldFile(const char* world_filename, const char* compiled_filename)
+{
+    std::vector<std::byte> blob;
+    if(!CompileWorld(world_filename, blob))
+        return false;
+
+    file::FilePtr compiled_file = file::CreateBinaryFile(compiled_filename);
+    if(!compiled_file)
+        return false;
+
+    const size_t written = std::fwrite(blob.data(), 1, blob.size(), compiled_file.get());
+    if(written != blob.size())
+        return false;
+
+    System::Log(
+        "WorldFile|Compiled '%s' to '%s', %zu bytes.", world_filename, compiled_filename, blob.size());
+
+    return true;
+}
+
+int shared::CompileAllWorlds(const char* all_worlds_file)
+{
+    file::FilePtr file = file::OpenAsciiFile(all_worlds_file);
+    if(!file)
+        return -1;
+
+    const std::vector<byte> file_data = file::FileRead(file);
+    const nlohmann::json& json = nlohmann::json::parse(file_data);
+
+    int n_failed = 0;
+
+    for(const auto& list_entry : json["all_worlds"])
+    {
+        const std::string world_filename = list_entry;
+        const std::string compiled_filename = CompiledWorldFilename(world_filename.c_str());
+        if(!CompileWorldFile(world_filename.c_str(), compiled_filename.c_str()))
+        {
+            System::Log("WorldFile|Failed to compile world '%s'.", world_filename.c_str());
+            n_failed++;
+        }
+    }
+
+    return n_failed;
+}
+
+using namespace shared;
+
+CompiledWorld::CompiledWorld()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_mapping(nullptr)
+    , m_header(nullptr)
+    , m_entities(nullptr)
+    , m_components(nullptr)
+    , m_attributes(nullptr)
+    , m_points(nullptr)
+    , m_strings(nullptr)
+{ }
+
+CompiledWorld::~CompiledWorld()
+{
+    Close();
+}
+
+bool CompiledWorld::Open(const char* filename)
+{
+    Close();
+
+#if !defined(_WIN32)
+    const int file_descriptor = open(filename, O_RDONLY);
+    if(file_descriptor >= 0)
+    {
+        struct stat file_stat;
+        if(fstat(file_descriptor, &file_stat) == 0 && file_stat.st_size > 0)
+        {
+            void* mapping = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+            if(mapping != MAP_FAILED)
+            {
+                m_mapping = mapping;
+                m_data = static_cast<const std::byte*>(mapping);
+                m_size = file_stat.st_size;
+            }
+        }
+
+        close(file_descriptor);
+    }
+#endif
+
+    // No mapping on this platform, or it failed. Read the whole file in one go instead.
+    if(!m_data)
+    {
+        file::FilePtr file = file::OpenBinaryFile(filename);
+        if(!file)
+            return false;
+
+        const std::vector<byte> file_data = file::FileRead(file);
+        m_read_buffer.resize(file_data.size());
+        std::memcpy(m_read_buffer.data(), file_data.data(), file_data.size());
+
+        m_data = m_read_buffer.data();
+        m_size = m_read_buffer.size();
+    }
+
+    return Initialize(filename);
+}
+
+bool CompiledWorld::Open(std::vector<std::byte>&& blob, const char* name)
+{
+    Close();
+
+    m_read_buffer = std::move(blob);
+    m_data = m_read_buffer.data();
+    m_size = m_read_buffer.size();
+
+    return Initialize(name);
+}
+
+bool CompiledWorld::Initialize(const char* name)
+{
+    if(m_size < sizeof(CompiledWorldHeader))
+    {
+        Close();
+        return false;
+    }
+
+    m_header = reinterpret_cast<const CompiledWorldHeader*>(m_data);
+    const bool valid_header =
+        m_header->magic == COMPILED_WORLD_MAGIC &&
+        m_header->version == COMPILED_WORLD_VERSION &&
+        m_header->file_size == m_size &&
+        m_header->component_defaults_hash == ComponentDefaultsHash() &&
+        InRange(m_header->component_types_offset, m_header->n_component_types, sizeof(uint32_t), m_size) &&
+        InRange(m_header->entities_offset, m_header->n_entities, sizeof(CompiledEntity), m_size) &&
+        InRange(m_header->components_offset, m_header->n_components, sizeof(CompiledComponent), m_size) &&
+        InRange(m_header->attributes_offset, m_header->n_attributes, sizeof(CompiledAttribute), m_size) &&
+        InRange(m_header->points_offset, m_header->n_points, sizeof(float) * 2, m_size) &&
+        InRange(m_header->strings_offset, m_header->strings_size, sizeof(char), m_size) &&
+        m_header->strings_size > 0;
+
+    if(!valid_header)
+    {
+        System::Log("WorldFile|Compiled world '%s' has an invalid or old header.", name);
+        Close();
+        return false;
+    }
+
+    m_entities = reinterpret_cast<const CompiledEntity*>(m_data + m_header->entities_offset);
+    m_components = reinterpret_cast<const CompiledComponent*>(m_data + m_header->components_offset);
+    m_attributes = reinterpret_cast<const CompiledAttribute*>(m_data + m_header->attributes_offset);
+    m_points = reinterpret_cast<const float*>(m_data + m_header->points_offset);
+    m_strings = reinterpret_cast<const char*>(m_data + m_header->strings_offset);
+
+    if(!Validate())
+    {
+        System::Log("WorldFile|Compiled world '%s' is corrupt.", name);
+        Close();
+        return false;
+    }
+
+    const uint32_t* component_type_hashes = reinterpret_cast<const uint32_t*>(m_data + m_header->component_types_offset);
+    m_component_types.reserve(m_header->n_component_types);
+
+    for(uint32_t index = 0; index < m_header->n_component_types; ++index)
+    {
+        Component component_type = DefaultComponentFromHash(component_type_hashes[index]);
+        component_type.hash = component_type_hashes[index];
+        component_type.properties.clear();
+        m_component_types.push_back(std::move(component_type));
+    }
+
+    return true;
+}
+
+void CompiledWorld::Close()
+{
+#if !defined(_WIN32)
+    if(m_mapping)
+        munmap(m_mapping, m_size);
+#endif
+
+    m_mapping = nullptr;
+    m_data = nullptr;
+    m_size = 0;
+    m_read_buffer.clear();
+    m_read_buffer.shrink_to_fit();
+
+    m_header = nullptr;
+    m_entities = nullptr;
+    m_components = nullptr;
+    m_attributes = nullptr;
+    m_points = nullptr;
+    m_strings = nullptr;
+    m_component_types.clear();
+}
+
+bool CompiledWorld::IsOpen() const
+{
+    return m_header != nullptr;
+}
+
+bool CompiledWorld::Validate() const
+{
+    const uint32_t strings_size = m_header->strings_size;
+    if(m_strings[strings_size - 1] != '\0' || m_header->background_texture >= strings_size)
+        return false;
+
+    for(uint32_t index = 0; index < m_header->n_entities; ++index)
+    {
+        const CompiledEntity& entity = m_entities[index];
+        const bool valid_entity =
+            entity.name < strings_size &&
+            entity.folder < strings_size &&
+            entity.first_component <= m_header->n_components &&
+            entity.n_components <= m_header->n_components - entity.first_component;
+        if(!valid_entity)
+            return false;
+    }
+
+    for(uint32_t index = 0; index < m_header->n_components; ++index)
+    {
+        const CompiledComponent& component = m_components[index];
+        const bool valid_component =
+            component.type_index < m_header->n_component_types &&
+            component.first_attribute <= m_header->n_attributes &&
+            component.n_attributes <= m_header->n_attributes - component.first_attribute;
+        if(!valid_component)
+            return false;
+    }
+
+    for(uint32_t index = 0; index < m_header->n_attributes; ++index)
+    {
+        const CompiledAttribute& attribute = m_attributes[index];
+        if(attribute.variant_type > VariantTypeIndex::POLYGON)
+            return false;
+
+        if(attribute.variant_type == VariantTypeIndex::STRING)
+        {
+            const uint64_t string_end = uint64_t(attribute.value[0]) + attribute.value[1];
+            if(string_end >= strings_size)
+                return false;
+        }
+        else if(attribute.variant_type == VariantTypeIndex::POLYGON)
+        {
+            const uint64_t points_end = uint64_t(attribute.value[0]) + attribute.value[1];
+            if(points_end > m_header->n_points)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+LevelMetadata CompiledWorld::Metadata() const
+{
+    LevelMetadata metadata;
+    metadata.camera_position = math::Vector(m_header->camera_position[0], m_header->camera_position[1]);
+    metadata.camera_size = math::Vector(m_header->camera_size[0], m_header->camera_size[1]);
+    metadata.player_spawn_point = math::Vector(m_header->player_spawn_point[0], m_header->player_spawn_point[1]);
+    metadata.background_color = mono::Color::RGBA(
+        m_header->background_color[0], m_header->background_color[1], m_header->background_color[2], m_header->background_color[3]);
+    metadata.ambient_shade = mono::Color::RGBA(
+        m_header->ambient_shade[0], m_header->ambient_shade[1], m_header->ambient_shade[2], m_header->ambient_shade[3]);
+    metadata.background_texture = String(m_header->background_texture);
+
+    return metadata;
+}
+
+uint32_t CompiledWorld::EntityCount() const
+{
+    return m_header->n_entities;
+}
+
+const CompiledEntity& CompiledWorld::Entity(uint32_t index) const
+{
+    return m_entities[index];
+}
+
+const char* CompiledWorld::String(uint32_t offset) const
+{
+    return m_strings + offset;
+}
+
+const CompiledAttribute* CompiledWorld::FindAttribute(
+    const CompiledEntity& entity, uint32_t component_hash, uint32_t attribute_id) const
+{
+    for(uint32_t component_index = 0; component_index < entity.n_components; ++component_index)
+    {
+        const CompiledComponent& compiled_component = m_components[entity.first_component + component_index];
+        if(m_component_types[compiled_component.type_index].hash != component_hash)
+            continue;
+
+        for(uint32_t attribute_index = 0; attribute_index < compiled_component.n_attributes; ++attribute_index)
+        {
+            const CompiledAttribute& compiled_attribute = m_attributes[compiled_component.first_attribute + attribute_index];
+            if(compiled_attribute.id == attribute_id)
+                return &compiled_attribute;
+        }
+    }
+
+    return nullptr;
+}
+
+void CompiledWorld::ReadComponents(
+    const CompiledEntity& entity,
+    const ComponentFilterCallback& component_filter,
+    std::vector<Component>& out_components,
+    uint32_t& out_n_ignored) const
+{
+    uint32_t n_components = 0;
+    out_components.resize(entity.n_components);
+
+    for(uint32_t component_index = 0; component_index < entity.n_components; ++component_index)
+    {
+        const CompiledComponent& compiled_component = m_components[entity.first_component + component_index];
+        const Component& component_type = m_component_types[compiled_component.type_index];
+
+        if(component_filter && !component_filter(component_type.hash))
+        {
+            out_n_ignored++;
+            continue;
+        }
+
+        Component& component = out_components[n_components++];
+        component.hash = component_type.hash;
+        component.depends_on = component_type.depends_on;
+        component.allow_multiple = component_type.allow_multiple;
+        component.category = component_type.category;
+        component.properties.resize(compiled_component.n_attributes);
+
+        for(uint32_t attribute_index = 0; attribute_index < compiled_component.n_attributes; ++attribute_index)
+        {
+            const CompiledAttribute& compiled_attribute = m_attributes[compiled_component.first_attribute + attribute_index];
+            const uint32_t* value = compiled_attribute.value;
+
+            Attribute& attribute = component.properties[attribute_index];
+            attribute.id = compiled_attribute.id;
+
+            switch(compiled_attribute.variant_type)
+            {
+            case VariantTypeIndex::BOOL:
+                attribute.value = (value[0] != 0);
+                break;
+            case VariantTypeIndex::INT:
+            {
+                int int_value;
+                std::memcpy(&int_value, value, sizeof(int_value));
+                attribute.value = int_value;
+                break;
+            }
+            case VariantTypeIndex::UINT:
+                attribute.value = value[0];
+                break;
+            case VariantTypeIndex::FLOAT:
+            {
+                float float_value;
+                std::memcpy(&float_value, value, sizeof(float_value));
+                attribute.value = float_value;
+                break;
+            }
+            case VariantTypeIndex::POINT:
+            {
+                float values[2];
+                std::memcpy(values, value, sizeof(values));
+                attribute.value = math::Vector(values[0], values[1]);
+                break;
+            }
+            case VariantTypeIndex::COLOR:
+            {
+                float values[4];
+                std::memcpy(values, value, sizeof(values));
+                attribute.value = mono::Color::RGBA(values[0], values[1], values[2], values[3]);
+                break;
+            }
+            case VariantTypeIndex::STRING:
+                EmplaceOrAssign<std::string>(attribute.value).assign(m_strings + value[0], value[1]);
+                break;
+            case VariantTypeIndex::POLYGON:
+            {
+                std::vector<math::Vector>& polygon = EmplaceOrAssign<std::vector<math::Vector>>(attribute.value);
+                polygon.resize(value[1]);
+
+                const float* points = m_points + size_t(value[0]) * 2;
+                for(math::Vector& point : polygon)
+                {
+                    point.x = *points++;
+                    point.y = *points++;
+                }
+                break;
+            }
+            }
+        }
+    }
+
+    out_components.resize(n_components);
+}
@@ -0,0 +1,167 @@
+
+#pragma once
+
+#include "WorldFile.h"
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+struct Component;
+
+namespace shared
+{
+    // The compiled world is a little endian blob that is loaded without parsing. All records are four byte
+    // aligned, offsets are from the start of the file and strings are offsets into a zero terminated string table.
+    // The attributes are merged with the component defaults when compiled, so loading is a copy of the values.
+    constexpr uint32_t COMPILED_WORLD_MAGIC = 0x444C5753; // "SWLD"
+    constexpr uint32_t COMPILED_WORLD_VERSION = 2;
+
+#if defined(__BYTE_ORDER__)
+    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "The compiled world is used in place and is little endian.");
+#endif
+
+    enum CompiledEntityFlags : uint32_t
+    {
+        HAS_UUID = 1,
+
+        // The last component is a name_folder component patched in by the compiler, it's only passed to the
+        // creation callback and not added to the entity. Same as when reading the json file.
+        PATCHED_NAME_FOLDER = 2,
+    };
+
+    struct CompiledWorldHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t file_size;
+
+        // Hash of the default components the attributes were merged with, a world compiled with other defaults
+        // is compiled again.
+        uint32_t component_defaults_hash;
+
+        float camera_position[2];
+        float camera_size[2];
+        float player_spawn_point[2];
+        float background_color[4];
+        float ambient_shade[4];
+        uint32_t background_texture;
+
+        uint32_t component_types_offset;
+        uint32_t n_component_types;
+        uint32_t entities_offset;
+        uint32_t n_entities;
+        uint32_t components_offset;
+        uint32_t n_components;
+        uint32_t attributes_offset;
+        uint32_t n_attributes;
+        uint32_t points_offset;
+        uint32_t n_points;
+        uint32_t strings_offset;
+        uint32_t strings_size;
+    };
+
+    struct CompiledEntity
+    {
+        uint32_t name;
+        uint32_t folder;
+        uint32_t uuid_hash;
+        uint32_t entity_properties;
+        uint32_t flags;
+        uint32_t first_component;
+        uint32_t n_components;
+    };
+
+    struct CompiledComponent
+    {
+        uint32_t type_index;
+        uint32_t first_attribute;
+        uint32_t n_attributes;
+    };
+
+    // The value is stored as the variant type, strings are {string offset, length} and polygons are
+    // {first point, n points}.
+    struct CompiledAttribute
+    {
+        uint32_t id;
+        uint32_t variant_type;
+        uint32_t value[4];
+    };
+
+    static_assert(sizeof(CompiledWorldHeader) == 124);
+    static_assert(sizeof(CompiledEntity) == 28);
+    static_assert(sizeof(CompiledComponent) == 12);
+    static_assert(sizeof(CompiledAttribute) == 24);
+
+    // res/worlds/world.components -> res/worlds/world.compiled
+    std::string CompiledWorldFilename(const char* world_filename);
+
+    // Hash over all the default components and their default values.
+    uint32_t ComponentDefaultsHash();
+
+    // True if the compiled file exists, is not older than the world file and was compiled with the same
+    // version and component defaults.
+    bool IsCompiledWorldCurrent(const char* world_filename, const char* compiled_filename);
+
+    // Compiles the world in memory, the blob can be opened as a compiled world without touching the disk.
+    bool CompileWorld(const char* world_filename, std::vector<std::byte>& out_blob);
+    bool CompileWorldFile(const char* world_filename, const char* compiled_filename);
+
+    // Compiles all the worlds in the list next to their world files, returns the number of failed worlds.
+    int CompileAllWorlds(const char* all_worlds_file);
+
+    // Read only view of a compiled world, the file is memory mapped and the records are used in place.
+    class CompiledWorld
+    {
+    public:
+
+        CompiledWorld();
+        ~CompiledWorld();
+
+        CompiledWorld(const CompiledWorld&) = delete;
+        CompiledWorld& operator = (const CompiledWorld&) = delete;
+
+        // Validates the header and all record indices, so the accessors below don't have to.
+        bool Open(const char* filename);
+        bool Open(std::vector<std::byte>&& blob, const char* name);
+        void Close();
+        bool IsOpen() const;
+
+        LevelMetadata Metadata() const;
+        uint32_t EntityCount() const;
+        const CompiledEntity& Entity(uint32_t index) const;
+        const char* String(uint32_t offset) const;
+
+        // First attribute with the id in a component of the type, or nullptr.
+        const CompiledAttribute* FindAttribute(const CompiledEntity& entity, uint32_t component_hash, uint32_t attribute_id) const;
+
+        // Decodes the components of the entity into out_components, the vector and the attribute vectors in it are
+        // reused between calls. Components not accepted by the filter are skipped and counted in out_n_ignored.
+        void ReadComponents(
+            const CompiledEntity& entity,
+            const ComponentFilterCallback& component_filter,
+            std::vector<Component>& out_components,
+            uint32_t& out_n_ignored) const;
+
+    private:
+
+        bool Initialize(const char* name);
+        bool Validate() const;
+
+        const std::byte* m_data;
+        size_t m_size;
+        std::vector<std::byte> m_read_buffer;
+        void* m_mapping;
+
+        const CompiledWorldHeader* m_header;
+        const CompiledEntity* m_entities;
+        const CompiledComponent* m_components;
+        const CompiledAttribute* m_attributes;
+        const float* m_points;
+        const char* m_strings;
+
+        // Default component for each component type in the file, without properties.
+        std::vector<Component> m_component_types;
+    };
+}
@@ -0,0 +1,203 @@
+
+#include "WorldLoader.h"
+
+#include "EntitySystem/IEntityManager.h"
+#include "Component.h"
+
+#include "System/System.h"
+
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cstring>
+#include <exception>
+
+using namespace shared;
+
+WorldLoader::WorldLoader(const char* filename, ComponentFilterCallback component_filter)
+    : m_filename(filename)
+    , m_component_filter(component_filter)
+    , m_parsed(false)
+    , m_parse_ok(false)
+    , m_next_entity(0)
+    , m_n_ignored_components(0)
+{
+    m_parse_thread = std::thread(&WorldLoader::Parse, this);
+}
+
+WorldLoader::~WorldLoader()
+{
+    WaitForParse();
+}
+
+void WorldLoader::Parse()
+{
+    System::Log("WorldFile|Loading world '%s'.", m_filename.c_str());
+
+    bool opened = false;
+
+    const std::string compiled_filename = CompiledWorldFilename(m_filename.c_str());
+    if(IsCompiledWorldCurrent(m_filename.c_str(), compiled_filename.c_str()))
+        opened = m_compiled_world.Open(compiled_filename.c_str());
+
+    if(!opened)
+    {
+        // A broken world file throws from the json parser, which would terminate the program on this thread.
+        try
+        {
+            std::vector<std::byte> blob;
+            opened = CompileWorld(m_filename.c_str(), blob) && m_compiled_world.Open(std::move(blob), m_filename.c_str());
+        }
+        catch(const std::exception& error)
+        {
+            m_parse_error = error.what();
+            opened = false;
+        }
+    }
+
+    if(opened)
+    {
+        m_level_data.metadata = m_compiled_world.Metadata();
+        m_level_data.loaded_entities.reserve(m_compiled_world.EntityCount());
+
+        m_order.resize(m_compiled_world.EntityCount());
+        std::iota(m_order.begin(), m_order.end(), 0);
+    }
+
+    m_parse_ok = opened;
+    m_parsed = true;
+}
+
+bool WorldLoader::WaitForParse()
+{
+    if(m_parse_thread.joinable())
+    {
+        m_parse_thread.join();
+
+        if(!m_parse_ok)
+        {
+            const char* reason = m_parse_error.empty() ? "unable to read or compile the file" : m_parse_error.c_str();
+            System::Log("WorldFile|Failed to load world '%s', %s.", m_filename.c_str(), reason);
+        }
+    }
+
+    return m_parse_ok;
+}
+
+bool WorldLoader::IsParsed() const
+{
+    return m_parsed;
+}
+
+const std::string& WorldLoader::ParseError() const
+{
+    return m_parse_error;
+}
+
+void WorldLoader::SortByDistance(const math::Vector& point)
+{
+    if(!WaitForParse())
+        return;
+
+    std::vector<float> distances(m_order.size(), -1.0f);
+
+    for(uint32_t index = 0; index < m_order.size(); ++index)
+    {
+        const CompiledEntity& entity = m_compiled_world.Entity(index);
+        const CompiledAttribute* position =
+            m_compiled_world.FindAttribute(entity, TRANSFORM_COMPONENT, POSITION_ATTRIBUTE);
+        if(!position || position->variant_type != VariantTypeIndex::POINT)
+            continue;
+
+        float values[2];
+        std::memcpy(values, position->value, sizeof(values));
+
+        const float delta_x = values[0] - point.x;
+        const float delta_y = values[1] - point.y;
+        distances[index] = delta_x * delta_x + delta_y * delta_y;
+    }
+
+    const auto sort_by_distance = [&distances](uint32_t first, uint32_t second) {
+        return distances[first] < distances[second];
+    };
+    std::stable_sort(m_order.begin() + m_next_entity, m_order.end(), sort_by_distance);
+}
+
+bool WorldLoader::InstantiateEntities(
+    mono::IEntityManager* entity_manager, const EntityCreationCallback& creation_callback, float budget_ms)
+{
+    if(!WaitForParse())
+        return true;
+
+    const uint64_t start_time = System::GetPerformanceCounter();
+    const uint64_t budget_ticks = (budget_ms > 0.0f) ?
+        uint64_t(budget_ms * System::GetPerformanceFrequency() / 1000.0f) : std::numeric_limits<uint64_t>::max();
+
+    while(m_next_entity < m_order.size())
+    {
+        const CompiledEntity& compiled_entity = m_compiled_world.Entity(m_order[m_next_entity]);
+        m_next_entity++;
+
+        const char* entity_name = m_compiled_world.String(compiled_entity.name);
+
+        mono::Entity new_entity;
+
+        if(compiled_entity.flags & HAS_UUID)
+            new_entity = entity_manager->CreateEntity(entity_name, compiled_entity.uuid_hash, std::vector<uint32_t>());
+        else
+            new_entity = entity_manager->CreateEntity(entity_name, std::vector<uint32_t>());
+
+        entity_manager->SetEntityProperties(new_entity.id, compiled_entity.entity_properties);
+
+        m_compiled_world.ReadComponents(compiled_entity, m_component_filter, m_components, m_n_ignored_components);
+
+        // The patched name and folder component is only for the callback.
+        const bool has_patched_component =
+            (compiled_entity.flags & PATCHED_NAME_FOLDER) &&
+            !m_components.empty() &&
+            m_components.back().hash == NAME_FOLDER_COMPONENT;
+        const size_t n_entity_components = m_components.size() - (has_patched_component ? 1 : 0);
+
+        for(size_t index = 0; index < n_entity_components; ++index)
+        {
+            const Component& component = m_components[index];
+            entity_manager->AddComponent(new_entity.id, component.hash);
+            entity_manager->SetComponentData(new_entity.id, component.hash, component.properties);
+        }
+
+        m_level_data.loaded_entities.push_back(new_entity.id);
+
+        if(creation_callback)
+            creation_callback(new_entity, m_compiled_world.String(compiled_entity.folder), m_components);
+
+        if(System::GetPerformanceCounter() - start_time >= budget_ticks)
+            break;
+    }
+
+    const bool done = IsDone();
+    if(done && m_n_ignored_components > 0)
+    {
+        System::Log("WorldFile|Ignored %u components when loading '%s'.", m_n_ignored_components, m_filename.c_str());
+        m_n_ignored_components = 0;
+    }
+
+    return done;
+}
+
+bool WorldLoader::IsDone() const
+{
+    return m_parsed && m_next_entity >= m_order.size();
+}
+
+float WorldLoader::Progress() const
+{
+    if(!m_parsed)
+        return 0.0f;
+
+    return m_order.empty() ? 1.0f : float(m_next_entity) / float(m_order.size());
+}
+
+const LevelData& WorldLoader::GetLevelData() const
+{
+    return m_level_data;
+}
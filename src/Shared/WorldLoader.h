@@ -0,0 +1,67 @@
+
+#pragma once
+
+#include "WorldFile.h"
+#include "WorldFileBinary.h"
+
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace shared
+{
+    // Loads a world in two stages. The file is read on a background thread, the compiled world if it's current
+    // otherwise the json file compiled in memory. The entities are then created on the main thread a few at a
+    // time, so a large world can be spread over several frames.
+    class WorldLoader
+    {
+    public:
+
+        WorldLoader(const char* filename, ComponentFilterCallback component_filter);
+        ~WorldLoader();
+
+        // Blocks until the background stage is done, returns false if the world could not be read. The failure is
+        // logged from here, on the calling thread.
+        bool WaitForParse();
+        bool IsParsed() const;
+
+        // Set when the world file could not be parsed, valid after the parse.
+        const std::string& ParseError() const;
+
+        // Create the entities closest to the point first, entities without a position are created before the rest.
+        // Call after the parse and before any entities are created.
+        void SortByDistance(const math::Vector& point);
+
+        // Creates entities until the budget is spent, at least one per call. A budget of zero or less creates all of
+        // them. Returns true when all entities are created.
+        bool InstantiateEntities(mono::IEntityManager* entity_manager, const EntityCreationCallback& creation_callback, float budget_ms);
+
+        bool IsDone() const;
+        float Progress() const;
+
+        // The metadata is valid after the parse, the loaded entities grow as they are created.
+        const LevelData& GetLevelData() const;
+
+    private:
+
+        void Parse();
+
+        const std::string m_filename;
+        const ComponentFilterCallback m_component_filter;
+
+        std::thread m_parse_thread;
+        std::atomic<bool> m_parsed;
+        bool m_parse_ok;
+        std::string m_parse_error;
+
+        CompiledWorld m_compiled_world;
+        LevelData m_level_data;
+
+        std::vector<uint32_t> m_order;
+        uint32_t m_next_entity;
+        uint32_t m_n_ignored_components;
+        std::vector<Component> m_components;
+    };
+}
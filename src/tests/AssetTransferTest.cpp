@@ -0,0 +1,154 @@
+
+#include "gtest/gtest.h"
+
+#include "Network/AssetTransfer.h"
+#include "Network/AssetClient.h"
+#include "Network/NetworkMessage.h"
+#include "Network/NetworkSerialize.h"
+#include "EventHandler/EventHandler.h"
+#include "System/Hash.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+    game::AssetEntry MakeAsset(const char* filename, uint32_t size)
+    {
+        game::AssetEntry entry;
+        entry.filename = filename;
+        for(uint32_t index = 0; index < size; ++index)
+            entry.content.push_back(byte(index * 31));
+        entry.content_hash = game::HashAssetContent(entry.content.data(), entry.content.size());
+        return entry;
+    }
+
+    template <typename T>
+    T RoundTrip(const T& message)
+    {
+        const std::vector<byte>& message_bytes = game::SerializeMessage(message);
+        const std::vector<byte_view>& message_views = game::UnpackMessageBuffer(message_bytes);
+
+        T deserialized_message;
+        EXPECT_EQ(1u, message_views.size());
+        EXPECT_TRUE(game::DeserializeMessage(message_views[0], deserialized_message));
+        return deserialized_message;
+    }
+
+    std::string TempDirectory(const char* name)
+    {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove_all(path);
+        return path.string();
+    }
+}
+
+TEST(AssetTransferTest, ManifestAndChunkRoundTrip)
+{
+    const game::AssetEntry asset = MakeAsset("res/sprites/asset_transfer_test.sprite", 1300);
+
+    game::AssetManifestMessage manifest_message;
+    ASSERT_TRUE(game::MakeAssetManifestMessage(asset, 2, 5, manifest_message));
+
+    const game::AssetManifestMessage received_manifest = RoundTrip(manifest_message);
+    EXPECT_EQ(2u, received_manifest.entry_index);
+    EXPECT_EQ(5u, received_manifest.n_entries);
+    EXPECT_EQ(asset.content_hash, received_manifest.content_hash);
+    EXPECT_EQ(1300u, received_manifest.content_size);
+    EXPECT_STREQ(asset.filename.c_str(), received_manifest.filename);
+
+    const uint32_t n_chunks = game::NumberOfAssetChunks(asset.content.size());
+    ASSERT_EQ(3u, n_chunks);
+
+    std::vector<byte> content;
+    for(uint32_t index = 0; index < n_chunks; ++index)
+    {
+        game::AssetChunkMessage chunk_message;
+        ASSERT_TRUE(game::MakeAssetChunkMessage(asset, index, chunk_message));
+
+        const game::AssetChunkMessage received_chunk = RoundTrip(chunk_message);
+        EXPECT_EQ(asset.content_hash, received_chunk.content_hash);
+        EXPECT_EQ(index, received_chunk.chunk_index);
+        content.insert(content.end(), received_chunk.data, received_chunk.data + received_chunk.chunk_size);
+    }
+
+    EXPECT_EQ(asset.content, content);
+
+    game::AssetChunkMessage chunk_message;
+    EXPECT_FALSE(game::MakeAssetChunkMessage(asset, n_chunks, chunk_message));
+}
+
+TEST(AssetTransferTest, FilenameThatDoesNotFitIsRejected)
+{
+    const std::string filename(game::AssetMaxFilenameLength, 'a');
+    const game::AssetEntry asset = MakeAsset(filename.c_str(), 10);
+
+    game::AssetManifestMessage manifest_message;
+    EXPECT_FALSE(game::MakeAssetManifestMessage(asset, 0, 1, manifest_message));
+}
+
+TEST(AssetTransferTest, ClientFetchesAndResolvesMissingBlobs)
+{
+    mono::EventHandler event_handler;
+
+    const std::string cache_directory = TempDirectory("asset_transfer_test_cache");
+    const std::vector<game::AssetEntry> assets = {
+        MakeAsset("res/sprites/asset_transfer_test_1.sprite", 700),
+        MakeAsset("res/sprites/asset_transfer_test_2.sprite", 12),
+    };
+
+    int n_synced = 0;
+    game::AssetClient asset_client(cache_directory, &event_handler, nullptr, [&n_synced]() { n_synced++; });
+
+    for(size_t index = 0; index < assets.size(); ++index)
+    {
+        game::AssetManifestMessage manifest_message;
+        ASSERT_TRUE(game::MakeAssetManifestMessage(assets[index], index, assets.size(), manifest_message));
+        event_handler.DispatchEvent(RoundTrip(manifest_message));
+    }
+
+    EXPECT_FALSE(asset_client.IsSynced());
+    EXPECT_FLOAT_EQ(0.0f, asset_client.Progress());
+
+    for(const game::AssetEntry& asset : assets)
+    {
+        for(uint32_t index = 0; index < game::NumberOfAssetChunks(asset.content.size()); ++index)
+        {
+            game::AssetChunkMessage chunk_message;
+            ASSERT_TRUE(game::MakeAssetChunkMessage(asset, index, chunk_message));
+            event_handler.DispatchEvent(RoundTrip(chunk_message));
+        }
+    }
+
+    EXPECT_TRUE(asset_client.IsSynced());
+    EXPECT_FALSE(asset_client.IsRejected());
+    EXPECT_EQ(1, n_synced);
+
+    const game::AssetCache cache(cache_directory);
+    for(const game::AssetEntry& asset : assets)
+    {
+        EXPECT_TRUE(cache.HasBlob(asset.content_hash));
+        EXPECT_EQ(cache.BlobPath(asset.content_hash), asset_client.ResolveAssetPath(hash::Hash(asset.filename.c_str())));
+    }
+
+    std::filesystem::remove_all(cache_directory);
+}
+
+TEST(AssetTransferTest, ClientRejectsOversizedManifest)
+{
+    mono::EventHandler event_handler;
+
+    const std::string cache_directory = TempDirectory("asset_transfer_test_rejected");
+    game::AssetClient asset_client(cache_directory, &event_handler, nullptr, []() { });
+
+    game::AssetManifestMessage manifest_message;
+    ASSERT_TRUE(game::MakeAssetManifestMessage(MakeAsset("res/sprites/huge.sprite", 1), 0, 1, manifest_message));
+    manifest_message.content_size = game::AssetMaxContentSize + 1;
+    event_handler.DispatchEvent(RoundTrip(manifest_message));
+
+    EXPECT_TRUE(asset_client.IsRejected());
+    EXPECT_FALSE(asset_client.IsSynced());
+
+    std::filesystem::remove_all(cache_directory);
+}
@@ -0,0 +1,88 @@
+
+#include "gtest/gtest.h"
+
+#include "Entity/ComponentSchema.h"
+#include "Component.h"
+#include "System/Hash.h"
+
+namespace
+{
+    enum class TestEnum : int
+    {
+        FIRST,
+        SECOND,
+        THIRD,
+    };
+
+    struct TestData
+    {
+        shared::StringHash trigger;
+        math::Vector size;
+        uint32_t faction;
+        TestEnum operation;
+        int n_entities;
+    };
+
+    const shared::ComponentSchema<TestData>& TestSchema()
+    {
+        static const shared::ComponentSchema<TestData> schema(AREA_TRIGGER_COMPONENT, {
+            shared::Field<&TestData::trigger>(TRIGGER_NAME_ATTRIBUTE, FallbackMode::REQUIRE_ATTRIBUTE),
+            shared::Field<&TestData::size>(SIZE_ATTRIBUTE),
+            shared::Field<&TestData::faction>(FACTION_PICKER_ATTRIBUTE),
+            shared::Field<&TestData::operation>(LOGIC_OP_ATTRIBUTE),
+            shared::Field<&TestData::n_entities>(N_ENTITIES_ATTRIBUTE),
+        });
+        return schema;
+    }
+}
+
+TEST(ComponentSchemaTest, ReadMatchesFindAttribute)
+{
+    const std::vector<Attribute> properties = {
+        { N_ENTITIES_ATTRIBUTE, 7 },
+        { TRIGGER_NAME_ATTRIBUTE, std::string("door_open") },
+        { LOGIC_OP_ATTRIBUTE, 2 },
+    };
+
+    TestData data;
+    ASSERT_TRUE(TestSchema().Read(properties, data));
+
+    math::Vector size;
+    uint32_t faction;
+    FindAttribute(SIZE_ATTRIBUTE, properties, size, FallbackMode::SET_DEFAULT);
+    FindAttribute(FACTION_PICKER_ATTRIBUTE, properties, faction, FallbackMode::SET_DEFAULT);
+
+    EXPECT_EQ(hash::Hash("door_open"), data.trigger.value);
+    EXPECT_EQ(size.x, data.size.x);
+    EXPECT_EQ(size.y, data.size.y);
+    EXPECT_EQ(faction, data.faction);
+    EXPECT_EQ(TestEnum::THIRD, data.operation);
+    EXPECT_EQ(7, data.n_entities);
+}
+
+TEST(ComponentSchemaTest, MissingRequiredAttribute)
+{
+    const std::vector<Attribute> properties = {
+        { N_ENTITIES_ATTRIBUTE, 7 },
+    };
+
+    TestData data;
+    EXPECT_FALSE(TestSchema().Read(properties, data));
+
+    const uint32_t found_mask = TestSchema().ReadFields(properties, data);
+    EXPECT_EQ(TestSchema().FieldMask(N_ENTITIES_ATTRIBUTE), found_mask);
+    EXPECT_EQ(7, data.n_entities);
+}
+
+TEST(ComponentSchemaTest, WrongTypeIsNotRead)
+{
+    const std::vector<Attribute> properties = {
+        { TRIGGER_NAME_ATTRIBUTE, std::string("door_open") },
+        { N_ENTITIES_ATTRIBUTE, 1.0f },
+    };
+
+    TestData data;
+    const uint32_t found_mask = TestSchema().ReadFields(properties, data);
+    EXPECT_EQ(0u, found_mask & TestSchema().FieldMask(N_ENTITIES_ATTRIBUTE));
+    EXPECT_EQ(std::get<int>(DefaultAttributeFromHash(N_ENTITIES_ATTRIBUTE)), data.n_entities);
+}
@@ -0,0 +1,194 @@
+
+#include "gtest/gtest.h"
+
+#include "DamageSystem.h"
+#include "EventHandler/EventHandler.h"
+
+#include <vector>
+#include <thread>
+
+namespace
+{
+    struct DamageCall
+    {
+        uint32_t id;
+        int damage;
+        uint32_t who_did_damage;
+        game::DamageType type;
+
+        bool operator == (const DamageCall& other) const
+        {
+            return
+                id == other.id &&
+                damage == other.damage &&
+                who_did_damage == other.who_did_damage &&
+                type == other.type;
+        }
+    };
+
+    mono::UpdateContext MakeFrame(uint32_t timestamp)
+    {
+        mono::UpdateContext update_context = {};
+        update_context.timestamp = timestamp;
+        return update_context;
+    }
+
+    void CreateTarget(game::DamageSystem& damage_system, uint32_t id, int health, std::vector<DamageCall>& calls)
+    {
+        game::DamageRecord* record = damage_system.CreateRecord(id);
+        record->full_health = health;
+        damage_system.SetHealth(id, health);
+        record->score = 10;
+        damage_system.PreventReleaseOnDeath(id, true);
+
+        const auto callback = [&calls](uint32_t id, int damage, uint32_t who_did_damage, game::DamageType type) {
+            calls.push_back({ id, damage, who_did_damage, type });
+        };
+        damage_system.SetDamageCallback(id, game::DamageType::ALL, callback);
+    }
+}
+
+TEST(DamageSystemTest, DamageIsResolvedInUpdate)
+{
+    mono::EventHandler event_handler;
+    game::DamageSystem damage_system(16, nullptr, nullptr, &event_handler);
+
+    std::vector<DamageCall> calls;
+    CreateTarget(damage_system, 1, 100, calls);
+    CreateTarget(damage_system, 2, 30, calls);
+
+    const game::DamageResult result = damage_system.ApplyDamage(1, 10, 7);
+    EXPECT_TRUE(result.did_damage);
+    EXPECT_EQ(100, result.health_left);
+
+    damage_system.ApplyDamage(1, 15, 7);
+    damage_system.ApplyDamage(2, 20, 8);
+    damage_system.ApplyDamage(2, 20, 9);
+    damage_system.ApplyDamage(2, 20, 10);
+    EXPECT_FALSE(damage_system.ApplyDamage(3, 20, 10).did_damage);
+
+    // Nothing happens until the update.
+    EXPECT_TRUE(calls.empty());
+    EXPECT_EQ(100, damage_system.GetHealth(1));
+
+    damage_system.ScheduledUpdate(MakeFrame(100));
+
+    // One call per target, the request that takes the health to zero gets the kill.
+    const std::vector<DamageCall> expected_calls = {
+        { 1, 25, 7, game::DamageType::DAMAGED },
+        { 2, 40, 9, game::DamageType::DESTROYED },
+    };
+    EXPECT_EQ(expected_calls, calls);
+    EXPECT_EQ(75, damage_system.GetHealth(1));
+    EXPECT_EQ(0, damage_system.GetHealth(2));
+    EXPECT_EQ(100u, damage_system.GetDamageRecord(2)->last_damaged_timestamp);
+
+    EXPECT_FALSE(damage_system.ApplyDamage(2, 20, 8).did_damage);
+}
+
+TEST(DamageSystemTest, CallbacksRemoveCallbacks)
+{
+    mono::EventHandler event_handler;
+    game::DamageSystem damage_system(16, nullptr, nullptr, &event_handler);
+
+    game::DamageRecord* record = damage_system.CreateRecord(1);
+    record->full_health = 100;
+
+    int n_first_calls = 0;
+    int n_second_calls = 0;
+    uint32_t first_callback_id = 0;
+    uint32_t second_callback_id = 0;
+
+    // Removes itself and the callback after it in the list, then adds a new one.
+    const auto first_callback = [&](uint32_t id, int damage, uint32_t who_did_damage, game::DamageType type) {
+        n_first_calls++;
+        damage_system.RemoveDamageCallback(1, first_callback_id);
+        damage_system.RemoveDamageCallback(1, second_callback_id);
+        damage_system.SetDamageCallback(1, game::DamageType::ALL, [&n_second_calls](uint32_t, int, uint32_t, game::DamageType) {
+            n_second_calls++;
+        });
+    };
+    second_callback_id = damage_system.SetDamageCallback(1, game::DamageType::ALL, [&n_second_calls](uint32_t, int, uint32_t, game::DamageType) {
+        n_second_calls++;
+    });
+    first_callback_id = damage_system.SetDamageCallback(1, game::DamageType::ALL, first_callback);
+
+    damage_system.ApplyDamage(1, 10, 0);
+    damage_system.ScheduledUpdate(MakeFrame(1));
+    EXPECT_EQ(1, n_first_calls);
+    EXPECT_EQ(0, n_second_calls);
+
+    damage_system.ApplyDamage(1, 10, 0);
+    damage_system.ScheduledUpdate(MakeFrame(2));
+    EXPECT_EQ(1, n_first_calls);
+    EXPECT_EQ(1, n_second_calls);
+    EXPECT_EQ(80, damage_system.GetHealth(1));
+}
+
+TEST(DamageSystemTest, SameResultFromManyThreads)
+{
+    constexpr uint32_t n_targets = 64;
+    constexpr uint32_t n_threads = 4;
+
+    std::vector<std::vector<DamageCall>> results;
+
+    for(int run = 0; run < 3; ++run)
+    {
+        mono::EventHandler event_handler;
+        game::DamageSystem damage_system(n_targets, nullptr, nullptr, &event_handler);
+
+        std::vector<DamageCall> calls;
+        for(uint32_t id = 0; id < n_targets; ++id)
+            CreateTarget(damage_system, id, 50, calls);
+
+        std::vector<std::thread> threads;
+        for(uint32_t thread_index = 0; thread_index < n_threads; ++thread_index)
+        {
+            const auto emit_damage = [&damage_system, thread_index]() {
+                for(uint32_t id = 0; id < n_targets; ++id)
+                    damage_system.ApplyDamage(id, 5 + id % 20, thread_index);
+            };
+            threads.emplace_back(emit_damage);
+        }
+
+        for(std::thread& thread : threads)
+            thread.join();
+
+        damage_system.ScheduledUpdate(MakeFrame(100));
+        results.push_back(calls);
+    }
+
+    // Which thread got its hit in last differs between the runs, the damage does not.
+    EXPECT_EQ(n_targets, results[0].size());
+    for(const std::vector<DamageCall>& calls : results)
+    {
+        ASSERT_EQ(results[0].size(), calls.size());
+        for(size_t index = 0; index < calls.size(); ++index)
+        {
+            EXPECT_EQ(results[0][index].id, calls[index].id);
+            EXPECT_EQ(results[0][index].damage, calls[index].damage);
+            EXPECT_EQ(results[0][index].type, calls[index].type);
+            EXPECT_LT(calls[index].who_did_damage, n_threads);
+        }
+    }
+}
+
+TEST(DamageSystemTest, KillGoesToTheLastHit)
+{
+    mono::EventHandler event_handler;
+    game::DamageSystem damage_system(16, nullptr, nullptr, &event_handler);
+
+    std::vector<DamageCall> calls;
+    CreateTarget(damage_system, 1, 30, calls);
+
+    // The attacker with the higher id hits first.
+    damage_system.ApplyDamage(1, 20, 9);
+    damage_system.ApplyDamage(1, 20, 3);
+    damage_system.ApplyDamage(1, 20, 5);
+    damage_system.ScheduledUpdate(MakeFrame(100));
+
+    const std::vector<DamageCall> expected_calls = {
+        { 1, 40, 3, game::DamageType::DESTROYED },
+    };
+    EXPECT_EQ(expected_calls, calls);
+}
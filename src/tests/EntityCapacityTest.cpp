@@ -0,0 +1,105 @@
+
+#include "gtest/gtest.h"
+
+#include "ChunkedArray.h"
+#include "DamageSystem.h"
+#include "Entity/EntityLogicSystem.h"
+#include "Entity/IEntityLogic.h"
+#include "SimulationClock.h"
+
+#include <vector>
+
+namespace
+{
+    struct TestRecord
+    {
+        int value;
+        float position[2];
+    };
+
+    struct CountingLogic : game::IEntityLogic
+    {
+        CountingLogic(int* n_updates)
+            : m_n_updates(n_updates)
+        { }
+
+        void Update(const mono::UpdateContext& update_context) override
+        {
+            (*m_n_updates)++;
+        }
+
+        int* m_n_updates;
+    };
+}
+
+TEST(EntityCapacityTest, ChunkedArrayKeepsPointers)
+{
+    game::ChunkedArray<TestRecord, 64> records(10);
+    EXPECT_EQ(64u, records.Size());
+
+    TestRecord* first = &records[0];
+    first->value = 7;
+
+    records.EnsureSize(1000);
+    EXPECT_EQ(1024u, records.Size());
+    EXPECT_EQ(first, &records[0]);
+    EXPECT_EQ(7, records[0].value);
+
+    // New chunks are value initialized.
+    EXPECT_EQ(0, records[999].value);
+    EXPECT_EQ(0.0f, records[999].position[1]);
+
+    records.EnsureSize(10);
+    EXPECT_EQ(1024u, records.Size());
+}
+
+// Starts the game systems with the default capacity and creates components for many more entities than that.
+TEST(EntityCapacityTest, TwentyThousandEntities)
+{
+    constexpr uint32_t initial_capacity = 500;
+    constexpr uint32_t n_entities = 20000;
+
+    game::SimulationClock simulation_clock(1000);
+    mono::UpdateContext update_context = {};
+    update_context.timestamp = 1000;
+    simulation_clock.Update(update_context);
+
+    game::DamageSystem damage_system(initial_capacity, nullptr, nullptr, nullptr);
+    game::EntityLogicSystem logic_system(initial_capacity, &simulation_clock);
+
+    int n_updates = 0;
+
+    game::DamageRecord* first_record = damage_system.CreateRecord(0);
+    first_record->full_health = 100;
+    logic_system.CreateLogic<CountingLogic>(0, &n_updates);
+
+    for(uint32_t entity_id = 1; entity_id < n_entities; ++entity_id)
+    {
+        game::DamageRecord* record = damage_system.CreateRecord(entity_id);
+        record->full_health = 100;
+        logic_system.CreateLogic<CountingLogic>(entity_id, &n_updates);
+    }
+
+    EXPECT_EQ(first_record, damage_system.GetDamageRecord(0));
+
+    for(uint32_t entity_id = 0; entity_id < n_entities; ++entity_id)
+        damage_system.ApplyDamage(entity_id, 10, entity_id);
+
+    update_context.timestamp++;
+    simulation_clock.Update(update_context);
+    logic_system.ScheduledUpdate(update_context);
+    damage_system.ScheduledUpdate(update_context);
+
+    EXPECT_EQ(int(n_entities), n_updates);
+    EXPECT_EQ(90, damage_system.GetHealth(0));
+    EXPECT_EQ(90, damage_system.GetHealth(n_entities - 1));
+
+    for(uint32_t entity_id = 0; entity_id < n_entities; ++entity_id)
+    {
+        damage_system.ReleaseRecord(entity_id);
+        logic_system.ReleaseLogic(entity_id);
+    }
+
+    EXPECT_FALSE(damage_system.IsAllocated(n_entities - 1));
+    EXPECT_FALSE(logic_system.HasLogic(n_entities - 1));
+}
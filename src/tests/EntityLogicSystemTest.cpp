@@ -0,0 +1,164 @@
+
+#include "gtest/gtest.h"
+
+#include "Entity/EntityLogicSystem.h"
+#include "Entity/IEntityLogic.h"
+#include "SimulationClock.h"
+
+#include <vector>
+
+namespace
+{
+    struct TestBulletLogic : game::IEntityLogic
+    {
+        TestBulletLogic(uint32_t entity_id, int* n_updates)
+            : m_entity_id(entity_id)
+            , m_n_updates(n_updates)
+            , m_position(0.0f)
+            , m_life_span(1000)
+        { }
+
+        void Update(const mono::UpdateContext& update_context) override
+        {
+            m_position += 2.0f * update_context.delta_s;
+            m_life_span -= update_context.delta_ms;
+            (*m_n_updates)++;
+        }
+
+        uint32_t m_entity_id;
+        int* m_n_updates;
+        float m_position;
+        int m_life_span;
+    };
+
+    struct TestEnemyLogic : game::IEntityLogic
+    {
+        TestEnemyLogic(uint32_t entity_id, int* n_updates)
+            : m_entity_id(entity_id)
+            , m_n_updates(n_updates)
+        { }
+
+        void Update(const mono::UpdateContext& update_context) override
+        {
+            m_state = (m_state + update_context.delta_ms) % 7;
+            (*m_n_updates)++;
+        }
+
+        uint32_t m_entity_id;
+        int* m_n_updates;
+        uint32_t m_state = 0;
+        float m_padding[16];
+    };
+
+    // Releases another logic, and itself, while the system is updating.
+    struct TestReleasingLogic : game::IEntityLogic
+    {
+        TestReleasingLogic(uint32_t entity_id, game::EntityLogicSystem* logic_system, uint32_t release_id)
+            : m_entity_id(entity_id)
+            , m_logic_system(logic_system)
+            , m_release_id(release_id)
+        { }
+
+        void Update(const mono::UpdateContext& update_context) override
+        {
+            m_logic_system->ReleaseLogic(m_release_id);
+            m_logic_system->ReleaseLogic(m_entity_id);
+        }
+
+        uint32_t m_entity_id;
+        game::EntityLogicSystem* m_logic_system;
+        uint32_t m_release_id;
+    };
+
+    class TestClock
+    {
+    public:
+
+        // One millisecond ticks, so every frame of one millisecond is exactly one tick.
+        TestClock()
+            : m_simulation_clock(1000)
+            , m_timestamp(1000)
+        {
+            m_simulation_clock.Update(MakeFrame());
+        }
+
+        void Advance()
+        {
+            m_timestamp++;
+            m_simulation_clock.Update(MakeFrame());
+        }
+
+        mono::UpdateContext MakeFrame() const
+        {
+            mono::UpdateContext update_context = {};
+            update_context.timestamp = m_timestamp;
+            return update_context;
+        }
+
+        game::SimulationClock m_simulation_clock;
+        uint32_t m_timestamp;
+    };
+}
+
+TEST(EntityLogicSystemTest, CreateUpdateRelease)
+{
+    TestClock clock;
+    game::EntityLogicSystem logic_system(100, &clock.m_simulation_clock);
+
+    int n_bullet_updates = 0;
+    int n_enemy_updates = 0;
+
+    for(uint32_t entity_id = 0; entity_id < 100; ++entity_id)
+    {
+        if(entity_id % 2 == 0)
+            logic_system.CreateLogic<TestBulletLogic>(entity_id, entity_id, &n_bullet_updates);
+        else
+            logic_system.CreateLogic<TestEnemyLogic>(entity_id, entity_id, &n_enemy_updates);
+    }
+
+    clock.Advance();
+    logic_system.ScheduledUpdate(clock.MakeFrame());
+    EXPECT_EQ(50, n_bullet_updates);
+    EXPECT_EQ(50, n_enemy_updates);
+
+    for(uint32_t entity_id = 0; entity_id < 100; entity_id += 4)
+        logic_system.ReleaseLogic(entity_id);
+
+    clock.Advance();
+    logic_system.ScheduledUpdate(clock.MakeFrame());
+    EXPECT_EQ(75, n_bullet_updates);
+    EXPECT_EQ(100, n_enemy_updates);
+
+    // Reuses the released slots.
+    TestBulletLogic* reused = logic_system.CreateLogic<TestBulletLogic>(0, 0, &n_bullet_updates);
+    EXPECT_EQ(0u, reused->m_entity_id);
+
+    for(uint32_t entity_id = 0; entity_id < 100; ++entity_id)
+    {
+        if(entity_id % 4 != 0 || entity_id == 0)
+            logic_system.ReleaseLogic(entity_id);
+    }
+}
+
+TEST(EntityLogicSystemTest, ReleaseWhileUpdating)
+{
+    TestClock clock;
+    game::EntityLogicSystem logic_system(10, &clock.m_simulation_clock);
+
+    int n_updates = 0;
+    logic_system.CreateLogic<TestReleasingLogic>(0, 0, &logic_system, 1);
+    logic_system.CreateLogic<TestBulletLogic>(1, 1, &n_updates);
+    logic_system.CreateLogic<TestBulletLogic>(2, 2, &n_updates);
+
+    // Depending on the bucket order the released bullet might have updated before it was released.
+    clock.Advance();
+    logic_system.ScheduledUpdate(clock.MakeFrame());
+    const int n_first_updates = n_updates;
+    EXPECT_TRUE(n_first_updates == 1 || n_first_updates == 2);
+
+    clock.Advance();
+    logic_system.ScheduledUpdate(clock.MakeFrame());
+    EXPECT_EQ(n_first_updates + 1, n_updates);
+
+    logic_system.ReleaseLogic(2);
+}
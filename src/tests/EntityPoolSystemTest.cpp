@@ -0,0 +1,86 @@
+
+#include "gtest/gtest.h"
+
+#include "Entity/EntityPoolSystem.h"
+#include "Entity/LoadEntity.h"
+#include "Component.h"
+#include "EntitySystem/EntitySystem.h"
+#include "SystemContext.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+    std::string WriteEntityFile(const char* name)
+    {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+        std::ofstream(path) << R"({ "entities": [ { "name": "pooled", "entity_properties": 0, "components": [] } ] })";
+        return path.string();
+    }
+
+    struct PoolTestContext
+    {
+        PoolTestContext()
+        {
+            entity_system = system_context.CreateSystem<mono::EntitySystem>(16, &system_context, shared::LoadEntityFile, ComponentNameFromHash);
+            entity_pool = system_context.CreateSystem<game::EntityPoolSystem>(entity_system, &system_context);
+        }
+
+        mono::SystemContext system_context;
+        mono::EntitySystem* entity_system;
+        game::EntityPoolSystem* entity_pool;
+    };
+}
+
+TEST(EntityPoolSystemTest, WarmUpCreatesIdleEntities)
+{
+    const std::string entity_file = WriteEntityFile("pool_warm_up_test.entity");
+    PoolTestContext context;
+
+    context.entity_pool->WarmUp(entity_file.c_str(), 3);
+
+    const uint32_t first_id = context.entity_pool->SpawnEntity(entity_file.c_str());
+    const uint32_t second_id = context.entity_pool->SpawnEntity(entity_file.c_str());
+    EXPECT_NE(first_id, second_id);
+    EXPECT_FALSE(context.entity_pool->IsPooled(first_id));
+    EXPECT_FALSE(context.entity_pool->IsPooled(second_id));
+
+    // Taken out of the pool, not created by the entity manager.
+    EXPECT_EQ(2u, context.entity_pool->GetSpawnEvents().size());
+    EXPECT_TRUE(context.entity_pool->GetSpawnEvents()[0].spawned);
+
+    context.entity_pool->ReleaseIdleEntities();
+    std::filesystem::remove(entity_file);
+}
+
+TEST(EntityPoolSystemTest, ReleasedEntityIsReused)
+{
+    const std::string entity_file = WriteEntityFile("pool_reuse_test.entity");
+    PoolTestContext context;
+
+    const uint32_t entity_id = context.entity_pool->SpawnEntity(entity_file.c_str());
+    EXPECT_FALSE(context.entity_pool->IsPooled(entity_id));
+
+    // Deactivated in Sync, releasing twice in the same frame is the same as once.
+    context.entity_pool->ReleaseEntity(entity_id);
+    context.entity_pool->ReleaseEntity(entity_id);
+    EXPECT_FALSE(context.entity_pool->IsPooled(entity_id));
+
+    context.entity_pool->Sync();
+    EXPECT_TRUE(context.entity_pool->IsPooled(entity_id));
+    ASSERT_EQ(1u, context.entity_pool->GetSpawnEvents().size());
+    EXPECT_FALSE(context.entity_pool->GetSpawnEvents()[0].spawned);
+
+    context.entity_pool->Sync();
+    EXPECT_EQ(entity_id, context.entity_pool->SpawnEntity(entity_file.c_str()));
+    EXPECT_FALSE(context.entity_pool->IsPooled(entity_id));
+
+    context.entity_pool->ReleaseEntity(entity_id);
+    context.entity_pool->Sync();
+    context.entity_pool->ReleaseIdleEntities();
+    EXPECT_FALSE(context.entity_pool->IsPooled(entity_id));
+
+    std::filesystem::remove(entity_file);
+}
@@ -0,0 +1,46 @@
+
+#include "gtest/gtest.h"
+
+#include "InteractionSystem/InteractionGrid.h"
+#include "Math/MathFunctions.h"
+
+#include <vector>
+
+namespace
+{
+    math::Quad MakeBounds(float x, float y, float size)
+    {
+        return math::Quad(math::Vector(x, y), math::Vector(x + size, y + size));
+    }
+}
+
+TEST(InteractionGridTest, QueryInsertAndMove)
+{
+    game::InteractionGrid grid(4.0f);
+
+    grid.Insert(3, MakeBounds(1.0f, 1.0f, 1.0f));
+    grid.Insert(1, MakeBounds(-2.0f, -2.0f, 1.0f));
+    grid.Insert(7, MakeBounds(3.0f, 3.0f, 3.0f));   // Spans four cells.
+    grid.Insert(9, MakeBounds(100.0f, 100.0f, 1.0f));
+
+    std::vector<uint32_t> found;
+    grid.Query(MakeBounds(-3.0f, -3.0f, 7.0f), found);
+    EXPECT_EQ(std::vector<uint32_t>({ 1, 3, 7 }), found);
+
+    found.clear();
+    grid.Query(MakeBounds(5.0f, 5.0f, 0.5f), found);
+    EXPECT_EQ(std::vector<uint32_t>({ 7 }), found);
+
+    grid.Insert(9, MakeBounds(1.5f, 1.5f, 1.0f));
+    grid.Remove(3);
+    EXPECT_FALSE(grid.Contains(3));
+    EXPECT_TRUE(grid.Contains(9));
+
+    found.clear();
+    grid.Query(MakeBounds(0.0f, 0.0f, 2.0f), found);
+    EXPECT_EQ(std::vector<uint32_t>({ 9 }), found);
+
+    found.clear();
+    grid.Query(MakeBounds(99.0f, 99.0f, 5.0f), found);
+    EXPECT_TRUE(found.empty());
+}
@@ -0,0 +1,95 @@
+
+#include "gtest/gtest.h"
+
+#include "Entity/LoadEntity.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+    std::string WriteEntityFile(const char* name, const char* entity_name)
+    {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+
+        std::ofstream file(path);
+        file << R"({ "entities": [ { "name": ")" << entity_name << R"(", "uuid_hash": 1, "components": [] } ] })";
+
+        return path.string();
+    }
+}
+
+TEST(LoadEntityTest, TemplateIsCachedUntilCleared)
+{
+    shared::ClearEntityFileCache();
+
+    const std::string entity_file = WriteEntityFile("load_entity_test.entity", "first");
+    EXPECT_EQ("first", shared::LoadEntityFile(entity_file.c_str()).entity_name);
+
+    // The cached template is returned even though the file changed.
+    WriteEntityFile("load_entity_test.entity", "second");
+    EXPECT_EQ("first", shared::LoadEntityFile(entity_file.c_str()).entity_name);
+
+    shared::ClearEntityFileCache();
+    EXPECT_EQ("second", shared::LoadEntityFile(entity_file.c_str()).entity_name);
+
+    std::filesystem::remove(entity_file);
+    shared::ClearEntityFileCache();
+}
+
+TEST(LoadEntityTest, ReloadPicksUpChangedFiles)
+{
+    shared::ClearEntityFileCache();
+    shared::SetEntityFileReload(true);
+
+    const std::string entity_file = WriteEntityFile("load_entity_reload_test.entity", "first");
+    EXPECT_EQ("first", shared::LoadEntityFile(entity_file.c_str()).entity_name);
+
+    // Make sure the modification time differs on file systems with coarse time stamps.
+    WriteEntityFile("load_entity_reload_test.entity", "second");
+    std::filesystem::last_write_time(entity_file, std::filesystem::last_write_time(entity_file) + std::chrono::seconds(2));
+    EXPECT_EQ("second", shared::LoadEntityFile(entity_file.c_str()).entity_name);
+
+    shared::SetEntityFileReload(false);
+    std::filesystem::remove(entity_file);
+    shared::ClearEntityFileCache();
+}
+
+TEST(LoadEntityTest, PreloadedFilesAreCached)
+{
+    shared::ClearEntityFileCache();
+
+    const std::string entity_file = WriteEntityFile("load_entity_preload_test.entity", "first");
+
+    const std::filesystem::path list_path = std::filesystem::temp_directory_path() / "load_entity_preload_list.json";
+    {
+        std::ofstream list_file(list_path);
+        list_file << R"({ "all_entities": [ ")" << entity_file << R"(" ] })";
+    }
+
+    const std::vector<std::string> entity_files = shared::ReadEntityFileList(list_path.string().c_str());
+    ASSERT_EQ(1u, entity_files.size());
+    EXPECT_EQ(entity_file, entity_files[0]);
+
+    for(const std::string& file : entity_files)
+        shared::PreloadEntityFile(file.c_str());
+
+    // Changed after the preload, the preloaded template is used.
+    WriteEntityFile("load_entity_preload_test.entity", "second");
+    EXPECT_EQ("first", shared::LoadEntityFile(entity_file.c_str()).entity_name);
+
+    EXPECT_TRUE(shared::ReadEntityFileList("res/entities/does_not_exist.json").empty());
+
+    std::filesystem::remove(list_path);
+    std::filesystem::remove(entity_file);
+    shared::ClearEntityFileCache();
+}
+
+TEST(LoadEntityTest, MissingFileGivesEmptyData)
+{
+    const mono::EntityData entity_data = shared::LoadEntityFile("res/entities/does_not_exist.entity");
+    EXPECT_TRUE(entity_data.entity_name.empty());
+    EXPECT_TRUE(entity_data.entity_components.empty());
+}
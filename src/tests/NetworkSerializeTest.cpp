@@ -4,6 +4,9 @@
 #include "System/Network.h"
 #include "Network/NetworkMessage.h"
 #include "Network/NetworkSerialize.h"
+#include "Network/JoinSnapshot.h"
+
+#include <algorithm>
 
 TEST(Network, SingleSerialize)
 {
@@ -106,3 +109,144 @@ TEST(Network, SerializeText)
     EXPECT_STREQ("hello world!", deserialized_text1.text);
     EXPECT_STREQ("Goodbye cansas!", deserialized_text2.text);
 }
+
+TEST(Network, MessageBufferIterator)
+{
+    game::PingMessage ping_message;
+    ping_message.local_time = 123;
+
+    game::TextMessage text_message;
+    std::sprintf(text_message.text, "iterate me");
+
+    std::vector<byte> message_buffer;
+    game::PrepareMessageBuffer(message_buffer);
+
+    EXPECT_TRUE(game::SerializeMessageToBuffer(ping_message, message_buffer));
+    EXPECT_TRUE(game::SerializeMessageToBuffer(text_message, message_buffer));
+
+    game::MessageBufferIterator message_iterator(message_buffer);
+    EXPECT_EQ(2u, message_iterator.MessageCount());
+
+    byte_view message_view;
+
+    EXPECT_TRUE(message_iterator.Next(message_view));
+    game::PingMessage deserialized_ping;
+    EXPECT_TRUE(game::DeserializeMessage(message_view, deserialized_ping));
+    EXPECT_EQ(123u, deserialized_ping.local_time);
+
+    EXPECT_TRUE(message_iterator.Next(message_view));
+    game::TextMessage deserialized_text;
+    EXPECT_TRUE(game::DeserializeMessage(message_view, deserialized_text));
+    EXPECT_STREQ("iterate me", deserialized_text.text);
+
+    EXPECT_FALSE(message_iterator.Next(message_view));
+}
+
+TEST(Network, MessageBufferPoolRecycles)
+{
+    std::vector<byte> warmup_buffer = game::SerializeMessage(game::ServerQuitMessage());
+    game::ReleaseMessageBuffer(std::move(warmup_buffer));
+
+    const game::NetworkBufferPoolStats stats_before = game::GetMessageBufferPoolStats();
+
+    for(int index = 0; index < 100; ++index)
+    {
+        std::vector<byte> message_buffer = game::SerializeMessage(game::ServerQuitMessage());
+        EXPECT_EQ(1u, game::GetMessageBufferHeader(message_buffer).n_messages);
+        game::ReleaseMessageBuffer(std::move(message_buffer));
+    }
+
+    const game::NetworkBufferPoolStats stats_after = game::GetMessageBufferPoolStats();
+    EXPECT_EQ(stats_before.allocated_buffers, stats_after.allocated_buffers);
+}
+
+TEST(Network, JoinSnapshotRoundtrip)
+{
+    game::JoinSnapshot snapshot;
+    snapshot.timestamp = 1234;
+
+    for(uint16_t index = 0; index < 300; ++index)
+    {
+        game::TransformMessage& transform_message = snapshot.transforms.emplace_back();
+        transform_message.timestamp = snapshot.timestamp;
+        transform_message.entity_id = index;
+        transform_message.parent_transform = 0;
+        transform_message.position = math::Vector(index, index * 2.0f);
+        transform_message.rotation = 0.0f;
+
+        game::DamageInfoMessage& damage_info = snapshot.damage_infos.emplace_back();
+        damage_info.entity_id = index;
+        damage_info.health = 100;
+        damage_info.full_health = 100;
+        damage_info.is_boss = false;
+        damage_info.damage_timestamp = 0;
+    }
+
+    const game::CompressedSnapshot compressed = game::CompressJoinSnapshot(snapshot);
+    EXPECT_LT(compressed.data.size(), compressed.uncompressed_size);
+
+    // Deliver the fragments out of order and with a duplicate, like the network might.
+    const uint16_t n_fragments = game::NumberOfSnapshotFragments(compressed.data.size());
+    EXPECT_GT(n_fragments, 1u);
+
+    game::SnapshotAssembler assembler;
+
+    for(int index = n_fragments - 1; index >= -1; --index)
+    {
+        const uint16_t fragment_index = (index < 0) ? 0 : index;
+        const uint32_t offset = fragment_index * game::SnapshotFragmentSize;
+
+        game::SnapshotFragmentMessage fragment;
+        fragment.snapshot_id = 7;
+        fragment.uncompressed_size = compressed.uncompressed_size;
+        fragment.compressed_size = compressed.data.size();
+        fragment.version = game::JoinSnapshotVersion;
+        fragment.fragment_index = fragment_index;
+        fragment.n_fragments = n_fragments;
+        fragment.data_size = std::min<uint32_t>(game::SnapshotFragmentSize, compressed.data.size() - offset);
+        std::memcpy(fragment.data, compressed.data.data() + offset, fragment.data_size);
+
+        EXPECT_TRUE(assembler.AddFragment(fragment));
+    }
+
+    EXPECT_TRUE(assembler.IsComplete());
+
+    game::JoinSnapshot read_snapshot;
+    const bool success = game::DecompressJoinSnapshot(
+        assembler.Data().data(), assembler.Data().size(), assembler.UncompressedSize(), read_snapshot);
+    EXPECT_TRUE(success);
+
+    EXPECT_EQ(snapshot.timestamp, read_snapshot.timestamp);
+    EXPECT_EQ(snapshot.transforms.size(), read_snapshot.transforms.size());
+    EXPECT_EQ(snapshot.damage_infos.size(), read_snapshot.damage_infos.size());
+    EXPECT_TRUE(read_snapshot.sprites.empty());
+    EXPECT_EQ(299u, read_snapshot.transforms.back().entity_id);
+    EXPECT_FLOAT_EQ(598.0f, read_snapshot.transforms.back().position.y);
+}
+
+TEST(Network, JoinSnapshotRejectsOversizedFragments)
+{
+    const uint32_t compressed_size = game::JoinSnapshotMaxSize + game::SnapshotFragmentSize;
+
+    game::SnapshotFragmentMessage fragment;
+    fragment.snapshot_id = 7;
+    fragment.uncompressed_size = 1000;
+    fragment.compressed_size = compressed_size;
+    fragment.version = game::JoinSnapshotVersion;
+    fragment.fragment_index = 0;
+    fragment.n_fragments = game::NumberOfSnapshotFragments(compressed_size);
+    fragment.data_size = game::SnapshotFragmentSize;
+
+    game::SnapshotAssembler assembler;
+    EXPECT_FALSE(assembler.AddFragment(fragment));
+    EXPECT_TRUE(assembler.Data().empty());
+
+    fragment.compressed_size = game::SnapshotFragmentSize;
+    fragment.n_fragments = 1;
+    fragment.uncompressed_size = game::JoinSnapshotMaxSize + 1;
+    EXPECT_FALSE(assembler.AddFragment(fragment));
+
+    const byte data[4] = { 0 };
+    game::JoinSnapshot snapshot;
+    EXPECT_FALSE(game::DecompressJoinSnapshot(data, std::size(data), game::JoinSnapshotMaxSize + 1, snapshot));
+}
@@ -2,6 +2,7 @@
 #include "gtest/gtest.h"
 
 #include "PredictionSystem/PositionPredictionSystem.h"
+#include "Network/NetworkMessage.h"
 
 TEST(PredictionSystemTest, FindBestPredictionIndex)
 {
@@ -26,3 +27,24 @@ TEST(PredictionSystemTest, FindBestPredictionIndex)
     EXPECT_EQ(6u, best_index_3);
     EXPECT_EQ(7u, best_index_4);
 }
+
+TEST(PredictionSystemTest, RejectsEntitiesOutsideOfTheRecords)
+{
+    game::PositionPredictionSystem prediction_system(4, nullptr, nullptr);
+    ASSERT_EQ(4u, prediction_system.m_prediction_data.size());
+
+    game::TransformMessage transform_message = {};
+    transform_message.timestamp = 100;
+    transform_message.position = math::Vector(1.0f, 2.0f);
+
+    transform_message.entity_id = 3;
+    prediction_system.HandlePredicitonMessage(transform_message);
+    EXPECT_EQ(100u, prediction_system.m_prediction_data[3].prediction_buffer.back().timestamp);
+
+    // An id from the network past the transform system capacity does not grow the records.
+    transform_message.entity_id = 60000;
+    prediction_system.HandlePredicitonMessage(transform_message);
+    prediction_system.ClearPredictionsForEntity(60000);
+    EXPECT_EQ(4u, prediction_system.m_prediction_data.size());
+    EXPECT_FALSE(prediction_system.EnsureRecord(4));
+}
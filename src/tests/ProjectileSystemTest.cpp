@@ -0,0 +1,185 @@
+
+#include "gtest/gtest.h"
+
+#include "Weapons/ProjectileSystem.h"
+#include "SimulationClock.h"
+
+namespace
+{
+    // Ten millisecond ticks, one tick per frame.
+    class TestClock
+    {
+    public:
+
+        TestClock()
+            : m_simulation_clock(100)
+            , m_timestamp(1000)
+        {
+            m_simulation_clock.Update(MakeFrame());
+        }
+
+        void Advance()
+        {
+            m_timestamp += 10;
+            m_simulation_clock.Update(MakeFrame());
+        }
+
+        mono::UpdateContext MakeFrame() const
+        {
+            mono::UpdateContext update_context = {};
+            update_context.timestamp = m_timestamp;
+            return update_context;
+        }
+
+        game::SimulationClock m_simulation_clock;
+        uint32_t m_timestamp;
+    };
+}
+
+// Visual projectiles never touch the physics space, so no physics system is needed.
+TEST(ProjectileSystemTest, VisualProjectilesMoveAndTimeOut)
+{
+    TestClock clock;
+    game::ProjectileSystem projectile_system(16, nullptr, &clock.m_simulation_clock);
+
+    const uint32_t short_id = projectile_system.SpawnVisualProjectile(1, 0, math::Vector(0.0f, 0.0f), math::Vector(10.0f, 0.0f), 50);
+    const uint32_t long_id = projectile_system.SpawnVisualProjectile(2, 0, math::Vector(0.0f, 1.0f), math::Vector(0.0f, 10.0f), 200);
+    EXPECT_EQ(2u, projectile_system.ActiveProjectiles());
+
+    for(int frame = 0; frame < 10; ++frame)
+    {
+        clock.Advance();
+        projectile_system.ScheduledUpdate(clock.MakeFrame());
+    }
+
+    EXPECT_FALSE(projectile_system.IsAlive(short_id));
+    EXPECT_TRUE(projectile_system.IsAlive(long_id));
+    EXPECT_EQ(1u, projectile_system.ActiveProjectiles());
+
+    const auto check_position = [](const math::Vector& position, const math::Vector& velocity, uint32_t sprite_hash, uint8_t flags) {
+        EXPECT_EQ(2u, sprite_hash);
+        EXPECT_TRUE(flags & game::ProjectileFlags::VISUAL_ONLY);
+        EXPECT_NEAR(0.0f, position.x, 0.001f);
+        EXPECT_NEAR(2.0f, position.y, 0.001f);
+    };
+    projectile_system.ForEachProjectile(check_position);
+
+    for(int frame = 0; frame < 15; ++frame)
+    {
+        clock.Advance();
+        projectile_system.ScheduledUpdate(clock.MakeFrame());
+    }
+    EXPECT_EQ(0u, projectile_system.ActiveProjectiles());
+}
+
+TEST(ProjectileSystemTest, ReleaseKeepsOtherIdsValid)
+{
+    TestClock clock;
+    game::ProjectileSystem projectile_system(4, nullptr, &clock.m_simulation_clock);
+
+    uint32_t ids[4];
+    for(uint32_t index = 0; index < 4; ++index)
+        ids[index] = projectile_system.SpawnVisualProjectile(index, 0, math::Vector(float(index), 0.0f), math::Vector(), 1000);
+
+    const uint32_t no_room = projectile_system.SpawnVisualProjectile(0, 0, math::Vector(), math::Vector(), 1000);
+    EXPECT_FALSE(projectile_system.IsAlive(no_room));
+
+    projectile_system.ReleaseProjectile(ids[1]);
+    EXPECT_FALSE(projectile_system.IsAlive(ids[1]));
+
+    projectile_system.RedirectProjectile(ids[3], math::Vector(5.0f, 5.0f), math::Vector());
+
+    uint32_t n_found = 0;
+    const auto check_position = [&n_found](const math::Vector& position, const math::Vector& velocity, uint32_t sprite_hash, uint8_t flags) {
+        if(sprite_hash == 3)
+            EXPECT_FLOAT_EQ(5.0f, position.x);
+        else
+            EXPECT_FLOAT_EQ(float(sprite_hash), position.x);
+        n_found++;
+    };
+    projectile_system.ForEachProjectile(check_position);
+    EXPECT_EQ(3u, n_found);
+
+    projectile_system.ReleaseAllProjectiles();
+    EXPECT_EQ(0u, projectile_system.ActiveProjectiles());
+}
+
+TEST(ProjectileSystemTest, CallbackCanReuseTheProjectileId)
+{
+    TestClock clock;
+    game::ProjectileSystem projectile_system(4, nullptr, &clock.m_simulation_clock);
+
+    // Not moving, so the projectile times out without sweeping the physics space.
+    uint32_t projectile_id = 0;
+    uint32_t respawned_id = 0;
+    int n_callbacks = 0;
+
+    game::BulletConfiguration config;
+    config.life_span = 0.05f;
+    config.collision_callback = [&](uint32_t owner_id, game::BulletCollisionFlag flags, const game::CollisionDetails& details) {
+        n_callbacks++;
+        projectile_system.ReleaseProjectile(projectile_id);
+        respawned_id = projectile_system.SpawnVisualProjectile(1, 0, math::Vector(0.0f, 0.0f), math::Vector(0.0f, 0.0f), 1000);
+    };
+
+    const uint32_t projectile_type = projectile_system.RegisterProjectileType(config);
+    projectile_id = projectile_system.SpawnProjectile(projectile_type, 0, math::Vector(0.0f, 0.0f), math::Vector(0.0f, 0.0f));
+
+    for(int frame = 0; frame < 10; ++frame)
+    {
+        clock.Advance();
+        projectile_system.ScheduledUpdate(clock.MakeFrame());
+    }
+
+    // The new projectile got the released id and is left alone.
+    EXPECT_EQ(1, n_callbacks);
+    EXPECT_EQ(projectile_id, respawned_id);
+    EXPECT_TRUE(projectile_system.IsAlive(respawned_id));
+    EXPECT_EQ(1u, projectile_system.ActiveProjectiles());
+}
+
+TEST(ProjectileSystemTest, HitBehaviours)
+{
+    using game::BulletCollisionBehaviour;
+
+    const game::ProjectileHitResponse normal = game::ProjectileHitBehaviour(BulletCollisionBehaviour::NORMAL, false, 3);
+    EXPECT_EQ(game::APPLY_DAMAGE | game::DESTROY_THIS, normal.collision_flags);
+    EXPECT_FALSE(normal.reflect || normal.jump || normal.remember_hit);
+
+    // Bounces off walls while it has bounces left, destroyed by anything else.
+    const game::ProjectileHitResponse bounce_wall = game::ProjectileHitBehaviour(BulletCollisionBehaviour::BOUNCE, true, 1);
+    EXPECT_EQ(0, bounce_wall.collision_flags);
+    EXPECT_TRUE(bounce_wall.reflect);
+
+    const game::ProjectileHitResponse bounce_last = game::ProjectileHitBehaviour(BulletCollisionBehaviour::BOUNCE, true, 0);
+    EXPECT_EQ(game::APPLY_DAMAGE | game::DESTROY_THIS, bounce_last.collision_flags);
+    EXPECT_FALSE(bounce_last.reflect);
+
+    const game::ProjectileHitResponse bounce_body = game::ProjectileHitBehaviour(BulletCollisionBehaviour::BOUNCE, false, 3);
+    EXPECT_EQ(game::APPLY_DAMAGE | game::DESTROY_THIS, bounce_body.collision_flags);
+    EXPECT_FALSE(bounce_body.reflect);
+
+    // Jumps between bodies, walls and running out of jumps end it.
+    const game::ProjectileHitResponse jumper_body = game::ProjectileHitBehaviour(BulletCollisionBehaviour::JUMPER, false, 2);
+    EXPECT_EQ(game::APPLY_DAMAGE, jumper_body.collision_flags);
+    EXPECT_TRUE(jumper_body.jump);
+    EXPECT_TRUE(jumper_body.remember_hit);
+
+    const game::ProjectileHitResponse jumper_wall = game::ProjectileHitBehaviour(BulletCollisionBehaviour::JUMPER, true, 2);
+    EXPECT_EQ(game::APPLY_DAMAGE | game::DESTROY_THIS, jumper_wall.collision_flags);
+    EXPECT_FALSE(jumper_wall.jump);
+
+    const game::ProjectileHitResponse jumper_last = game::ProjectileHitBehaviour(BulletCollisionBehaviour::JUMPER, false, 0);
+    EXPECT_EQ(game::APPLY_DAMAGE | game::DESTROY_THIS, jumper_last.collision_flags);
+    EXPECT_FALSE(jumper_last.jump);
+
+    // Goes through bodies once each, stopped by walls.
+    const game::ProjectileHitResponse pass_body = game::ProjectileHitBehaviour(BulletCollisionBehaviour::PASS_THROUGH, false, 0);
+    EXPECT_EQ(game::APPLY_DAMAGE, pass_body.collision_flags);
+    EXPECT_TRUE(pass_body.remember_hit);
+    EXPECT_FALSE(pass_body.reflect || pass_body.jump);
+
+    const game::ProjectileHitResponse pass_wall = game::ProjectileHitBehaviour(BulletCollisionBehaviour::PASS_THROUGH, true, 0);
+    EXPECT_EQ(game::APPLY_DAMAGE | game::DESTROY_THIS, pass_wall.collision_flags);
+    EXPECT_FALSE(pass_wall.remember_hit);
+}
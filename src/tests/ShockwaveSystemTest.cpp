@@ -0,0 +1,157 @@
+
+#include "gtest/gtest.h"
+
+#include "ShockwaveSystem.h"
+
+#include <vector>
+
+namespace
+{
+    game::ShockwaveBody MakeBody(uint32_t entity_id, const math::Vector& position, float half_size = 0.0f)
+    {
+        const math::Vector half_extent(half_size, half_size);
+        return { entity_id, position, math::Quad(position - half_extent, position + half_extent) };
+    }
+}
+
+TEST(ShockwaveSystemTest, Falloff)
+{
+    EXPECT_FLOAT_EQ(1.0f, game::ShockwaveFalloff(game::FalloffCurve::CONSTANT, 2.0f, 4.0f));
+    EXPECT_FLOAT_EQ(0.5f, game::ShockwaveFalloff(game::FalloffCurve::LINEAR, 2.0f, 4.0f));
+    EXPECT_FLOAT_EQ(0.25f, game::ShockwaveFalloff(game::FalloffCurve::QUADRATIC, 2.0f, 4.0f));
+    EXPECT_FLOAT_EQ(0.0f, game::ShockwaveFalloff(game::FalloffCurve::CONSTANT, 4.5f, 4.0f));
+}
+
+TEST(ShockwaveSystemTest, OverlappingShockwavesAreSummed)
+{
+    std::vector<game::ShockwaveParams> shockwaves(3);
+    shockwaves[0].position = math::Vector(0.0f, 0.0f);
+    shockwaves[0].magnitude = 10.0f;
+    shockwaves[0].damage = 10;
+    shockwaves[0].who_did_damage = 7;
+
+    shockwaves[1].position = math::Vector(4.0f, 0.0f);
+    shockwaves[1].magnitude = 10.0f;
+    shockwaves[1].impulse_falloff = game::FalloffCurve::LINEAR;
+    shockwaves[1].damage = 20;
+    shockwaves[1].damage_falloff = game::FalloffCurve::LINEAR;
+    shockwaves[1].who_did_damage = 7;
+
+    shockwaves[2].position = math::Vector(2.0f, 2.0f);
+    shockwaves[2].radius = 1.0f;
+    shockwaves[2].damage = 5;
+    shockwaves[2].who_did_damage = 8;
+
+    const std::vector<game::ShockwaveBody> bodies = {
+        MakeBody(1, math::Vector(2.0f, 0.0f)),     // Between the first two.
+        MakeBody(2, math::Vector(0.0f, 0.0f)),     // Right at the center of the first.
+        MakeBody(3, math::Vector(2.0f, 2.5f)),     // Only in the third.
+        MakeBody(4, math::Vector(20.0f, 0.0f)),    // Outside of all.
+    };
+
+    std::vector<game::ShockwaveImpulse> impulses;
+    std::vector<game::ShockwaveDamage> damage;
+    game::AccumulateShockwaves(shockwaves, bodies, impulses, damage);
+
+    ASSERT_EQ(4u, impulses.size());
+    EXPECT_FLOAT_EQ(10.0f - 10.0f / 3.0f, impulses[0].impulse.x);
+    EXPECT_FLOAT_EQ(0.0f, impulses[0].impulse.y);
+    EXPECT_FLOAT_EQ(0.0f, impulses[1].impulse.x);
+    EXPECT_FLOAT_EQ(0.0f, impulses[2].impulse.x);
+    EXPECT_FLOAT_EQ(0.0f, impulses[3].impulse.x);
+
+    // The first body takes 10 + 20 * 1/3 from the same dealer, in one entry.
+    ASSERT_EQ(3u, damage.size());
+    EXPECT_EQ(1u, damage[0].entity_id);
+    EXPECT_EQ(7u, damage[0].who_did_damage);
+    EXPECT_EQ(17, damage[0].damage);
+    EXPECT_EQ(2u, damage[1].entity_id);
+    EXPECT_EQ(10, damage[1].damage);
+    EXPECT_EQ(3u, damage[2].entity_id);
+    EXPECT_EQ(8u, damage[2].who_did_damage);
+    EXPECT_EQ(5, damage[2].damage);
+}
+
+TEST(ShockwaveSystemTest, OverlappingShockwavesAreClustered)
+{
+    std::vector<game::ShockwaveParams> shockwaves(4);
+    shockwaves[0].position = math::Vector(0.0f, 0.0f);
+    shockwaves[1].position = math::Vector(15.0f, 0.0f);
+    shockwaves[2].position = math::Vector(10.0f, 0.0f);
+    shockwaves[3].position = math::Vector(5.0f, 0.0f);
+
+    // The third overlaps the second and the fourth overlaps the first and the third, so all four end up in
+    // one cluster. The first two alone are apart.
+    std::vector<math::Quad> bounds;
+    game::ClusterShockwaves({ shockwaves[0], shockwaves[1] }, bounds);
+    EXPECT_EQ(2u, bounds.size());
+
+    bounds.clear();
+    game::ClusterShockwaves(shockwaves, bounds);
+    ASSERT_EQ(1u, bounds.size());
+    EXPECT_FLOAT_EQ(-3.0f, bounds[0].mA.x);
+    EXPECT_FLOAT_EQ(-3.0f, bounds[0].mA.y);
+    EXPECT_FLOAT_EQ(18.0f, bounds[0].mB.x);
+    EXPECT_FLOAT_EQ(3.0f, bounds[0].mB.y);
+}
+
+TEST(ShockwaveSystemTest, ReachIsMeasuredToTheBounds)
+{
+    std::vector<game::ShockwaveParams> shockwaves(1);
+    shockwaves[0].position = math::Vector(0.0f, 0.0f);
+    shockwaves[0].magnitude = 10.0f;
+    shockwaves[0].impulse_falloff = game::FalloffCurve::LINEAR;
+    shockwaves[0].damage = 10;
+
+    // The center of the large body is out of reach, its side is 1 meter from the center.
+    const std::vector<game::ShockwaveBody> bodies = {
+        MakeBody(1, math::Vector(5.0f, 0.0f), 4.0f),
+        MakeBody(2, math::Vector(5.0f, 0.0f)),
+    };
+
+    std::vector<game::ShockwaveImpulse> impulses;
+    std::vector<game::ShockwaveDamage> damage;
+    game::AccumulateShockwaves(shockwaves, bodies, impulses, damage);
+
+    ASSERT_EQ(2u, impulses.size());
+    EXPECT_FLOAT_EQ(10.0f * 2.0f / 3.0f, impulses[0].impulse.x);
+    EXPECT_FLOAT_EQ(0.0f, impulses[1].impulse.x);
+
+    ASSERT_EQ(1u, damage.size());
+    EXPECT_EQ(1u, damage[0].entity_id);
+}
+
+TEST(ShockwaveSystemTest, ImpulseOffTheCenterSpins)
+{
+    std::vector<game::ShockwaveParams> shockwaves(2);
+    shockwaves[0].position = math::Vector(-2.0f, 1.0f);
+    shockwaves[0].magnitude = 10.0f;
+    shockwaves[1].position = math::Vector(0.0f, -2.5f);
+    shockwaves[1].magnitude = 4.0f;
+
+    const std::vector<game::ShockwaveBody> bodies = {
+        MakeBody(1, math::Vector(0.0f, 0.0f), 1.0f),
+        MakeBody(2, math::Vector(0.0f, 1.0f), 0.0f),
+    };
+
+    std::vector<game::ShockwaveImpulse> impulses;
+    std::vector<game::ShockwaveDamage> damage;
+    game::AccumulateShockwaves(shockwaves, bodies, impulses, damage);
+
+    // The first is hit on the side at (-1, 1) and from below at (0, -1).
+    ASSERT_EQ(2u, impulses.size());
+    const game::ShockwaveImpulse& impulse = impulses[0];
+    EXPECT_FLOAT_EQ(10.0f, impulse.impulse.x);
+    EXPECT_FLOAT_EQ(4.0f, impulse.impulse.y);
+    EXPECT_FLOAT_EQ(-1.0f * 0.0f - 1.0f * 10.0f, impulse.torque);
+
+    // The single impulse at the point spins the body as much as both did.
+    const float offset_x = impulse.point.x - bodies[0].position.x;
+    const float offset_y = impulse.point.y - bodies[0].position.y;
+    EXPECT_FLOAT_EQ(impulse.torque, offset_x * impulse.impulse.y - offset_y * impulse.impulse.x);
+
+    // A body without bounds is pushed at its position.
+    EXPECT_FLOAT_EQ(0.0f, impulses[1].torque);
+    EXPECT_FLOAT_EQ(0.0f, impulses[1].point.x);
+    EXPECT_FLOAT_EQ(1.0f, impulses[1].point.y);
+}
@@ -0,0 +1,78 @@
+
+#include "gtest/gtest.h"
+
+#include "SimulationClock.h"
+
+namespace
+{
+    mono::UpdateContext MakeFrame(uint32_t timestamp)
+    {
+        mono::UpdateContext update_context = {};
+        update_context.timestamp = timestamp;
+        return update_context;
+    }
+}
+
+TEST(SimulationClockTest, FixedTicksFromVariableFrames)
+{
+    game::SimulationClock simulation_clock(60);
+
+    simulation_clock.Update(MakeFrame(1000));
+    EXPECT_EQ(0u, simulation_clock.TicksThisFrame());
+
+    // 8 ms frames, a tick every other frame.
+    uint32_t total_ticks = 0;
+    uint32_t total_tick_time = 0;
+
+    for(uint32_t frame = 1; frame <= 125; ++frame)
+    {
+        simulation_clock.Update(MakeFrame(1000 + frame * 8));
+
+        const auto tick_func = [&](const mono::UpdateContext& tick_context) {
+            EXPECT_TRUE(tick_context.delta_ms == 16 || tick_context.delta_ms == 17);
+            total_ticks++;
+            total_tick_time += tick_context.delta_ms;
+        };
+        game::ForEachSimulationTick(&simulation_clock, tick_func);
+
+        EXPECT_GE(simulation_clock.InterpolationAlpha(), 0.0f);
+        EXPECT_LT(simulation_clock.InterpolationAlpha(), 1.0f);
+    }
+
+    // One second of frames is exactly one second of ticks.
+    EXPECT_EQ(60u, total_ticks);
+    EXPECT_EQ(1000u, total_tick_time);
+    EXPECT_EQ(2000u, simulation_clock.FrameContext().timestamp);
+}
+
+TEST(SimulationClockTest, SlowFrameIsClamped)
+{
+    game::SimulationClock simulation_clock(60);
+
+    simulation_clock.Update(MakeFrame(1000));
+    simulation_clock.Update(MakeFrame(2000));
+
+    EXPECT_EQ(5u, simulation_clock.TicksThisFrame());
+
+    const mono::UpdateContext frame_context = simulation_clock.FrameContext();
+    // The dropped time is skipped so the simulation time stays close to the frame time.
+    EXPECT_NEAR(2000.0, double(frame_context.timestamp), 1.0);
+    EXPECT_EQ(83u, frame_context.delta_ms);
+}
+
+TEST(SimulationClockTest, TicksDontDriftOverLongSessions)
+{
+    game::SimulationClock simulation_clock(60);
+    simulation_clock.Update(MakeFrame(1000));
+
+    // An hour of 10 ms frames.
+    uint64_t total_ticks = 0;
+    for(uint32_t frame = 1; frame <= 360000; ++frame)
+    {
+        simulation_clock.Update(MakeFrame(1000 + frame * 10));
+        total_ticks += simulation_clock.TicksThisFrame();
+    }
+
+    EXPECT_EQ(60u * 60u * 60u, total_ticks);
+    EXPECT_EQ(1000u + 3600000u, simulation_clock.FrameContext().timestamp);
+}
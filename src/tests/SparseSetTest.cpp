@@ -0,0 +1,69 @@
+
+#include "gtest/gtest.h"
+
+#include "SparseSet.h"
+
+#include <vector>
+
+TEST(SparseSetTest, AddRemoveContains)
+{
+    game::SparseSet sparse_set(16);
+    EXPECT_TRUE(sparse_set.Empty());
+    EXPECT_EQ(16u, sparse_set.Capacity());
+
+    EXPECT_TRUE(sparse_set.Add(3));
+    EXPECT_TRUE(sparse_set.Add(7));
+    EXPECT_TRUE(sparse_set.Add(15));
+    EXPECT_FALSE(sparse_set.Add(7));
+    EXPECT_EQ(3u, sparse_set.Size());
+
+    EXPECT_TRUE(sparse_set.Contains(3));
+    EXPECT_FALSE(sparse_set.Contains(4));
+    EXPECT_FALSE(sparse_set.Contains(100));
+
+    EXPECT_TRUE(sparse_set.Remove(3));
+    EXPECT_FALSE(sparse_set.Remove(3));
+    EXPECT_FALSE(sparse_set.Contains(3));
+    EXPECT_TRUE(sparse_set.Contains(7));
+    EXPECT_TRUE(sparse_set.Contains(15));
+    EXPECT_EQ(2u, sparse_set.Size());
+
+    sparse_set.Clear();
+    EXPECT_TRUE(sparse_set.Empty());
+    EXPECT_FALSE(sparse_set.Contains(7));
+    EXPECT_TRUE(sparse_set.Add(7));
+}
+
+TEST(SparseSetTest, GrowsPastCapacity)
+{
+    game::SparseSet sparse_set(16);
+    EXPECT_TRUE(sparse_set.Add(3));
+    EXPECT_TRUE(sparse_set.Add(1000));
+    EXPECT_LE(1001u, sparse_set.Capacity());
+
+    EXPECT_TRUE(sparse_set.Contains(3));
+    EXPECT_TRUE(sparse_set.Contains(1000));
+    EXPECT_FALSE(sparse_set.Contains(999));
+    EXPECT_EQ(2u, sparse_set.Size());
+}
+
+TEST(SparseSetTest, RemoveWhileIterating)
+{
+    game::SparseSet sparse_set(100);
+    for(uint32_t id = 0; id < 100; id += 3)
+        sparse_set.Add(id);
+
+    uint32_t visited = 0;
+    const auto remove_even = [&](uint32_t id) {
+        visited++;
+        if(id % 2 == 0)
+            sparse_set.Remove(id);
+    };
+    sparse_set.ForEach(remove_even);
+
+    EXPECT_EQ(34u, visited);
+    EXPECT_EQ(17u, sparse_set.Size());
+
+    for(uint32_t id : sparse_set)
+        EXPECT_EQ(1u, id % 2);
+}
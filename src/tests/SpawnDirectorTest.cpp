@@ -0,0 +1,153 @@
+
+#include "gtest/gtest.h"
+
+#include "SpawnSystem/SpawnDirector.h"
+
+#include <vector>
+
+namespace
+{
+    game::SpawnDirector MakeDirector(uint32_t max_population, uint32_t max_spawn_point_population)
+    {
+        game::SpawnDirectorConfig config;
+        config.max_population = max_population;
+        config.max_spawn_point_population = max_spawn_point_population;
+        config.frame_budget_ms = 8.0f;
+
+        game::SpawnDirector director;
+        director.SetConfig(config);
+        director.SetDefinitions({
+            { 3, "res/entities/cacodemon.entity" },
+            { 1, "res/entities/goblin.entity" },
+        });
+
+        return director;
+    }
+}
+
+TEST(SpawnDirectorTest, PopulationCaps)
+{
+    game::SpawnDirector director = MakeDirector(5, 3);
+
+    EXPECT_EQ(game::SpawnDecision::SPAWN, director.RequestSpawn(1));
+    EXPECT_EQ(3u, director.SpawnRoom(1));
+
+    director.EntitySpawned(1, 100);
+    director.EntitySpawned(1, 101);
+    director.EntitySpawned(1, 102);
+    EXPECT_EQ(3u, director.Population(1));
+    EXPECT_EQ(0u, director.SpawnRoom(1));
+    EXPECT_EQ(game::SpawnDecision::SPAWN_POINT_CAPPED, director.RequestSpawn(1));
+
+    director.EntitySpawned(2, 200);
+    director.EntitySpawned(2, 201);
+    EXPECT_EQ(5u, director.Population());
+    EXPECT_EQ(game::SpawnDecision::POPULATION_CAPPED, director.RequestSpawn(2));
+
+    // Unknown entities are ignored, and so is a second release.
+    director.EntityReleased(100);
+    director.EntityReleased(100);
+    director.EntityReleased(999);
+    EXPECT_EQ(4u, director.Population());
+    EXPECT_EQ(2u, director.Population(1));
+    EXPECT_EQ(game::SpawnDecision::SPAWN, director.RequestSpawn(1));
+    EXPECT_EQ(1u, director.SpawnRoom(1));
+
+    const game::SpawnDirectorStats& stats = director.Stats();
+    EXPECT_EQ(5u, stats.spawned);
+    EXPECT_EQ(1u, stats.population_capped);
+    EXPECT_EQ(1u, stats.spawn_point_capped);
+    EXPECT_EQ(0u, stats.throttled);
+}
+
+TEST(SpawnDirectorTest, ThrottledOverBudget)
+{
+    game::SpawnDirector director = MakeDirector(100, 100);
+
+    for(int frame = 0; frame < 100; ++frame)
+        director.AddFrameCost(12.0f);
+
+    EXPECT_LT(8.0f, director.FrameCost());
+    EXPECT_EQ(game::SpawnDecision::THROTTLED, director.RequestSpawn(1));
+    EXPECT_EQ(1u, director.Stats().throttled);
+
+    for(int frame = 0; frame < 100; ++frame)
+        director.AddFrameCost(4.0f);
+
+    EXPECT_GT(8.0f, director.FrameCost());
+    EXPECT_EQ(game::SpawnDecision::SPAWN, director.RequestSpawn(1));
+}
+
+TEST(SpawnDirectorTest, SelectBySpawnScore)
+{
+    game::SpawnDirector director = MakeDirector(100, 100);
+
+    // Sorted by value.
+    EXPECT_EQ(1, director.Definitions().front().value);
+
+    const auto total_value = [&director](const std::vector<uint32_t>& selected) {
+        int value = 0;
+        for(uint32_t index : selected)
+            value += director.Definitions()[index].value;
+        return value;
+    };
+
+    std::vector<uint32_t> selected;
+    director.SelectDefinitions(0, 10, selected);
+    ASSERT_EQ(1u, selected.size());
+    EXPECT_EQ(0u, selected.front());
+
+    selected.clear();
+    director.SelectDefinitions(7, 10, selected);
+    EXPECT_FALSE(selected.empty());
+    EXPECT_GE(7, total_value(selected));
+    EXPECT_LT(7 - 1, total_value(selected));
+
+    selected.clear();
+    director.SelectDefinitions(20, 4, selected);
+    EXPECT_EQ(4u, selected.size());
+
+    selected.clear();
+    director.SelectDefinitions(20, 0, selected);
+    EXPECT_TRUE(selected.empty());
+}
+
+// A long session, spawn points keep asking while the entities are killed slower than they spawn.
+TEST(SpawnDirectorTest, LongSessionStaysCapped)
+{
+    constexpr uint32_t n_spawn_points = 40;
+    constexpr uint32_t n_frames = 3600;
+
+    game::SpawnDirector director = MakeDirector(150, 20);
+
+    uint32_t next_entity_id = 1000;
+    uint32_t oldest_entity_id = next_entity_id;
+    uint32_t max_population = 0;
+    std::vector<uint32_t> selected;
+
+    for(uint32_t frame = 0; frame < n_frames; ++frame)
+    {
+        // Heavier frames the more there is alive.
+        director.AddFrameCost(2.0f + director.Population() * 0.05f);
+
+        const uint32_t spawner_id = frame % n_spawn_points;
+        if(director.RequestSpawn(spawner_id) == game::SpawnDecision::SPAWN)
+        {
+            selected.clear();
+            director.SelectDefinitions(5, director.SpawnRoom(spawner_id), selected);
+            for(size_t index = 0; index < selected.size(); ++index)
+                director.EntitySpawned(spawner_id, next_entity_id++);
+        }
+
+        if(frame % 3 == 0 && oldest_entity_id < next_entity_id)
+            director.EntityReleased(oldest_entity_id++);
+
+        max_population = std::max(max_population, director.Population());
+    }
+
+    EXPECT_GE(150u, max_population);
+
+    const game::SpawnDirectorStats& stats = director.Stats();
+    EXPECT_LT(0u, stats.spawned);
+    EXPECT_LT(0u, stats.throttled);
+}
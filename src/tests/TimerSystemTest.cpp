@@ -0,0 +1,98 @@
+
+#include "gtest/gtest.h"
+
+#include "TimerSystem.h"
+
+#include <vector>
+
+TEST(TimerSystemTest, OneShotAndRepeating)
+{
+    game::TimerSystem timer_system(16, nullptr);
+
+    std::vector<uint32_t> expired_at;
+    const uint32_t once_id = timer_system.StartTimer(10, [&](uint32_t timer_id) {
+        expired_at.push_back(timer_system.Time());
+    });
+
+    int n_repeats = 0;
+    const uint32_t repeating_id = timer_system.StartRepeatingTimer(4, [&n_repeats](uint32_t timer_id) {
+        n_repeats++;
+    });
+
+    EXPECT_EQ(2u, timer_system.ActiveTimers());
+
+    timer_system.Advance(9);
+    EXPECT_TRUE(expired_at.empty());
+    EXPECT_EQ(2, n_repeats);
+
+    timer_system.Advance(1);
+    ASSERT_EQ(1u, expired_at.size());
+    EXPECT_EQ(10u, expired_at.front());
+    EXPECT_FALSE(timer_system.IsActive(once_id));
+    EXPECT_FALSE(timer_system.CancelTimer(once_id));
+
+    timer_system.Advance(30);
+    EXPECT_EQ(10, n_repeats);
+    EXPECT_TRUE(timer_system.IsActive(repeating_id));
+
+    EXPECT_TRUE(timer_system.CancelTimer(repeating_id));
+    timer_system.Advance(30);
+    EXPECT_EQ(10, n_repeats);
+    EXPECT_EQ(0u, timer_system.ActiveTimers());
+}
+
+TEST(TimerSystemTest, CallbacksStartAndCancelTimers)
+{
+    game::TimerSystem timer_system(16, nullptr);
+
+    int n_repeats = 0;
+    uint32_t repeating_id = game::TimerSystem::NO_TIMER;
+    repeating_id = timer_system.StartRepeatingTimer(5, [&](uint32_t timer_id) {
+        EXPECT_EQ(repeating_id, timer_id);
+        n_repeats++;
+        if(n_repeats == 3)
+            timer_system.CancelTimer(timer_id);
+    });
+
+    int n_chained = 0;
+    std::function<void (uint32_t)> chain = [&](uint32_t timer_id) {
+        n_chained++;
+        if(n_chained < 4)
+            timer_system.StartTimer(7, chain);
+    };
+    timer_system.StartTimer(7, chain);
+
+    timer_system.Advance(100);
+    EXPECT_EQ(3, n_repeats);
+    EXPECT_EQ(4, n_chained);
+    EXPECT_FALSE(timer_system.IsActive(repeating_id));
+    EXPECT_EQ(0u, timer_system.ActiveTimers());
+
+    // The slot of a cancelled timer is reused, but the old id stays invalid.
+    const uint32_t new_id = timer_system.StartTimer(5, [](uint32_t timer_id) { });
+    EXPECT_NE(repeating_id, new_id);
+    EXPECT_FALSE(timer_system.CancelTimer(repeating_id));
+    EXPECT_TRUE(timer_system.IsActive(new_id));
+}
+
+TEST(TimerSystemTest, LongTimeoutsCascadeDown)
+{
+    game::TimerSystem timer_system(16, nullptr);
+    timer_system.Advance(37);
+
+    const std::vector<uint32_t> timeouts = { 1, 63, 64, 65, 4095, 4096, 4097, 300000, 20000000 };
+
+    std::vector<uint32_t> expected;
+    std::vector<uint32_t> expired;
+    for(uint32_t timeout_ms : timeouts)
+    {
+        expected.push_back(timer_system.Time() + timeout_ms);
+        timer_system.StartTimer(timeout_ms, [&](uint32_t timer_id) {
+            expired.push_back(timer_system.Time());
+        });
+    }
+
+    timer_system.Advance(20000037);
+    EXPECT_EQ(expected, expired);
+    EXPECT_EQ(0u, timer_system.ActiveTimers());
+}
@@ -0,0 +1,484 @@
+
+#include "gtest/gtest.h"
+
+#include "TriggerSystem/TriggerSystem.h"
+#include "SimulationClock.h"
+#include "TimerSystem.h"
+#include "System/Hash.h"
+#include "CollisionConfiguration.h"
+#include "Component.h"
+#include "Entity/LoadEntity.h"
+#include "EntitySystem/EntitySystem.h"
+#include "Physics/IBody.h"
+#include "Physics/PhysicsSystem.h"
+#include "TransformSystem/TransformSystem.h"
+#include "SystemContext.h"
+
+#include <vector>
+#include <string>
+
+namespace
+{
+    class TestClock
+    {
+    public:
+
+        TestClock()
+            : m_simulation_clock(1000)
+            , m_timer_system(16, &m_simulation_clock)
+            , m_timestamp(1000)
+        {
+            m_simulation_clock.Update(MakeFrame());
+        }
+
+        void Advance()
+        {
+            m_timestamp++;
+            m_simulation_clock.Update(MakeFrame());
+        }
+
+        mono::UpdateContext MakeFrame() const
+        {
+            mono::UpdateContext update_context = {};
+            update_context.timestamp = m_timestamp;
+            return update_context;
+        }
+
+        game::SimulationClock m_simulation_clock;
+        game::TimerSystem m_timer_system;
+        uint32_t m_timestamp;
+    };
+
+    void RunFrame(TestClock& clock, game::TriggerSystem& trigger_system)
+    {
+        clock.Advance();
+        clock.m_timer_system.ScheduledUpdate(clock.MakeFrame());
+        trigger_system.ScheduledUpdate(clock.MakeFrame());
+    }
+
+    struct AreaTestContext
+    {
+        AreaTestContext()
+        {
+            mono::PhysicsSystemInitParams physics_params;
+            physics_params.n_bodies = 16;
+            physics_params.n_circle_shapes = 16;
+            physics_params.n_segment_shapes = 16;
+            physics_params.n_polygon_shapes = 16;
+
+            transform_system = system_context.CreateSystem<mono::TransformSystem>(16);
+            entity_system = system_context.CreateSystem<mono::EntitySystem>(16, &system_context, shared::LoadEntityFile, ComponentNameFromHash);
+            physics_system = system_context.CreateSystem<mono::PhysicsSystem>(physics_params, transform_system);
+            trigger_system = system_context.CreateSystem<game::TriggerSystem>(16, nullptr, physics_system, entity_system, &clock.m_timer_system);
+        }
+
+        uint32_t SpawnBody(uint32_t category, uint32_t mask, const math::Vector& position)
+        {
+            const mono::Entity entity = entity_system->CreateEntity("body", {});
+
+            mono::BodyComponent body_params;
+            body_params.mass = 1.0f;
+            body_params.inertia = 1.0f;
+            body_params.type = mono::BodyType::DYNAMIC;
+            physics_system->AllocateBody(entity.id, body_params);
+
+            mono::BoxComponent shape_params;
+            shape_params.size = math::Vector(1.0f, 1.0f);
+            shape_params.offset = math::ZeroVec;
+            shape_params.is_sensor = false;
+            shape_params.category = category;
+            shape_params.mask = mask;
+            physics_system->AddShape(entity.id, shape_params);
+
+            physics_system->GetBody(entity.id)->SetPosition(position);
+            return entity.id;
+        }
+
+        void RunFrame()
+        {
+            clock.Advance();
+
+            mono::UpdateContext update_context = clock.MakeFrame();
+            update_context.delta_ms = 16;
+            update_context.delta_s = 0.016f;
+            physics_system->Update(update_context);
+
+            clock.m_timer_system.ScheduledUpdate(update_context);
+            trigger_system->ScheduledUpdate(update_context);
+        }
+
+        TestClock clock;
+        mono::SystemContext system_context;
+        mono::TransformSystem* transform_system;
+        mono::EntitySystem* entity_system;
+        mono::PhysicsSystem* physics_system;
+        game::TriggerSystem* trigger_system;
+    };
+
+    const math::Quad area_bb(-2.0f, -2.0f, 2.0f, 2.0f);
+    const math::Vector inside_area(0.0f, 0.0f);
+    const math::Vector outside_area(10.0f, 10.0f);
+}
+
+TEST(TriggerSystemTest, EmitsAreCoalescedPerFrame)
+{
+    TestClock clock;
+    game::TriggerSystem trigger_system(16, nullptr, nullptr, nullptr, &clock.m_timer_system);
+
+    const uint32_t door_hash = hash::Hash("door_open");
+
+    int n_calls = 0;
+    uint32_t n_counted_emits = 0;
+    const uint32_t callback_id = trigger_system.RegisterTriggerCallback(
+        door_hash, [&n_calls](uint32_t trigger_id) { n_calls++; }, 0);
+    const uint32_t count_callback_id = trigger_system.RegisterTriggerCountCallback(
+        door_hash, [&n_counted_emits](uint32_t trigger_id, uint32_t n_emits) { n_counted_emits += n_emits; }, 0);
+
+    for(int index = 0; index < 10; ++index)
+        trigger_system.EmitTrigger(door_hash);
+
+    RunFrame(clock, trigger_system);
+    EXPECT_EQ(1, n_calls);
+    EXPECT_EQ(10u, n_counted_emits);
+
+    RunFrame(clock, trigger_system);
+    EXPECT_EQ(1, n_calls);
+
+    trigger_system.RemoveTriggerCallback(door_hash, callback_id, 0);
+    trigger_system.RemoveTriggerCallback(door_hash, count_callback_id, 0);
+    trigger_system.EmitTrigger(door_hash);
+
+    RunFrame(clock, trigger_system);
+    EXPECT_EQ(1, n_calls);
+    EXPECT_EQ(10u, n_counted_emits);
+}
+
+TEST(TriggerSystemTest, NoLimitOnListeners)
+{
+    TestClock clock;
+    game::TriggerSystem trigger_system(16, nullptr, nullptr, nullptr, &clock.m_timer_system);
+
+    const uint32_t trigger_hash = hash::Hash("wave_completed");
+
+    int n_calls = 0;
+    std::vector<uint32_t> callback_ids;
+    for(int index = 0; index < 20; ++index)
+    {
+        const uint32_t callback_id =
+            trigger_system.RegisterTriggerCallback(trigger_hash, [&n_calls](uint32_t trigger_id) { n_calls++; }, index);
+        callback_ids.push_back(callback_id);
+    }
+
+    trigger_system.EmitTrigger(trigger_hash);
+    RunFrame(clock, trigger_system);
+    EXPECT_EQ(20, n_calls);
+
+    for(size_t index = 0; index < callback_ids.size(); index += 2)
+        trigger_system.RemoveTriggerCallback(trigger_hash, callback_ids[index], index);
+
+    trigger_system.EmitTrigger(trigger_hash);
+    RunFrame(clock, trigger_system);
+    EXPECT_EQ(30, n_calls);
+}
+
+TEST(TriggerSystemTest, CallbacksChangeListenersWhileDispatching)
+{
+    TestClock clock;
+    game::TriggerSystem trigger_system(16, nullptr, nullptr, nullptr, &clock.m_timer_system);
+
+    const uint32_t first_hash = hash::Hash("first");
+    const uint32_t second_hash = hash::Hash("second");
+
+    int n_first_calls = 0;
+    int n_second_calls = 0;
+    uint32_t first_callback_id = 0;
+
+    // Removes itself, registers a new listener and emits a trigger that is dispatched next frame.
+    const auto first_callback = [&](uint32_t trigger_id) {
+        n_first_calls++;
+        trigger_system.RemoveTriggerCallback(first_hash, first_callback_id, 0);
+        const uint32_t callback_id =
+            trigger_system.RegisterTriggerCallback(second_hash, [&n_second_calls](uint32_t trigger_id) { n_second_calls++; }, 1);
+        (void)callback_id;
+        trigger_system.EmitTrigger(second_hash);
+    };
+    first_callback_id = trigger_system.RegisterTriggerCallback(first_hash, first_callback, 0);
+
+    trigger_system.EmitTrigger(first_hash);
+    RunFrame(clock, trigger_system);
+    EXPECT_EQ(1, n_first_calls);
+    EXPECT_EQ(0, n_second_calls);
+
+    trigger_system.EmitTrigger(first_hash);
+    RunFrame(clock, trigger_system);
+    EXPECT_EQ(1, n_first_calls);
+    EXPECT_EQ(1, n_second_calls);
+}
+
+TEST(TriggerSystemTest, CounterTriggerCountsEveryEmit)
+{
+    TestClock clock;
+    game::TriggerSystem trigger_system(16, nullptr, nullptr, nullptr, &clock.m_timer_system);
+
+    const uint32_t kill_hash = hash::Hash("enemy_killed");
+    const uint32_t completed_hash = hash::Hash("all_killed");
+
+    trigger_system.AllocateCounterTrigger(3);
+    trigger_system.AddCounterTrigger(3, kill_hash, completed_hash, 5, true);
+
+    uint32_t n_completed = 0;
+    const uint32_t callback_id = trigger_system.RegisterTriggerCountCallback(
+        completed_hash, [&n_completed](uint32_t trigger_id, uint32_t n_emits) { n_completed += n_emits; }, 0);
+    (void)callback_id;
+
+    for(int index = 0; index < 11; ++index)
+        trigger_system.EmitTrigger(kill_hash);
+
+    RunFrame(clock, trigger_system);
+    RunFrame(clock, trigger_system);
+    EXPECT_EQ(2u, n_completed);
+
+    for(int index = 0; index < 4; ++index)
+        trigger_system.EmitTrigger(kill_hash);
+
+    RunFrame(clock, trigger_system);
+    RunFrame(clock, trigger_system);
+    EXPECT_EQ(3u, n_completed);
+
+    trigger_system.ReleaseCounterTrigger(3);
+}
+
+TEST(TriggerSystemTest, CounterTriggerWithoutCount)
+{
+    TestClock clock;
+    game::TriggerSystem trigger_system(16, nullptr, nullptr, nullptr, &clock.m_timer_system);
+
+    const uint32_t kill_hash = hash::Hash("enemy_killed");
+    const uint32_t completed_hash = hash::Hash("all_killed");
+
+    trigger_system.AllocateCounterTrigger(3);
+    trigger_system.AddCounterTrigger(3, kill_hash, completed_hash, 0, true);
+
+    uint32_t n_completed = 0;
+    trigger_system.RegisterTriggerCountCallback(
+        completed_hash, [&n_completed](uint32_t trigger_id, uint32_t n_emits) { n_completed += n_emits; }, 0);
+
+    for(int index = 0; index < 3; ++index)
+        trigger_system.EmitTrigger(kill_hash);
+
+    RunFrame(clock, trigger_system);
+    RunFrame(clock, trigger_system);
+    EXPECT_EQ(3u, n_completed);
+
+    trigger_system.ReleaseCounterTrigger(3);
+}
+
+TEST(TriggerSystemTest, RemoveCallbackChecksTriggerHash)
+{
+    TestClock clock;
+    game::TriggerSystem trigger_system(16, nullptr, nullptr, nullptr, &clock.m_timer_system);
+
+    const uint32_t door_hash = hash::Hash("door_open");
+    const uint32_t lever_hash = hash::Hash("lever_pulled");
+
+    int n_door_calls = 0;
+    int n_lever_calls = 0;
+    const uint32_t door_callback_id = trigger_system.RegisterTriggerCallback(
+        door_hash, [&n_door_calls](uint32_t trigger_id) { n_door_calls++; }, 0);
+
+    // Removing with another trigger hash keeps the listener.
+    trigger_system.RemoveTriggerCallback(lever_hash, door_callback_id, 0);
+    trigger_system.EmitTrigger(door_hash);
+    RunFrame(clock, trigger_system);
+    EXPECT_EQ(1, n_door_calls);
+
+    // The id is reused by the lever listener, a late remove of the door listener keeps it.
+    trigger_system.RemoveTriggerCallback(door_hash, door_callback_id, 0);
+    RunFrame(clock, trigger_system);
+    const uint32_t lever_callback_id = trigger_system.RegisterTriggerCallback(
+        lever_hash, [&n_lever_calls](uint32_t trigger_id) { n_lever_calls++; }, 0);
+    EXPECT_EQ(door_callback_id, lever_callback_id);
+
+    trigger_system.RemoveTriggerCallback(door_hash, door_callback_id, 0);
+    trigger_system.EmitTrigger(door_hash);
+    trigger_system.EmitTrigger(lever_hash);
+    RunFrame(clock, trigger_system);
+    EXPECT_EQ(1, n_door_calls);
+    EXPECT_EQ(1, n_lever_calls);
+
+    trigger_system.RemoveTriggerCallback(lever_hash, lever_callback_id, 0);
+}
+
+TEST(TriggerSystemTest, AreaTriggerOnEnter)
+{
+    AreaTestContext context;
+
+    const uint32_t entered_hash = hash::Hash("player_entered");
+    int n_entered = 0;
+    context.trigger_system->RegisterTriggerCallback(entered_hash, [&n_entered](uint32_t trigger_id) { n_entered++; }, 0);
+
+    const uint32_t player_id =
+        context.SpawnBody(shared::CollisionCategory::PLAYER, shared::PLAYER_MASK, outside_area);
+
+    const uint32_t trigger_id = context.entity_system->CreateEntity("area_trigger", {}).id;
+    const game::AreaEntityTriggerComponent* area_trigger = context.trigger_system->AllocateAreaTrigger(trigger_id);
+    context.trigger_system->AddAreaEntityTrigger(
+        trigger_id, entered_hash, area_bb, shared::CollisionCategory::PLAYER, shared::AreaTriggerOperation::GREATER_THAN, 0);
+
+    for(int frame = 0; frame < 3; ++frame)
+        context.RunFrame();
+    EXPECT_EQ(0, area_trigger->n_bodies);
+    EXPECT_EQ(0, n_entered);
+
+    context.physics_system->GetBody(player_id)->SetPosition(inside_area);
+    for(int frame = 0; frame < 3; ++frame)
+        context.RunFrame();
+    EXPECT_EQ(1, area_trigger->n_bodies);
+    EXPECT_EQ(1, n_entered);
+
+    context.trigger_system->ReleaseAreaTrigger(trigger_id);
+}
+
+TEST(TriggerSystemTest, AreaTriggerOnExit)
+{
+    AreaTestContext context;
+
+    const uint32_t left_hash = hash::Hash("player_left");
+    int n_left = 0;
+    context.trigger_system->RegisterTriggerCallback(left_hash, [&n_left](uint32_t trigger_id) { n_left++; }, 0);
+
+    const uint32_t player_id =
+        context.SpawnBody(shared::CollisionCategory::PLAYER, shared::PLAYER_MASK, inside_area);
+
+    const uint32_t trigger_id = context.entity_system->CreateEntity("area_trigger", {}).id;
+    const game::AreaEntityTriggerComponent* area_trigger = context.trigger_system->AllocateAreaTrigger(trigger_id);
+    context.trigger_system->AddAreaEntityTrigger(
+        trigger_id, left_hash, area_bb, shared::CollisionCategory::PLAYER, shared::AreaTriggerOperation::LESS_THAN, 1);
+
+    for(int frame = 0; frame < 3; ++frame)
+        context.RunFrame();
+    EXPECT_EQ(1, area_trigger->n_bodies);
+    EXPECT_EQ(0, n_left);
+
+    context.physics_system->GetBody(player_id)->SetPosition(outside_area);
+    for(int frame = 0; frame < 3; ++frame)
+        context.RunFrame();
+    EXPECT_EQ(0, area_trigger->n_bodies);
+    EXPECT_EQ(1, n_left);
+
+    context.trigger_system->ReleaseAreaTrigger(trigger_id);
+}
+
+TEST(TriggerSystemTest, AreaTriggerCountsFaction)
+{
+    AreaTestContext context;
+
+    const uint32_t collected_hash = hash::Hash("pickups_collected");
+    int n_collected = 0;
+    context.trigger_system->RegisterTriggerCallback(collected_hash, [&n_collected](uint32_t trigger_id) { n_collected++; }, 0);
+
+    const uint32_t trigger_id = context.entity_system->CreateEntity("area_trigger", {}).id;
+    const game::AreaEntityTriggerComponent* area_trigger = context.trigger_system->AllocateAreaTrigger(trigger_id);
+    context.trigger_system->AddAreaEntityTrigger(
+        trigger_id, collected_hash, area_bb, shared::CollisionCategory::PICKUPS, shared::AreaTriggerOperation::EQUAL_TO, 2);
+
+    // Enemies are not counted by a pickup area.
+    context.SpawnBody(shared::CollisionCategory::ENEMY, shared::ENEMY_MASK, inside_area);
+    context.SpawnBody(shared::CollisionCategory::PICKUPS, shared::PICKUPS_MASK, inside_area);
+    const uint32_t second_pickup_id =
+        context.SpawnBody(shared::CollisionCategory::PICKUPS, shared::PICKUPS_MASK, outside_area);
+
+    for(int frame = 0; frame < 3; ++frame)
+        context.RunFrame();
+    EXPECT_EQ(1, area_trigger->n_bodies);
+    EXPECT_EQ(0, n_collected);
+
+    context.physics_system->GetBody(second_pickup_id)->SetPosition(inside_area);
+    for(int frame = 0; frame < 3; ++frame)
+        context.RunFrame();
+    EXPECT_EQ(2, area_trigger->n_bodies);
+    EXPECT_EQ(1, n_collected);
+
+    context.trigger_system->ReleaseAreaTrigger(trigger_id);
+}
+
+TEST(TriggerSystemTest, HeldAreaTriggersWaitForRelease)
+{
+    AreaTestContext context;
+
+    const uint32_t cleared_hash = hash::Hash("area_cleared");
+    int n_cleared = 0;
+    context.trigger_system->RegisterTriggerCallback(cleared_hash, [&n_cleared](uint32_t trigger_id) { n_cleared++; }, 0);
+
+    // Like a world that is streamed in, the area is created before the enemy in it.
+    context.trigger_system->HoldAreaTriggers(true);
+
+    const uint32_t trigger_id = context.entity_system->CreateEntity("area_trigger", {}).id;
+    const game::AreaEntityTriggerComponent* area_trigger = context.trigger_system->AllocateAreaTrigger(trigger_id);
+    context.trigger_system->AddAreaEntityTrigger(
+        trigger_id, cleared_hash, area_bb, shared::CollisionCategory::ENEMY, shared::AreaTriggerOperation::LESS_THAN, 1);
+
+    for(int frame = 0; frame < 3; ++frame)
+        context.RunFrame();
+    EXPECT_EQ(0, n_cleared);
+
+    const uint32_t enemy_id =
+        context.SpawnBody(shared::CollisionCategory::ENEMY, shared::ENEMY_MASK, inside_area);
+    context.RunFrame();
+    context.trigger_system->HoldAreaTriggers(false);
+
+    for(int frame = 0; frame < 3; ++frame)
+        context.RunFrame();
+    EXPECT_EQ(1, area_trigger->n_bodies);
+    EXPECT_EQ(0, n_cleared);
+
+    context.physics_system->GetBody(enemy_id)->SetPosition(outside_area);
+    for(int frame = 0; frame < 3; ++frame)
+        context.RunFrame();
+    EXPECT_EQ(0, area_trigger->n_bodies);
+    EXPECT_EQ(1, n_cleared);
+
+    context.trigger_system->ReleaseAreaTrigger(trigger_id);
+}
+
+TEST(TriggerSystemTest, TimeTriggers)
+{
+    TestClock clock;
+    game::TriggerSystem trigger_system(16, nullptr, nullptr, nullptr, &clock.m_timer_system);
+
+    const uint32_t once_hash = hash::Hash("once");
+    const uint32_t repeating_hash = hash::Hash("repeating");
+
+    int n_once = 0;
+    int n_repeating = 0;
+    const uint32_t once_callback_id =
+        trigger_system.RegisterTriggerCallback(once_hash, [&n_once](uint32_t trigger_id) { n_once++; }, 0);
+    const uint32_t repeating_callback_id =
+        trigger_system.RegisterTriggerCallback(repeating_hash, [&n_repeating](uint32_t trigger_id) { n_repeating++; }, 1);
+    (void)once_callback_id;
+    (void)repeating_callback_id;
+
+    trigger_system.AllocateTimeTrigger(0);
+    trigger_system.AddTimeTrigger(0, once_hash, 5.0f, false);
+    trigger_system.AllocateTimeTrigger(1);
+    trigger_system.AddTimeTrigger(1, repeating_hash, 3.0f, true);
+
+    // One millisecond per frame, the timers are advanced before the triggers are dispatched.
+    for(int frame = 0; frame < 10; ++frame)
+        RunFrame(clock, trigger_system);
+
+    EXPECT_EQ(1, n_once);
+    EXPECT_EQ(3, n_repeating);
+    EXPECT_EQ(1u, clock.m_timer_system.ActiveTimers());
+
+    trigger_system.ReleaseTimeTrigger(1);
+    EXPECT_EQ(0u, clock.m_timer_system.ActiveTimers());
+
+    for(int frame = 0; frame < 10; ++frame)
+        RunFrame(clock, trigger_system);
+
+    EXPECT_EQ(1, n_once);
+    EXPECT_EQ(3, n_repeating);
+
+    trigger_system.ReleaseTimeTrigger(0);
+}
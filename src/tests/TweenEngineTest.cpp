@@ -0,0 +1,141 @@
+
+#include "gtest/gtest.h"
+
+#include "Entity/TweenEngine.h"
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+    struct TweenValue
+    {
+        uint32_t target_id;
+        float x;
+        float y;
+    };
+
+    std::vector<TweenValue> CollectValues(const game::TweenEngine& tween_engine)
+    {
+        std::vector<TweenValue> values;
+        tween_engine.ForEachGroup(
+            [&values](game::TweenType type, uint32_t count, const uint32_t* target_ids, const float* values_x, const float* values_y) {
+                for(uint32_t index = 0; index < count; ++index)
+                    values.push_back({ target_ids[index], values_x[index], values_y[index] });
+            });
+
+        std::sort(values.begin(), values.end(), [](const TweenValue& first, const TweenValue& second) {
+            return first.target_id < second.target_id;
+        });
+        return values;
+    }
+
+    float HalfwayStep(float time, float duration, float start, float delta)
+    {
+        return (time < duration / 2.0f) ? start : start + delta;
+    }
+}
+
+TEST(TweenEngineTest, EvaluatesAndFinishes)
+{
+    game::TweenEngine tween_engine;
+
+    const uint32_t linear_id = tween_engine.AddTween(
+        1, game::TweenType::TRANSLATION, math::LinearTween, 2.0f, 10.0f, 0.0f, 4.0f, -2.0f, 100);
+    const uint32_t rotation_id = tween_engine.AddTween(
+        2, game::TweenType::ROTATION, math::LinearTween, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 200);
+    const uint32_t cubic_id = tween_engine.AddTween(
+        3, game::TweenType::TRANSLATION, math::EaseInOutCubic, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 300);
+
+    EXPECT_EQ(3u, tween_engine.ActiveTweens());
+
+    tween_engine.Update(0.5f);
+    std::vector<TweenValue> values = CollectValues(tween_engine);
+    ASSERT_EQ(3u, values.size());
+    EXPECT_FLOAT_EQ(11.0f, values[0].x);
+    EXPECT_FLOAT_EQ(-0.5f, values[0].y);
+    EXPECT_FLOAT_EQ(1.5f, values[1].x);
+    EXPECT_FLOAT_EQ(0.5f, values[2].x);
+    EXPECT_TRUE(tween_engine.RemoveFinished().empty());
+
+    tween_engine.Update(0.75f);
+    const std::vector<game::FinishedTween> finished = tween_engine.RemoveFinished();
+    ASSERT_EQ(2u, finished.size());
+    EXPECT_FALSE(tween_engine.IsActive(rotation_id));
+    EXPECT_FALSE(tween_engine.IsActive(cubic_id));
+    EXPECT_TRUE(tween_engine.IsActive(linear_id));
+
+    // Finished tweens end exactly at the end value and the rest keep going.
+    values = CollectValues(tween_engine);
+    ASSERT_EQ(1u, values.size());
+    EXPECT_FLOAT_EQ(12.5f, values[0].x);
+
+    tween_engine.Update(10.0f);
+    values = CollectValues(tween_engine);
+    EXPECT_FLOAT_EQ(14.0f, values[0].x);
+    EXPECT_FLOAT_EQ(-2.0f, values[0].y);
+
+    ASSERT_EQ(1u, tween_engine.RemoveFinished().size());
+    EXPECT_EQ(0u, tween_engine.ActiveTweens());
+}
+
+TEST(TweenEngineTest, InlinedAndOtherEaseFunctionsAgree)
+{
+    game::TweenEngine tween_engine;
+
+    const math::EaseFunction ease_functions[] = {
+        math::LinearTween, math::EaseInCubic, math::EaseOutCubic, math::EaseInOutCubic, HalfwayStep };
+
+    uint32_t target_id = 0;
+    for(const math::EaseFunction ease_function : ease_functions)
+        tween_engine.AddTween(target_id++, game::TweenType::TRANSLATION, ease_function, 2.0f, 1.0f, 2.0f, 3.0f, 4.0f, 0);
+
+    for(int step = 1; step <= 4; ++step)
+    {
+        tween_engine.Update(0.5f);
+        const float time = step * 0.5f;
+        const std::vector<TweenValue> values = CollectValues(tween_engine);
+        ASSERT_EQ(std::size(ease_functions), values.size());
+
+        for(const TweenValue& value : values)
+        {
+            const math::EaseFunction ease_function = ease_functions[value.target_id];
+            const float progress = ease_function(time, 2.0f, 0.0f, 1.0f);
+            EXPECT_FLOAT_EQ(1.0f + 3.0f * progress, value.x);
+            EXPECT_FLOAT_EQ(2.0f + 4.0f * progress, value.y);
+        }
+    }
+}
+
+TEST(TweenEngineTest, RemoveKeepsOtherTweens)
+{
+    game::TweenEngine tween_engine;
+
+    std::vector<uint32_t> tween_ids;
+    for(uint32_t index = 0; index < 10; ++index)
+    {
+        tween_ids.push_back(tween_engine.AddTween(
+            index, game::TweenType::TRANSLATION, math::LinearTween, 1.0f, float(index), 0.0f, 1.0f, 0.0f, index));
+    }
+
+    EXPECT_TRUE(tween_engine.RemoveTween(tween_ids[0]));
+    EXPECT_TRUE(tween_engine.RemoveTween(tween_ids[5]));
+    EXPECT_FALSE(tween_engine.RemoveTween(tween_ids[5]));
+
+    // The freed slot is reused, but the old id stays invalid.
+    const uint32_t new_id = tween_engine.AddTween(
+        20, game::TweenType::TRANSLATION, math::LinearTween, 1.0f, 20.0f, 0.0f, 1.0f, 0.0f, 20);
+    EXPECT_FALSE(tween_engine.IsActive(tween_ids[5]));
+    EXPECT_TRUE(tween_engine.IsActive(new_id));
+
+    tween_engine.Update(0.5f);
+    const std::vector<TweenValue> values = CollectValues(tween_engine);
+    ASSERT_EQ(9u, values.size());
+    for(const TweenValue& value : values)
+        EXPECT_FLOAT_EQ(float(value.target_id) + 0.5f, value.x);
+
+    tween_engine.Update(0.5f);
+    EXPECT_EQ(9u, tween_engine.RemoveFinished().size());
+    EXPECT_EQ(0u, tween_engine.ActiveTweens());
+}
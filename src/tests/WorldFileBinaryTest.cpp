@@ -0,0 +1,258 @@
+
+#include "gtest/gtest.h"
+
+#include "WorldFileBinary.h"
+#include "WorldLoader.h"
+#include "Component.h"
+#include "Entity/Serialize.h"
+#include "Math/Serialize.h"
+#include "Rendering/Serialize.h"
+
+#include "nlohmann/json.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <cstddef>
+#include <cstring>
+
+namespace
+{
+    nlohmann::json MakeComponent(uint32_t component_hash, const std::vector<Attribute>& properties)
+    {
+        nlohmann::json json_component;
+        json_component["hash"] = component_hash;
+        json_component["name"] = ComponentNameFromHash(component_hash);
+        json_component["properties"] = properties;
+        return json_component;
+    }
+
+    // Entities with a transform and a sprite, every third entity has a path with a polygon and a name and folder.
+    void WriteTestWorld(const std::string& filename, uint32_t n_entities)
+    {
+        nlohmann::json json_entities = nlohmann::json::array();
+
+        for(uint32_t index = 0; index < n_entities; ++index)
+        {
+            const std::vector<Attribute> transform_properties = {
+                { POSITION_ATTRIBUTE, math::Vector(index, -1.0f * index) }
+            };
+            const std::vector<Attribute> sprite_properties = {
+                { SPRITE_ATTRIBUTE, std::string("res/sprites/sprite_") + std::to_string(index % 10) + ".sprite" },
+                { ANIMATION_ATTRIBUTE, int(index % 3) }
+            };
+
+            nlohmann::json json_components = {
+                MakeComponent(TRANSFORM_COMPONENT, transform_properties),
+                MakeComponent(SPRITE_COMPONENT, sprite_properties)
+            };
+
+            if(index % 3 == 0)
+            {
+                const std::vector<Attribute> path_properties = {
+                    { PATH_POINTS_ATTRIBUTE, std::vector<math::Vector>{ { 0.0f, 0.0f }, { 1.0f, float(index) } } }
+                };
+                json_components.push_back(MakeComponent(PATH_COMPONENT, path_properties));
+
+                Component name_folder = DefaultComponentFromHash(NAME_FOLDER_COMPONENT);
+                SetAttribute(NAME_ATTRIBUTE, name_folder.properties, std::string("path"));
+                json_components.push_back(MakeComponent(NAME_FOLDER_COMPONENT, name_folder.properties));
+            }
+
+            nlohmann::json json_entity;
+            json_entity["name"] = "entity_" + std::to_string(index);
+            json_entity["folder"] = (index % 2 == 0) ? "even" : "";
+            json_entity["entity_properties"] = index;
+            json_entity["components"] = json_components;
+            if(index % 2 == 0)
+                json_entity["uuid_hash"] = 1000 + index;
+
+            json_entities.push_back(json_entity);
+        }
+
+        nlohmann::json json_metadata;
+        json_metadata["camera_position"] = math::Vector(1.0f, 2.0f);
+        json_metadata["camera_size"] = math::Vector(30.0f, 20.0f);
+        json_metadata["player_spawn_point"] = math::Vector(-5.0f, 5.0f);
+        json_metadata["background_color"] = mono::Color::RGBA(0.1f, 0.2f, 0.3f, 1.0f);
+        json_metadata["ambient_shade"] = mono::Color::RGBA(1.0f, 1.0f, 1.0f, 0.5f);
+        json_metadata["background_texture"] = "res/textures/background.png";
+
+        nlohmann::json json;
+        json["metadata"] = json_metadata;
+        json["entities"] = json_entities;
+
+        std::ofstream(filename) << json.dump(4);
+    }
+
+    std::string TempFilename(const char* name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+}
+
+TEST(WorldFileBinaryTest, CompiledFilename)
+{
+    EXPECT_EQ("res/worlds/world.compiled", shared::CompiledWorldFilename("res/worlds/world.components"));
+    EXPECT_EQ("res/worlds.old/world.compiled", shared::CompiledWorldFilename("res/worlds.old/world"));
+}
+
+TEST(WorldFileBinaryTest, CompileAndRead)
+{
+    const std::string world_filename = TempFilename("compile_test.components");
+    const std::string compiled_filename = shared::CompiledWorldFilename(world_filename.c_str());
+
+    WriteTestWorld(world_filename, 7);
+    ASSERT_TRUE(shared::CompileWorldFile(world_filename.c_str(), compiled_filename.c_str()));
+    EXPECT_TRUE(shared::IsCompiledWorldCurrent(world_filename.c_str(), compiled_filename.c_str()));
+
+    shared::CompiledWorld compiled_world;
+    ASSERT_TRUE(compiled_world.Open(compiled_filename.c_str()));
+
+    const shared::LevelMetadata metadata = compiled_world.Metadata();
+    EXPECT_FLOAT_EQ(2.0f, metadata.camera_position.y);
+    EXPECT_FLOAT_EQ(30.0f, metadata.camera_size.x);
+    EXPECT_FLOAT_EQ(-5.0f, metadata.player_spawn_point.x);
+    EXPECT_FLOAT_EQ(0.3f, metadata.background_color.blue);
+    EXPECT_FLOAT_EQ(0.5f, metadata.ambient_shade.alpha);
+    EXPECT_EQ("res/textures/background.png", metadata.background_texture);
+
+    ASSERT_EQ(7u, compiled_world.EntityCount());
+
+    std::vector<Component> components;
+    uint32_t n_ignored = 0;
+
+    for(uint32_t index = 0; index < compiled_world.EntityCount(); ++index)
+    {
+        const shared::CompiledEntity& entity = compiled_world.Entity(index);
+        EXPECT_EQ("entity_" + std::to_string(index), compiled_world.String(entity.name));
+        EXPECT_EQ(index, entity.entity_properties);
+        EXPECT_EQ(index % 2 == 0, (entity.flags & shared::HAS_UUID) != 0);
+        EXPECT_EQ(index % 3 != 0, (entity.flags & shared::PATCHED_NAME_FOLDER) != 0);
+
+        compiled_world.ReadComponents(entity, nullptr, components, n_ignored);
+        ASSERT_EQ(index % 3 == 0 ? 4u : 3u, components.size());
+
+        // Merged with the defaults, so the attributes not in the file are there as well.
+        const Component& transform = components[0];
+        EXPECT_EQ(TRANSFORM_COMPONENT, transform.hash);
+        EXPECT_EQ(DefaultComponentFromHash(TRANSFORM_COMPONENT).properties.size(), transform.properties.size());
+
+        math::Vector position;
+        EXPECT_TRUE(FindAttribute(POSITION_ATTRIBUTE, transform.properties, position, FallbackMode::REQUIRE_ATTRIBUTE));
+        EXPECT_FLOAT_EQ(-1.0f * index, position.y);
+
+        std::string sprite_file;
+        EXPECT_TRUE(FindAttribute(SPRITE_ATTRIBUTE, components[1].properties, sprite_file, FallbackMode::REQUIRE_ATTRIBUTE));
+        EXPECT_EQ("res/sprites/sprite_" + std::to_string(index % 10) + ".sprite", sprite_file);
+
+        std::string name;
+        EXPECT_EQ(NAME_FOLDER_COMPONENT, components.back().hash);
+        EXPECT_TRUE(FindAttribute(NAME_ATTRIBUTE, components.back().properties, name, FallbackMode::REQUIRE_ATTRIBUTE));
+        EXPECT_EQ(index % 3 == 0 ? "path" : "entity_" + std::to_string(index), name);
+
+        if(index % 3 == 0)
+        {
+            std::vector<math::Vector> points;
+            EXPECT_TRUE(FindAttribute(PATH_POINTS_ATTRIBUTE, components[2].properties, points, FallbackMode::REQUIRE_ATTRIBUTE));
+            ASSERT_EQ(2u, points.size());
+            EXPECT_FLOAT_EQ(float(index), points[1].y);
+        }
+    }
+
+    const auto only_transform = [](uint32_t component_hash) {
+        return component_hash == TRANSFORM_COMPONENT;
+    };
+    compiled_world.ReadComponents(compiled_world.Entity(0), only_transform, components, n_ignored);
+    EXPECT_EQ(1u, components.size());
+    EXPECT_EQ(3u, n_ignored);
+
+    compiled_world.Close();
+    std::filesystem::remove(world_filename);
+    std::filesystem::remove(compiled_filename);
+}
+
+TEST(WorldFileBinaryTest, CompileInMemory)
+{
+    const std::string world_filename = TempFilename("memory_test.components");
+    WriteTestWorld(world_filename, 4);
+
+    std::vector<std::byte> blob;
+    ASSERT_TRUE(shared::CompileWorld(world_filename.c_str(), blob));
+
+    shared::CompiledWorld compiled_world;
+    ASSERT_TRUE(compiled_world.Open(std::move(blob), world_filename.c_str()));
+    ASSERT_EQ(4u, compiled_world.EntityCount());
+
+    const shared::CompiledAttribute* position =
+        compiled_world.FindAttribute(compiled_world.Entity(3), TRANSFORM_COMPONENT, POSITION_ATTRIBUTE);
+    ASSERT_NE(nullptr, position);
+    EXPECT_EQ(uint32_t(VariantTypeIndex::POINT), position->variant_type);
+
+    float values[2];
+    std::memcpy(values, position->value, sizeof(values));
+    EXPECT_FLOAT_EQ(3.0f, values[0]);
+    EXPECT_FLOAT_EQ(-3.0f, values[1]);
+
+    EXPECT_EQ(nullptr, compiled_world.FindAttribute(compiled_world.Entity(1), PATH_COMPONENT, PATH_POINTS_ATTRIBUTE));
+
+    std::filesystem::remove(world_filename);
+}
+
+TEST(WorldFileBinaryTest, RejectsTruncatedFile)
+{
+    const std::string world_filename = TempFilename("truncated_test.components");
+    const std::string compiled_filename = shared::CompiledWorldFilename(world_filename.c_str());
+
+    WriteTestWorld(world_filename, 3);
+    ASSERT_TRUE(shared::CompileWorldFile(world_filename.c_str(), compiled_filename.c_str()));
+
+    const uintmax_t file_size = std::filesystem::file_size(compiled_filename);
+    std::filesystem::resize_file(compiled_filename, file_size - 8);
+
+    shared::CompiledWorld compiled_world;
+    EXPECT_FALSE(compiled_world.Open(compiled_filename.c_str()));
+    EXPECT_FALSE(compiled_world.IsOpen());
+
+    std::filesystem::remove(world_filename);
+    std::filesystem::remove(compiled_filename);
+}
+
+TEST(WorldFileBinaryTest, RejectsOtherComponentDefaults)
+{
+    const std::string world_filename = TempFilename("defaults_test.components");
+    const std::string compiled_filename = shared::CompiledWorldFilename(world_filename.c_str());
+
+    WriteTestWorld(world_filename, 3);
+    ASSERT_TRUE(shared::CompileWorldFile(world_filename.c_str(), compiled_filename.c_str()));
+    EXPECT_TRUE(shared::IsCompiledWorldCurrent(world_filename.c_str(), compiled_filename.c_str()));
+
+    // Same as a world compiled before the defaults changed.
+    {
+        std::fstream file(compiled_filename, std::ios::in | std::ios::out | std::ios::binary);
+        const uint32_t other_hash = shared::ComponentDefaultsHash() + 1;
+        file.seekp(offsetof(shared::CompiledWorldHeader, component_defaults_hash));
+        file.write(reinterpret_cast<const char*>(&other_hash), sizeof(other_hash));
+    }
+
+    EXPECT_FALSE(shared::IsCompiledWorldCurrent(world_filename.c_str(), compiled_filename.c_str()));
+
+    shared::CompiledWorld compiled_world;
+    EXPECT_FALSE(compiled_world.Open(compiled_filename.c_str()));
+
+    std::filesystem::remove(world_filename);
+    std::filesystem::remove(compiled_filename);
+}
+
+TEST(WorldFileBinaryTest, LoaderReportsBrokenWorldFile)
+{
+    const std::string world_filename = TempFilename("broken_test.components");
+    std::ofstream(world_filename) << "{ \"entities\": [ { \"name\": ";
+
+    shared::WorldLoader world_loader(world_filename.c_str(), nullptr);
+    EXPECT_FALSE(world_loader.WaitForParse());
+    EXPECT_TRUE(world_loader.IsParsed());
+    EXPECT_FALSE(world_loader.ParseError().empty());
+    EXPECT_EQ(0u, world_loader.GetLevelData().loaded_entities.size());
+
+    std::filesystem::remove(world_filename);
+}